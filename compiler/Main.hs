@@ -78,11 +78,14 @@ writeSchema _ = error "writeSchema: impossible happened."
 
 cppCodegen :: Options -> IO()
 cppCodegen options@Cpp {..} = do
-    let typeMappingAliases = maybe cppTypeMapping (cppCustomAllocTypeMapping scoped_alloc_enabled) allocator
+    when (blob_strings_enabled && isJust allocator) $ fail "--blob-strings can't be used with --allocator."
+    let typeMappingAllocator = maybe cppTypeMapping (cppCustomAllocTypeMapping scoped_alloc_enabled) allocator
+    let typeMappingAliases = if blob_strings_enabled then cppBlobStringsTypeMapping typeMappingAllocator else typeMappingAllocator
     let typeMapping = if type_aliases_enabled then typeMappingAliases else cppExpandAliasesTypeMapping typeMappingAliases
     concurrentlyFor_ files $ codeGen options typeMapping templates
   where
     applyProto = map snd $ filter (enabled apply) protocols
+    directProto = if direct_codecs_enabled then map snd $ filter (\p -> fst p == Compact && enabled apply p) protocols else []
     enabled a p = null a || fst p `elem` a
     protocols =
         [ (Compact, ProtocolReader " ::bond::CompactBinaryReader<::bond::InputBuffer>")
@@ -98,11 +101,11 @@ cppCodegen options@Cpp {..} = do
                         , (grpc_enabled, [grpc_h export_attribute, grpc_cpp])
                         ]
     core_files = [
-          reflection_h export_attribute
-        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled
+          reflection_h directProto export_attribute
+        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled blob_strings_enabled
         , types_cpp
         , apply_h applyProto export_attribute
-        , apply_cpp applyProto
+        , apply_cpp applyProto directProto
         ] <>
         [ enum_h | enum_header]
 cppCodegen _ = error "cppCodegen: impossible happened."
@@ -44,6 +44,8 @@ data Options
         , alloc_ctors_enabled :: Bool
         , type_aliases_enabled :: Bool
         , scoped_alloc_enabled :: Bool
+        , blob_strings_enabled :: Bool
+        , direct_codecs_enabled :: Bool
         , service_inheritance_enabled :: Bool
         }
     | Cs
@@ -100,6 +102,8 @@ cpp = Cpp
     , alloc_ctors_enabled = False &= explicit &= name "alloc-ctors" &= help "Generate constructors with allocator argument"
     , type_aliases_enabled = False &= explicit &= name "type-aliases" &= help "Generate type aliases"
     , scoped_alloc_enabled = False &= explicit &= name "scoped-alloc" &= help "Use std::scoped_allocator_adaptor for strings and containers"
+    , blob_strings_enabled = False &= explicit &= name "blob-strings" &= help "Use bond::blob_string and bond::blob_wstring for strings, which reference the input buffer or a string pool instead of copying"
+    , direct_codecs_enabled = False &= explicit &= name "direct-codecs" &= help "Generate straight-line Compact Binary serialization and deserialization code for each struct, declared in the _reflection.h file and defined in the _apply.cpp file"
     , service_inheritance_enabled = False &= explicit &= name "enable-service-inheritance" &= help "Enable service inheritance syntax in IDL"
     } &=
     name "c++" &=
@@ -11,18 +11,20 @@ import Language.Bond.Syntax.Types
 import Language.Bond.Codegen.TypeMapping
 import Language.Bond.Codegen.Util
 import Language.Bond.Codegen.Cpp.ApplyOverloads
+import Language.Bond.Codegen.Cpp.DirectCodecs
 
 -- | Codegen template for generating /base_name/_apply.cpp containing
 -- definitions of the @Apply@ function overloads for the specified protocols.
 apply_cpp :: [Protocol]   -- ^ List of protocols for which @Apply@ overloads should be generated
+          -> [Protocol]   -- ^ List of Compact Binary protocols for which direct codecs should be generated
           -> MappingContext -> String -> [Import] -> [Declaration] -> (String, Text)
-apply_cpp protocols cpp file _imports declarations = ("_apply.cpp", [lt|
+apply_cpp protocols directProtocols cpp file _imports declarations = ("_apply.cpp", [lt|
 #include "#{file}_apply.h"
 #include "#{file}_reflection.h"
 
 namespace bond
 {
-    #{newlineSepEnd 1 (applyOverloads protocols cpp attr extern) declarations}
+    #{newlineSepEnd 1 (directCodecs directProtocols cpp attr True) declarations}#{newlineSepEnd 1 (applyOverloads protocols cpp attr extern) declarations}
 } // namespace bond
 |])
   where
@@ -0,0 +1,80 @@
+-- Copyright (c) Microsoft. All rights reserved.
+-- Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+{-# LANGUAGE QuasiQuotes, OverloadedStrings, RecordWildCards #-}
+
+module Language.Bond.Codegen.Cpp.DirectCodecs (directCodecs) where
+
+import Data.Monoid
+import Prelude
+import Data.Text.Lazy (Text)
+import Text.Shakespeare.Text
+import Language.Bond.Syntax.Types
+import Language.Bond.Codegen.TypeMapping
+import Language.Bond.Codegen.Util
+import Language.Bond.Codegen.Cpp.ApplyOverloads
+
+-- Explicit specializations of the parsers which Apply uses for the specified
+-- Compact Binary protocols. Fields are written one by one and read with a
+-- switch on the field id, rather than by recursion over the compile-time
+-- schema, which is cheaper to compile. The specializations are declared in
+-- _reflection.h, which defines the schema, and defined in _apply.cpp.
+directCodecs :: [Protocol] -> MappingContext -> Text -> Bool -> Declaration -> Text
+directCodecs protocols@(_:_) cpp attr define s@Struct {..} | null declParams && not (null structFields) = [lt|
+    //
+    // Direct Compact Binary codecs for #{declName}.
+    //
+    #{newlineSep 1 codec protocols}|]
+  where
+    qualifiedName = getDeclTypeName cpp s
+
+    schema = [lt|#{qualifiedName}::Schema|]
+
+    definition code = if define then code else ";"
+
+    codec (ProtocolReader protocolReader) = [lt|
+    template <> template <> #{attr}
+    bool DynamicParser<#{protocolReader}&>::Apply(
+        const ::bond::To< #{qualifiedName}>& transform,
+        const #{schema}& schema)#{definition parser}|]
+
+    codec (ProtocolWriter protocolWriter) = [lt|
+    template <> template <> #{attr}
+    bool StaticParser<const #{qualifiedName}&>::Apply(
+        const ::bond::Serializer<#{protocolWriter} >& transform,
+        const #{schema}& schema)#{definition serializer}|]
+
+    parser = [lt|
+    {
+        return DirectApply(transform, schema, [&](uint16_t id, ::bond::BondDataType type)
+        {
+            switch (id)
+            {
+                #{newlineSep 4 readField structFields}
+                default:
+                    UnknownField(id, type, transform);
+                    break;
+            }
+        });
+    }|]
+
+    readField Field {..} = [lt|case #{fieldOrdinal}:
+                    DirectField(#{schema}::var::#{fieldName}(), type, transform);
+                    break;|]
+
+    serializer = [lt|
+    {
+        transform.Begin(schema.GetMetadata());#{base structBase}
+        #{newlineSep 2 writeField structFields}
+        transform.End();
+        return false;
+    }|]
+
+    base (Just b) = [lt|
+        transform.Base(static_cast<const #{getTypeName cpp b}&>(_input));|]
+    base Nothing = mempty
+
+    writeField Field {..} =
+        [lt|transform.KnownField(#{schema}::var::#{fieldName}(), _input.#{fieldName});|]
+
+directCodecs _ _ _ _ _ = mempty
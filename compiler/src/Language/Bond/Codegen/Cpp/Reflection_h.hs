@@ -16,23 +16,45 @@ import Language.Bond.Syntax.Types
 import Language.Bond.Codegen.TypeMapping
 import Language.Bond.Codegen.Util
 import qualified Language.Bond.Codegen.Cpp.Util as CPP
+import Language.Bond.Codegen.Cpp.ApplyOverloads (Protocol)
+import Language.Bond.Codegen.Cpp.DirectCodecs
 
 -- | Codegen template for generating /base_name/_reflection.h containing schema
--- metadata definitions.
-reflection_h :: Maybe String -> MappingContext -> String -> [Import] -> [Declaration] -> (String, Text)
-reflection_h export_attribute cpp file imports declarations = ("_reflection.h", [lt|
+-- metadata definitions and declarations of the direct codecs for the specified
+-- protocols.
+reflection_h :: [Protocol]   -- ^ List of Compact Binary protocols for which direct codecs are generated
+             -> Maybe String -- ^ Optional attribute to decorate the declarations
+             -> MappingContext -> String -> [Import] -> [Declaration] -> (String, Text)
+reflection_h directProtocols export_attribute cpp file imports declarations = ("_reflection.h", [lt|
 #pragma once
 
 #include "#{file}_types.h"
 #include <bond/core/reflection.h>
-#{newlineSepEnd 0 include imports}
+#{newlineSepEnd 0 include imports}#{directCodecsIncludes}
 #{CPP.openNamespace cpp}
     #{doubleLineSepEnd 1 schema declarations}
 #{CPP.closeNamespace cpp}
-|])
+#{directCodecsDeclarations}|])
   where
     idl = MappingContext idlTypeMapping [] [] []
 
+    -- The direct codecs are explicit specializations of the parser templates.
+    -- They are declared here, next to the schema which any code using them
+    -- needs, so that no compilation unit can instantiate the generic
+    -- templates for these structs instead.
+    directCodecsIncludes = if null directProtocols then mempty else [lt|#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+|]
+
+    directCodecsDeclarations = if null directProtocols then mempty else [lt|
+namespace bond
+{
+    #{newlineSepEnd 1 (directCodecs directProtocols cpp codecs_attr False) declarations}
+} // namespace bond
+|]
+
+    codecs_attr = optional (\a -> [lt|#{a}|]) export_attribute
+
     -- C++ type
     cppType = getTypeName cpp
 
@@ -44,26 +66,25 @@ reflection_h export_attribute cpp file imports declarations = ("_reflection.h",
     // #{declName}
     //
     #{CPP.template s}struct #{className}::Schema
+        : ::bond::reflection::SchemaTemplate<#{className}::Schema>
     {
         typedef #{baseType structBase} base;
-
-        #{export_attr}static const ::bond::Metadata metadata;
-        #{newlineBeginSep 2 fieldMetadata structFields}
+        #{fieldsMetadata}
 
         public: struct var
-        {#{fieldTemplates (zip structFields uniqueFieldTemplateStructNames)}};
+        {#{fieldTemplates (zip3 structFields uniqueFieldTemplateStructNames [0 :: Int ..])}};
 
         private: typedef boost::mpl::list<> fields0;
         #{newlineSep 2 pushField indexedFields}
 
         public: typedef #{typename}fields#{length structFields}::type fields;
-        #{constructor}
         
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit#{metadataInitArgs}("#{declName}", "#{getDeclTypeName idl s}",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit#{metadataInitArgs}("#{declName}", "#{getDeclTypeName idl s}",
                 #{CPP.attributeInit declAttributes}
             );
+            return s_metadata;
         }
     };
     #{onlyTemplate $ CPP.schemaMetadata cpp s}|]
@@ -82,17 +103,6 @@ reflection_h export_attribute cpp file imports declarations = ("_reflection.h",
 
         typename = onlyTemplate [lt|typename |]
 
-        -- constructor, generated only for struct templates
-        constructor = onlyTemplate [lt|
-        Schema()
-        {
-            // Force instantiation of template statics
-            (void)metadata;
-            #{newlineSep 3 static structFields}
-        }|]
-          where
-            static Field {..} = [lt|(void)s_#{fieldName}_metadata;|]
-
         -- reversed list of field names zipped with indexes
         indexedFields :: [(String, Int)]
         indexedFields = zipWith ((,) . fieldName) (reverse structFields) [0..]
@@ -103,11 +113,11 @@ reflection_h export_attribute cpp file imports declarations = ("_reflection.h",
         pushField (field, i) =
             [lt|private: typedef #{typename}boost::mpl::push_front<fields#{i}, #{typename}var::#{field}>::type fields#{i + 1};|]
 
-        fieldMetadata Field {..} =
-            [lt|private: #{export_attr}static const ::bond::Metadata s_#{fieldName}_metadata;|]
+        fieldsMetadata = if null structFields then mempty else [lt|
+        private: #{export_attr}static const ::bond::Metadata* s_fields_metadata();|]
 
-        -- fieldTemplateReservedNames are names used in ::bond::reflection::FieldTemplate<>
-        fieldTemplateReservedNames = ["FieldTemplate", "struct_type", "field_pointer", "field_type", "value_type", "field_modifier", "metadata", "field", "id", "GetVariable"]
+        -- fieldTemplateReservedNames are names used in ::bond::reflection::LazyFieldTemplate<> and its bases
+        fieldTemplateReservedNames = ["FieldTemplateBase", "FieldTemplate", "LazyFieldTemplate", "struct_type", "field_pointer", "field_type", "value_type", "field_modifier", "metadata", "GetMetadata", "field", "id", "GetVariable"]
 
         fieldNames = map (\f -> fieldName f) structFields
 
@@ -115,15 +125,16 @@ reflection_h export_attribute cpp file imports declarations = ("_reflection.h",
 
         uniqueFieldTemplateStructNames = uniqueNames (map (\n -> n ++ "_type") fieldNames) fieldTemplateStructReservedNames
 
-        fieldTemplates = F.foldMap $ \ (f@Field {..}, sn) -> [lt|
+        fieldTemplates = F.foldMap $ \ (f@Field {..}, sn, i) -> [lt|
             // #{fieldName}
-            typedef struct #{sn} : ::bond::reflection::FieldTemplate<
+            typedef struct #{sn} : ::bond::reflection::LazyFieldTemplate<
                 #{fieldOrdinal},
                 #{CPP.modifierTag f},
                 #{className},
                 #{cppType fieldType},
                 &#{className}::#{fieldName},
-                &s_#{fieldName}_metadata
+                &s_fields_metadata,
+                #{i}
             > {} #{fieldName};
         |]
 
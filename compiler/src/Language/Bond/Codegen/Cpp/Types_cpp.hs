@@ -5,39 +5,46 @@
 
 module Language.Bond.Codegen.Cpp.Types_cpp (types_cpp) where
 
+import Data.Function (on)
+import Data.Int (Int32)
+import Data.List (nubBy, sortOn)
 import Data.Monoid
 import Prelude
+import qualified Data.ByteString as BS
+import qualified Data.Text as T
+import Data.Text.Encoding (encodeUtf8)
 import Data.Text.Lazy (Text)
 import Text.Shakespeare.Text
 import Language.Bond.Syntax.Types
+import Language.Bond.Syntax.Util
 import Language.Bond.Codegen.TypeMapping
 import Language.Bond.Codegen.Util
 import qualified Language.Bond.Codegen.Cpp.Util as CPP
 
 -- | Codegen template for generating /base_name/_types.cpp containing
--- definitions of helper functions and schema metadata static variables.
+-- definitions of helper functions and schema field metadata accessors.
 types_cpp :: MappingContext -> String -> [Import] -> [Declaration] -> (String, Text)
 types_cpp cpp file _imports declarations = ("_types.cpp", [lt|
 #include "#{file}_reflection.h"
 #include <bond/core/exception.h>
-#{unorderedMapInclude}
+#{enumNamesInclude}
 #{CPP.openNamespace cpp}
     #{doubleLineSepEnd 1 statics declarations}
 #{CPP.closeNamespace cpp}
 |])
   where
-    unorderedMapInclude = if not (any CPP.isEnumDeclaration declarations) then mempty else [lt|#include <unordered_map>
+    enumNamesInclude = if not (any CPP.isEnumDeclaration declarations) then mempty else [lt|#include <bond/core/detail/enum_names.h>
 |]
 
-    -- definitions of Schema statics for non-generic structs
+    -- definitions of Schema field metadata accessors for non-generic structs
     statics s@Struct {..} =
         if null declParams then CPP.schemaMetadata cpp s else mempty
 
-    -- global variables for enum name/value conversions
+    -- enum name/value conversions
     --
-    -- ToString is intentionally not implemented in terms of FromEnum, as
-    -- ToString returns a reference to the name stored in the map. FromEnum
-    -- copies this name into the output paramater.
+    -- Names of values are looked up with a switch, which returns a reference
+    -- to a static string so that ToString doesn't copy. Values of names are
+    -- looked up without allocation in a perfect hash table computed by gbc.
     statics Enum {..} = [lt|
     namespace _bond_enumerators
     {
@@ -45,58 +52,79 @@ types_cpp cpp file _imports declarations = ("_types.cpp", [lt|
     {
         namespace
         {
-            struct _hash_#{declName}
+            const std::string* _name_#{declName}(enum #{declName} value)
             {
-                std::size_t operator()(enum #{declName} value) const
+                static const std::string s_names[] =
+                    {
+                        #{commaLineSep 6 nameString constByValue}
+                    };
+
+                switch (value)
                 {
-                    return static_cast<std::size_t>(value);
+                    #{newlineSep 5 nameCase (zip [0 :: Int ..] constByValue)}
+                    default: return nullptr;
                 }
-            };
+            }
+
+            const uint32_t _seeds_#{declName}[] = { #{commaSep toText seeds} };
+
+            const ::bond::detail::enum_name<enum #{declName}> _names_#{declName}[] =
+                {
+                    #{commaLineSep 5 tableEntry table}
+                };
         }
+
         const std::string& ToString(enum #{declName} value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum #{declName}, std::string, _hash_#{declName}> >(value);
-            auto it = map.find(value);
+            const std::string* name = _name_#{declName}(value);
 
-            if (map.end() == it)
+            if (name == nullptr)
                 ::bond::InvalidEnumValueException(value, "#{declName}");
 
-            return it->second;
+            return *name;
         }
 
         void FromString(const std::string& name, enum #{declName}& value)
         {
-            if (!ToEnum(value, name))
+            if (!ToEnum(value, name.data(), name.size()))
                 ::bond::InvalidEnumValueException(name.c_str(), "#{declName}");
         }
 
         bool ToEnum(enum #{declName}& value, const std::string& name)
         {
-            const auto& map = GetNameToValueMap<std::unordered_map<std::string, enum #{declName}> >(value);
-            auto it = map.find(name);
-
-            if (map.end() == it)
-                return false;
-
-            value = it->second;
+            return ToEnum(value, name.data(), name.size());
+        }
 
-            return true;
+        bool ToEnum(enum #{declName}& value, const char* name, std::size_t length)
+        {
+            return ::bond::detail::find_enum_value(_seeds_#{declName}, _names_#{declName}, name, length, value);
         }
 
         bool FromEnum(std::string& name, enum #{declName} value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum #{declName}, std::string, _hash_#{declName}> >(value);
-            auto it = map.find(value);
+            const std::string* found = _name_#{declName}(value);
 
-            if (map.end() == it)
+            if (found == nullptr)
                 return false;
 
-            name = it->second;
+            name = *found;
 
             return true;
         }
 
     } // namespace #{declName}
     } // namespace _bond_enumerators|]
+      where
+        -- the first constant with a given value names it, same as in
+        -- GetValueToNameMap; values are compared after conversion to int32
+        -- the same as the enum constants in C++
+        constByValue = nubBy ((==) `on` int32 . snd) $ sortOn snd $ reifyEnumValues enumConstants
+        int32 = fromIntegral :: Int -> Int32
+        nameString (name, _) = [lt|"#{name}"|]
+        nameCase (i, (name, _)) = [lt|case #{declName}::#{name}: return &s_names[#{i}];|]
+        (seeds, table) = CPP.enumNameHashTable $ map constantName enumConstants
+        tableEntry (Just name) = [lt|{ "#{name}", #{utf8Length name}, #{name} }|]
+        tableEntry Nothing = [lt|{ nullptr, 0, {} }|]
+        utf8Length = BS.length . encodeUtf8 . T.pack
 
     statics _ = mempty
@@ -33,8 +33,9 @@ types_h :: Maybe String -- ^ Optional attribute to decorate the enum conversion
         -> Bool         -- ^ 'True' to generate constructors with allocator
         -> Bool         -- ^ 'True' to generate type aliases
         -> Bool         -- ^ 'True' to use std::scoped_allocator_adaptor for strings and containers
+        -> Bool         -- ^ 'True' to use bond::blob_string and bond::blob_wstring for strings
         -> MappingContext -> String -> [Import] -> [Declaration] -> (String, L.Text)
-types_h export_attribute userHeaders enumHeader allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled cpp file imports declarations = ("_types.h", [lt|
+types_h export_attribute userHeaders enumHeader allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled blob_strings_enabled cpp file imports declarations = ("_types.h", [lt|
 #pragma once
 #{newlineBeginSep 0 includeHeader userHeaders}
 #include <bond/core/bond_version.h>
@@ -103,7 +104,8 @@ types_h export_attribute userHeaders enumHeader allocator alloc_ctors_enabled ty
         (have anyNullable, "<bond/core/nullable.h>"),
         (have anyBonded, "<bond/core/bonded.h>"),
         (have anyBlob, "<bond/core/blob.h>"),
-        (scoped_alloc_enabled && have anyStringOrContainer, "<scoped_allocator>")]
+        (scoped_alloc_enabled && have anyStringOrContainer, "<scoped_allocator>"),
+        (blob_strings_enabled, "<bond/core/blob_string.h>")]
 
     -- forward declaration
     typeDeclaration f@Forward {..} = [lt|#{CPP.template f}struct #{declName};|]
@@ -399,6 +401,8 @@ types_h export_attribute userHeaders enumHeader allocator alloc_ctors_enabled ty
 
         #{export_attr}bool ToEnum(enum #{declName}& value, const std::string& name);
 
+        #{export_attr}bool ToEnum(enum #{declName}& value, const char* name, std::size_t length);
+
         #{export_attr}bool FromEnum(std::string& name, enum #{declName} value);
 
     } // namespace #{declName}
@@ -19,12 +19,21 @@ module Language.Bond.Codegen.Cpp.Util
     , isEnumDeclaration
     , enumValueToNameInitList
     , enumNameToValueInitList
+    , enumNameHash
+    , enumNameMix
+    , enumNameHashTable
     ) where
 
+import Data.Bits (shiftL, shiftR, xor, (.&.), (.|.))
 import Data.Int (Int64)
-import Data.List (sortOn)
+import Data.List (foldl', nub, sortOn)
+import Data.Maybe (fromMaybe)
 import Data.Monoid
+import Data.Word (Word32, Word64)
 import Prelude
+import qualified Data.ByteString as BS
+import qualified Data.Text as T
+import Data.Text.Encoding (encodeUtf8)
 import Data.Text.Lazy (Text, unpack)
 import Data.Text.Lazy.Builder (toLazyText)
 import Text.Shakespeare.Text
@@ -111,21 +120,26 @@ enumValue cpp (BT_UserDefined e@Enum {..} _) x =
 enumValue cpp (BT_UserDefined a@Alias {..} args) e = enumValue cpp (resolveAlias a args) e
 enumValue _ _ _ = error "enumValue: impossible happened."
 
--- schema metadata static member definitions
+-- schema metadata definitions
 schemaMetadata :: MappingContext -> Declaration -> Text
+schemaMetadata _ Struct {structFields = []} = mempty
 schemaMetadata cpp s@Struct {..} = [lt|
-    #{template s}const ::bond::Metadata #{className s}::Schema::metadata
-        = #{className s}::Schema::GetMetadata();#{newlineBeginSep 1 staticDef structFields}|]
+    #{template s}const ::bond::Metadata* #{className s}::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            #{commaLineSep 3 metadataInit structFields}
+        };
+        return s_metadata;
+    }|]
   where
-    -- static member definition for field metadata
-    staticDef f@Field {..}
-        | fieldModifier == Optional && null fieldAttributes = [lt|
-    #{template s}const ::bond::Metadata #{className s}::Schema::s_#{fieldName}_metadata
-        = ::bond::reflection::MetadataInit(#{defaultInit f}"#{fieldName}");|]
-        | otherwise = [lt|
-    #{template s}const ::bond::Metadata #{className s}::Schema::s_#{fieldName}_metadata
-        = ::bond::reflection::MetadataInit(#{defaultInit f}"#{fieldName}", #{modifierTag f}::value,
-                #{attributeInit fieldAttributes});|]
+    -- metadata of all the fields is constructed together on first use, so
+    -- that each field doesn't need its own guard and cleanup code
+    metadataInit f = [lt|::bond::reflection::MetadataInit(#{metadataInitArgs f})|]
+    metadataInitArgs f@Field {..}
+        | fieldModifier == Optional && null fieldAttributes = [lt|#{defaultInit f}"#{fieldName}"|]
+        | otherwise = [lt|#{defaultInit f}"#{fieldName}", #{modifierTag f}::value,
+                #{attributeInit fieldAttributes}|]
       where
         defaultInit Field {fieldDefault = (Just def)} = [lt|#{explicitDefault def}, |]
         defaultInit _ = mempty
@@ -181,3 +195,49 @@ enumNameToValueInitList n Enum {..} = commaLineSep n nameValueConst enumConstByN
     nameValueConst Constant {..} = [lt|{ "#{constantName}", #{constantName} }|]
     enumConstByName = sortOn constantName enumConstants
 enumNameToValueInitList _ _ = error "enumNameToValueInitList: impossible happened."
+
+-- | Hash of the UTF-8 encoding of an enum constant name, read 8 bytes at a
+-- time as little endian words. Must match bond::detail::enum_name_hash.
+enumNameHash :: String -> Word64
+enumNameHash name = foldl' step (fromIntegral (BS.length bytes) * multiplier) (words8 bytes)
+  where
+    bytes = encodeUtf8 $ T.pack name
+    multiplier = 0x9e3779b97f4a7c15
+    step h w = (h `xor` w) * multiplier
+    words8 b
+        | BS.null b = []
+        | otherwise = BS.foldr (\c w -> w `shiftL` 8 .|. fromIntegral c) 0 (BS.take 8 b) : words8 (BS.drop 8 b)
+
+-- | MurmurHash3 finalizer. Must match bond::detail::enum_name_mix.
+enumNameMix :: Word64 -> Word64
+enumNameMix = shift33 . (* 0xc4ceb9fe1a85ec53) . shift33 . (* 0xff51afd7ed558ccd) . shift33
+  where
+    shift33 h = h `xor` (h `shiftR` 33)
+
+-- | Perfect hash table of enum constant names for
+-- bond::detail::find_enum_value. Returns seeds of the buckets and the table
+-- slots. Names are assigned to buckets by the mixed 'enumNameHash', and the
+-- seed of each bucket is the first one with which its names, mixed with the
+-- seed, map to distinct free slots. Buckets with more names are placed first,
+-- while the table is mostly empty. Table load is at most 0.8 and both sizes
+-- are powers of 2. Names with the same hash map to the same slot with any
+-- seed, so they are reported as an error.
+enumNameHashTable :: [String] -> ([Word32], [Maybe String])
+enumNameHashTable names = case collisions of
+    (a, b) : _ -> error $ "Enum constants " ++ a ++ " and " ++ b ++ " have the same name hash, one of them must be renamed"
+    [] -> (map seed [0 .. buckets - 1], map (`lookup` slots) [0 .. size - 1])
+  where
+    collisions = [(a, b) | ((a, ha), (b, hb)) <- zip sorted (drop 1 sorted), ha == hb]
+    sorted = sortOn snd hashes
+    size = until (\s -> s * 4 >= length names * 5) (* 2) 1
+    buckets = max 1 (size `div` 4)
+    index n h = fromIntegral h .&. (n - 1) :: Int
+    hashes = [(name, enumNameHash name) | name <- names]
+    members b = [(name, h) | (name, h) <- hashes, index buckets (enumNameMix h) == b]
+    (seeds, slots) = foldl' place ([], []) $ sortOn (negate . length . snd) [(b, members b) | b <- [0 .. buckets - 1]]
+    place (placedSeeds, used) (b, bucket) = ((b, x) : placedSeeds, placed ++ used)
+      where
+        (x, placed) = head [(x', p) | x' <- [1 ..], let p = hashed x', fits p]
+        hashed x' = [(index size (enumNameMix (h `xor` fromIntegral x')), name) | (name, h) <- bucket]
+        fits p = let is = map fst p in nub is == is && all (`notElem` map fst used) is
+    seed b = fromMaybe 0 $ lookup b seeds
@@ -24,6 +24,7 @@ module Language.Bond.Codegen.TypeMapping
     , cppTypeMapping
     , cppCustomAllocTypeMapping
     , cppExpandAliasesTypeMapping
+    , cppBlobStringsTypeMapping
     , csTypeMapping
     , csCollectionInterfacesTypeMapping
     , javaTypeMapping
@@ -195,6 +196,15 @@ cppExpandAliasesTypeMapping m = m
     , annotatedMapping = cppExpandAliasesTypeMapping $ annotatedMapping m
     }
 
+-- | C++ type name mapping using @::bond::blob_string@ and @::bond::blob_wstring@ for strings.
+cppBlobStringsTypeMapping :: TypeMapping -> TypeMapping
+cppBlobStringsTypeMapping m = m
+    { mapType = cppTypeBlobStrings $ mapType m
+    , instanceMapping = cppBlobStringsTypeMapping $ instanceMapping m
+    , elementMapping = cppBlobStringsTypeMapping $ elementMapping m
+    , annotatedMapping = cppBlobStringsTypeMapping $ annotatedMapping m
+    }
+
 -- | The default C# type name mapping.
 csTypeMapping :: TypeMapping
 csTypeMapping = TypeMapping
@@ -442,6 +452,11 @@ cppTypeCustomAlloc scoped alloc (BT_Set element) = "std::set<" <>> elementTypeNa
 cppTypeCustomAlloc scoped alloc (BT_Map key value) = "std::map<" <>> elementTypeName key <<>> ", " <>> elementTypeName value <<>> comparer key <<>> pairAllocator scoped alloc key value <<> ">"
 cppTypeCustomAlloc _ _ t = cppType t
 
+cppTypeBlobStrings :: (Type -> TypeNameBuilder) -> Type -> TypeNameBuilder
+cppTypeBlobStrings _ BT_String = pure "::bond::blob_string"
+cppTypeBlobStrings _ BT_WString = pure "::bond::blob_wstring"
+cppTypeBlobStrings m t = m t
+
 cppTypeExpandAliases :: (Type -> TypeNameBuilder) -> Type -> TypeNameBuilder
 cppTypeExpandAliases _ (BT_UserDefined a@Alias {..} args) = aliasTypeName a args
 cppTypeExpandAliases m t = m t
@@ -43,6 +43,9 @@ import Language.Bond.Util
 instance ToText Word16 where
     toText = toText . show
 
+instance ToText Word32 where
+    toText = toText . show
+
 instance ToText Double where
     toText = toText . show
 
@@ -112,12 +112,29 @@ tests = testGroup "Compiler tests"
                 , "--using=String=my::string"
                 ]
                 "custom_alias_without_allocator"
+            , verifyCodegenVariation
+                [ "c++"
+                , "--blob-strings"
+                ]
+                "basic_types"
+                "blob_strings"
+            , verifyCodegenVariation
+                [ "c++"
+                , "--blob-strings"
+                ]
+                "defaults"
+                "blob_strings"
            , testGroup "Apply"
                 [ verifyApplyCodegen
                     [ "c++"
                     , "--apply-attribute=DllExport"
                     ]
                     "basic_types"
+                , verifyApplyCodegen
+                    [ "c++"
+                    , "--direct-codecs"
+                    ]
+                    "inheritance"
                 ]
            , testGroup "Exports"
                 [ verifyExportsCodegen
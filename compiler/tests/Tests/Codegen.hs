@@ -58,13 +58,16 @@ verifyCodegenVariation args baseName variation =
 verifyApplyCodegen :: [String] -> FilePath -> TestTree
 verifyApplyCodegen args baseName =
     testGroup baseName $
-        map (verifyFile options baseName cppTypeMapping "apply") templates
+        map (verifyFile options baseName cppTypeMapping subfolder) templates
   where
     options = processOptions args
+    subfolder = if direct_codecs_enabled options then "direct_codecs" else "apply"
+    directProtocols = if direct_codecs_enabled options then take 3 protocols else []
     templates =
         [ apply_h protocols (export_attribute options)
-        , apply_cpp protocols
-        ]
+        , apply_cpp protocols directProtocols
+        ] <>
+        [ reflection_h directProtocols (export_attribute options) | direct_codecs_enabled options ]
     protocols =
         [ ProtocolReader "bond::CompactBinaryReader<bond::InputBuffer>"
         , ProtocolWriter "bond::CompactBinaryWriter<bond::OutputBuffer>"
@@ -82,8 +85,8 @@ verifyExportsCodegen args baseName =
   where
     options = processOptions args
     templates Cpp {..} =
-        [ reflection_h export_attribute
-        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled
+        [ reflection_h [] export_attribute
+        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled blob_strings_enabled
         ]
 
 verifyCppGrpcCodegen :: [String] -> FilePath -> TestTree
@@ -130,13 +133,13 @@ verifyFiles options baseName variation =
     constructorOptions Cs {..} = if constructor_parameters
         then ConstructorParameters
         else DefaultWithProtectedBase
-    typeMapping Cpp {..} = cppExpandAliases type_aliases_enabled $ maybe cppTypeMapping (cppCustomAllocTypeMapping scoped_alloc_enabled) allocator
+    typeMapping Cpp {..} = cppExpandAliases type_aliases_enabled $ cppBlobStrings blob_strings_enabled $ maybe cppTypeMapping (cppCustomAllocTypeMapping scoped_alloc_enabled) allocator
     typeMapping Cs {} = csTypeMapping
     typeMapping Java {} = javaTypeMapping
     templates Cpp {..} =
-        [ (reflection_h export_attribute)
+        [ (reflection_h [] export_attribute)
         , types_cpp
-        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled
+        , types_h export_attribute header enum_header allocator alloc_ctors_enabled type_aliases_enabled scoped_alloc_enabled blob_strings_enabled
         ] <>
         [ enum_h | enum_header]
     templates Cs {..} =
@@ -149,6 +152,8 @@ verifyFiles options baseName variation =
         [ testGroup "collection interfaces" $
             map (verify csCollectionInterfacesTypeMapping (variation </> "collection-interfaces")) (templates options)
         ]
+    extra Cpp {..}
+        | blob_strings_enabled = []
     extra Cpp {..} =
         [ testGroup "custom allocator" $
             map (verify (cppExpandAliasesTypeMapping $ cppCustomAllocTypeMapping False "arena") (variation </> "allocator"))
@@ -206,6 +211,11 @@ javaCatTemplate mappingContext _ imports declarations =
           Enum {}   -> Just $ enum_java mappingContext declaration
           _         -> Nothing
 
+cppBlobStrings :: Bool -> TypeMapping -> TypeMapping
+cppBlobStrings blob_strings_enabled = if blob_strings_enabled
+    then cppBlobStringsTypeMapping
+    else id
+
 cppExpandAliases :: Bool -> TypeMapping -> TypeMapping
 cppExpandAliases type_aliases_enabled = if type_aliases_enabled
     then id
@@ -10,144 +10,144 @@ namespace test
     // foo
     //
     struct foo::Schema
+        : ::bond::reflection::SchemaTemplate<foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
-        
-        private: static const ::bond::Metadata s_l_metadata;
-        private: static const ::bond::Metadata s_v_metadata;
-        private: static const ::bond::Metadata s_s_metadata;
-        private: static const ::bond::Metadata s_m_metadata;
-        private: static const ::bond::Metadata s_st_metadata;
-        private: static const ::bond::Metadata s_d_metadata;
-        private: static const ::bond::Metadata s_l1_metadata;
-        private: static const ::bond::Metadata s_v1_metadata;
-        private: static const ::bond::Metadata s_s1_metadata;
-        private: static const ::bond::Metadata s_m1_metadata;
-        private: static const ::bond::Metadata s_st1_metadata;
-        private: static const ::bond::Metadata s_na_metadata;
+        
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // l
-            typedef struct l_type : ::bond::reflection::FieldTemplate<
+            typedef struct l_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::list<bool, typename std::allocator_traits<arena>::template rebind_alloc<bool> >,
                 &foo::l,
-                &s_l_metadata
+                &s_fields_metadata,
+                0
             > {} l;
         
             // v
-            typedef struct v_type : ::bond::reflection::FieldTemplate<
+            typedef struct v_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::vector<bool, typename std::allocator_traits<arena>::template rebind_alloc<bool> >,
                 &foo::v,
-                &s_v_metadata
+                &s_fields_metadata,
+                1
             > {} v;
         
             // s
-            typedef struct s_type : ::bond::reflection::FieldTemplate<
+            typedef struct s_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::set<bool, std::less<bool>, typename std::allocator_traits<arena>::template rebind_alloc<bool> >,
                 &foo::s,
-                &s_s_metadata
+                &s_fields_metadata,
+                2
             > {} s;
         
             // m
-            typedef struct m_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_type : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::map<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, bool, std::less<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > >, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, bool> > >,
                 &foo::m,
-                &s_m_metadata
+                &s_fields_metadata,
+                3
             > {} m;
         
             // st
-            typedef struct st_type : ::bond::reflection::FieldTemplate<
+            typedef struct st_type : ::bond::reflection::LazyFieldTemplate<
                 4,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >,
                 &foo::st,
-                &s_st_metadata
+                &s_fields_metadata,
+                4
             > {} st;
         
             // d
-            typedef struct d_type : ::bond::reflection::FieldTemplate<
+            typedef struct d_type : ::bond::reflection::LazyFieldTemplate<
                 5,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >,
                 &foo::d,
-                &s_d_metadata
+                &s_fields_metadata,
+                5
             > {} d;
         
             // l1
-            typedef struct l1_type : ::bond::reflection::FieldTemplate<
+            typedef struct l1_type : ::bond::reflection::LazyFieldTemplate<
                 10,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<std::list<bool, typename std::allocator_traits<arena>::template rebind_alloc<bool> > >,
                 &foo::l1,
-                &s_l1_metadata
+                &s_fields_metadata,
+                6
             > {} l1;
         
             // v1
-            typedef struct v1_type : ::bond::reflection::FieldTemplate<
+            typedef struct v1_type : ::bond::reflection::LazyFieldTemplate<
                 11,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<std::vector<bool, typename std::allocator_traits<arena>::template rebind_alloc<bool> > >,
                 &foo::v1,
-                &s_v1_metadata
+                &s_fields_metadata,
+                7
             > {} v1;
         
             // s1
-            typedef struct s1_type : ::bond::reflection::FieldTemplate<
+            typedef struct s1_type : ::bond::reflection::LazyFieldTemplate<
                 12,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<std::set<bool, std::less<bool>, typename std::allocator_traits<arena>::template rebind_alloc<bool> > >,
                 &foo::s1,
-                &s_s1_metadata
+                &s_fields_metadata,
+                8
             > {} s1;
         
             // m1
-            typedef struct m1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m1_type : ::bond::reflection::LazyFieldTemplate<
                 13,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<std::map<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, bool, std::less<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > >, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, bool> > > >,
                 &foo::m1,
-                &s_m1_metadata
+                &s_fields_metadata,
+                9
             > {} m1;
         
             // st1
-            typedef struct st1_type : ::bond::reflection::FieldTemplate<
+            typedef struct st1_type : ::bond::reflection::LazyFieldTemplate<
                 14,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > >,
                 &foo::st1,
-                &s_st1_metadata
+                &s_fields_metadata,
+                10
             > {} st1;
         
             // na
-            typedef struct na_type : ::bond::reflection::FieldTemplate<
+            typedef struct na_type : ::bond::reflection::LazyFieldTemplate<
                 15,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::set<std::list<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > > > >, std::less<std::list<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > > > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::list<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::map<int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const int32_t, std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > > > > > > > >,
                 &foo::na,
-                &s_na_metadata
+                &s_fields_metadata,
+                11
             > {} na;
         };
 
@@ -167,12 +167,12 @@ namespace test
 
         public: typedef fields12::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("foo", "test.foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("foo", "test.foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -181,34 +181,34 @@ namespace test
     // withFoo
     //
     struct withFoo::Schema
+        : ::bond::reflection::SchemaTemplate<withFoo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_f_metadata;
-        private: static const ::bond::Metadata s_f1_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // f
-            typedef struct f_type : ::bond::reflection::FieldTemplate<
+            typedef struct f_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 withFoo,
                 ::test::foo,
                 &withFoo::f,
-                &s_f_metadata
+                &s_fields_metadata,
+                0
             > {} f;
         
             // f1
-            typedef struct f1_type : ::bond::reflection::FieldTemplate<
+            typedef struct f1_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 withFoo,
                 ::test::foo,
                 &withFoo::f1,
-                &s_f1_metadata
+                &s_fields_metadata,
+                1
             > {} f1;
         };
 
@@ -218,12 +218,12 @@ namespace test
 
         public: typedef fields2::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("withFoo", "test.withFoo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("withFoo", "test.withFoo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -1,7 +1,7 @@
 
 #include "aliases_reflection.h"
 #include <bond/core/exception.h>
-#include <unordered_map>
+#include <bond/core/detail/enum_names.h>
 
 namespace tests
 {
@@ -12,53 +12,63 @@ namespace tests
     {
         namespace
         {
-            struct _hash_EnumToWrap
+            const std::string* _name_EnumToWrap(enum EnumToWrap value)
             {
-                std::size_t operator()(enum EnumToWrap value) const
+                static const std::string s_names[] =
+                    {
+                        "anEnumValue"
+                    };
+
+                switch (value)
                 {
-                    return static_cast<std::size_t>(value);
+                    case EnumToWrap::anEnumValue: return &s_names[0];
+                    default: return nullptr;
                 }
-            };
+            }
+
+            const uint32_t _seeds_EnumToWrap[] = { 1 };
+
+            const ::bond::detail::enum_name<enum EnumToWrap> _names_EnumToWrap[] =
+                {
+                    { "anEnumValue", 11, anEnumValue },
+                    { nullptr, 0, {} }
+                };
         }
+
         const std::string& ToString(enum EnumToWrap value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum EnumToWrap, std::string, _hash_EnumToWrap> >(value);
-            auto it = map.find(value);
+            const std::string* name = _name_EnumToWrap(value);
 
-            if (map.end() == it)
+            if (name == nullptr)
                 ::bond::InvalidEnumValueException(value, "EnumToWrap");
 
-            return it->second;
+            return *name;
         }
 
         void FromString(const std::string& name, enum EnumToWrap& value)
         {
-            if (!ToEnum(value, name))
+            if (!ToEnum(value, name.data(), name.size()))
                 ::bond::InvalidEnumValueException(name.c_str(), "EnumToWrap");
         }
 
         bool ToEnum(enum EnumToWrap& value, const std::string& name)
         {
-            const auto& map = GetNameToValueMap<std::unordered_map<std::string, enum EnumToWrap> >(value);
-            auto it = map.find(name);
-
-            if (map.end() == it)
-                return false;
-
-            value = it->second;
+            return ToEnum(value, name.data(), name.size());
+        }
 
-            return true;
+        bool ToEnum(enum EnumToWrap& value, const char* name, std::size_t length)
+        {
+            return ::bond::detail::find_enum_value(_seeds_EnumToWrap, _names_EnumToWrap, name, length, value);
         }
 
         bool FromEnum(std::string& name, enum EnumToWrap value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum EnumToWrap, std::string, _hash_EnumToWrap> >(value);
-            auto it = map.find(value);
+            const std::string* found = _name_EnumToWrap(value);
 
-            if (map.end() == it)
+            if (found == nullptr)
                 return false;
 
-            name = it->second;
+            name = *found;
 
             return true;
         }
@@ -67,11 +77,14 @@ namespace tests
     } // namespace _bond_enumerators
 
     
-    const ::bond::Metadata WrappingAnEnum::Schema::metadata
-        = WrappingAnEnum::Schema::GetMetadata();
-    
-    const ::bond::Metadata WrappingAnEnum::Schema::s_aWrappedEnum_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumToWrap::anEnumValue, "aWrappedEnum");
+    const ::bond::Metadata* WrappingAnEnum::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumToWrap::anEnumValue, "aWrappedEnum")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
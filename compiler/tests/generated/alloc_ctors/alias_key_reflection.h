@@ -10,34 +10,34 @@ namespace test
     // foo
     //
     struct foo::Schema
+        : ::bond::reflection::SchemaTemplate<foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_m_metadata;
-        private: static const ::bond::Metadata s_s_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // m
-            typedef struct m_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::map<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, int32_t, std::less<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > >, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, int32_t> > >,
                 &foo::m,
-                &s_m_metadata
+                &s_fields_metadata,
+                0
             > {} m;
         
             // s
-            typedef struct s_type : ::bond::reflection::FieldTemplate<
+            typedef struct s_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 std::set<int32_t, std::less<int32_t>, typename std::allocator_traits<arena>::template rebind_alloc<int32_t> >,
                 &foo::s,
-                &s_s_metadata
+                &s_fields_metadata,
+                1
             > {} s;
         };
 
@@ -47,12 +47,12 @@ namespace test
 
         public: typedef fields2::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("foo", "test.foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("foo", "test.foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
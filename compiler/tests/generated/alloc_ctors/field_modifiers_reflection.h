@@ -10,45 +10,45 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_o_metadata;
-        private: static const ::bond::Metadata s_r_metadata;
-        private: static const ::bond::Metadata s_ro_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // o
-            typedef struct o_type : ::bond::reflection::FieldTemplate<
+            typedef struct o_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 bool,
                 &Foo::o,
-                &s_o_metadata
+                &s_fields_metadata,
+                0
             > {} o;
         
             // r
-            typedef struct r_type : ::bond::reflection::FieldTemplate<
+            typedef struct r_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::required_field_modifier,
                 Foo,
                 int16_t,
                 &Foo::r,
-                &s_r_metadata
+                &s_fields_metadata,
+                1
             > {} r;
         
             // ro
-            typedef struct ro_type : ::bond::reflection::FieldTemplate<
+            typedef struct ro_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::required_optional_field_modifier,
                 Foo,
                 double,
                 &Foo::ro,
-                &s_ro_metadata
+                &s_fields_metadata,
+                2
             > {} ro;
         };
 
@@ -59,12 +59,12 @@ namespace tests
 
         public: typedef fields3::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
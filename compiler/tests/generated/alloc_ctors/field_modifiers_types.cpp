@@ -5,19 +5,18 @@
 namespace tests
 {
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_o_metadata
-        = ::bond::reflection::MetadataInit("o");
-    
-    const ::bond::Metadata Foo::Schema::s_r_metadata
-        = ::bond::reflection::MetadataInit("r", ::bond::reflection::required_field_modifier::value,
-                ::bond::reflection::Attributes());
-    
-    const ::bond::Metadata Foo::Schema::s_ro_metadata
-        = ::bond::reflection::MetadataInit("ro", ::bond::reflection::required_optional_field_modifier::value,
-                ::bond::reflection::Attributes());
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("o"),
+            ::bond::reflection::MetadataInit("r", ::bond::reflection::required_field_modifier::value,
+                ::bond::reflection::Attributes()),
+            ::bond::reflection::MetadataInit("ro", ::bond::reflection::required_optional_field_modifier::value,
+                ::bond::reflection::Attributes())
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
@@ -5,11 +5,14 @@
 namespace import_test
 {
     
-    const ::bond::Metadata HasEmpty::Schema::metadata
-        = HasEmpty::Schema::GetMetadata();
-    
-    const ::bond::Metadata HasEmpty::Schema::s_e_metadata
-        = ::bond::reflection::MetadataInit("e");
+    const ::bond::Metadata* HasEmpty::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("e")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace import_test
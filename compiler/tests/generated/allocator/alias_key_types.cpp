@@ -5,14 +5,15 @@
 namespace test
 {
     
-    const ::bond::Metadata foo::Schema::metadata
-        = foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata foo::Schema::s_m_metadata
-        = ::bond::reflection::MetadataInit("m");
-    
-    const ::bond::Metadata foo::Schema::s_s_metadata
-        = ::bond::reflection::MetadataInit("s");
+    const ::bond::Metadata* foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("m"),
+            ::bond::reflection::MetadataInit("s")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace test
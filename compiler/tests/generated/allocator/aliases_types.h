@@ -125,6 +125,8 @@ namespace tests
 
         bool ToEnum(enum EnumToWrap& value, const std::string& name);
 
+        bool ToEnum(enum EnumToWrap& value, const char* name, std::size_t length);
+
         bool FromEnum(std::string& name, enum EnumToWrap value);
 
     } // namespace EnumToWrap
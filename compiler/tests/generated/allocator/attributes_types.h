@@ -64,6 +64,8 @@ namespace tests
 
         bool ToEnum(enum Enum& value, const std::string& name);
 
+        bool ToEnum(enum Enum& value, const char* name, std::size_t length);
+
         bool FromEnum(std::string& name, enum Enum value);
 
     } // namespace Enum
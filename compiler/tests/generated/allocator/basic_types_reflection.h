@@ -10,166 +10,166 @@ namespace tests
     // BasicTypes
     //
     struct BasicTypes::Schema
+        : ::bond::reflection::SchemaTemplate<BasicTypes::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s__bool_metadata;
-        private: static const ::bond::Metadata s__str_metadata;
-        private: static const ::bond::Metadata s__wstr_metadata;
-        private: static const ::bond::Metadata s__uint64_metadata;
-        private: static const ::bond::Metadata s__uint16_metadata;
-        private: static const ::bond::Metadata s__uint32_metadata;
-        private: static const ::bond::Metadata s__uint8_metadata;
-        private: static const ::bond::Metadata s__int8_metadata;
-        private: static const ::bond::Metadata s__int16_metadata;
-        private: static const ::bond::Metadata s__int32_metadata;
-        private: static const ::bond::Metadata s__int64_metadata;
-        private: static const ::bond::Metadata s__double_metadata;
-        private: static const ::bond::Metadata s__float_metadata;
-        private: static const ::bond::Metadata s__blob_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // _bool
-            typedef struct _bool_type : ::bond::reflection::FieldTemplate<
+            typedef struct _bool_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 bool,
                 &BasicTypes::_bool,
-                &s__bool_metadata
+                &s_fields_metadata,
+                0
             > {} _bool;
         
             // _str
-            typedef struct _str_type : ::bond::reflection::FieldTemplate<
+            typedef struct _str_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >,
                 &BasicTypes::_str,
-                &s__str_metadata
+                &s_fields_metadata,
+                1
             > {} _str;
         
             // _wstr
-            typedef struct _wstr_type : ::bond::reflection::FieldTemplate<
+            typedef struct _wstr_type : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 std::basic_string<wchar_t, std::char_traits<wchar_t>, typename std::allocator_traits<arena>::template rebind_alloc<wchar_t> >,
                 &BasicTypes::_wstr,
-                &s__wstr_metadata
+                &s_fields_metadata,
+                2
             > {} _wstr;
         
             // _uint64
-            typedef struct _uint64_type : ::bond::reflection::FieldTemplate<
+            typedef struct _uint64_type : ::bond::reflection::LazyFieldTemplate<
                 10,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 uint64_t,
                 &BasicTypes::_uint64,
-                &s__uint64_metadata
+                &s_fields_metadata,
+                3
             > {} _uint64;
         
             // _uint16
-            typedef struct _uint16_type : ::bond::reflection::FieldTemplate<
+            typedef struct _uint16_type : ::bond::reflection::LazyFieldTemplate<
                 11,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 uint16_t,
                 &BasicTypes::_uint16,
-                &s__uint16_metadata
+                &s_fields_metadata,
+                4
             > {} _uint16;
         
             // _uint32
-            typedef struct _uint32_type : ::bond::reflection::FieldTemplate<
+            typedef struct _uint32_type : ::bond::reflection::LazyFieldTemplate<
                 12,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 uint32_t,
                 &BasicTypes::_uint32,
-                &s__uint32_metadata
+                &s_fields_metadata,
+                5
             > {} _uint32;
         
             // _uint8
-            typedef struct _uint8_type : ::bond::reflection::FieldTemplate<
+            typedef struct _uint8_type : ::bond::reflection::LazyFieldTemplate<
                 13,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 uint8_t,
                 &BasicTypes::_uint8,
-                &s__uint8_metadata
+                &s_fields_metadata,
+                6
             > {} _uint8;
         
             // _int8
-            typedef struct _int8_type : ::bond::reflection::FieldTemplate<
+            typedef struct _int8_type : ::bond::reflection::LazyFieldTemplate<
                 14,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 int8_t,
                 &BasicTypes::_int8,
-                &s__int8_metadata
+                &s_fields_metadata,
+                7
             > {} _int8;
         
             // _int16
-            typedef struct _int16_type : ::bond::reflection::FieldTemplate<
+            typedef struct _int16_type : ::bond::reflection::LazyFieldTemplate<
                 15,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 int16_t,
                 &BasicTypes::_int16,
-                &s__int16_metadata
+                &s_fields_metadata,
+                8
             > {} _int16;
         
             // _int32
-            typedef struct _int32_type : ::bond::reflection::FieldTemplate<
+            typedef struct _int32_type : ::bond::reflection::LazyFieldTemplate<
                 16,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 int32_t,
                 &BasicTypes::_int32,
-                &s__int32_metadata
+                &s_fields_metadata,
+                9
             > {} _int32;
         
             // _int64
-            typedef struct _int64_type : ::bond::reflection::FieldTemplate<
+            typedef struct _int64_type : ::bond::reflection::LazyFieldTemplate<
                 17,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 int64_t,
                 &BasicTypes::_int64,
-                &s__int64_metadata
+                &s_fields_metadata,
+                10
             > {} _int64;
         
             // _double
-            typedef struct _double_type : ::bond::reflection::FieldTemplate<
+            typedef struct _double_type : ::bond::reflection::LazyFieldTemplate<
                 18,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 double,
                 &BasicTypes::_double,
-                &s__double_metadata
+                &s_fields_metadata,
+                11
             > {} _double;
         
             // _float
-            typedef struct _float_type : ::bond::reflection::FieldTemplate<
+            typedef struct _float_type : ::bond::reflection::LazyFieldTemplate<
                 20,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 float,
                 &BasicTypes::_float,
-                &s__float_metadata
+                &s_fields_metadata,
+                12
             > {} _float;
         
             // _blob
-            typedef struct _blob_type : ::bond::reflection::FieldTemplate<
+            typedef struct _blob_type : ::bond::reflection::LazyFieldTemplate<
                 21,
                 ::bond::reflection::optional_field_modifier,
                 BasicTypes,
                 ::bond::blob,
                 &BasicTypes::_blob,
-                &s__blob_metadata
+                &s_fields_metadata,
+                13
             > {} _blob;
         };
 
@@ -191,12 +191,12 @@ namespace tests
 
         public: typedef fields14::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("BasicTypes", "tests.BasicTypes",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("BasicTypes", "tests.BasicTypes",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -7,14 +7,15 @@ namespace deprecated
 namespace bondmeta
 {
     
-    const ::bond::Metadata HasMetaFields::Schema::metadata
-        = HasMetaFields::Schema::GetMetadata();
-    
-    const ::bond::Metadata HasMetaFields::Schema::s_full_name_metadata
-        = ::bond::reflection::MetadataInit("full_name");
-    
-    const ::bond::Metadata HasMetaFields::Schema::s_name_metadata
-        = ::bond::reflection::MetadataInit("name");
+    const ::bond::Metadata* HasMetaFields::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("full_name"),
+            ::bond::reflection::MetadataInit("name")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace bondmeta
@@ -10,10 +10,9 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
 
         public: struct var
@@ -24,12 +23,12 @@ namespace tests
 
         public: typedef fields0::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -38,89 +37,89 @@ namespace tests
     // ComplexTypes
     //
     struct ComplexTypes::Schema
+        : ::bond::reflection::SchemaTemplate<ComplexTypes::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_li8_metadata;
-        private: static const ::bond::Metadata s_sb_metadata;
-        private: static const ::bond::Metadata s_vb_metadata;
-        private: static const ::bond::Metadata s_nf_metadata;
-        private: static const ::bond::Metadata s_msws_metadata;
-        private: static const ::bond::Metadata s_bfoo_metadata;
-        private: static const ::bond::Metadata s_m_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // li8
-            typedef struct li8_type : ::bond::reflection::FieldTemplate<
+            typedef struct li8_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 std::list<int8_t, typename std::allocator_traits<arena>::template rebind_alloc<int8_t> >,
                 &ComplexTypes::li8,
-                &s_li8_metadata
+                &s_fields_metadata,
+                0
             > {} li8;
         
             // sb
-            typedef struct sb_type : ::bond::reflection::FieldTemplate<
+            typedef struct sb_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 std::set<bool, std::less<bool>, typename std::allocator_traits<arena>::template rebind_alloc<bool> >,
                 &ComplexTypes::sb,
-                &s_sb_metadata
+                &s_fields_metadata,
+                1
             > {} sb;
         
             // vb
-            typedef struct vb_type : ::bond::reflection::FieldTemplate<
+            typedef struct vb_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 std::vector< ::bond::blob, typename std::allocator_traits<arena>::template rebind_alloc< ::bond::blob> >,
                 &ComplexTypes::vb,
-                &s_vb_metadata
+                &s_fields_metadata,
+                2
             > {} vb;
         
             // nf
-            typedef struct nf_type : ::bond::reflection::FieldTemplate<
+            typedef struct nf_type : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 ::bond::nullable<float>,
                 &ComplexTypes::nf,
-                &s_nf_metadata
+                &s_fields_metadata,
+                3
             > {} nf;
         
             // msws
-            typedef struct msws_type : ::bond::reflection::FieldTemplate<
+            typedef struct msws_type : ::bond::reflection::LazyFieldTemplate<
                 4,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 std::map<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::basic_string<wchar_t, std::char_traits<wchar_t>, typename std::allocator_traits<arena>::template rebind_alloc<wchar_t> >, std::less<std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> > >, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const std::basic_string<char, std::char_traits<char>, typename std::allocator_traits<arena>::template rebind_alloc<char> >, std::basic_string<wchar_t, std::char_traits<wchar_t>, typename std::allocator_traits<arena>::template rebind_alloc<wchar_t> > > > >,
                 &ComplexTypes::msws,
-                &s_msws_metadata
+                &s_fields_metadata,
+                4
             > {} msws;
         
             // bfoo
-            typedef struct bfoo_type : ::bond::reflection::FieldTemplate<
+            typedef struct bfoo_type : ::bond::reflection::LazyFieldTemplate<
                 5,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 ::bond::bonded< ::tests::Foo>,
                 &ComplexTypes::bfoo,
-                &s_bfoo_metadata
+                &s_fields_metadata,
+                5
             > {} bfoo;
         
             // m
-            typedef struct m_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_type : ::bond::reflection::LazyFieldTemplate<
                 6,
                 ::bond::reflection::optional_field_modifier,
                 ComplexTypes,
                 std::map<double, std::list<std::vector< ::bond::nullable< ::bond::bonded< ::tests::Bar> >, typename std::allocator_traits<arena>::template rebind_alloc< ::bond::nullable< ::bond::bonded< ::tests::Bar> > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::vector< ::bond::nullable< ::bond::bonded< ::tests::Bar> >, typename std::allocator_traits<arena>::template rebind_alloc< ::bond::nullable< ::bond::bonded< ::tests::Bar> > > > > >, std::less<double>, typename std::allocator_traits<arena>::template rebind_alloc<std::pair<const double, std::list<std::vector< ::bond::nullable< ::bond::bonded< ::tests::Bar> >, typename std::allocator_traits<arena>::template rebind_alloc< ::bond::nullable< ::bond::bonded< ::tests::Bar> > > >, typename std::allocator_traits<arena>::template rebind_alloc<std::vector< ::bond::nullable< ::bond::bonded< ::tests::Bar> >, typename std::allocator_traits<arena>::template rebind_alloc< ::bond::nullable< ::bond::bonded< ::tests::Bar> > > > > > > > >,
                 &ComplexTypes::m,
-                &s_m_metadata
+                &s_fields_metadata,
+                6
             > {} m;
         };
 
@@ -135,12 +134,12 @@ namespace tests
 
         public: typedef fields7::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("ComplexTypes", "tests.ComplexTypes",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("ComplexTypes", "tests.ComplexTypes",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
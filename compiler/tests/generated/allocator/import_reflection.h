@@ -11,23 +11,23 @@ namespace import_test
     // HasEmpty
     //
     struct HasEmpty::Schema
+        : ::bond::reflection::SchemaTemplate<HasEmpty::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_e_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // e
-            typedef struct e_type : ::bond::reflection::FieldTemplate<
+            typedef struct e_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 HasEmpty,
                 ::empty::Empty,
                 &HasEmpty::e,
-                &s_e_metadata
+                &s_fields_metadata,
+                0
             > {} e;
         };
 
@@ -36,12 +36,12 @@ namespace import_test
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("HasEmpty", "import_test.HasEmpty",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("HasEmpty", "import_test.HasEmpty",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -5,11 +5,14 @@
 namespace tests
 {
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_b_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "b");
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit(::bond::nothing, "b")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
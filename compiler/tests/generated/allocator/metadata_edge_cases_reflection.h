@@ -10,67 +10,67 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_id_metadata;
-        private: static const ::bond::Metadata s_metadata_metadata;
-        private: static const ::bond::Metadata s_id_type_metadata;
-        private: static const ::bond::Metadata s_x_metadata;
-        private: static const ::bond::Metadata s_x_type_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // id
-            typedef struct id_type0 : ::bond::reflection::FieldTemplate<
+            typedef struct id_type0 : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::id,
-                &s_id_metadata
+                &s_fields_metadata,
+                0
             > {} id;
         
             // metadata
-            typedef struct metadata_type : ::bond::reflection::FieldTemplate<
+            typedef struct metadata_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::metadata,
-                &s_metadata_metadata
+                &s_fields_metadata,
+                1
             > {} metadata;
         
             // id_type
-            typedef struct id_type_type : ::bond::reflection::FieldTemplate<
+            typedef struct id_type_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::id_type,
-                &s_id_type_metadata
+                &s_fields_metadata,
+                2
             > {} id_type;
         
             // x
-            typedef struct x_type0 : ::bond::reflection::FieldTemplate<
+            typedef struct x_type0 : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::x,
-                &s_x_metadata
+                &s_fields_metadata,
+                3
             > {} x;
         
             // x_type
-            typedef struct x_type_type : ::bond::reflection::FieldTemplate<
+            typedef struct x_type_type : ::bond::reflection::LazyFieldTemplate<
                 4,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::x_type,
-                &s_x_type_metadata
+                &s_fields_metadata,
+                4
             > {} x_type;
         };
 
@@ -83,12 +83,12 @@ namespace tests
 
         public: typedef fields5::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
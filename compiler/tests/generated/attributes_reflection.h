@@ -10,23 +10,23 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_f_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // f
-            typedef struct f_type : ::bond::reflection::FieldTemplate<
+            typedef struct f_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 std::string,
                 &Foo::f,
-                &s_f_metadata
+                &s_fields_metadata,
+                0
             > {} f;
         };
 
@@ -35,15 +35,15 @@ namespace tests
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 {
                     { "StructAttribute1", "one" },
                     { "StructAttribute2", "two" }
                 }
             );
+            return s_metadata;
         }
     };
     
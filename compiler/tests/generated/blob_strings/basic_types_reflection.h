@@ -0,0 +1,205 @@
+
+#pragma once
+
+#include "basic_types_types.h"
+#include <bond/core/reflection.h>
+
+namespace tests
+{
+    //
+    // BasicTypes
+    //
+    struct BasicTypes::Schema
+        : ::bond::reflection::SchemaTemplate<BasicTypes::Schema>
+    {
+        typedef ::bond::no_base base;
+        
+        private: static const ::bond::Metadata* s_fields_metadata();
+
+        public: struct var
+        {
+            // _bool
+            typedef struct _bool_type : ::bond::reflection::LazyFieldTemplate<
+                0,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                bool,
+                &BasicTypes::_bool,
+                &s_fields_metadata,
+                0
+            > {} _bool;
+        
+            // _str
+            typedef struct _str_type : ::bond::reflection::LazyFieldTemplate<
+                2,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                ::bond::blob_string,
+                &BasicTypes::_str,
+                &s_fields_metadata,
+                1
+            > {} _str;
+        
+            // _wstr
+            typedef struct _wstr_type : ::bond::reflection::LazyFieldTemplate<
+                3,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                ::bond::blob_wstring,
+                &BasicTypes::_wstr,
+                &s_fields_metadata,
+                2
+            > {} _wstr;
+        
+            // _uint64
+            typedef struct _uint64_type : ::bond::reflection::LazyFieldTemplate<
+                10,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                uint64_t,
+                &BasicTypes::_uint64,
+                &s_fields_metadata,
+                3
+            > {} _uint64;
+        
+            // _uint16
+            typedef struct _uint16_type : ::bond::reflection::LazyFieldTemplate<
+                11,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                uint16_t,
+                &BasicTypes::_uint16,
+                &s_fields_metadata,
+                4
+            > {} _uint16;
+        
+            // _uint32
+            typedef struct _uint32_type : ::bond::reflection::LazyFieldTemplate<
+                12,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                uint32_t,
+                &BasicTypes::_uint32,
+                &s_fields_metadata,
+                5
+            > {} _uint32;
+        
+            // _uint8
+            typedef struct _uint8_type : ::bond::reflection::LazyFieldTemplate<
+                13,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                uint8_t,
+                &BasicTypes::_uint8,
+                &s_fields_metadata,
+                6
+            > {} _uint8;
+        
+            // _int8
+            typedef struct _int8_type : ::bond::reflection::LazyFieldTemplate<
+                14,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                int8_t,
+                &BasicTypes::_int8,
+                &s_fields_metadata,
+                7
+            > {} _int8;
+        
+            // _int16
+            typedef struct _int16_type : ::bond::reflection::LazyFieldTemplate<
+                15,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                int16_t,
+                &BasicTypes::_int16,
+                &s_fields_metadata,
+                8
+            > {} _int16;
+        
+            // _int32
+            typedef struct _int32_type : ::bond::reflection::LazyFieldTemplate<
+                16,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                int32_t,
+                &BasicTypes::_int32,
+                &s_fields_metadata,
+                9
+            > {} _int32;
+        
+            // _int64
+            typedef struct _int64_type : ::bond::reflection::LazyFieldTemplate<
+                17,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                int64_t,
+                &BasicTypes::_int64,
+                &s_fields_metadata,
+                10
+            > {} _int64;
+        
+            // _double
+            typedef struct _double_type : ::bond::reflection::LazyFieldTemplate<
+                18,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                double,
+                &BasicTypes::_double,
+                &s_fields_metadata,
+                11
+            > {} _double;
+        
+            // _float
+            typedef struct _float_type : ::bond::reflection::LazyFieldTemplate<
+                20,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                float,
+                &BasicTypes::_float,
+                &s_fields_metadata,
+                12
+            > {} _float;
+        
+            // _blob
+            typedef struct _blob_type : ::bond::reflection::LazyFieldTemplate<
+                21,
+                ::bond::reflection::optional_field_modifier,
+                BasicTypes,
+                ::bond::blob,
+                &BasicTypes::_blob,
+                &s_fields_metadata,
+                13
+            > {} _blob;
+        };
+
+        private: typedef boost::mpl::list<> fields0;
+        private: typedef boost::mpl::push_front<fields0, var::_blob>::type fields1;
+        private: typedef boost::mpl::push_front<fields1, var::_float>::type fields2;
+        private: typedef boost::mpl::push_front<fields2, var::_double>::type fields3;
+        private: typedef boost::mpl::push_front<fields3, var::_int64>::type fields4;
+        private: typedef boost::mpl::push_front<fields4, var::_int32>::type fields5;
+        private: typedef boost::mpl::push_front<fields5, var::_int16>::type fields6;
+        private: typedef boost::mpl::push_front<fields6, var::_int8>::type fields7;
+        private: typedef boost::mpl::push_front<fields7, var::_uint8>::type fields8;
+        private: typedef boost::mpl::push_front<fields8, var::_uint32>::type fields9;
+        private: typedef boost::mpl::push_front<fields9, var::_uint16>::type fields10;
+        private: typedef boost::mpl::push_front<fields10, var::_uint64>::type fields11;
+        private: typedef boost::mpl::push_front<fields11, var::_wstr>::type fields12;
+        private: typedef boost::mpl::push_front<fields12, var::_str>::type fields13;
+        private: typedef boost::mpl::push_front<fields13, var::_bool>::type fields14;
+
+        public: typedef fields14::type fields;
+        
+        static const ::bond::Metadata& GetMetadata()
+        {
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("BasicTypes", "tests.BasicTypes",
+                ::bond::reflection::Attributes()
+            );
+            return s_metadata;
+        }
+    };
+    
+
+    
+} // namespace tests
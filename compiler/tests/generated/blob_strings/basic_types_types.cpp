@@ -0,0 +1,31 @@
+
+#include "basic_types_reflection.h"
+#include <bond/core/exception.h>
+
+namespace tests
+{
+    
+    const ::bond::Metadata* BasicTypes::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("_bool"),
+            ::bond::reflection::MetadataInit("_str"),
+            ::bond::reflection::MetadataInit("_wstr"),
+            ::bond::reflection::MetadataInit("_uint64"),
+            ::bond::reflection::MetadataInit("_uint16"),
+            ::bond::reflection::MetadataInit("_uint32"),
+            ::bond::reflection::MetadataInit("_uint8"),
+            ::bond::reflection::MetadataInit("_int8"),
+            ::bond::reflection::MetadataInit("_int16"),
+            ::bond::reflection::MetadataInit("_int32"),
+            ::bond::reflection::MetadataInit("_int64"),
+            ::bond::reflection::MetadataInit("_double"),
+            ::bond::reflection::MetadataInit("_float"),
+            ::bond::reflection::MetadataInit("_blob")
+        };
+        return s_metadata;
+    }
+
+    
+} // namespace tests
@@ -10,144 +10,144 @@ namespace test
     // foo
     //
     struct foo::Schema
+        : ::bond::reflection::SchemaTemplate<foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_l_metadata;
-        private: static const ::bond::Metadata s_v_metadata;
-        private: static const ::bond::Metadata s_s_metadata;
-        private: static const ::bond::Metadata s_m_metadata;
-        private: static const ::bond::Metadata s_st_metadata;
-        private: static const ::bond::Metadata s_d_metadata;
-        private: static const ::bond::Metadata s_l1_metadata;
-        private: static const ::bond::Metadata s_v1_metadata;
-        private: static const ::bond::Metadata s_s1_metadata;
-        private: static const ::bond::Metadata s_m1_metadata;
-        private: static const ::bond::Metadata s_st1_metadata;
-        private: static const ::bond::Metadata s_na_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // l
-            typedef struct l_type : ::bond::reflection::FieldTemplate<
+            typedef struct l_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::list<bool>,
                 &foo::l,
-                &s_l_metadata
+                &s_fields_metadata,
+                0
             > {} l;
         
             // v
-            typedef struct v_type : ::bond::reflection::FieldTemplate<
+            typedef struct v_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::vector<bool>,
                 &foo::v,
-                &s_v_metadata
+                &s_fields_metadata,
+                1
             > {} v;
         
             // s
-            typedef struct s_type : ::bond::reflection::FieldTemplate<
+            typedef struct s_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::set<bool>,
                 &foo::s,
-                &s_s_metadata
+                &s_fields_metadata,
+                2
             > {} s;
         
             // m
-            typedef struct m_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_type : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::map<my::string, bool>,
                 &foo::m,
-                &s_m_metadata
+                &s_fields_metadata,
+                3
             > {} m;
         
             // st
-            typedef struct st_type : ::bond::reflection::FieldTemplate<
+            typedef struct st_type : ::bond::reflection::LazyFieldTemplate<
                 4,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::string,
                 &foo::st,
-                &s_st_metadata
+                &s_fields_metadata,
+                4
             > {} st;
         
             // d
-            typedef struct d_type : ::bond::reflection::FieldTemplate<
+            typedef struct d_type : ::bond::reflection::LazyFieldTemplate<
                 5,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::string,
                 &foo::d,
-                &s_d_metadata
+                &s_fields_metadata,
+                5
             > {} d;
         
             // l1
-            typedef struct l1_type : ::bond::reflection::FieldTemplate<
+            typedef struct l1_type : ::bond::reflection::LazyFieldTemplate<
                 10,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<my::list<bool> >,
                 &foo::l1,
-                &s_l1_metadata
+                &s_fields_metadata,
+                6
             > {} l1;
         
             // v1
-            typedef struct v1_type : ::bond::reflection::FieldTemplate<
+            typedef struct v1_type : ::bond::reflection::LazyFieldTemplate<
                 11,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<my::vector<bool> >,
                 &foo::v1,
-                &s_v1_metadata
+                &s_fields_metadata,
+                7
             > {} v1;
         
             // s1
-            typedef struct s1_type : ::bond::reflection::FieldTemplate<
+            typedef struct s1_type : ::bond::reflection::LazyFieldTemplate<
                 12,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<my::set<bool> >,
                 &foo::s1,
-                &s_s1_metadata
+                &s_fields_metadata,
+                8
             > {} s1;
         
             // m1
-            typedef struct m1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m1_type : ::bond::reflection::LazyFieldTemplate<
                 13,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<my::map<my::string, bool> >,
                 &foo::m1,
-                &s_m1_metadata
+                &s_fields_metadata,
+                9
             > {} m1;
         
             // st1
-            typedef struct st1_type : ::bond::reflection::FieldTemplate<
+            typedef struct st1_type : ::bond::reflection::LazyFieldTemplate<
                 14,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 ::bond::maybe<my::string>,
                 &foo::st1,
-                &s_st1_metadata
+                &s_fields_metadata,
+                10
             > {} st1;
         
             // na
-            typedef struct na_type : ::bond::reflection::FieldTemplate<
+            typedef struct na_type : ::bond::reflection::LazyFieldTemplate<
                 15,
                 ::bond::reflection::optional_field_modifier,
                 foo,
                 my::set<my::list<my::map<int32_t, my::string> > >,
                 &foo::na,
-                &s_na_metadata
+                &s_fields_metadata,
+                11
             > {} na;
         };
 
@@ -167,12 +167,12 @@ namespace test
 
         public: typedef fields12::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("foo", "test.foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("foo", "test.foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
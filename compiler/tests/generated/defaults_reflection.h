@@ -10,430 +10,430 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
-        
-        private: static const ::bond::Metadata s_m_bool_1_metadata;
-        private: static const ::bond::Metadata s_m_bool_2_metadata;
-        private: static const ::bond::Metadata s_m_bool_3_metadata;
-        private: static const ::bond::Metadata s_m_str_1_metadata;
-        private: static const ::bond::Metadata s_m_str_2_metadata;
-        private: static const ::bond::Metadata s_m_int8_4_metadata;
-        private: static const ::bond::Metadata s_m_int8_5_metadata;
-        private: static const ::bond::Metadata s_m_int16_4_metadata;
-        private: static const ::bond::Metadata s_m_int16_5_metadata;
-        private: static const ::bond::Metadata s_m_int32_4_metadata;
-        private: static const ::bond::Metadata s_m_int32_max_metadata;
-        private: static const ::bond::Metadata s_m_int64_4_metadata;
-        private: static const ::bond::Metadata s_m_int64_max_metadata;
-        private: static const ::bond::Metadata s_m_uint8_2_metadata;
-        private: static const ::bond::Metadata s_m_uint8_3_metadata;
-        private: static const ::bond::Metadata s_m_uint16_2_metadata;
-        private: static const ::bond::Metadata s_m_uint16_3_metadata;
-        private: static const ::bond::Metadata s_m_uint32_3_metadata;
-        private: static const ::bond::Metadata s_m_uint32_max_metadata;
-        private: static const ::bond::Metadata s_m_uint64_3_metadata;
-        private: static const ::bond::Metadata s_m_uint64_max_metadata;
-        private: static const ::bond::Metadata s_m_double_3_metadata;
-        private: static const ::bond::Metadata s_m_double_4_metadata;
-        private: static const ::bond::Metadata s_m_double_5_metadata;
-        private: static const ::bond::Metadata s_m_float_3_metadata;
-        private: static const ::bond::Metadata s_m_float_4_metadata;
-        private: static const ::bond::Metadata s_m_float_7_metadata;
-        private: static const ::bond::Metadata s_m_enum1_metadata;
-        private: static const ::bond::Metadata s_m_enum2_metadata;
-        private: static const ::bond::Metadata s_m_enum3_metadata;
-        private: static const ::bond::Metadata s_m_enum_int32min_metadata;
-        private: static const ::bond::Metadata s_m_enum_int32max_metadata;
-        private: static const ::bond::Metadata s_m_enum_uint32_min_metadata;
-        private: static const ::bond::Metadata s_m_enum_uint32_max_metadata;
-        private: static const ::bond::Metadata s_m_wstr_1_metadata;
-        private: static const ::bond::Metadata s_m_wstr_2_metadata;
-        private: static const ::bond::Metadata s_m_int64_neg_hex_metadata;
-        private: static const ::bond::Metadata s_m_int64_neg_oct_metadata;
+        
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // m_bool_1
-            typedef struct m_bool_1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_bool_1_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 bool,
                 &Foo::m_bool_1,
-                &s_m_bool_1_metadata
+                &s_fields_metadata,
+                0
             > {} m_bool_1;
         
             // m_bool_2
-            typedef struct m_bool_2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_bool_2_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 bool,
                 &Foo::m_bool_2,
-                &s_m_bool_2_metadata
+                &s_fields_metadata,
+                1
             > {} m_bool_2;
         
             // m_bool_3
-            typedef struct m_bool_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_bool_3_type : ::bond::reflection::LazyFieldTemplate<
                 2,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<bool>,
                 &Foo::m_bool_3,
-                &s_m_bool_3_metadata
+                &s_fields_metadata,
+                2
             > {} m_bool_3;
         
             // m_str_1
-            typedef struct m_str_1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_str_1_type : ::bond::reflection::LazyFieldTemplate<
                 3,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 std::string,
                 &Foo::m_str_1,
-                &s_m_str_1_metadata
+                &s_fields_metadata,
+                3
             > {} m_str_1;
         
             // m_str_2
-            typedef struct m_str_2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_str_2_type : ::bond::reflection::LazyFieldTemplate<
                 4,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<std::string>,
                 &Foo::m_str_2,
-                &s_m_str_2_metadata
+                &s_fields_metadata,
+                4
             > {} m_str_2;
         
             // m_int8_4
-            typedef struct m_int8_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int8_4_type : ::bond::reflection::LazyFieldTemplate<
                 5,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int8_t,
                 &Foo::m_int8_4,
-                &s_m_int8_4_metadata
+                &s_fields_metadata,
+                5
             > {} m_int8_4;
         
             // m_int8_5
-            typedef struct m_int8_5_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int8_5_type : ::bond::reflection::LazyFieldTemplate<
                 6,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<int8_t>,
                 &Foo::m_int8_5,
-                &s_m_int8_5_metadata
+                &s_fields_metadata,
+                6
             > {} m_int8_5;
         
             // m_int16_4
-            typedef struct m_int16_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int16_4_type : ::bond::reflection::LazyFieldTemplate<
                 7,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int16_t,
                 &Foo::m_int16_4,
-                &s_m_int16_4_metadata
+                &s_fields_metadata,
+                7
             > {} m_int16_4;
         
             // m_int16_5
-            typedef struct m_int16_5_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int16_5_type : ::bond::reflection::LazyFieldTemplate<
                 8,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<int16_t>,
                 &Foo::m_int16_5,
-                &s_m_int16_5_metadata
+                &s_fields_metadata,
+                8
             > {} m_int16_5;
         
             // m_int32_4
-            typedef struct m_int32_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int32_4_type : ::bond::reflection::LazyFieldTemplate<
                 9,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<int32_t>,
                 &Foo::m_int32_4,
-                &s_m_int32_4_metadata
+                &s_fields_metadata,
+                9
             > {} m_int32_4;
         
             // m_int32_max
-            typedef struct m_int32_max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int32_max_type : ::bond::reflection::LazyFieldTemplate<
                 10,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::m_int32_max,
-                &s_m_int32_max_metadata
+                &s_fields_metadata,
+                10
             > {} m_int32_max;
         
             // m_int64_4
-            typedef struct m_int64_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int64_4_type : ::bond::reflection::LazyFieldTemplate<
                 11,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<int64_t>,
                 &Foo::m_int64_4,
-                &s_m_int64_4_metadata
+                &s_fields_metadata,
+                11
             > {} m_int64_4;
         
             // m_int64_max
-            typedef struct m_int64_max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int64_max_type : ::bond::reflection::LazyFieldTemplate<
                 12,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int64_t,
                 &Foo::m_int64_max,
-                &s_m_int64_max_metadata
+                &s_fields_metadata,
+                12
             > {} m_int64_max;
         
             // m_uint8_2
-            typedef struct m_uint8_2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint8_2_type : ::bond::reflection::LazyFieldTemplate<
                 13,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 uint8_t,
                 &Foo::m_uint8_2,
-                &s_m_uint8_2_metadata
+                &s_fields_metadata,
+                13
             > {} m_uint8_2;
         
             // m_uint8_3
-            typedef struct m_uint8_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint8_3_type : ::bond::reflection::LazyFieldTemplate<
                 14,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<uint8_t>,
                 &Foo::m_uint8_3,
-                &s_m_uint8_3_metadata
+                &s_fields_metadata,
+                14
             > {} m_uint8_3;
         
             // m_uint16_2
-            typedef struct m_uint16_2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint16_2_type : ::bond::reflection::LazyFieldTemplate<
                 15,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 uint16_t,
                 &Foo::m_uint16_2,
-                &s_m_uint16_2_metadata
+                &s_fields_metadata,
+                15
             > {} m_uint16_2;
         
             // m_uint16_3
-            typedef struct m_uint16_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint16_3_type : ::bond::reflection::LazyFieldTemplate<
                 16,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<uint16_t>,
                 &Foo::m_uint16_3,
-                &s_m_uint16_3_metadata
+                &s_fields_metadata,
+                16
             > {} m_uint16_3;
         
             // m_uint32_3
-            typedef struct m_uint32_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint32_3_type : ::bond::reflection::LazyFieldTemplate<
                 17,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<uint32_t>,
                 &Foo::m_uint32_3,
-                &s_m_uint32_3_metadata
+                &s_fields_metadata,
+                17
             > {} m_uint32_3;
         
             // m_uint32_max
-            typedef struct m_uint32_max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint32_max_type : ::bond::reflection::LazyFieldTemplate<
                 18,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 uint32_t,
                 &Foo::m_uint32_max,
-                &s_m_uint32_max_metadata
+                &s_fields_metadata,
+                18
             > {} m_uint32_max;
         
             // m_uint64_3
-            typedef struct m_uint64_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint64_3_type : ::bond::reflection::LazyFieldTemplate<
                 19,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<uint64_t>,
                 &Foo::m_uint64_3,
-                &s_m_uint64_3_metadata
+                &s_fields_metadata,
+                19
             > {} m_uint64_3;
         
             // m_uint64_max
-            typedef struct m_uint64_max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_uint64_max_type : ::bond::reflection::LazyFieldTemplate<
                 20,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 uint64_t,
                 &Foo::m_uint64_max,
-                &s_m_uint64_max_metadata
+                &s_fields_metadata,
+                20
             > {} m_uint64_max;
         
             // m_double_3
-            typedef struct m_double_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_double_3_type : ::bond::reflection::LazyFieldTemplate<
                 21,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<double>,
                 &Foo::m_double_3,
-                &s_m_double_3_metadata
+                &s_fields_metadata,
+                21
             > {} m_double_3;
         
             // m_double_4
-            typedef struct m_double_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_double_4_type : ::bond::reflection::LazyFieldTemplate<
                 22,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 double,
                 &Foo::m_double_4,
-                &s_m_double_4_metadata
+                &s_fields_metadata,
+                22
             > {} m_double_4;
         
             // m_double_5
-            typedef struct m_double_5_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_double_5_type : ::bond::reflection::LazyFieldTemplate<
                 23,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 double,
                 &Foo::m_double_5,
-                &s_m_double_5_metadata
+                &s_fields_metadata,
+                23
             > {} m_double_5;
         
             // m_float_3
-            typedef struct m_float_3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_float_3_type : ::bond::reflection::LazyFieldTemplate<
                 24,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<float>,
                 &Foo::m_float_3,
-                &s_m_float_3_metadata
+                &s_fields_metadata,
+                24
             > {} m_float_3;
         
             // m_float_4
-            typedef struct m_float_4_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_float_4_type : ::bond::reflection::LazyFieldTemplate<
                 25,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 float,
                 &Foo::m_float_4,
-                &s_m_float_4_metadata
+                &s_fields_metadata,
+                25
             > {} m_float_4;
         
             // m_float_7
-            typedef struct m_float_7_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_float_7_type : ::bond::reflection::LazyFieldTemplate<
                 26,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 float,
                 &Foo::m_float_7,
-                &s_m_float_7_metadata
+                &s_fields_metadata,
+                26
             > {} m_float_7;
         
             // m_enum1
-            typedef struct m_enum1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum1_type : ::bond::reflection::LazyFieldTemplate<
                 27,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum1,
-                &s_m_enum1_metadata
+                &s_fields_metadata,
+                27
             > {} m_enum1;
         
             // m_enum2
-            typedef struct m_enum2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum2_type : ::bond::reflection::LazyFieldTemplate<
                 28,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum2,
-                &s_m_enum2_metadata
+                &s_fields_metadata,
+                28
             > {} m_enum2;
         
             // m_enum3
-            typedef struct m_enum3_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum3_type : ::bond::reflection::LazyFieldTemplate<
                 29,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe< ::tests::EnumType1>,
                 &Foo::m_enum3,
-                &s_m_enum3_metadata
+                &s_fields_metadata,
+                29
             > {} m_enum3;
         
             // m_enum_int32min
-            typedef struct m_enum_int32min_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum_int32min_type : ::bond::reflection::LazyFieldTemplate<
                 30,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum_int32min,
-                &s_m_enum_int32min_metadata
+                &s_fields_metadata,
+                30
             > {} m_enum_int32min;
         
             // m_enum_int32max
-            typedef struct m_enum_int32max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum_int32max_type : ::bond::reflection::LazyFieldTemplate<
                 31,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum_int32max,
-                &s_m_enum_int32max_metadata
+                &s_fields_metadata,
+                31
             > {} m_enum_int32max;
         
             // m_enum_uint32_min
-            typedef struct m_enum_uint32_min_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum_uint32_min_type : ::bond::reflection::LazyFieldTemplate<
                 32,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum_uint32_min,
-                &s_m_enum_uint32_min_metadata
+                &s_fields_metadata,
+                32
             > {} m_enum_uint32_min;
         
             // m_enum_uint32_max
-            typedef struct m_enum_uint32_max_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_enum_uint32_max_type : ::bond::reflection::LazyFieldTemplate<
                 33,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::tests::EnumType1,
                 &Foo::m_enum_uint32_max,
-                &s_m_enum_uint32_max_metadata
+                &s_fields_metadata,
+                33
             > {} m_enum_uint32_max;
         
             // m_wstr_1
-            typedef struct m_wstr_1_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_wstr_1_type : ::bond::reflection::LazyFieldTemplate<
                 34,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 std::wstring,
                 &Foo::m_wstr_1,
-                &s_m_wstr_1_metadata
+                &s_fields_metadata,
+                34
             > {} m_wstr_1;
         
             // m_wstr_2
-            typedef struct m_wstr_2_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_wstr_2_type : ::bond::reflection::LazyFieldTemplate<
                 35,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 ::bond::maybe<std::wstring>,
                 &Foo::m_wstr_2,
-                &s_m_wstr_2_metadata
+                &s_fields_metadata,
+                35
             > {} m_wstr_2;
         
             // m_int64_neg_hex
-            typedef struct m_int64_neg_hex_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int64_neg_hex_type : ::bond::reflection::LazyFieldTemplate<
                 36,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int64_t,
                 &Foo::m_int64_neg_hex,
-                &s_m_int64_neg_hex_metadata
+                &s_fields_metadata,
+                36
             > {} m_int64_neg_hex;
         
             // m_int64_neg_oct
-            typedef struct m_int64_neg_oct_type : ::bond::reflection::FieldTemplate<
+            typedef struct m_int64_neg_oct_type : ::bond::reflection::LazyFieldTemplate<
                 37,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int64_t,
                 &Foo::m_int64_neg_oct,
-                &s_m_int64_neg_oct_metadata
+                &s_fields_metadata,
+                37
             > {} m_int64_neg_oct;
         };
 
@@ -479,12 +479,12 @@ namespace tests
 
         public: typedef fields38::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
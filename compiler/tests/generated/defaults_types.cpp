@@ -1,7 +1,7 @@
 
 #include "defaults_reflection.h"
 #include <bond/core/exception.h>
-#include <unordered_map>
+#include <bond/core/detail/enum_names.h>
 
 namespace tests
 {
@@ -12,53 +12,113 @@ namespace tests
     {
         namespace
         {
-            struct _hash_EnumType1
+            const std::string* _name_EnumType1(enum EnumType1 value)
             {
-                std::size_t operator()(enum EnumType1 value) const
+                static const std::string s_names[] =
+                    {
+                        "Int32Min",
+                        "HexNeg",
+                        "OctNeg",
+                        "EnumValue3",
+                        "UInt32Min",
+                        "Low",
+                        "EnumValue1",
+                        "EnumValue2",
+                        "EnumValue4",
+                        "Int32Max",
+                        "UInt32Max"
+                    };
+
+                switch (value)
                 {
-                    return static_cast<std::size_t>(value);
+                    case EnumType1::Int32Min: return &s_names[0];
+                    case EnumType1::HexNeg: return &s_names[1];
+                    case EnumType1::OctNeg: return &s_names[2];
+                    case EnumType1::EnumValue3: return &s_names[3];
+                    case EnumType1::UInt32Min: return &s_names[4];
+                    case EnumType1::Low: return &s_names[5];
+                    case EnumType1::EnumValue1: return &s_names[6];
+                    case EnumType1::EnumValue2: return &s_names[7];
+                    case EnumType1::EnumValue4: return &s_names[8];
+                    case EnumType1::Int32Max: return &s_names[9];
+                    case EnumType1::UInt32Max: return &s_names[10];
+                    default: return nullptr;
                 }
-            };
+            }
+
+            const uint32_t _seeds_EnumType1[] = { 1, 1, 1, 1, 1, 1, 2, 1 };
+
+            const ::bond::detail::enum_name<enum EnumType1> _names_EnumType1[] =
+                {
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { "OctNeg", 6, OctNeg },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { "Int32Max", 8, Int32Max },
+                    { "HexNeg", 6, HexNeg },
+                    { "UInt32Max", 9, UInt32Max },
+                    { "UInt32Min", 9, UInt32Min },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { "EnumValue4", 10, EnumValue4 },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { "EnumValue5", 10, EnumValue5 },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { "EnumValue3", 10, EnumValue3 },
+                    { "EnumValue2", 10, EnumValue2 },
+                    { "Int32Min", 8, Int32Min },
+                    { "EnumValue6", 10, EnumValue6 },
+                    { "Low", 3, Low },
+                    { nullptr, 0, {} },
+                    { "EnumValue1", 10, EnumValue1 },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} },
+                    { nullptr, 0, {} }
+                };
         }
+
         const std::string& ToString(enum EnumType1 value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum EnumType1, std::string, _hash_EnumType1> >(value);
-            auto it = map.find(value);
+            const std::string* name = _name_EnumType1(value);
 
-            if (map.end() == it)
+            if (name == nullptr)
                 ::bond::InvalidEnumValueException(value, "EnumType1");
 
-            return it->second;
+            return *name;
         }
 
         void FromString(const std::string& name, enum EnumType1& value)
         {
-            if (!ToEnum(value, name))
+            if (!ToEnum(value, name.data(), name.size()))
                 ::bond::InvalidEnumValueException(name.c_str(), "EnumType1");
         }
 
         bool ToEnum(enum EnumType1& value, const std::string& name)
         {
-            const auto& map = GetNameToValueMap<std::unordered_map<std::string, enum EnumType1> >(value);
-            auto it = map.find(name);
-
-            if (map.end() == it)
-                return false;
-
-            value = it->second;
+            return ToEnum(value, name.data(), name.size());
+        }
 
-            return true;
+        bool ToEnum(enum EnumType1& value, const char* name, std::size_t length)
+        {
+            return ::bond::detail::find_enum_value(_seeds_EnumType1, _names_EnumType1, name, length, value);
         }
 
         bool FromEnum(std::string& name, enum EnumType1 value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum EnumType1, std::string, _hash_EnumType1> >(value);
-            auto it = map.find(value);
+            const std::string* found = _name_EnumType1(value);
 
-            if (map.end() == it)
+            if (found == nullptr)
                 return false;
 
-            name = it->second;
+            name = *found;
 
             return true;
         }
@@ -67,122 +127,51 @@ namespace tests
     } // namespace _bond_enumerators
 
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_m_bool_1_metadata
-        = ::bond::reflection::MetadataInit(true, "m_bool_1");
-    
-    const ::bond::Metadata Foo::Schema::s_m_bool_2_metadata
-        = ::bond::reflection::MetadataInit(false, "m_bool_2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_bool_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_bool_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_str_1_metadata
-        = ::bond::reflection::MetadataInit("default string value", "m_str_1");
-    
-    const ::bond::Metadata Foo::Schema::s_m_str_2_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_str_2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int8_4_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int8_t>(-127), "m_int8_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int8_5_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_int8_5");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int16_4_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int16_t>(-32767), "m_int16_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int16_5_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_int16_5");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int32_4_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_int32_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int32_max_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int32_t>(2147483647), "m_int32_max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int64_4_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_int64_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int64_max_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int64_t>(9223372036854775807LL), "m_int64_max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint8_2_metadata
-        = ::bond::reflection::MetadataInit(static_cast<uint8_t>(255), "m_uint8_2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint8_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_uint8_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint16_2_metadata
-        = ::bond::reflection::MetadataInit(static_cast<uint16_t>(65535), "m_uint16_2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint16_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_uint16_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint32_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_uint32_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint32_max_metadata
-        = ::bond::reflection::MetadataInit(static_cast<uint32_t>(4294967295), "m_uint32_max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint64_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_uint64_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_uint64_max_metadata
-        = ::bond::reflection::MetadataInit(static_cast<uint64_t>(18446744073709551615ULL), "m_uint64_max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_double_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_double_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_double_4_metadata
-        = ::bond::reflection::MetadataInit(static_cast<double>(-123.456789), "m_double_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_double_5_metadata
-        = ::bond::reflection::MetadataInit(static_cast<double>(-0.0), "m_double_5");
-    
-    const ::bond::Metadata Foo::Schema::s_m_float_3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_float_3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_float_4_metadata
-        = ::bond::reflection::MetadataInit(static_cast<float>(2.71828183f), "m_float_4");
-    
-    const ::bond::Metadata Foo::Schema::s_m_float_7_metadata
-        = ::bond::reflection::MetadataInit(static_cast<float>(0.0f), "m_float_7");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum1_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::EnumValue1, "m_enum1");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum2_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::EnumValue3, "m_enum2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum3_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_enum3");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum_int32min_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::Int32Min, "m_enum_int32min");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum_int32max_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::Int32Max, "m_enum_int32max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum_uint32_min_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::UInt32Min, "m_enum_uint32_min");
-    
-    const ::bond::Metadata Foo::Schema::s_m_enum_uint32_max_metadata
-        = ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::UInt32Max, "m_enum_uint32_max");
-    
-    const ::bond::Metadata Foo::Schema::s_m_wstr_1_metadata
-        = ::bond::reflection::MetadataInit(L"default wstring value", "m_wstr_1");
-    
-    const ::bond::Metadata Foo::Schema::s_m_wstr_2_metadata
-        = ::bond::reflection::MetadataInit(::bond::nothing, "m_wstr_2");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int64_neg_hex_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int64_t>(-4095LL), "m_int64_neg_hex");
-    
-    const ::bond::Metadata Foo::Schema::s_m_int64_neg_oct_metadata
-        = ::bond::reflection::MetadataInit(static_cast<int64_t>(-83LL), "m_int64_neg_oct");
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit(true, "m_bool_1"),
+            ::bond::reflection::MetadataInit(false, "m_bool_2"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_bool_3"),
+            ::bond::reflection::MetadataInit("default string value", "m_str_1"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_str_2"),
+            ::bond::reflection::MetadataInit(static_cast<int8_t>(-127), "m_int8_4"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_int8_5"),
+            ::bond::reflection::MetadataInit(static_cast<int16_t>(-32767), "m_int16_4"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_int16_5"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_int32_4"),
+            ::bond::reflection::MetadataInit(static_cast<int32_t>(2147483647), "m_int32_max"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_int64_4"),
+            ::bond::reflection::MetadataInit(static_cast<int64_t>(9223372036854775807LL), "m_int64_max"),
+            ::bond::reflection::MetadataInit(static_cast<uint8_t>(255), "m_uint8_2"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_uint8_3"),
+            ::bond::reflection::MetadataInit(static_cast<uint16_t>(65535), "m_uint16_2"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_uint16_3"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_uint32_3"),
+            ::bond::reflection::MetadataInit(static_cast<uint32_t>(4294967295), "m_uint32_max"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_uint64_3"),
+            ::bond::reflection::MetadataInit(static_cast<uint64_t>(18446744073709551615ULL), "m_uint64_max"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_double_3"),
+            ::bond::reflection::MetadataInit(static_cast<double>(-123.456789), "m_double_4"),
+            ::bond::reflection::MetadataInit(static_cast<double>(-0.0), "m_double_5"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_float_3"),
+            ::bond::reflection::MetadataInit(static_cast<float>(2.71828183f), "m_float_4"),
+            ::bond::reflection::MetadataInit(static_cast<float>(0.0f), "m_float_7"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::EnumValue1, "m_enum1"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::EnumValue3, "m_enum2"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_enum3"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::Int32Min, "m_enum_int32min"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::Int32Max, "m_enum_int32max"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::UInt32Min, "m_enum_uint32_min"),
+            ::bond::reflection::MetadataInit(::tests::_bond_enumerators::EnumType1::UInt32Max, "m_enum_uint32_max"),
+            ::bond::reflection::MetadataInit(L"default wstring value", "m_wstr_1"),
+            ::bond::reflection::MetadataInit(::bond::nothing, "m_wstr_2"),
+            ::bond::reflection::MetadataInit(static_cast<int64_t>(-4095LL), "m_int64_neg_hex"),
+            ::bond::reflection::MetadataInit(static_cast<int64_t>(-83LL), "m_int64_neg_oct")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
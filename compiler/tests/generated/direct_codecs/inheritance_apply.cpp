@@ -0,0 +1,502 @@
+
+#include "inheritance_apply.h"
+#include "inheritance_reflection.h"
+
+namespace bond
+{
+    
+    //
+    // Direct Compact Binary codecs for Base.
+    //
+    
+    template <> template <> 
+    bool DynamicParser<bond::CompactBinaryReader<bond::InputBuffer>&>::Apply(
+        const ::bond::To< ::tests::Base>& transform,
+        const ::tests::Base::Schema& schema)
+    {
+        return DirectApply(transform, schema, [&](uint16_t id, ::bond::BondDataType type)
+        {
+            switch (id)
+            {
+                case 0:
+                    DirectField(::tests::Base::Schema::var::x(), type, transform);
+                    break;
+                default:
+                    UnknownField(id, type, transform);
+                    break;
+            }
+        });
+    }
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Base&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+        const ::tests::Base::Schema& schema)
+    {
+        transform.Begin(schema.GetMetadata());
+        transform.KnownField(::tests::Base::Schema::var::x(), _input.x);
+        transform.End();
+        return false;
+    }
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Base&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+        const ::tests::Base::Schema& schema)
+    {
+        transform.Begin(schema.GetMetadata());
+        transform.KnownField(::tests::Base::Schema::var::x(), _input.x);
+        transform.End();
+        return false;
+    }
+    
+    //
+    // Direct Compact Binary codecs for Foo.
+    //
+    
+    template <> template <> 
+    bool DynamicParser<bond::CompactBinaryReader<bond::InputBuffer>&>::Apply(
+        const ::bond::To< ::tests::Foo>& transform,
+        const ::tests::Foo::Schema& schema)
+    {
+        return DirectApply(transform, schema, [&](uint16_t id, ::bond::BondDataType type)
+        {
+            switch (id)
+            {
+                case 0:
+                    DirectField(::tests::Foo::Schema::var::x(), type, transform);
+                    break;
+                default:
+                    UnknownField(id, type, transform);
+                    break;
+            }
+        });
+    }
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Foo&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+        const ::tests::Foo::Schema& schema)
+    {
+        transform.Begin(schema.GetMetadata());
+        transform.Base(static_cast<const ::tests::Base&>(_input));
+        transform.KnownField(::tests::Foo::Schema::var::x(), _input.x);
+        transform.End();
+        return false;
+    }
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Foo&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+        const ::tests::Foo::Schema& schema)
+    {
+        transform.Begin(schema.GetMetadata());
+        transform.Base(static_cast<const ::tests::Base&>(_input));
+        transform.KnownField(::tests::Foo::Schema::var::x(), _input.x);
+        transform.End();
+        return false;
+    }
+    
+    //
+    // Extern template specializations of Apply function with common
+    // transforms for Base.
+    //
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+
+    template 
+    bool Apply(const ::bond::InitSchemaDef& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Null& transform,
+               const ::bond::bonded< ::tests::Base, ::bond::SimpleBinaryReader< ::bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    //
+    // Extern template specializations of Apply function with common
+    // transforms for Foo.
+    //
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+
+    template 
+    bool Apply(const ::bond::InitSchemaDef& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Null& transform,
+               const ::bond::bonded< ::tests::Foo, ::bond::SimpleBinaryReader< ::bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+
+    template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+} // namespace bond
@@ -0,0 +1,414 @@
+
+#pragma once
+
+#include "inheritance_types.h"
+#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+
+
+namespace bond
+{
+    
+    //
+    // Extern template specializations of Apply function with common
+    // transforms for Base.
+    //
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+
+    extern template 
+    bool Apply(const ::bond::InitSchemaDef& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Null& transform,
+               const ::bond::bonded< ::tests::Base, ::bond::SimpleBinaryReader< ::bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Base>& transform,
+               const ::bond::bonded<void, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Base& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Base, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    //
+    // Extern template specializations of Apply function with common
+    // transforms for Foo.
+    //
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+
+    extern template 
+    bool Apply(const ::bond::InitSchemaDef& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Null& transform,
+               const ::bond::bonded< ::tests::Foo, ::bond::SimpleBinaryReader< ::bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::FastBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+
+    extern template 
+    bool Apply(const ::bond::To< ::tests::Foo>& transform,
+               const ::bond::bonded<void, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Serializer<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::tests::Foo& value);
+
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::CompactBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::FastBinaryReader<bond::InputBuffer>&>& value);
+    
+    extern template 
+    bool Apply(const ::bond::Marshaler<bond::SimpleBinaryWriter<bond::OutputBuffer> >& transform,
+               const ::bond::bonded< ::tests::Foo, bond::SimpleBinaryReader<bond::InputBuffer>&>& value);
+    
+} // namespace bond
@@ -0,0 +1,133 @@
+
+#pragma once
+
+#include "inheritance_types.h"
+#include <bond/core/reflection.h>
+#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+
+namespace tests
+{
+    //
+    // Base
+    //
+    struct Base::Schema
+        : ::bond::reflection::SchemaTemplate<Base::Schema>
+    {
+        typedef ::bond::no_base base;
+        
+        private: static const ::bond::Metadata* s_fields_metadata();
+
+        public: struct var
+        {
+            // x
+            typedef struct x_type : ::bond::reflection::LazyFieldTemplate<
+                0,
+                ::bond::reflection::optional_field_modifier,
+                Base,
+                int32_t,
+                &Base::x,
+                &s_fields_metadata,
+                0
+            > {} x;
+        };
+
+        private: typedef boost::mpl::list<> fields0;
+        private: typedef boost::mpl::push_front<fields0, var::x>::type fields1;
+
+        public: typedef fields1::type fields;
+        
+        static const ::bond::Metadata& GetMetadata()
+        {
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Base", "tests.Base",
+                ::bond::reflection::Attributes()
+            );
+            return s_metadata;
+        }
+    };
+    
+
+    //
+    // Foo
+    //
+    struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
+    {
+        typedef ::tests::Base base;
+        
+        private: static const ::bond::Metadata* s_fields_metadata();
+
+        public: struct var
+        {
+            // x
+            typedef struct x_type : ::bond::reflection::LazyFieldTemplate<
+                0,
+                ::bond::reflection::optional_field_modifier,
+                Foo,
+                int32_t,
+                &Foo::x,
+                &s_fields_metadata,
+                0
+            > {} x;
+        };
+
+        private: typedef boost::mpl::list<> fields0;
+        private: typedef boost::mpl::push_front<fields0, var::x>::type fields1;
+
+        public: typedef fields1::type fields;
+        
+        static const ::bond::Metadata& GetMetadata()
+        {
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+                ::bond::reflection::Attributes()
+            );
+            return s_metadata;
+        }
+    };
+    
+
+    
+} // namespace tests
+
+namespace bond
+{
+    
+    //
+    // Direct Compact Binary codecs for Base.
+    //
+    
+    template <> template <> 
+    bool DynamicParser<bond::CompactBinaryReader<bond::InputBuffer>&>::Apply(
+        const ::bond::To< ::tests::Base>& transform,
+        const ::tests::Base::Schema& schema);
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Base&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+        const ::tests::Base::Schema& schema);
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Base&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+        const ::tests::Base::Schema& schema);
+    
+    //
+    // Direct Compact Binary codecs for Foo.
+    //
+    
+    template <> template <> 
+    bool DynamicParser<bond::CompactBinaryReader<bond::InputBuffer>&>::Apply(
+        const ::bond::To< ::tests::Foo>& transform,
+        const ::tests::Foo::Schema& schema);
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Foo&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputBuffer> >& transform,
+        const ::tests::Foo::Schema& schema);
+    
+    template <> template <> 
+    bool StaticParser<const ::tests::Foo&>::Apply(
+        const ::bond::Serializer<bond::CompactBinaryWriter<bond::OutputCounter> >& transform,
+        const ::tests::Foo::Schema& schema);
+    
+} // namespace bond
@@ -12,25 +12,24 @@ namespace tests
     // dummy
     //
     struct dummy::Schema
+        : ::bond::reflection::SchemaTemplate<dummy::Schema>
     {
         typedef ::bond::no_base base;
-
-        DllExport
-        static const ::bond::Metadata metadata;
         
         private: DllExport
-        static const ::bond::Metadata s_count_metadata;
+        static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // count
-            typedef struct count_type : ::bond::reflection::FieldTemplate<
+            typedef struct count_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 dummy,
                 int32_t,
                 &dummy::count,
-                &s_count_metadata
+                &s_fields_metadata,
+                0
             > {} count;
         };
 
@@ -39,12 +38,12 @@ namespace tests
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("dummy", "tests.dummy",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("dummy", "tests.dummy",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
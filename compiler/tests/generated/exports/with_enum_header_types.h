@@ -94,6 +94,8 @@ namespace tests
 
         DllExport bool ToEnum(enum EnumType1& value, const std::string& name);
 
+        DllExport bool ToEnum(enum EnumType1& value, const char* name, std::size_t length);
+
         DllExport bool FromEnum(std::string& name, enum EnumType1 value);
 
     } // namespace EnumType1
@@ -11,34 +11,34 @@ namespace tests
     //
     template <typename T1, typename T2>
     struct Foo<T1, T2>::Schema
+        : ::bond::reflection::SchemaTemplate<Foo<T1, T2>::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_t2_metadata;
-        private: static const ::bond::Metadata s_n_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // t2
-            typedef struct t2_type : ::bond::reflection::FieldTemplate<
+            typedef struct t2_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo<T1, T2>,
                 T2,
                 &Foo<T1, T2>::t2,
-                &s_t2_metadata
+                &s_fields_metadata,
+                0
             > {} t2;
         
             // n
-            typedef struct n_type : ::bond::reflection::FieldTemplate<
+            typedef struct n_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::optional_field_modifier,
                 Foo<T1, T2>,
                 ::bond::nullable< ::tests::Foo<T1, bool> >,
                 &Foo<T1, T2>::n,
-                &s_n_metadata
+                &s_fields_metadata,
+                1
             > {} n;
         };
 
@@ -48,33 +48,25 @@ namespace tests
 
         public: typedef typename fields2::type fields;
         
-        Schema()
-        {
-            // Force instantiation of template statics
-            (void)metadata;
-            (void)s_t2_metadata;
-            (void)s_n_metadata;
-        }
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit<boost::mpl::list<T1, T2> >("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit<boost::mpl::list<T1, T2> >("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
     template <typename T1, typename T2>
-    const ::bond::Metadata Foo<T1, T2>::Schema::metadata
-        = Foo<T1, T2>::Schema::GetMetadata();
-    
-    template <typename T1, typename T2>
-    const ::bond::Metadata Foo<T1, T2>::Schema::s_t2_metadata
-        = ::bond::reflection::MetadataInit("t2");
-    
-    template <typename T1, typename T2>
-    const ::bond::Metadata Foo<T1, T2>::Schema::s_n_metadata
-        = ::bond::reflection::MetadataInit("n");
+    const ::bond::Metadata* Foo<T1, T2>::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("t2"),
+            ::bond::reflection::MetadataInit("n")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
@@ -5,18 +5,24 @@
 namespace tests
 {
     
-    const ::bond::Metadata Base::Schema::metadata
-        = Base::Schema::GetMetadata();
-    
-    const ::bond::Metadata Base::Schema::s_x_metadata
-        = ::bond::reflection::MetadataInit("x");
+    const ::bond::Metadata* Base::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("x")
+        };
+        return s_metadata;
+    }
 
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_x_metadata
-        = ::bond::reflection::MetadataInit("x");
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("x")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
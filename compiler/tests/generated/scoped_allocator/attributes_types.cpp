@@ -1,7 +1,7 @@
 
 #include "attributes_reflection.h"
 #include <bond/core/exception.h>
-#include <unordered_map>
+#include <bond/core/detail/enum_names.h>
 
 namespace tests
 {
@@ -12,53 +12,63 @@ namespace tests
     {
         namespace
         {
-            struct _hash_Enum
+            const std::string* _name_Enum(enum Enum value)
             {
-                std::size_t operator()(enum Enum value) const
+                static const std::string s_names[] =
+                    {
+                        "Value1"
+                    };
+
+                switch (value)
                 {
-                    return static_cast<std::size_t>(value);
+                    case Enum::Value1: return &s_names[0];
+                    default: return nullptr;
                 }
-            };
+            }
+
+            const uint32_t _seeds_Enum[] = { 1 };
+
+            const ::bond::detail::enum_name<enum Enum> _names_Enum[] =
+                {
+                    { "Value1", 6, Value1 },
+                    { nullptr, 0, {} }
+                };
         }
+
         const std::string& ToString(enum Enum value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum Enum, std::string, _hash_Enum> >(value);
-            auto it = map.find(value);
+            const std::string* name = _name_Enum(value);
 
-            if (map.end() == it)
+            if (name == nullptr)
                 ::bond::InvalidEnumValueException(value, "Enum");
 
-            return it->second;
+            return *name;
         }
 
         void FromString(const std::string& name, enum Enum& value)
         {
-            if (!ToEnum(value, name))
+            if (!ToEnum(value, name.data(), name.size()))
                 ::bond::InvalidEnumValueException(name.c_str(), "Enum");
         }
 
         bool ToEnum(enum Enum& value, const std::string& name)
         {
-            const auto& map = GetNameToValueMap<std::unordered_map<std::string, enum Enum> >(value);
-            auto it = map.find(name);
-
-            if (map.end() == it)
-                return false;
-
-            value = it->second;
+            return ToEnum(value, name.data(), name.size());
+        }
 
-            return true;
+        bool ToEnum(enum Enum& value, const char* name, std::size_t length)
+        {
+            return ::bond::detail::find_enum_value(_seeds_Enum, _names_Enum, name, length, value);
         }
 
         bool FromEnum(std::string& name, enum Enum value)
         {
-            const auto& map = GetValueToNameMap<std::unordered_map<enum Enum, std::string, _hash_Enum> >(value);
-            auto it = map.find(value);
+            const std::string* found = _name_Enum(value);
 
-            if (map.end() == it)
+            if (found == nullptr)
                 return false;
 
-            name = it->second;
+            name = *found;
 
             return true;
         }
@@ -67,15 +77,18 @@ namespace tests
     } // namespace _bond_enumerators
 
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_f_metadata
-        = ::bond::reflection::MetadataInit("f", ::bond::reflection::optional_field_modifier::value,
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("f", ::bond::reflection::optional_field_modifier::value,
                 {
                     { "FieldAttribute1", "one" },
                     { "FieldAttribute2", "two" }
-                });
+                })
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
@@ -12,34 +12,34 @@ namespace bondmeta
     // HasMetaFields
     //
     struct HasMetaFields::Schema
+        : ::bond::reflection::SchemaTemplate<HasMetaFields::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_full_name_metadata;
-        private: static const ::bond::Metadata s_name_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // full_name
-            typedef struct full_name_type : ::bond::reflection::FieldTemplate<
+            typedef struct full_name_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::required_optional_field_modifier,
                 HasMetaFields,
                 std::basic_string<char, std::char_traits<char>, std::scoped_allocator_adaptor<typename std::allocator_traits<arena>::template rebind_alloc<char> > >,
                 &HasMetaFields::full_name,
-                &s_full_name_metadata
+                &s_fields_metadata,
+                0
             > {} full_name;
         
             // name
-            typedef struct name_type : ::bond::reflection::FieldTemplate<
+            typedef struct name_type : ::bond::reflection::LazyFieldTemplate<
                 1,
                 ::bond::reflection::required_optional_field_modifier,
                 HasMetaFields,
                 std::basic_string<char, std::char_traits<char>, std::scoped_allocator_adaptor<typename std::allocator_traits<arena>::template rebind_alloc<char> > >,
                 &HasMetaFields::name,
-                &s_name_metadata
+                &s_fields_metadata,
+                1
             > {} name;
         };
 
@@ -49,12 +49,12 @@ namespace bondmeta
 
         public: typedef fields2::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("HasMetaFields", "deprecated.bondmeta.HasMetaFields",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("HasMetaFields", "deprecated.bondmeta.HasMetaFields",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -10,23 +10,23 @@ namespace tests
     // Base
     //
     struct Base::Schema
+        : ::bond::reflection::SchemaTemplate<Base::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_x_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // x
-            typedef struct x_type : ::bond::reflection::FieldTemplate<
+            typedef struct x_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Base,
                 int32_t,
                 &Base::x,
-                &s_x_metadata
+                &s_fields_metadata,
+                0
             > {} x;
         };
 
@@ -35,12 +35,12 @@ namespace tests
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Base", "tests.Base",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Base", "tests.Base",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -49,23 +49,23 @@ namespace tests
     // Foo
     //
     struct Foo::Schema
+        : ::bond::reflection::SchemaTemplate<Foo::Schema>
     {
         typedef ::tests::Base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_x_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // x
-            typedef struct x_type : ::bond::reflection::FieldTemplate<
+            typedef struct x_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo,
                 int32_t,
                 &Foo::x,
-                &s_x_metadata
+                &s_fields_metadata,
+                0
             > {} x;
         };
 
@@ -74,12 +74,12 @@ namespace tests
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
@@ -5,12 +5,4 @@
 namespace tests
 {
     
-    const ::bond::Metadata Result::Schema::metadata
-        = Result::Schema::GetMetadata();
-
-    
-    const ::bond::Metadata Param::Schema::metadata
-        = Param::Schema::GetMetadata();
-
-    
 } // namespace tests
@@ -5,11 +5,14 @@
 namespace tests
 {
     
-    const ::bond::Metadata dummy::Schema::metadata
-        = dummy::Schema::GetMetadata();
-    
-    const ::bond::Metadata dummy::Schema::s_count_metadata
-        = ::bond::reflection::MetadataInit("count");
+    const ::bond::Metadata* dummy::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("count")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
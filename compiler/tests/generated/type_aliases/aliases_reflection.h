@@ -11,23 +11,23 @@ namespace tests
     //
     template <typename T>
     struct Foo<T>::Schema
+        : ::bond::reflection::SchemaTemplate<Foo<T>::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_aa_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // aa
-            typedef struct aa_type : ::bond::reflection::FieldTemplate<
+            typedef struct aa_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 Foo<T>,
                 ::tests::array10< ::tests::array<20, T> >,
                 &Foo<T>::aa,
-                &s_aa_metadata
+                &s_fields_metadata,
+                0
             > {} aa;
         };
 
@@ -36,50 +36,46 @@ namespace tests
 
         public: typedef typename fields1::type fields;
         
-        Schema()
-        {
-            // Force instantiation of template statics
-            (void)metadata;
-            (void)s_aa_metadata;
-        }
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit<boost::mpl::list<T> >("Foo", "tests.Foo",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit<boost::mpl::list<T> >("Foo", "tests.Foo",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
     template <typename T>
-    const ::bond::Metadata Foo<T>::Schema::metadata
-        = Foo<T>::Schema::GetMetadata();
-    
-    template <typename T>
-    const ::bond::Metadata Foo<T>::Schema::s_aa_metadata
-        = ::bond::reflection::MetadataInit("aa");
+    const ::bond::Metadata* Foo<T>::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("aa")
+        };
+        return s_metadata;
+    }
 
     //
     // WrappingAnEnum
     //
     struct WrappingAnEnum::Schema
+        : ::bond::reflection::SchemaTemplate<WrappingAnEnum::Schema>
     {
         typedef ::bond::no_base base;
-
-        static const ::bond::Metadata metadata;
         
-        private: static const ::bond::Metadata s_aWrappedEnum_metadata;
+        private: static const ::bond::Metadata* s_fields_metadata();
 
         public: struct var
         {
             // aWrappedEnum
-            typedef struct aWrappedEnum_type : ::bond::reflection::FieldTemplate<
+            typedef struct aWrappedEnum_type : ::bond::reflection::LazyFieldTemplate<
                 0,
                 ::bond::reflection::optional_field_modifier,
                 WrappingAnEnum,
                 ::tests::Wrapper< ::tests::EnumToWrap>,
                 &WrappingAnEnum::aWrappedEnum,
-                &s_aWrappedEnum_metadata
+                &s_fields_metadata,
+                0
             > {} aWrappedEnum;
         };
 
@@ -88,12 +84,12 @@ namespace tests
 
         public: typedef fields1::type fields;
         
-        
-        static ::bond::Metadata GetMetadata()
+        static const ::bond::Metadata& GetMetadata()
         {
-            return ::bond::reflection::MetadataInit("WrappingAnEnum", "tests.WrappingAnEnum",
+            static const ::bond::Metadata s_metadata = ::bond::reflection::MetadataInit("WrappingAnEnum", "tests.WrappingAnEnum",
                 ::bond::reflection::Attributes()
             );
+            return s_metadata;
         }
     };
     
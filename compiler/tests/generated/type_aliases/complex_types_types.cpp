@@ -5,33 +5,20 @@
 namespace tests
 {
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-
-    
-    const ::bond::Metadata ComplexTypes::Schema::metadata
-        = ComplexTypes::Schema::GetMetadata();
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_li8_metadata
-        = ::bond::reflection::MetadataInit("li8");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_sb_metadata
-        = ::bond::reflection::MetadataInit("sb");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_vb_metadata
-        = ::bond::reflection::MetadataInit("vb");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_nf_metadata
-        = ::bond::reflection::MetadataInit("nf");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_msws_metadata
-        = ::bond::reflection::MetadataInit("msws");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_bfoo_metadata
-        = ::bond::reflection::MetadataInit("bfoo");
-    
-    const ::bond::Metadata ComplexTypes::Schema::s_m_metadata
-        = ::bond::reflection::MetadataInit("m");
+    const ::bond::Metadata* ComplexTypes::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("li8"),
+            ::bond::reflection::MetadataInit("sb"),
+            ::bond::reflection::MetadataInit("vb"),
+            ::bond::reflection::MetadataInit("nf"),
+            ::bond::reflection::MetadataInit("msws"),
+            ::bond::reflection::MetadataInit("bfoo"),
+            ::bond::reflection::MetadataInit("m")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
@@ -100,6 +100,8 @@ namespace tests
 
         bool ToEnum(enum EnumType1& value, const std::string& name);
 
+        bool ToEnum(enum EnumType1& value, const char* name, std::size_t length);
+
         bool FromEnum(std::string& name, enum EnumType1 value);
 
     } // namespace EnumType1
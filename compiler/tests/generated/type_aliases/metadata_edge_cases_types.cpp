@@ -5,23 +5,18 @@
 namespace tests
 {
     
-    const ::bond::Metadata Foo::Schema::metadata
-        = Foo::Schema::GetMetadata();
-    
-    const ::bond::Metadata Foo::Schema::s_id_metadata
-        = ::bond::reflection::MetadataInit("id");
-    
-    const ::bond::Metadata Foo::Schema::s_metadata_metadata
-        = ::bond::reflection::MetadataInit("metadata");
-    
-    const ::bond::Metadata Foo::Schema::s_id_type_metadata
-        = ::bond::reflection::MetadataInit("id_type");
-    
-    const ::bond::Metadata Foo::Schema::s_x_metadata
-        = ::bond::reflection::MetadataInit("x");
-    
-    const ::bond::Metadata Foo::Schema::s_x_type_metadata
-        = ::bond::reflection::MetadataInit("x_type");
+    const ::bond::Metadata* Foo::Schema::s_fields_metadata()
+    {
+        static const ::bond::Metadata s_metadata[] =
+        {
+            ::bond::reflection::MetadataInit("id"),
+            ::bond::reflection::MetadataInit("metadata"),
+            ::bond::reflection::MetadataInit("id_type"),
+            ::bond::reflection::MetadataInit("x"),
+            ::bond::reflection::MetadataInit("x_type")
+        };
+        return s_metadata;
+    }
 
     
 } // namespace tests
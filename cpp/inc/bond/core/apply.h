@@ -46,6 +46,15 @@ ApplyTransform(const Transform& transform, const T& value)
 }
 
 
+/// @brief Serialize an instance of a flat struct using protocol which packs fields
+template <typename Protocols, typename Writer, typename ProtocolsT, typename T>
+typename boost::enable_if<is_packed_flat_struct<Writer, T>, bool>::type inline
+ApplyTransform(const Serializer<Writer, ProtocolsT>& transform, const T& value)
+{
+    return ApplyFlatStruct(transform, value);
+}
+
+
 /// @brief Apply transform which can modify an instance of a struct
 template <typename Protocols, typename Transform, typename T>
 typename boost::enable_if<is_modifying_transform<Transform>, bool>::type inline
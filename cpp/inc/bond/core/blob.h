@@ -266,6 +266,8 @@ public:
     template <typename A>
     friend blob blob_prolong(blob src, const A& allocator);
 
+    friend class local_blob;
+
 private:
     template <typename T>
     struct deleter
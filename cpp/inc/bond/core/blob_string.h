@@ -0,0 +1,280 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "blob.h"
+#include "container_interface.h"
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+namespace bond
+{
+
+/// @brief String referencing the memory of a blob
+///
+/// When deserialized with Compact, Fast or Simple Binary protocols, a
+/// blob_string points into the input buffer and shares ownership of its
+/// memory instead of copying the characters. If the input buffer was created
+/// from raw memory, the string is valid only as long as that memory is.
+/// Strings constructed from characters, wide strings and strings deserialized
+/// by other protocols own a copy of the characters.
+///
+/// Generated types use blob_string and blob_wstring for string fields when
+/// the schema is compiled with `gbc c++ --blob-strings`.
+template <typename C>
+class basic_blob_string
+{
+public:
+    typedef C value_type;
+    typedef const C* const_iterator;
+
+    /// @brief Default constructor
+    basic_blob_string()
+    {}
+
+    /// @brief Construct a string referencing the content of a blob
+    ///
+    /// The content must be aligned for the character type.
+    explicit basic_blob_string(const blob& data)
+        : _data(data)
+    {}
+
+    /// @brief Construct a copy of a null-terminated string
+    basic_blob_string(const C* str)
+    {
+        assign(str, static_cast<uint32_t>(std::char_traits<C>::length(str)));
+    }
+
+    /// @brief Construct a copy of characters
+    basic_blob_string(const C* str, uint32_t length)
+    {
+        assign(str, length);
+    }
+
+    /// @brief Construct a copy of a std::basic_string
+    explicit basic_blob_string(const std::basic_string<C>& str)
+    {
+        assign(str.data(), static_cast<uint32_t>(str.size()));
+    }
+
+    // Copies share the characters until either of them is written to. The
+    // source of a copy isn't modified, so a const string can be copied
+    // concurrently.
+
+    /// @brief Reference the content of a blob
+    void assign(const blob& data)
+    {
+        _data = data;
+        _buffer.reset();
+    }
+
+    /// @brief Assign a copy of characters
+    void assign(const C* str, uint32_t length)
+    {
+        basic_blob_string temp;
+
+        temp.resize(length);
+        std::memcpy(temp._buffer.get(), str, length * sizeof(C));
+        swap(temp);
+    }
+
+    /// @brief Resize to a newly allocated, uninitialized buffer which is
+    /// writable via \ref mutable_data.
+    void resize(uint32_t length)
+    {
+        if (length)
+        {
+            _buffer = boost::make_shared_noinit<C[]>(length);
+            _data.assign(
+                boost::shared_ptr<const char[]>(_buffer, reinterpret_cast<const char*>(_buffer.get())),
+                static_cast<uint32_t>(length * sizeof(C)));
+        }
+        else
+        {
+            _data.clear();
+            _buffer.reset();
+        }
+    }
+
+    /// @brief Pointer to the characters, which are not null-terminated
+    const C* data() const
+    {
+        return reinterpret_cast<const C*>(_data.content());
+    }
+
+    /// @brief Pointer to the characters for writing; memory referenced from
+    /// another blob or string is copied first.
+    C* mutable_data()
+    {
+        if (!_data.empty() && !writable())
+        {
+            assign(data(), length());
+        }
+
+        return _buffer.get();
+    }
+
+    /// @brief Length of the string
+    uint32_t length() const
+    {
+        return static_cast<uint32_t>(_data.length() / sizeof(C));
+    }
+
+    /// @brief Length of the string
+    uint32_t size() const
+    {
+        return length();
+    }
+
+    /// @brief Check if the string is empty
+    bool empty() const
+    {
+        return _data.empty();
+    }
+
+    /// @brief Iterator for the beginning of the string
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    /// @brief Iterator for the end of the string
+    const_iterator end() const
+    {
+        return data() + length();
+    }
+
+    /// @brief The blob referenced by the string
+    ///
+    /// If the blob is copied, the characters are copied again before they
+    /// are next written to.
+    const blob& get_blob() const
+    {
+        return _data;
+    }
+
+    /// @brief Copy of the string as std::basic_string
+    std::basic_string<C> str() const
+    {
+        return std::basic_string<C>(begin(), end());
+    }
+
+    /// @brief Swap with another string
+    void swap(basic_blob_string& that)
+    {
+        _data.swap(that._data);
+        _buffer.swap(that._buffer);
+    }
+
+    bool operator==(const basic_blob_string& that) const
+    {
+        return _data == that._data;
+    }
+
+    bool operator!=(const basic_blob_string& that) const
+    {
+        return !(_data == that._data);
+    }
+
+    bool operator<(const basic_blob_string& that) const
+    {
+        return std::lexicographical_compare(begin(), end(), that.begin(), that.end());
+    }
+
+private:
+    // The characters allocated by this object can be written in place when
+    // their only owners are _buffer and _data, i.e. no copy of the string or
+    // of its blob shares them. Only this object can add owners, so the check
+    // can't be invalidated by other threads.
+    bool writable() const
+    {
+        return _buffer && _buffer.use_count() == 2;
+    }
+
+    blob _data;
+    boost::shared_ptr<C[]> _buffer;
+};
+
+
+typedef basic_blob_string<char> blob_string;
+typedef basic_blob_string<wchar_t> blob_wstring;
+
+
+/// @brief Swap two strings
+template <typename C>
+inline void swap(basic_blob_string<C>& x, basic_blob_string<C>& y)
+{
+    x.swap(y);
+}
+
+
+template <> struct
+is_string<blob_string>
+    : std::true_type {};
+
+
+template <> struct
+is_wstring<blob_wstring>
+    : std::true_type {};
+
+
+template <typename C>
+inline const C* string_data(const basic_blob_string<C>& str)
+{
+    return str.data();
+}
+
+
+template <typename C>
+inline C* string_data(basic_blob_string<C>& str)
+{
+    return str.mutable_data();
+}
+
+
+template <typename C>
+inline uint32_t string_length(const basic_blob_string<C>& str)
+{
+    return str.length();
+}
+
+
+template <typename C>
+inline void resize_string(basic_blob_string<C>& str, uint32_t size)
+{
+    str.resize(size);
+}
+
+
+namespace detail
+{
+
+template <typename Buffer, typename T, typename Enable> struct
+string_data_reader;
+
+// Strings are deserialized by referencing the input buffer. Wide strings are
+// encoded as UTF-16 and are copied.
+template <typename Buffer> struct
+string_data_reader<Buffer, blob_string, void>
+{
+    static void Read(Buffer& input, blob_string& value, uint32_t length)
+    {
+        blob data;
+
+        input.Read(data, length);
+        value.assign(data);
+    }
+};
+
+} // namespace detail
+
+} // namespace bond
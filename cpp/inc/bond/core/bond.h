@@ -7,8 +7,15 @@
 #include <bond/core/config.h>
 
 #include "apply.h"
+#include "diff.h"
+#include "reuse.h"
+#include "scan.h"
 #include "select_protocol.h"
 
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
 /// namespace bond
 namespace bond
 {
@@ -40,6 +47,113 @@ inline T Deserialize(Reader input)
 }
 
 
+/// @brief Serialize a range of objects one after another using a protocol
+/// writer
+///
+/// The output is the same as calling bond::Serialize for each object, but the
+/// serializer is set up once for the whole range.
+template <typename Protocols = BuiltInProtocols, typename Range, typename Writer>
+inline void SerializeMany(const Range& range, Writer& output)
+{
+    detail::SerializeMany<Protocols>(range, output);
+}
+
+
+/// @brief Deserialize a stream of objects of type T from a protocol reader
+///
+/// Objects are deserialized until the end of the input buffer or until
+/// max_count objects have been read, and assigned to the output iterator.
+/// The reader is advanced past the objects which were read, so the call can
+/// be repeated to read the stream in batches.
+///
+/// When the iterator refers to existing objects, e.g. the begin() of a vector
+/// holding at least max_count objects, they are deserialized in place and the
+/// memory they hold is reused as by \ref DeserializeReuse. Other output
+/// iterators, e.g. std::back_inserter, are assigned new objects.
+///
+/// @return the number of objects read
+template <typename T, typename Protocols = BuiltInProtocols, typename Reader, typename OutputIterator>
+inline std::size_t DeserializeMany(Reader& input, OutputIterator out, std::size_t max_count)
+{
+    const bonded<T, Reader&> record(input);
+    std::size_t count = 0;
+
+    for (; count != max_count && !input.GetBuffer().IsEof(); ++count, ++out)
+        detail::DeserializeElement<Protocols>(record, out);
+
+    return count;
+}
+
+
+/// @brief Deserialize a stream of objects of type T from a protocol reader
+/// until the end of the input buffer
+///
+/// The output iterator must create new objects, e.g. std::back_inserter;
+/// iterators which refer to existing objects require a bound on the number
+/// of objects read.
+///
+/// @return the number of objects read
+template <typename T, typename Protocols = BuiltInProtocols, typename Reader, typename OutputIterator>
+inline std::size_t DeserializeMany(Reader& input, OutputIterator out)
+{
+    BOOST_STATIC_ASSERT_MSG((!detail::refers_to_objects<T, OutputIterator>::value),
+        "Deserializing in place requires max_count or a range of objects.");
+
+    return DeserializeMany<T, Protocols>(input, out, (std::numeric_limits<std::size_t>::max)());
+}
+
+
+/// @brief Deserialize a stream of objects of type T from a protocol reader
+/// in place into the objects of a range
+///
+/// Objects are deserialized until the end of the input buffer or of the
+/// range, reusing the memory they hold as by \ref DeserializeReuse.
+///
+/// @return the number of objects read
+template <typename T, typename Protocols = BuiltInProtocols, typename Reader, typename ForwardIterator>
+inline std::size_t DeserializeMany(Reader& input, ForwardIterator begin, ForwardIterator end)
+{
+    BOOST_STATIC_ASSERT((detail::refers_to_objects<T, ForwardIterator>::value));
+
+    return DeserializeMany<T, Protocols>(input, begin, static_cast<std::size_t>(std::distance(begin, end)));
+}
+
+
+/// @brief Same as \ref Scan, using the specified protocols for the values
+/// of the selected fields, e.g. marshaled payloads, rather than
+/// bond::BuiltInProtocols
+///
+/// @return the number of objects read
+template <typename T, typename Protocols, typename... Fields, typename Reader, typename Function>
+inline std::size_t ScanWith(Reader& input, const Function& function)
+{
+    detail::Scanner<T, Protocols, Fields...> scanner;
+    std::size_t count = 0;
+
+    for (; !input.GetBuffer().IsEof(); ++count)
+        scanner.Read(input, function);
+
+    return count;
+}
+
+
+/// @brief Read a stream of objects of type T from a protocol reader,
+/// deserializing only the selected fields
+///
+/// Fields are selected using their reflection metadata, e.g.
+/// T::Schema::var::field, and may be fields of T or of its bases. For each
+/// object the function is called with the values of the selected fields, in
+/// the order they were selected. The other fields are skipped and no instance
+/// of T is created. Objects are read until the end of the input buffer.
+///
+/// @return the number of objects read
+template <typename T, typename... Fields, typename Reader, typename Function>
+inline std::size_t Scan(Reader& input, const Function& function)
+{
+    return ScanWith<T, BuiltInProtocols, Fields...>(input, function);
+}
+
+
 /// @brief Deserialize an object from a protocol reader using runtime schema
 template <typename Protocols = BuiltInProtocols, typename Reader, typename T>
 inline void Deserialize(Reader input, T& obj, const RuntimeSchema& schema)
@@ -127,4 +241,25 @@ inline void Merge(const T& obj, Reader input, Writer& output)
     Apply<Protocols>(Merger<T, Writer, Protocols>(obj, output), bonded<T>(input));
 }
 
+
+
+/// @brief Write a patch which transforms one object into another using
+/// a tagged protocol writer
+///
+/// Only the fields which differ are written. The patch can be applied to a
+/// copy of the original object using bond::Patch.
+template <typename Protocols = BuiltInProtocols, typename T, typename Writer>
+inline void Diff(const T& original, const T& updated, Writer& output)
+{
+    detail::WriteDiff<Protocols>(original, updated, output);
+}
+
+
+/// @brief Apply a patch written by bond::Diff to an object in place
+template <typename Protocols = BuiltInProtocols, typename T, typename Reader>
+inline void Patch(T& obj, Reader input)
+{
+    Apply<Protocols>(detail::Patcher<T, Protocols>(obj), bonded<T, Reader&>(input));
+}
+
 }
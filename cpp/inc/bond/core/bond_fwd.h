@@ -61,6 +61,12 @@ get_type_id;
 template <typename T> struct
 may_omit_fields;
 
+template <typename T> struct
+uses_packed_fields;
+
+template <typename T> struct
+uses_static_field_headers;
+
 template <typename Input>
 struct base_input;
 
@@ -0,0 +1,391 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "bond.h"
+#include "detail/marshaled_bonded.h"
+#include "detail/omit_default.h"
+
+#include <bond/protocol/compact_binary.h>
+#include <bond/stream/input_buffer.h>
+#include <bond/stream/output_buffer.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace bond
+{
+
+namespace detail
+{
+
+// Strict weak order of container keys used by canonical serialization. NaNs
+// are ordered after all other values.
+template <typename T>
+inline
+typename boost::enable_if<std::is_floating_point<T>, bool>::type
+CanonicalLess(const T& x, const T& y)
+{
+    return std::isnan(y) ? !std::isnan(x) : x < y;
+}
+
+
+template <typename T>
+inline
+typename boost::enable_if_c<is_string<T>::value || is_wstring<T>::value, bool>::type
+CanonicalLess(const T& x, const T& y)
+{
+    return std::lexicographical_compare(
+        string_data(x), string_data(x) + string_length(x),
+        string_data(y), string_data(y) + string_length(y));
+}
+
+
+template <typename T>
+inline
+typename boost::enable_if<is_type_alias<T>, bool>::type
+CanonicalLess(const T& x, const T& y)
+{
+    return CanonicalLess(get_aliased_value(x), get_aliased_value(y));
+}
+
+
+template <typename T>
+inline
+typename boost::disable_if_c<std::is_floating_point<T>::value
+                          || is_string<T>::value
+                          || is_wstring<T>::value
+                          || is_type_alias<T>::value, bool>::type
+CanonicalLess(const T& x, const T& y)
+{
+    return x < y;
+}
+
+
+template <typename T>
+inline const T& CanonicalKey(const T& element)
+{
+    return element;
+}
+
+
+template <typename K, typename T>
+inline const K& CanonicalKey(const std::pair<K, T>& element)
+{
+    return element.first;
+}
+
+
+// Deserialized values of the bonded<T> fields in an object. With double-pass
+// serialization both passes visit the fields in the same order; each field
+// is deserialized during the first pass which reaches it and the value is
+// reused by the other one.
+struct CanonicalSerializerState
+    : boost::noncopyable
+{
+    CanonicalSerializerState()
+        : pass0(0),
+          pass1(0)
+    {}
+
+    std::vector<boost::shared_ptr<void> > bonded;
+    size_t pass0;
+    size_t pass1;
+};
+
+
+//
+// CanonicalSerializer<Writer> serializes an object like Serializer<Writer>,
+// except that the output depends only on the values of the fields:
+//  - elements of sets and entries of maps are written in ascending order of
+//    their keys, regardless of the iteration order of the container;
+//  - floating point NaNs are written as the quiet NaN of their type and
+//    negative zeros as positive zeros;
+//  - bonded<T> fields are deserialized and serialized canonically rather than
+//    passed through, so the output doesn't depend on how they were produced.
+// Optional fields equal to their default values are always omitted when the
+// protocol can omit fields, and always written otherwise, as omitting them
+// would make the output unreadable by untagged protocols. Either way the
+// output is a function of the values of the fields for a given protocol.
+//
+template <typename Writer, typename Protocols>
+class CanonicalSerializer
+    : public Serializer<Writer, Protocols>
+{
+public:
+    CanonicalSerializer(Writer& output, CanonicalSerializerState& state, size_t& cursor, bool base = false)
+        : Serializer<Writer, Protocols>(output, base),
+          _state(state),
+          _cursor(cursor)
+    {}
+
+    template <typename Pass0>
+    CanonicalSerializer<Pass0, Protocols> Rebind(Pass0& pass0) const
+    {
+        return CanonicalSerializer<Pass0, Protocols>(pass0, _state, _state.pass0);
+    }
+
+    template <typename T>
+    bool Base(const T& value) const
+    {
+        // 'true' means that we are writing a base struct
+        Apply<Protocols>(CanonicalSerializer(_output, _state, _cursor, true), value);
+        return false;
+    }
+
+    template <typename T>
+    typename boost::disable_if<is_bond_type<T>, bool>::type
+    Field(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        if (detail::omit_field<Writer>(metadata, value))
+        {
+            detail::WriteFieldOmitted(_output, GetTypeId(value), id, metadata);
+            return false;
+        }
+
+        WriteField(id, metadata, value);
+        return false;
+    }
+
+    template <typename T>
+    typename boost::enable_if<is_bond_type<T>, bool>::type
+    Field(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        WriteField(id, metadata, value);
+        return false;
+    }
+
+    template <typename T>
+    bool Field(uint16_t id, const Metadata& metadata, const maybe<T>& value) const
+    {
+        if (detail::omit_field<Writer>(metadata, value))
+        {
+            detail::WriteFieldOmitted(_output, get_type_id<T>::value, id, metadata);
+            return false;
+        }
+
+        WriteField(id, metadata, value.value());
+        return false;
+    }
+
+protected:
+    using Serializer<Writer, Protocols>::_output;
+
+private:
+    // basic type field
+    template <typename T>
+    typename boost::enable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+    WriteField(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        _output.WriteField(id, metadata, Normalize(value));
+    }
+
+    // struct or container field
+    template <typename T>
+    typename boost::disable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+    WriteField(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        _output.WriteFieldBegin(GetTypeId(value), id, metadata);
+        Write(value);
+        _output.WriteFieldEnd();
+    }
+
+    template <typename T>
+    static
+    typename boost::enable_if<std::is_floating_point<T>, T>::type
+    Normalize(T value)
+    {
+        return std::isnan(value) ? std::numeric_limits<T>::quiet_NaN()
+            : value == 0 ? T(0) : value;
+    }
+
+    template <typename T>
+    static
+    typename boost::disable_if<std::is_floating_point<T>, const T&>::type
+    Normalize(const T& value)
+    {
+        return value;
+    }
+
+    // basic type value
+    template <typename T>
+    typename boost::enable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+    Write(const T& value) const
+    {
+        _output.Write(Normalize(value));
+    }
+
+    // type alias
+    template <typename T>
+    typename boost::enable_if<is_type_alias<T> >::type
+    Write(const T& value) const
+    {
+        Write(get_aliased_value(value));
+    }
+
+    // struct value
+    template <typename T>
+    typename boost::enable_if<has_schema<T> >::type
+    Write(const T& value) const
+    {
+        Apply<Protocols>(CanonicalSerializer(_output, _state, _cursor), value);
+    }
+
+    // bonded<T> and tagged writer
+    template <typename T, typename Reader>
+    typename boost::disable_if<uses_marshaled_bonded<typename Writer::Reader, T> >::type
+    Write(const bonded<T, Reader>& value) const
+    {
+        Write(Deserialize(value));
+    }
+
+    // bonded<T> and untagged writer
+    template <typename T, typename Reader>
+    typename boost::enable_if<uses_marshaled_bonded<typename Writer::Reader, T> >::type
+    Write(const bonded<T, Reader>& value) const
+    {
+        // Same as MarshalToBlob, with the struct serialized canonically
+        auto output = CreateOutputBuffer(_output.GetBuffer());
+        CompactBinaryWriter<decltype(output)> writer(output);
+
+        writer.WriteVersion();
+        Apply<Protocols>(CanonicalSerializer<CompactBinaryWriter<decltype(output)>, Protocols>(writer, _state, _cursor),
+                         Deserialize(value));
+
+        auto data = std::move(output).GetBuffer();
+
+        _output.Write(static_cast<uint32_t>(data.size()));
+        _output.GetBuffer().Write(data);
+    }
+
+    template <typename T, typename Reader>
+    const T& Deserialize(const bonded<T, Reader>& value) const
+    {
+        if (_cursor == _state.bonded.size())
+            _state.bonded.push_back(boost::make_shared<T>(Transcode(value)));
+
+        return *static_cast<const T*>(_state.bonded[_cursor++].get());
+    }
+
+    // bonded<T> may hold an instance of T rather than a payload, in which case
+    // it can only be serialized, so it is transcoded to Compact Binary first.
+    template <typename T, typename Reader>
+    static T Transcode(const bonded<T, Reader>& value)
+    {
+        OutputBuffer output;
+        CompactBinaryWriter<OutputBuffer> writer(output);
+
+        value.template Serialize<Protocols>(writer);
+
+        T obj;
+        bond::Deserialize<Protocols>(CompactBinaryReader<InputBuffer>(output.GetBuffer()), obj);
+        return obj;
+    }
+
+    // 2-tuple
+    template <typename T1, typename T2>
+    void Write(const std::pair<T1, T2>& value) const
+    {
+        Write(value.first);
+        Write(value.second);
+    }
+
+    // list container value
+    template <typename T>
+    typename boost::enable_if_c<is_container<T>::value
+                             && !is_set_container<T>::value
+                             && !is_map_container<T>::value>::type
+    Write(const T& value) const
+    {
+        _output.WriteContainerBegin(container_size(value), get_type_id<typename element_type<T>::type>::value);
+
+        for (const_enumerator<T> items(value); items.more();)
+        {
+            Write(items.next());
+        }
+
+        _output.WriteContainerEnd();
+    }
+
+    // set or map container value
+    template <typename T>
+    typename boost::enable_if_c<is_set_container<T>::value
+                             || is_map_container<T>::value>::type
+    Write(const T& value) const
+    {
+        typedef typename std::remove_reference<
+            decltype(std::declval<const_enumerator<T>&>().next())>::type element;
+
+        const auto less = [](const element* x, const element* y)
+        {
+            return CanonicalLess(CanonicalKey(*x), CanonicalKey(*y));
+        };
+
+        std::vector<const element*> elements;
+        elements.reserve(container_size(value));
+
+        for (const_enumerator<T> items(value); items.more();)
+        {
+            elements.push_back(&items.next());
+        }
+
+        // Ordered containers are usually sorted already
+        if (!std::is_sorted(elements.begin(), elements.end(), less))
+        {
+            std::sort(elements.begin(), elements.end(), less);
+        }
+
+        _output.WriteContainerBegin(container_size(value), get_type_id<typename element_type<T>::type>::value);
+
+        for (const element* item : elements)
+        {
+            Write(*item);
+        }
+
+        _output.WriteContainerEnd();
+    }
+
+    // blob
+    void Write(const blob& value) const
+    {
+        _output.WriteContainerBegin(value.length(), get_type_id<blob::value_type>::value);
+        _output.Write(value);
+        _output.WriteContainerEnd();
+    }
+
+    CanonicalSerializerState& _state;
+    size_t& _cursor;
+};
+
+} // namespace detail
+
+
+/// @brief Serialize an object canonically using a protocol writer
+///
+/// Logically equal objects are serialized to identical bytes for a given
+/// protocol and version, which makes the output suitable as a cache key or
+/// for hashing. Unlike bond::Serialize, elements of sets and maps are
+/// written in ascending order of keys, whatever the type of the container,
+/// NaNs and negative zeros are normalized, and bonded<T> fields are serialized canonically
+/// rather than passed through. Fields which are not in the schema of a
+/// bonded<T> field's payload are not preserved.
+template <typename Protocols = BuiltInProtocols, typename T, typename Writer>
+inline void SerializeCanonical(const T& obj, Writer& output)
+{
+    BOOST_STATIC_ASSERT(has_schema<T>::value);
+
+    detail::CanonicalSerializerState state;
+
+    Apply<Protocols>(detail::CanonicalSerializer<Writer, Protocols>(output, state, state.pass1), obj);
+}
+
+} // namespace bond
@@ -87,6 +87,9 @@ class const_enumerator;
 template <typename T>
 uint32_t container_size(const T& container);
 
+template <typename T>
+void container_reserve(T& container, uint32_t size);
+
 template <typename T>
 void resize_list(T& list, uint32_t size);
 
@@ -104,6 +107,9 @@ void clear_map(T& map);
 
 template <typename M, typename K, typename T>
 T& mapped_at(M& map, const K& key);
+
+template <typename M, typename K, typename T>
+T& map_insert(M& map, K&& key);
 #endif
 
 //
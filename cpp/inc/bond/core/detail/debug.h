@@ -35,7 +35,7 @@ public:
                                         reflection::optional_field_modifier>::value>::type
     operator()(const Field&)
     {
-        _default = _default && is_default(Field::GetVariable(_var), Field::metadata);
+        _default = _default && is_default(Field::GetVariable(_var), Field::GetMetadata());
     }
 
 
@@ -33,6 +33,41 @@ namespace bond
             return transform.Serializer::_output.WithPass0(pass0), Apply<Protocols>(transform, value);
         }
 
+
+        template <typename Protocols, typename Transform, typename Range>
+        inline void ApplyEach(const Transform& transform, const Range& range)
+        {
+            for (const auto& obj : range)
+                Apply<Protocols>(transform, obj);
+        }
+
+        template <typename Protocols, typename Range, typename Writer>
+        typename boost::disable_if<need_double_pass<Serializer<Writer, Protocols> > >::type
+        inline SerializeMany(const Range& range, Writer& output)
+        {
+            ApplyEach<Protocols>(Serializer<Writer, Protocols>(output), range);
+        }
+
+        // The first pass is done once for all objects in the range; the second
+        // pass consumes the struct lengths in the same order.
+        template <typename Protocols, typename Range, typename Writer>
+        typename boost::enable_if<need_double_pass<Serializer<Writer, Protocols> > >::type
+        inline SerializeMany(const Range& range, Writer& output)
+        {
+            if (output.NeedPass0())
+            {
+                typename Writer::Pass0::Buffer buffer;
+                typename Writer::Pass0 pass0(buffer, output);
+
+                ApplyEach<Protocols>(Serializer<typename Writer::Pass0, Protocols>(pass0), range);
+                output.WithPass0(pass0), ApplyEach<Protocols>(Serializer<Writer, Protocols>(output), range);
+            }
+            else
+            {
+                ApplyEach<Protocols>(Serializer<Writer, Protocols>(output), range);
+            }
+        }
+
     } // namespace detail
 
 } // namespace bond
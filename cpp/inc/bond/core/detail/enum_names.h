@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <boost/static_assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace bond
+{
+namespace detail
+{
+
+// Entry of the perfect hash table of enum constant names which gbc generates
+// for the conversions from name to value. Unused entries have null name.
+template <typename Enum>
+struct enum_name
+{
+    const char* name;
+    uint32_t length;
+    Enum value;
+};
+
+
+// Up to 8 bytes of an enum constant name as a little endian word
+inline uint64_t enum_name_word(const char* name, std::size_t length)
+{
+    uint64_t word = 0;
+
+    for (std::size_t i = 0; i < length; ++i)
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(name[i])) << (8 * i);
+
+    return word;
+}
+
+
+// Hash of an enum constant name, which gbc also computes when building the
+// tables, so it must not be changed without changing the compiler. The name
+// is read 8 bytes at a time as little endian words, on any platform. Names
+// of the same length up to 8 bytes never collide; other names can, and gbc
+// rejects enums with two constant names of the same hash.
+inline uint64_t enum_name_hash(const char* name, std::size_t length)
+{
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    uint64_t hash = length * multiplier;
+
+    for (; length >= sizeof(uint64_t); name += sizeof(uint64_t), length -= sizeof(uint64_t))
+        hash = (hash ^ enum_name_word(name, sizeof(uint64_t))) * multiplier;
+
+    if (length)
+        hash = (hash ^ enum_name_word(name, length)) * multiplier;
+
+    return hash;
+}
+
+
+// MurmurHash3 finalizer, which maps the name hash to a bucket and, combined
+// with the seed of the bucket, to an entry of the table.
+inline uint64_t enum_name_mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+
+// Looks up an enum constant name, which doesn't have to be null terminated,
+// in a table generated by gbc. Sizes of both arrays are powers of 2.
+template <typename Enum, std::size_t Buckets, std::size_t Size>
+inline bool find_enum_value(
+    const uint32_t (&seeds)[Buckets],
+    const enum_name<Enum> (&names)[Size],
+    const char* name,
+    std::size_t length,
+    Enum& value)
+{
+    BOOST_STATIC_ASSERT((Buckets & (Buckets - 1)) == 0 && (Size & (Size - 1)) == 0);
+
+    const uint64_t hash = enum_name_hash(name, length);
+    const uint32_t seed = Buckets == 1 ? seeds[0] : seeds[enum_name_mix(hash) & (Buckets - 1)];
+    const enum_name<Enum>& entry = names[enum_name_mix(hash ^ seed) & (Size - 1)];
+
+    if (entry.name != nullptr && entry.length == length && std::memcmp(entry.name, name, length) == 0)
+    {
+        value = entry.value;
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace detail
+} // namespace bond
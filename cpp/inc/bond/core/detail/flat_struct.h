@@ -0,0 +1,388 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/reflection.h>
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/next.hpp>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace bond
+{
+
+/// @brief Protocols which write struct fields back to back, without any
+/// headers, each in the native representation of its type.
+///
+/// Flat structs are serialized to and deserialized from such protocols with
+/// a single copy of all the fields.
+template <typename T> struct
+uses_packed_fields
+    : std::false_type {};
+
+
+namespace detail
+{
+
+template <typename T, typename Enable = void> struct
+flat_value;
+
+template <typename Begin, typename End> struct
+flat_fields
+{
+    typedef typename boost::mpl::deref<Begin>::type field;
+    typedef flat_value<typename field::value_type> head;
+    typedef flat_fields<typename boost::mpl::next<Begin>::type, End> tail;
+
+    static const bool value = head::value && tail::value;
+    static const uint32_t size = head::size + tail::size;
+};
+
+template <typename End> struct
+flat_fields<End, End>
+{
+    static const bool value = true;
+    static const uint32_t size = 0;
+};
+
+template <typename T, typename Enable = void> struct
+flat_base
+{
+    static const bool value = true;
+    static const uint32_t size = 0;
+};
+
+template <typename T> struct
+flat_base<T, typename boost::enable_if<has_base<T> >::type>
+    : flat_value<typename schema<T>::type::base> {};
+
+
+// Values which Simple Binary writes as a copy of their object representation:
+// numbers, bool, enums and structs which contain nothing else. The size is
+// the number of bytes of the value in the payload.
+template <typename T, typename Enable> struct
+flat_value
+{
+    static const bool value = false;
+    static const uint32_t size = 0;
+};
+
+template <typename T> struct
+flat_value<T, typename boost::enable_if_c<std::is_arithmetic<T>::value
+                                      || (std::is_enum<T>::value && sizeof(T) == sizeof(int32_t))>::type>
+{
+    static const bool value = true;
+    static const uint32_t size = sizeof(T);
+};
+
+template <typename T> struct
+flat_value<T, typename boost::enable_if<has_schema<T> >::type>
+{
+    typedef typename schema<T>::type::fields fields;
+    typedef flat_fields<typename boost::mpl::begin<fields>::type,
+                        typename boost::mpl::end<fields>::type> members;
+
+    static const bool value = flat_base<T>::value && members::value;
+    static const uint32_t size = flat_base<T>::size + members::size;
+};
+
+} // namespace detail
+
+
+/// @brief Structs, including their bases, with only fields of fixed size
+/// scalar types, enums and other flat structs.
+template <typename T> struct
+is_flat_struct
+    : std::integral_constant<bool,
+        has_schema<T>::value
+        && detail::flat_value<T>::value> {};
+
+
+namespace detail
+{
+
+template <typename Protocol, typename T> struct
+is_packed_flat_struct
+    : std::integral_constant<bool,
+        uses_packed_fields<Protocol>::value
+        && is_flat_struct<T>::value> {};
+
+
+// Copies the fields of a flat struct to or from their packed representation,
+// in the order in which they appear in the payload.
+class FlatFields
+{
+public:
+    template <typename T>
+    static typename boost::enable_if_c<!has_schema<T>::value, char*>::type
+    Pack(char* data, const T& value)
+    {
+        std::memcpy(data, &value, sizeof(T));
+        return data + sizeof(T);
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_schema<T>, char*>::type
+    Pack(char* data, const T& value)
+    {
+        data = PackBase(data, value);
+
+        typedef typename schema<T>::type::fields fields;
+        return PackFields(data, value, typename boost::mpl::begin<fields>::type(), typename boost::mpl::end<fields>::type());
+    }
+
+    template <typename T>
+    static typename boost::enable_if_c<!has_schema<T>::value, const char*>::type
+    Unpack(const char* data, T& value)
+    {
+        std::memcpy(&value, data, sizeof(T));
+        return data + sizeof(T);
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_schema<T>, const char*>::type
+    Unpack(const char* data, T& value)
+    {
+        data = UnpackBase(data, value);
+
+        typedef typename schema<T>::type::fields fields;
+        return UnpackFields(data, value, typename boost::mpl::begin<fields>::type(), typename boost::mpl::end<fields>::type());
+    }
+
+    // True when every field is at the same offset in the object as in the
+    // payload and there is no padding, so that the packed representation of
+    // the struct is its object representation.
+    template <typename T>
+    static bool IsPacked(const T& value)
+    {
+        return sizeof(T) == flat_value<T>::size
+            && IsPacked(value, reinterpret_cast<const char*>(&value));
+    }
+
+private:
+    template <typename T>
+    static typename boost::enable_if_c<!has_schema<T>::value, bool>::type
+    IsPacked(const T& value, const char* data)
+    {
+        return reinterpret_cast<const char*>(&value) == data;
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_schema<T>, bool>::type
+    IsPacked(const T& value, const char* data)
+    {
+        if (!IsPackedBase(value, data))
+            return false;
+
+        typedef typename schema<T>::type::fields fields;
+        return IsPackedFields(value, data + flat_base<T>::size,
+            typename boost::mpl::begin<fields>::type(), typename boost::mpl::end<fields>::type());
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_base<T>, char*>::type
+    PackBase(char* data, const T& value)
+    {
+        return Pack(data, static_cast<const typename schema<T>::type::base&>(value));
+    }
+
+    template <typename T>
+    static typename boost::disable_if<has_base<T>, char*>::type
+    PackBase(char* data, const T& /*value*/)
+    {
+        return data;
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_base<T>, const char*>::type
+    UnpackBase(const char* data, T& value)
+    {
+        return Unpack(data, static_cast<typename schema<T>::type::base&>(value));
+    }
+
+    template <typename T>
+    static typename boost::disable_if<has_base<T>, const char*>::type
+    UnpackBase(const char* data, T& /*value*/)
+    {
+        return data;
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_base<T>, bool>::type
+    IsPackedBase(const T& value, const char* data)
+    {
+        return IsPacked(static_cast<const typename schema<T>::type::base&>(value), data);
+    }
+
+    template <typename T>
+    static typename boost::disable_if<has_base<T>, bool>::type
+    IsPackedBase(const T& /*value*/, const char* /*data*/)
+    {
+        return true;
+    }
+
+    template <typename T, typename End>
+    static char* PackFields(char* data, const T& /*value*/, const End&, const End&)
+    {
+        return data;
+    }
+
+    template <typename T, typename Begin, typename End>
+    static char* PackFields(char* data, const T& value, const Begin&, const End& end)
+    {
+        typedef typename boost::mpl::deref<Begin>::type field;
+
+        data = Pack(data, field::GetVariable(value));
+        return PackFields(data, value, typename boost::mpl::next<Begin>::type(), end);
+    }
+
+    template <typename T, typename End>
+    static const char* UnpackFields(const char* data, T& /*value*/, const End&, const End&)
+    {
+        return data;
+    }
+
+    template <typename T, typename Begin, typename End>
+    static const char* UnpackFields(const char* data, T& value, const Begin&, const End& end)
+    {
+        typedef typename boost::mpl::deref<Begin>::type field;
+
+        data = Unpack(data, field::GetVariable(value));
+        return UnpackFields(data, value, typename boost::mpl::next<Begin>::type(), end);
+    }
+
+    template <typename T, typename End>
+    static bool IsPackedFields(const T& /*value*/, const char* /*data*/, const End&, const End&)
+    {
+        return true;
+    }
+
+    template <typename T, typename Begin, typename End>
+    static bool IsPackedFields(const T& value, const char* data, const Begin&, const End& end)
+    {
+        typedef typename boost::mpl::deref<Begin>::type field;
+
+        return IsPacked(field::GetVariable(value), data)
+            && IsPackedFields(value, data + flat_value<typename field::value_type>::size,
+                              typename boost::mpl::next<Begin>::type(), end);
+    }
+};
+
+
+// Structs whose packed representation is the object representation are
+// copied in one go, others field by field via a buffer on the stack.
+template <typename T>
+inline bool IsPackedLayout(const T& value)
+{
+    static const bool packed = std::is_trivially_copyable<T>::value && FlatFields::IsPacked(value);
+    return packed;
+}
+
+
+template <typename Buffer, typename T>
+inline void WriteFlatStruct(Buffer& output, const T& value)
+{
+    BOOST_STATIC_ASSERT(is_flat_struct<T>::value);
+
+    const uint32_t size = flat_value<T>::size;
+
+    if (IsPackedLayout(value))
+    {
+        output.Write(&value, size);
+    }
+    else
+    {
+        char data[size ? size : 1];
+
+        FlatFields::Pack(data, value);
+        output.Write(data, size);
+    }
+}
+
+
+template <typename Buffer, typename T>
+inline void ReadFlatStruct(Buffer& input, T& value)
+{
+    BOOST_STATIC_ASSERT(is_flat_struct<T>::value);
+
+    const uint32_t size = flat_value<T>::size;
+
+    if (IsPackedLayout(value))
+    {
+        input.Read(&value, size);
+    }
+    else
+    {
+        char data[size ? size : 1];
+
+        input.Read(data, size);
+        FlatFields::Unpack(data, value);
+    }
+}
+
+
+// Contiguous elements of a vector of flat structs with packed layout are
+// written and read with a single copy, as long as it fits in one call.
+template <typename Buffer, typename T, typename Alloc>
+inline void WriteFlatStructs(Buffer& output, const std::vector<T, Alloc>& values)
+{
+    const uint64_t size = static_cast<uint64_t>(values.size()) * flat_value<T>::size;
+
+    if (!values.empty() && size <= (std::numeric_limits<uint32_t>::max)() && IsPackedLayout(values.front()))
+    {
+        output.Write(values.data(), static_cast<uint32_t>(size));
+    }
+    else
+    {
+        for (const T& value : values)
+            WriteFlatStruct(output, value);
+    }
+}
+
+
+template <typename Buffer, typename T, typename Alloc>
+inline void ReadFlatStructs(Buffer& input, std::vector<T, Alloc>& values)
+{
+    const uint64_t size = static_cast<uint64_t>(values.size()) * flat_value<T>::size;
+
+    if (!values.empty() && size <= (std::numeric_limits<uint32_t>::max)() && IsPackedLayout(values.front()))
+    {
+        input.Read(values.data(), static_cast<uint32_t>(size));
+    }
+    else
+    {
+        for (T& value : values)
+            ReadFlatStruct(input, value);
+    }
+}
+
+
+// Serializes a flat struct to a protocol which packs fields, bypassing the
+// parser and the Serializer transform.
+template <typename Writer, typename Protocols, typename T>
+inline bool ApplyFlatStruct(const Serializer<Writer, Protocols>& transform, const T& value)
+{
+    WriteFlatStruct(transform._output.GetBuffer(), value);
+    return false;
+}
+
+
+// Deserializes a flat struct from a protocol which packs fields. All fields
+// are read, thus the required fields don't need to be validated.
+template <typename T, typename Protocols, typename Validator, typename Reader>
+inline bool ApplyFlatStruct(const To<T, Protocols, Validator>& transform, Reader& reader)
+{
+    ReadFlatStruct(reader.GetBuffer(), transform._var);
+    return false;
+}
+
+} // namespace detail
+} // namespace bond
@@ -100,7 +100,7 @@ protected:
         // We are at the expected level within the hierarchy.
         // First we recurse into base structs (serialized data starts at the top of the hierarchy)
         // and then we read to the transform the fields of the top level struct.
-        transform.Begin(T::metadata);
+        transform.Begin(schema_metadata<T>());
 
         bool done = ReadBase(base_class<T>(), transform);
 
@@ -12,6 +12,13 @@ namespace bond
 {
 namespace detail
 {
+    // Transforms which take fields of structs with compile-time schema as
+    // KnownField(field, value) when applied to an instance of the struct.
+    template <typename Transform> struct
+    uses_known_fields
+        : std::false_type {};
+
+
     template <typename T, typename Transform>
     typename boost::enable_if<is_fast_path_field<T, Transform>, bool>::type
     inline OmittedField(const T& field, const Transform& transform)
@@ -24,7 +31,7 @@ namespace detail
     typename boost::disable_if<is_fast_path_field<T, Transform>, bool>::type
     inline OmittedField(const T&, const Transform& transform)
     {
-        return transform.OmittedField(T::id, T::metadata, get_type_id<typename T::field_type>::value);
+        return transform.OmittedField(T::id, T::GetMetadata(), get_type_id<typename T::field_type>::value);
     }
 
 
@@ -66,10 +73,20 @@ namespace detail
 
 
     template <typename T, typename Transform, typename X>
-    typename boost::disable_if_c<is_reader<X>::value && is_fast_path_field<T, Transform>::value, bool>::type
+    typename boost::enable_if_c<!is_reader<X>::value && uses_known_fields<Transform>::value, bool>::type
+    inline NonBasicTypeField(const T& field, const Transform& transform, X&& value)
+    {
+        return transform.KnownField(field, GetFieldValue<T>(std::forward<X>(value)));
+    }
+
+
+    template <typename T, typename Transform, typename X>
+    typename boost::disable_if_c<is_reader<X>::value
+                                    ? is_fast_path_field<T, Transform>::value
+                                    : uses_known_fields<Transform>::value, bool>::type
     inline NonBasicTypeField(const T&, const Transform& transform, X&& value)
     {
-        return transform.Field(T::id, T::metadata, GetFieldValue<T>(std::forward<X>(value)));
+        return transform.Field(T::id, T::GetMetadata(), GetFieldValue<T>(std::forward<X>(value)));
     }
 
 
@@ -5,6 +5,7 @@
 
 #include <bond/core/config.h>
 
+#include "flat_struct.h"
 #include "pass_through.h"
 #include "tags.h"
 
@@ -84,6 +85,14 @@ public:
         return FastPassThrough(reader, transform._output, schema);
     }
 
+    template <typename Reader, typename Protocols, typename Validator>
+    static
+    typename boost::enable_if<is_packed_flat_struct<Reader, T>, bool>::type
+    Apply(const To<T, Protocols, Validator>& transform, Reader& reader, const Schema& /*schema*/, bool /*base*/)
+    {
+        return ApplyFlatStruct(transform, reader);
+    }
+
     template <typename TransformT, typename Reader>
     static
     bool Apply(const TransformT& transform, Reader& reader, const Schema& schema, bool base)
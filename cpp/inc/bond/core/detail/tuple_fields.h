@@ -18,7 +18,7 @@ struct tuple_field
     typedef typename remove_maybe<value_type>::type field_type;
     typedef reflection::optional_field_modifier field_modifier;
 
-    static const Metadata metadata;
+    static const Metadata& metadata;
     BOND_STATIC_CONSTEXPR uint16_t id = Id;
 
     static BOND_CONSTEXPR const value_type& GetVariable(const struct_type& obj)
@@ -31,18 +31,23 @@ struct tuple_field
         return std::get<id>(obj);
     }
 
-    static Metadata GetMetadata()
+    static const Metadata& GetMetadata()
     {
-        Metadata m;
-        m.name = "item" + std::to_string(id);
-        return m;
+        static const Metadata s_metadata = []
+        {
+            Metadata m;
+            m.name = "item" + std::to_string(id);
+            return m;
+        }();
+
+        return s_metadata;
     }
 };
 
 using ignore_t = decltype(std::ignore);
 
 template <typename Tuple, uint16_t t_id, typename T>
-const Metadata tuple_field<Tuple, t_id, T>::metadata
+const Metadata& tuple_field<Tuple, t_id, T>::metadata
     = tuple_field<Tuple, t_id, T>::GetMetadata();
 
 
@@ -31,6 +31,10 @@ inline DeserializeElements(nullable<X>& var, const T& element, uint32_t size);
 template <typename Protocols, typename Reader>
 inline void DeserializeElements(blob& var, const value<blob::value_type, Reader&>& element, uint32_t size);
 
+template <typename Protocols, typename T, typename Alloc, typename Reader>
+typename boost::enable_if<detail::is_packed_flat_struct<Reader, T> >::type
+inline DeserializeElements(std::vector<T, Alloc>& var, const value<T, Reader&>& element, uint32_t size);
+
 template <typename Protocols, typename X, typename T>
 typename boost::enable_if_c<is_set_container<X>::value
                          && is_element_matching<T, X>::value>::type
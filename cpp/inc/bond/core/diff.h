@@ -0,0 +1,354 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/double_pass.h"
+#include "detail/tags.h"
+#include "reflection.h"
+#include "transforms.h"
+
+#include <boost/mpl/for_each.hpp>
+#include <boost/ref.hpp>
+
+
+namespace bond
+{
+
+namespace detail
+{
+
+template <typename T, typename Enable = void> struct
+is_struct_list
+    : std::false_type {};
+
+template <typename T> struct
+is_struct_list<T, typename boost::enable_if<is_list_container<T> >::type>
+    : has_schema<typename element_type<T>::type> {};
+
+
+//
+// Differ writes a patch which transforms the original object into the updated
+// one. The patch is a sparse instance of the struct: only fields which differ
+// are written. Nested structs are written as nested patches and lists of
+// structs are written element-wise, with elements past the end of the original
+// list written in full. Other fields are written in full when they differ.
+//
+// The patch must be written with a tagged protocol, since an untagged protocol
+// has no way to express an absent field.
+//
+template <typename T, typename Writer, typename Protocols>
+class Differ
+    : public Serializer<Writer, Protocols>
+{
+public:
+    BOOST_STATIC_ASSERT(has_schema<T>::value);
+    BOOST_STATIC_ASSERT(!uses_static_parser<typename Writer::Reader>::value);
+
+    Differ(const T& original, const T& updated, Writer& output, bool base = false)
+        : Serializer<Writer, Protocols>(output, base),
+          _original(original),
+          _updated(updated)
+    {}
+
+    void Diff() const
+    {
+        _output.WriteStructBegin(schema_metadata<typename schema<T>::type>(), _base);
+        DiffBase();
+        boost::mpl::for_each<typename schema<T>::type::fields>(boost::cref(*this));
+        _output.WriteStructEnd(_base);
+    }
+
+    template <typename FieldT>
+    void operator()(const FieldT&) const
+    {
+        Field(FieldT::id, FieldT::GetMetadata(), FieldT::GetVariable(_original), FieldT::GetVariable(_updated));
+    }
+
+protected:
+    using Serializer<Writer, Protocols>::_output;
+    using Serializer<Writer, Protocols>::_base;
+
+private:
+    template <typename U = T>
+    typename boost::enable_if<has_base<U> >::type
+    DiffBase() const
+    {
+        typedef typename schema<T>::type::base Base;
+
+        // 'true' means that we are writing a base struct
+        Differ<Base, Writer, Protocols>(_original, _updated, _output, true).Diff();
+    }
+
+    template <typename U = T>
+    typename boost::disable_if<has_base<U> >::type
+    DiffBase() const
+    {}
+
+    // struct field is written as a nested patch
+    template <typename X>
+    typename boost::enable_if<has_schema<X> >::type
+    Field(uint16_t id, const Metadata& metadata, const X& original, const X& updated) const
+    {
+        if (original == updated)
+            return;
+
+        _output.WriteFieldBegin(BT_STRUCT, id, metadata);
+        Differ<X, Writer, Protocols>(original, updated, _output).Diff();
+        _output.WriteFieldEnd();
+    }
+
+    // list of structs is written element-wise
+    template <typename X>
+    typename boost::enable_if<is_struct_list<X> >::type
+    Field(uint16_t id, const Metadata& metadata, const X& original, const X& updated) const
+    {
+        typedef typename element_type<X>::type Element;
+
+        if (original == updated)
+            return;
+
+        _output.WriteFieldBegin(BT_LIST, id, metadata);
+        _output.WriteContainerBegin(container_size(updated), BT_STRUCT);
+
+        const_enumerator<X> originals(original);
+
+        for (const_enumerator<X> items(updated); items.more();)
+        {
+            const Element& item = items.next();
+
+            if (originals.more())
+                Differ<Element, Writer, Protocols>(originals.next(), item, _output).Diff();
+            else
+                this->Write(item);
+        }
+
+        _output.WriteContainerEnd();
+        _output.WriteFieldEnd();
+    }
+
+    // other fields are written in full
+    template <typename X>
+    typename boost::disable_if_c<has_schema<X>::value || is_struct_list<X>::value>::type
+    Field(uint16_t id, const Metadata& metadata, const X& original, const X& updated) const
+    {
+        if (!(original == updated))
+            this->WriteField(id, metadata, updated);
+    }
+
+    // bonded<T> compares instances rather than values, so bonded fields are
+    // always written in full
+    template <typename X, typename Reader>
+    void Field(uint16_t id, const Metadata& metadata, const bonded<X, Reader>& /*original*/, const bonded<X, Reader>& updated) const
+    {
+        this->WriteField(id, metadata, updated);
+    }
+
+    // A maybe field which changed to nothing is written as an empty struct,
+    // which Patcher recognizes because it never matches the type of the field.
+    template <typename X>
+    void Field(uint16_t id, const Metadata& metadata, const maybe<X>& original, const maybe<X>& updated) const
+    {
+        BOOST_STATIC_ASSERT_MSG(!has_schema<X>::value, "Struct fields can't have default of nothing");
+
+        if (original == updated)
+            return;
+
+        if (updated.is_nothing())
+        {
+            _output.WriteFieldBegin(BT_STRUCT, id, metadata);
+            this->Write(Void());
+            _output.WriteFieldEnd();
+        }
+        else
+        {
+            this->WriteField(id, metadata, updated.value());
+        }
+    }
+
+    const T& _original;
+    const T& _updated;
+};
+
+
+//
+// Patcher applies a patch written by Differ to an object in place. Fields
+// which are absent in the patch are left unchanged.
+//
+template <typename T, typename Protocols>
+class Patcher
+    : public DeserializingTransform
+{
+public:
+    typedef T FastPathType;
+
+    Patcher(T& var)
+        : _var(var)
+    {}
+
+    void Begin(const Metadata& /*metadata*/) const
+    {}
+
+    void End() const
+    {}
+
+    void UnknownEnd() const
+    {}
+
+    template <typename X>
+    bool Base(const X& value) const
+    {
+        return Apply<Protocols>(Patcher<typename schema<T>::type::base, Protocols>(_var), value);
+    }
+
+    template <typename FieldT, typename X>
+    bool Field(const FieldT&, const X& value) const
+    {
+        Patch<FieldT>(FieldT::GetVariable(_var), value);
+        return false;
+    }
+
+    // Patch fields whose type doesn't match the schema are skipped
+    template <typename X>
+    bool Field(uint16_t /*id*/, const Metadata& /*metadata*/, const X& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename X>
+    bool UnknownField(uint16_t /*id*/, const X& /*value*/) const
+    {
+        return false;
+    }
+
+    // A struct in place of a maybe field resets it to nothing
+    template <typename Reader>
+    bool UnknownField(uint16_t id, const bonded<void, Reader>& /*value*/) const
+    {
+        boost::mpl::for_each<typename schema<T>::type::fields>(NothingSetter(_var, id));
+        return false;
+    }
+
+    template <typename FieldT>
+    bool OmittedField(const FieldT&) const
+    {
+        return false;
+    }
+
+    bool OmittedField(uint16_t /*id*/, const Metadata& /*metadata*/, BondDataType /*type*/) const
+    {
+        return false;
+    }
+
+    // list of structs
+    template <typename X, typename Reader, typename U = T>
+    typename boost::enable_if<std::is_same<X, typename element_type<U>::type> >::type
+    Container(const value<X, Reader>& element, uint32_t size) const
+    {
+        resize_list(_var, size);
+
+        for (enumerator<T> items(_var); items.more();)
+            element.template _Apply<Protocols>(Patcher<X, Protocols>(items.next()));
+    }
+
+    template <typename X>
+    void Container(const X& element, uint32_t size) const
+    {
+        detail::SkipElements(element, size);
+    }
+
+private:
+    class NothingSetter
+    {
+    public:
+        NothingSetter(T& var, uint16_t id)
+            : _var(var),
+              _id(id)
+        {}
+
+        template <typename FieldT>
+        void operator()(const FieldT&) const
+        {
+            if (FieldT::id == _id)
+                SetNothing(FieldT::GetVariable(_var));
+        }
+
+    private:
+        template <typename X>
+        static void SetNothing(maybe<X>& var)
+        {
+            var.set_nothing();
+        }
+
+        template <typename X>
+        static void SetNothing(X& /*var*/)
+        {}
+
+        T& _var;
+        uint16_t _id;
+    };
+
+    template <typename FieldT, typename X>
+    typename boost::enable_if<is_struct_field<FieldT> >::type
+    Patch(typename FieldT::field_type& var, const X& value) const
+    {
+        Apply<Protocols>(Patcher<typename FieldT::field_type, Protocols>(var), value);
+    }
+
+    template <typename FieldT, typename X>
+    typename boost::enable_if<is_struct_list<typename FieldT::field_type> >::type
+    Patch(typename FieldT::field_type& var, const X& value) const
+    {
+        value.template _Apply<Protocols>(Patcher<typename FieldT::field_type, Protocols>(var));
+    }
+
+    template <typename FieldT, typename V, typename X>
+    typename boost::disable_if_c<is_struct_field<FieldT>::value
+                              || is_struct_list<typename FieldT::field_type>::value>::type
+    Patch(V& var, const X& value) const
+    {
+        value.template Deserialize<Protocols>(var);
+    }
+
+    template <typename FieldT, typename V, typename X>
+    void Patch(maybe<V>& var, const X& value) const
+    {
+        value.template Deserialize<Protocols>(var.set_value());
+    }
+
+    T& _var;
+};
+
+
+template <typename Protocols, typename T, typename Writer>
+typename boost::disable_if<need_double_pass<Serializer<Writer, Protocols> > >::type
+inline WriteDiff(const T& original, const T& updated, Writer& output)
+{
+    Differ<T, Writer, Protocols>(original, updated, output).Diff();
+}
+
+
+template <typename Protocols, typename T, typename Writer>
+typename boost::enable_if<need_double_pass<Serializer<Writer, Protocols> > >::type
+inline WriteDiff(const T& original, const T& updated, Writer& output)
+{
+    if (output.NeedPass0())
+    {
+        typename Writer::Pass0::Buffer buffer;
+        typename Writer::Pass0 pass0(buffer, output);
+
+        Differ<T, typename Writer::Pass0, Protocols>(original, updated, pass0).Diff();
+        // The object returned by WithPass0 must outlive the second pass
+        output.WithPass0(pass0), Differ<T, Writer, Protocols>(original, updated, output).Diff();
+    }
+    else
+    {
+        Differ<T, Writer, Protocols>(original, updated, output).Diff();
+    }
+}
+
+} // namespace detail
+
+} // namespace bond
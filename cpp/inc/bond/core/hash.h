@@ -0,0 +1,784 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "bond.h"
+#include "detail/omit_default.h"
+
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bond
+{
+
+namespace detail
+{
+
+// Kinds of normalized values. Integers are widened to 64 bits and floats to
+// double, so that values read with a promoted type digest the same.
+enum digest_kind : uint8_t
+{
+    digest_end,
+    digest_unsigned,
+    digest_signed,
+    digest_floating,
+    digest_string,
+    digest_wstring,
+    digest_bytes,
+    digest_field,
+    digest_base
+};
+
+
+inline uint64_t HashMix(uint64_t h)
+{
+    // Finalizer of MurmurHash3
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb3f93ba11f2dULL;
+    h ^= h >> 33;
+    return h;
+}
+
+
+inline uint64_t HashCombine(uint64_t seed, uint64_t value)
+{
+    // Cheap multiplicative step; members are mixed with HashMix when done
+    return ((seed << 5 | seed >> 59) ^ value) * 0x9e3779b97f4a7c15ULL;
+}
+
+
+// Digest sink computing a 64-bit hash. Ordered members are combined in
+// sequence and unordered members are summed, so that the order of fields,
+// set elements and map entries in the payload doesn't affect the result.
+class HashSink
+{
+public:
+    HashSink()
+        : _ordered(),
+          _unordered()
+    {}
+
+    HashSink Member() const
+    {
+        return HashSink();
+    }
+
+    void Scalar(digest_kind kind, uint64_t value)
+    {
+        _ordered = HashCombine(HashCombine(_ordered, kind), value);
+    }
+
+    void Bytes(digest_kind kind, const void* data, uint32_t size)
+    {
+        const char* p = static_cast<const char*>(data);
+
+        Scalar(kind, size);
+
+        for (; size >= sizeof(uint64_t); p += sizeof(uint64_t), size -= sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            _ordered = HashCombine(_ordered, word);
+        }
+
+        if (size)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, p, size);
+            _ordered = HashCombine(_ordered, word);
+        }
+    }
+
+    void Ordered(const HashSink& member)
+    {
+        _ordered = HashCombine(_ordered, member.value());
+    }
+
+    void Unordered(const HashSink& member)
+    {
+        _unordered += member.value();
+    }
+
+    void Discard(const HashSink& /*member*/)
+    {}
+
+    bool Done() const
+    {
+        return false;
+    }
+
+    uint64_t value() const
+    {
+        return HashMix(HashCombine(_ordered, _unordered));
+    }
+
+private:
+    uint64_t _ordered;
+    uint64_t _unordered;
+};
+
+
+// Buffer shared by the CanonicalSinks digesting one payload
+struct CanonicalBuffer
+{
+    std::string data;
+    std::vector<std::pair<size_t, size_t> > members;
+    std::string temp;
+};
+
+
+// Canonical strings of the base and fields of the root struct of a payload.
+// bond::Equal collects them for one payload and matches the fields of the
+// other payload against them one at a time, as they are digested, so that
+// the canonical string of the other payload is never built as a whole and
+// the remaining fields are skipped after the first mismatch.
+class CanonicalFields
+{
+public:
+    explicit
+    CanonicalFields(CanonicalBuffer& buffer)
+        : _buffer(buffer),
+          _expected(nullptr),
+          _count(0),
+          _max_size(0),
+          _mismatch(false)
+    {}
+
+    CanonicalFields(CanonicalBuffer& buffer, const CanonicalFields& expected)
+        : _buffer(buffer),
+          _expected(&expected),
+          _matched(expected._fields.size()),
+          _count(0),
+          _max_size(0),
+          _mismatch(false)
+    {
+        // Matching fields are no larger than the largest expected one
+        _buffer.data.reserve(expected._max_size);
+    }
+
+    CanonicalBuffer& buffer()
+    {
+        return _buffer;
+    }
+
+    // Adds the member which starts at begin and ends the buffer
+    void Add(size_t begin)
+    {
+        if (!_expected)
+        {
+            _fields.emplace_back(begin, _buffer.data.size());
+            _max_size = (std::max)(_max_size, _buffer.data.size() - begin);
+            return;
+        }
+
+        if (!_mismatch)
+        {
+            _mismatch = !Match(_buffer.data.data() + begin, _buffer.data.size() - begin);
+        }
+
+        _buffer.data.resize(begin);
+    }
+
+    bool mismatch() const
+    {
+        return _mismatch;
+    }
+
+    // True if all the fields matched, i.e. the payloads are equal
+    bool equal() const
+    {
+        return !_mismatch && _count == _matched.size();
+    }
+
+private:
+    bool Match(const char* data, size_t size)
+    {
+        const auto& fields = _expected->_fields;
+        const char* expected = _expected->_buffer.data.data();
+
+        if (_count == fields.size())
+            return false;
+
+        // Fields are usually in the same order in both payloads, so the
+        // field after the last one matched is tried first
+        for (size_t i = _count, n = 0; n != fields.size(); ++n, i = (i + 1) % fields.size())
+        {
+            if (!_matched[i]
+                && fields[i].second - fields[i].first == size
+                && std::memcmp(expected + fields[i].first, data, size) == 0)
+            {
+                _matched[i] = true;
+                ++_count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    CanonicalBuffer& _buffer;
+    const CanonicalFields* _expected;
+    std::vector<std::pair<size_t, size_t> > _fields;
+    std::vector<bool> _matched;
+    size_t _count;
+    size_t _max_size;
+    bool _mismatch;
+};
+
+
+// Digest sink building a canonical byte string in a CanonicalBuffer, so that
+// two payloads are equal if and only if their strings are equal. Values are
+// written as tokens starting with their kind and members are terminated with
+// digest_end, which makes the string self-delimiting. The unordered members
+// of a sink, which must follow its ordered data, are sorted when the sink is
+// finished. Scalars are big-endian so that members written in ascending
+// order, such as fields ordered by id, are usually sorted already. The
+// members of the root sink are passed to CanonicalFields instead.
+class CanonicalSink
+{
+public:
+    explicit
+    CanonicalSink(CanonicalBuffer& buffer, CanonicalFields* fields = nullptr)
+        : _buffer(buffer),
+          _fields(fields),
+          _begin(buffer.data.size()),
+          _members(buffer.members.size())
+    {}
+
+    CanonicalSink Member()
+    {
+        return CanonicalSink(_buffer);
+    }
+
+    void Scalar(digest_kind kind, uint64_t value)
+    {
+        char bytes[1 + sizeof(uint64_t)];
+
+        bytes[0] = static_cast<char>(kind);
+
+        for (size_t i = sizeof(uint64_t); i; --i, value >>= 8)
+            bytes[i] = static_cast<char>(value & 0xff);
+
+        _buffer.data.append(bytes, sizeof(bytes));
+    }
+
+    void Bytes(digest_kind kind, const void* data, uint32_t size)
+    {
+        Scalar(kind, size);
+        _buffer.data.append(static_cast<const char*>(data), size);
+    }
+
+    void Ordered(const CanonicalSink& member)
+    {
+        member.Finish();
+        _buffer.data += static_cast<char>(digest_end);
+
+        if (_fields)
+            _fields->Add(member._begin);
+    }
+
+    void Unordered(const CanonicalSink& member)
+    {
+        Ordered(member);
+
+        if (!_fields)
+            _buffer.members.emplace_back(member._begin, _buffer.data.size());
+    }
+
+    void Discard(const CanonicalSink& member)
+    {
+        _buffer.data.resize(member._begin);
+        _buffer.members.resize(member._members);
+    }
+
+    bool Done() const
+    {
+        return _fields && _fields->mismatch();
+    }
+
+    // Sorts the unordered members
+    void Finish() const
+    {
+        const auto first = _buffer.members.begin() + _members;
+        const auto last = _buffer.members.end();
+
+        if (last - first > 1)
+        {
+            Sort(first, last);
+        }
+
+        _buffer.members.resize(_members);
+    }
+
+private:
+    using iterator = std::vector<std::pair<size_t, size_t> >::iterator;
+
+    void Sort(iterator first, iterator last) const
+    {
+        const char* data = _buffer.data.data();
+
+        const auto less = [data](const std::pair<size_t, size_t>& x, const std::pair<size_t, size_t>& y)
+        {
+            const size_t x_size = x.second - x.first;
+            const size_t y_size = y.second - y.first;
+            const int result = std::memcmp(data + x.first, data + y.first, (std::min)(x_size, y_size));
+
+            return result != 0 ? result < 0 : x_size < y_size;
+        };
+
+        if (std::is_sorted(first, last, less))
+        {
+            return;
+        }
+
+        const size_t begin = first->first;
+
+        std::sort(first, last, less);
+
+        _buffer.temp.clear();
+
+        for (auto it = first; it != last; ++it)
+        {
+            _buffer.temp.append(data + it->first, it->second - it->first);
+        }
+
+        // Unordered members are contiguous at the end of the sink
+        BOOST_ASSERT(_buffer.data.size() - begin == _buffer.temp.size());
+        _buffer.data.replace(begin, _buffer.temp.size(), _buffer.temp);
+    }
+
+    CanonicalBuffer& _buffer;
+    CanonicalFields* _fields;
+    size_t _begin;
+    size_t _members;
+};
+
+
+template <typename T> struct
+is_unordered_container
+    : std::integral_constant<bool,
+        is_set_container<T>::value || is_map_container<T>::value> {};
+
+
+// Buffers reused for the strings read while digesting one payload
+struct DigestScratch
+{
+    std::string str;
+    std::wstring wstr;
+};
+
+
+// Returns true if the value should be skipped: container elements have no
+// default and neither do fields with default of nothing, which are omitted
+// only when they aren't set.
+template <typename X>
+inline bool IsDigestDefault(const X& data, const Metadata* metadata)
+{
+    return metadata
+        && !metadata->default_value.nothing
+        && is_default(data, *metadata);
+}
+
+
+// Digest a value of a basic type; returns false for default values.
+template <typename Sink, typename X, typename Reader>
+typename boost::enable_if_c<std::is_unsigned<X>::value || std::is_same<X, bool>::value, bool>::type
+inline DigestValue(Sink& sink, const value<X, Reader>& value, const Metadata* metadata, DigestScratch& /*scratch*/)
+{
+    X data;
+    value.Deserialize(data);
+
+    if (IsDigestDefault(data, metadata))
+        return false;
+
+    sink.Scalar(digest_unsigned, static_cast<uint64_t>(data));
+    return true;
+}
+
+
+template <typename Sink, typename X, typename Reader>
+typename boost::enable_if_c<(std::is_signed<X>::value && std::is_integral<X>::value)
+                         || std::is_enum<X>::value, bool>::type
+inline DigestValue(Sink& sink, const value<X, Reader>& value, const Metadata* metadata, DigestScratch& /*scratch*/)
+{
+    X data;
+    value.Deserialize(data);
+
+    if (IsDigestDefault(data, metadata))
+        return false;
+
+    sink.Scalar(digest_signed, static_cast<uint64_t>(static_cast<int64_t>(data)));
+    return true;
+}
+
+
+template <typename Sink, typename X, typename Reader>
+typename boost::enable_if<std::is_floating_point<X>, bool>::type
+inline DigestValue(Sink& sink, const value<X, Reader>& value, const Metadata* metadata, DigestScratch& /*scratch*/)
+{
+    X data;
+    value.Deserialize(data);
+
+    if (IsDigestDefault(data, metadata))
+        return false;
+
+    const double wide = data;
+    uint64_t bits;
+    std::memcpy(&bits, &wide, sizeof(bits));
+
+    sink.Scalar(digest_floating, bits);
+    return true;
+}
+
+
+template <typename Sink, typename X, typename Reader>
+typename boost::enable_if<is_string<X>, bool>::type
+inline DigestValue(Sink& sink, const value<X, Reader>& value, const Metadata* metadata, DigestScratch& scratch)
+{
+    value.Deserialize(scratch.str);
+
+    if (IsDigestDefault(scratch.str, metadata))
+        return false;
+
+    sink.Bytes(digest_string, scratch.str.data(), static_cast<uint32_t>(scratch.str.size()));
+    return true;
+}
+
+
+template <typename Sink, typename X, typename Reader>
+typename boost::enable_if<is_wstring<X>, bool>::type
+inline DigestValue(Sink& sink, const value<X, Reader>& value, const Metadata* metadata, DigestScratch& scratch)
+{
+    value.Deserialize(scratch.wstr);
+
+    if (IsDigestDefault(scratch.wstr, metadata))
+        return false;
+
+    // Wide strings are digested as UTF-16, which is how they are serialized
+    scratch.str.resize(scratch.wstr.size() * 2);
+
+    for (size_t i = 0; i != scratch.wstr.size(); ++i)
+    {
+        scratch.str[2 * i] = static_cast<char>(scratch.wstr[i] & 0xff);
+        scratch.str[2 * i + 1] = static_cast<char>((scratch.wstr[i] >> 8) & 0xff);
+    }
+
+    sink.Bytes(digest_wstring, scratch.str.data(), static_cast<uint32_t>(scratch.str.size()));
+    return true;
+}
+
+
+template <typename Sink, typename Protocols>
+class ContainerDigest;
+
+
+// Transform digesting the fields of a struct from a serialized payload.
+//
+// Fields whose value is equal to the default from the schema, including empty
+// containers, don't contribute to the digest, so an omitted optional field
+// digests the same as one explicitly set to its default. Fields with default
+// of nothing, including containers, contribute whenever they are present.
+// Fields that are not in the schema are ignored, and so are the remaining
+// fields once the sink is done.
+template <typename Sink, typename Protocols>
+class StructDigest
+    : public DeserializingTransform
+{
+public:
+    StructDigest(Sink& sink, DigestScratch& scratch)
+        : _sink(sink),
+          _scratch(scratch)
+    {}
+
+    void Begin(const Metadata& /*metadata*/) const
+    {}
+
+    void End() const
+    {}
+
+    void UnknownEnd() const
+    {}
+
+    template <typename X>
+    bool Base(const X& value) const
+    {
+        Sink base = _sink.Member();
+        base.Scalar(digest_base, 0);
+        Apply<Protocols>(StructDigest(base, _scratch), value);
+        _sink.Ordered(base);
+        return false;
+    }
+
+    template <typename X, typename Reader>
+    bool Field(uint16_t id, const Metadata& /*metadata*/, const bonded<X, Reader>& value) const
+    {
+        if (_sink.Done())
+            return false;
+
+        Sink field = FieldSink(id);
+        Apply<Protocols>(StructDigest(field, _scratch), value);
+        _sink.Unordered(field);
+        return false;
+    }
+
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_basic_type<X>, bool>::type
+    Field(uint16_t id, const Metadata& metadata, const value<X, Reader>& value) const
+    {
+        if (_sink.Done())
+            return false;
+
+        Sink field = FieldSink(id);
+
+        if (DigestValue(field, value, &metadata, _scratch))
+            _sink.Unordered(field);
+        else
+            _sink.Discard(field);
+
+        return false;
+    }
+
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_container<X>, bool>::type
+    Field(uint16_t id, const Metadata& metadata, const value<X, Reader>& value) const
+    {
+        if (_sink.Done())
+            return false;
+
+        Sink field = FieldSink(id);
+        bool empty = true;
+
+        value.template _Apply<Protocols>(
+            ContainerDigest<Sink, Protocols>(field, _scratch, is_unordered_container<X>::value, empty));
+
+        if (!empty || metadata.default_value.nothing)
+            _sink.Unordered(field);
+        else
+            _sink.Discard(field);
+
+        return false;
+    }
+
+    // Values of mismatched non-basic types are skipped
+    template <typename Reader>
+    bool Field(uint16_t /*id*/, const Metadata& /*metadata*/, const value<void, Reader>& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename X>
+    bool UnknownField(uint16_t /*id*/, const X& /*value*/) const
+    {
+        return false;
+    }
+
+private:
+    Sink FieldSink(uint16_t id) const
+    {
+        Sink field = _sink.Member();
+        field.Scalar(digest_field, id);
+        return field;
+    }
+
+    Sink& _sink;
+    DigestScratch& _scratch;
+};
+
+
+// Transform digesting the elements of a container from a serialized payload
+template <typename Sink, typename Protocols>
+class ContainerDigest
+    : public DeserializingTransform
+{
+public:
+    ContainerDigest(Sink& sink, DigestScratch& scratch, bool unordered, bool& empty)
+        : _sink(sink),
+          _scratch(scratch),
+          _unordered(unordered),
+          _empty(empty)
+    {}
+
+    template <typename T>
+    void Container(const T& element, uint32_t size) const
+    {
+        _empty = (size == 0);
+
+        while (size--)
+            Item(element);
+    }
+
+    // Lists of int8, including blobs, are digested as a single byte string
+    template <typename Reader>
+    void Container(const value<int8_t, Reader>& element, uint32_t size) const
+    {
+        _empty = (size == 0);
+
+        if (!_unordered)
+        {
+            blob data;
+            element.Deserialize(data, size);
+            _sink.Bytes(digest_bytes, data.content(), data.length());
+            return;
+        }
+
+        while (size--)
+            Item(element);
+    }
+
+    template <typename Key, typename T>
+    void Container(const Key& key, const T& element, uint32_t size) const
+    {
+        _empty = (size == 0);
+
+        while (size--)
+        {
+            Sink item = _sink.Member();
+            Element(item, key);
+            Element(item, element);
+            Add(item);
+        }
+    }
+
+private:
+    // Basic values are self-delimiting, so elements of ordered containers
+    // are digested directly into the container
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_basic_type<X> >::type
+    Item(const value<X, Reader>& element) const
+    {
+        if (_unordered)
+        {
+            Sink item = _sink.Member();
+            DigestValue(item, element, nullptr, _scratch);
+            _sink.Unordered(item);
+        }
+        else
+        {
+            DigestValue(_sink, element, nullptr, _scratch);
+        }
+    }
+
+    template <typename T>
+    void Item(const T& element) const
+    {
+        Sink item = _sink.Member();
+        Element(item, element);
+        Add(item);
+    }
+
+    void Add(const Sink& item) const
+    {
+        if (_unordered)
+            _sink.Unordered(item);
+        else
+            _sink.Ordered(item);
+    }
+
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_basic_type<X> >::type
+    Element(Sink& sink, const value<X, Reader>& element) const
+    {
+        DigestValue(sink, element, nullptr, _scratch);
+    }
+
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_bond_type<X> >::type
+    Element(Sink& sink, const value<X, Reader>& element) const
+    {
+        element.template _Apply<Protocols>(StructDigest<Sink, Protocols>(sink, _scratch));
+    }
+
+    template <typename X, typename Reader>
+    typename boost::enable_if<is_container<X> >::type
+    Element(Sink& sink, const value<X, Reader>& element) const
+    {
+        bool empty;
+        element.template _Apply<Protocols>(
+            ContainerDigest(sink, _scratch, is_unordered_container<X>::value, empty));
+    }
+
+    // Elements of mismatched non-basic types are skipped
+    template <typename Reader>
+    void Element(Sink& /*sink*/, const value<void, Reader>& element) const
+    {
+        element.Skip();
+    }
+
+    Sink& _sink;
+    DigestScratch& _scratch;
+    const bool _unordered;
+    bool& _empty;
+};
+
+
+template <typename Protocols, typename Sink, typename T, typename Reader>
+inline void Digest(Sink& sink, const bonded<T, Reader>& value)
+{
+    BOOST_STATIC_ASSERT(has_schema<T>::value);
+
+    DigestScratch scratch;
+
+    Apply<Protocols>(StructDigest<Sink, Protocols>(sink, scratch), value);
+}
+
+
+template <typename Protocols, typename T, typename Reader>
+inline void Canonical(CanonicalFields& fields, const bonded<T, Reader>& value)
+{
+    CanonicalSink sink(fields.buffer(), &fields);
+
+    Digest<Protocols>(sink, value);
+}
+
+} // namespace detail
+
+
+/// @brief Compute a hash of a struct from its serialized payload
+///
+/// The payload is parsed without deserializing an object. The hash depends
+/// only on the values of the fields of T: an optional field set to its
+/// default value hashes the same as an omitted one, and the order of the
+/// elements of sets and maps in the payload doesn't matter. Fields which are
+/// not in the schema of T are ignored. The hash is meant for in-memory use
+/// and may change between versions of Bond.
+template <typename Protocols = BuiltInProtocols, typename T, typename Reader>
+inline uint64_t Hash(const bonded<T, Reader>& value)
+{
+    detail::HashSink sink;
+
+    detail::Digest<Protocols>(sink, value);
+    return sink.value();
+}
+
+
+/// @brief Compare two serialized payloads of a struct for equality
+///
+/// The payloads are equal if they represent the same values of the fields of
+/// T, with the same rules as bond::Hash. Equal payloads have equal hashes.
+/// The fields of y are compared with those of x one at a time, and the
+/// comparison stops digesting y at the first field which doesn't match.
+template <typename Protocols = BuiltInProtocols, typename T, typename Reader1, typename Reader2>
+inline bool Equal(const bonded<T, Reader1>& x, const bonded<T, Reader2>& y)
+{
+    detail::CanonicalBuffer bx, by;
+
+    detail::CanonicalFields fx(bx);
+    detail::Canonical<Protocols>(fx, x);
+
+    detail::CanonicalFields fy(by, fx);
+    detail::Canonical<Protocols>(fy, y);
+
+    return fy.equal();
+}
+
+} // namespace bond
@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "blob.h"
+#include "detail/checked.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace bond
+{
+
+namespace detail
+{
+
+// Reference counted memory buffer of local_blob. The reference count is not
+// atomic. The memory either follows the header in the same allocation or is
+// owned by a boost::shared_ptr, when the buffer was created from a blob.
+class local_blob_buffer
+{
+public:
+    static local_blob_buffer* allocate(uint32_t length)
+    {
+        void* memory = ::operator new(detail::checked_add(sizeof(local_blob_buffer), length));
+
+        return new (memory) local_blob_buffer();
+    }
+
+    static local_blob_buffer* wrap(const boost::shared_ptr<const char[]>& buffer)
+    {
+        local_blob_buffer* result = allocate(0);
+
+        result->_keeper = buffer;
+        return result;
+    }
+
+    void add_ref()
+    {
+        ++_refs;
+    }
+
+    void release()
+    {
+        if (--_refs == 0)
+        {
+            destroy();
+        }
+    }
+
+    char* data()
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+
+    const boost::shared_ptr<const char[]>& keeper() const
+    {
+        return _keeper;
+    }
+
+private:
+    local_blob_buffer()
+        : _refs(1)
+    {}
+
+    ~local_blob_buffer() = default;
+
+    // Kept out of line so that release() stays small when inlined
+    BOND_NO_INLINE void destroy()
+    {
+        this->~local_blob_buffer();
+        ::operator delete(this);
+    }
+
+    uint32_t _refs;
+    boost::shared_ptr<const char[]> _keeper;
+};
+
+} // namespace detail
+
+
+class local_blob;
+
+namespace detail
+{
+
+template <typename A>
+void append_local_blobs(std::vector<local_blob, A>& buffers, const blob* begin, const blob* end);
+
+blob share_blob(const local_blob& src);
+
+} // namespace detail
+
+
+/// @brief Memory blob with a non-atomic reference count
+///
+/// local_blob has the same interface as blob, but copies of it update the
+/// reference count of the memory buffer without atomic operations. A
+/// local_blob and all its copies and ranges must be used from one thread at
+/// a time. Use LocalInputBuffer to deserialize from a local_blob.
+class local_blob
+{
+public:
+    typedef int8_t value_type;
+    typedef const char* const_iterator;
+
+    /// @brief Default constructor
+    local_blob()
+        : _buffer(),
+          _content(),
+          _length()
+    {}
+
+    /// @brief Construct from a raw pointer to memory buffer
+    ///
+    /// Not recommended because of buffer lifetime management.
+    local_blob(const void* content, uint32_t length)
+        : _buffer(),
+          _content(static_cast<const char*>(content)),
+          _length(length)
+    {
+        bond::detail::checked_add(_content, length);
+    }
+
+    /// @brief Construct with a copy of the content of a memory buffer
+    static local_blob copy(const void* content, uint32_t length)
+    {
+        local_blob result;
+
+        if (length)
+        {
+            result._buffer = detail::local_blob_buffer::allocate(length);
+            result._content = result._buffer->data();
+            result._length = length;
+            std::memcpy(result._buffer->data(), content, length);
+        }
+
+        return result;
+    }
+
+    /// @brief Construct from a boost::shared_ptr to const memory buffer
+    local_blob(const boost::shared_ptr<const char[]>& buffer, uint32_t offset, uint32_t length)
+        : _buffer(detail::local_blob_buffer::wrap(buffer)),
+          _content(bond::detail::checked_add(buffer.get(), offset)),
+          _length(length)
+    {
+        bond::detail::checked_add(_content, length);
+    }
+
+    /// @brief Construct from a boost::shared_ptr to memory buffer
+    local_blob(const boost::shared_ptr<char[]>& buffer, uint32_t offset, uint32_t length)
+        : local_blob(boost::shared_ptr<const char[]>(buffer), offset, length)
+    {}
+
+    /// @brief Construct from a blob, sharing its memory
+    ///
+    /// The reference count of the blob's memory is updated atomically once.
+    local_blob(const blob& from)
+        : _buffer(from._buffer ? detail::local_blob_buffer::wrap(from._buffer) : nullptr),
+          _content(from._content),
+          _length(from._length)
+    {}
+
+    local_blob(const local_blob& that)
+        : _buffer(that._buffer),
+          _content(that._content),
+          _length(that._length)
+    {
+        if (_buffer)
+        {
+            _buffer->add_ref();
+        }
+    }
+
+    local_blob(local_blob&& that) BOND_NOEXCEPT
+        : _buffer(that._buffer),
+          _content(that._content),
+          _length(that._length)
+    {
+        that._buffer = nullptr;
+        that._content = nullptr;
+        that._length = 0;
+    }
+
+    local_blob& operator=(const local_blob& that)
+    {
+        local_blob temp(that);
+
+        swap(temp);
+        return *this;
+    }
+
+    local_blob& operator=(local_blob&& that) BOND_NOEXCEPT
+    {
+        local_blob temp(std::move(that));
+
+        swap(temp);
+        return *this;
+    }
+
+    ~local_blob()
+    {
+        if (_buffer)
+        {
+            _buffer->release();
+        }
+    }
+
+    /// @brief Assign a new value from another local_blob object or its part
+    void assign(const local_blob& from, uint32_t offset, uint32_t length)
+    {
+        *this = from.range(offset, length);
+    }
+
+    /// @brief Return a local_blob object for a range of this object
+    local_blob range(uint32_t offset, uint32_t length) const
+    {
+        if (bond::detail::checked_add(offset, length) > _length)
+        {
+            throw std::invalid_argument("Total of offset and length too large; must be less than or equal to length of blob");
+        }
+
+        local_blob temp(*this);
+        temp._content += offset;
+        temp._length = length;
+
+        return temp;
+    }
+
+    /// @brief Return a local_blob object for a range from the specified
+    /// offset to the end of the buffer
+    local_blob range(uint32_t offset) const
+    {
+        if (offset > _length)
+        {
+            throw std::invalid_argument("Offset too large; must be less than or equal to length of blob");
+        }
+
+        local_blob temp(*this);
+        temp._content += offset;
+        temp._length -= offset;
+
+        return temp;
+    }
+
+    /// @brief Swap with another local_blob
+    void swap(local_blob& src)
+    {
+        std::swap(_buffer, src._buffer);
+        std::swap(_content, src._content);
+        std::swap(_length, src._length);
+    }
+
+    /// @brief Clear reference to the underlying memory buffer and reset the
+    /// local_blob to empty
+    void clear()
+    {
+        local_blob temp;
+
+        swap(temp);
+    }
+
+    /// @brief Pointer to the content
+    const char* content() const
+    {
+        return _content;
+    }
+
+    /// @brief Void pointer to the content
+    const void* data() const
+    {
+        return _content;
+    }
+
+    /// @brief Length of the content
+    uint32_t length() const
+    {
+        return _length;
+    }
+
+    /// @brief Length of the content
+    uint32_t size() const
+    {
+        return _length;
+    }
+
+    /// @brief Check if the local_blob is empty
+    bool empty() const
+    {
+        return 0 == length();
+    }
+
+    bool operator==(const local_blob& src) const
+    {
+        return this == &src
+               || ((_length == src._length)
+                   && (0 == ::memcmp(_content, src._content, _length)));
+    }
+
+    /// @brief Iterator for the beginning of the local_blob
+    const_iterator begin() const
+    {
+        return _content;
+    }
+
+    /// @brief Iterator for the end of the local_blob
+    const_iterator end() const
+    {
+        return _content + _length;
+    }
+
+private:
+    template <typename A>
+    friend void detail::append_local_blobs(std::vector<local_blob, A>& buffers, const blob* begin, const blob* end);
+
+    friend blob detail::share_blob(const local_blob& src);
+
+    // Shares the memory buffer of a local_blob constructed from a blob with
+    // the same memory
+    local_blob(const blob& from, const local_blob& other)
+        : _buffer(other._buffer),
+          _content(from._content),
+          _length(from._length)
+    {
+        _buffer->add_ref();
+    }
+
+    bool shares_memory(const blob& from) const
+    {
+        return _buffer && from._buffer && _buffer->keeper() == from._buffer;
+    }
+
+    detail::local_blob_buffer* _buffer;
+
+    const char* _content;
+
+    uint32_t _length;
+};
+
+/// @brief Swap two local_blobs
+inline void swap(local_blob& src, local_blob& dst)
+{
+    src.swap(dst);
+}
+
+inline bool operator != (const local_blob& x, const local_blob& y)
+{
+    return !(x == y);
+}
+
+/// @brief Returns a blob with a copy of the content of a local_blob
+///
+/// The content is copied because the blob may be released on another thread.
+template <typename A>
+inline blob blob_copy(const local_blob& src, const A& allocator)
+{
+    if (src.empty())
+    {
+        return blob();
+    }
+
+    boost::shared_ptr<char[]> buffer = boost::allocate_shared_noinit<char[]>(allocator, src.length());
+    ::memcpy(buffer.get(), src.content(), src.length());
+    return blob(buffer, src.length());
+}
+
+inline blob blob_copy(const local_blob& src)
+{
+    return blob_copy(src, std::allocator<char>());
+}
+
+
+namespace detail
+{
+
+// Appends local_blobs for a sequence of blobs. A memory buffer shared with
+// one of the two previous blobs is only wrapped once, which covers chained
+// blobs interleaved with ranges of the same buffer of an output stream.
+template <typename A>
+inline void append_local_blobs(std::vector<local_blob, A>& buffers, const blob* begin, const blob* end)
+{
+    for (; begin != end; ++begin)
+    {
+        const std::size_t size = buffers.size();
+
+        if (size > 0 && buffers[size - 1].shares_memory(*begin))
+        {
+            buffers.push_back(local_blob(*begin, buffers[size - 1]));
+        }
+        else if (size > 1 && buffers[size - 2].shares_memory(*begin))
+        {
+            buffers.push_back(local_blob(*begin, buffers[size - 2]));
+        }
+        else
+        {
+            buffers.push_back(local_blob(*begin));
+        }
+    }
+}
+
+
+// Returns a blob sharing the memory of a local_blob, which is only possible
+// when the memory is owned by a boost::shared_ptr, or an empty blob
+inline blob share_blob(const local_blob& src)
+{
+    if (!src._buffer || !src._buffer->keeper())
+    {
+        return blob();
+    }
+
+    const boost::shared_ptr<const char[]>& keeper = src._buffer->keeper();
+
+    return blob(keeper, static_cast<uint32_t>(src._content - keeper.get()), src._length);
+}
+
+} // namespace detail
+
+} // namespace bond
@@ -53,7 +53,7 @@ public:
                              || is_struct_container_field<FieldT>::value, bool>::type
     Field(const FieldT&, const X& value) const
     {
-        _output.WriteFieldBegin(GetTypeId(value), FieldT::id, FieldT::metadata);
+        _output.WriteFieldBegin(GetTypeId(value), FieldT::id, FieldT::GetMetadata());
         Merge(FieldT::GetVariable(_var), value);
         _output.WriteFieldEnd();
         return false;
@@ -65,14 +65,14 @@ public:
                               || is_struct_container_field<FieldT>::value, bool>::type
     Field(const FieldT&, const X&) const
     {
-        return this->Field(FieldT::id, FieldT::metadata, FieldT::GetVariable(_var));
+        return this->Field(FieldT::id, FieldT::GetMetadata(), FieldT::GetVariable(_var));
     }
 
 
     template <typename FieldT>
     bool OmittedField(const FieldT&) const
     {
-        return this->Field(FieldT::id, FieldT::metadata, FieldT::GetVariable(_var));
+        return this->Field(FieldT::id, FieldT::GetMetadata(), FieldT::GetVariable(_var));
     }
 
 
@@ -0,0 +1,519 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "bond.h"
+#include "exception.h"
+
+#include <bond/stream/output_buffer.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace bond
+{
+
+#ifdef BOND_DOXYGEN_ONLY
+/// @brief The interface that an executor used for parallel (de)serialization
+/// must implement.
+class executor
+{
+    /// @brief Schedules a task for execution, e.g. on a thread pool.
+    ///
+    /// @warning Every scheduled task must be executed eventually; the
+    /// calling thread blocks until all of them complete.
+    ///
+    /// @param task functor object to be executed.
+    void operator()(const std::function<void()>& task) const;
+};
+#endif
+
+
+/// @brief Options for parallel (de)serialization of large containers
+struct parallel_options
+{
+    parallel_options(uint32_t min_size = 16 * 1024, uint32_t chunk_size = 4 * 1024)
+        : min_size(min_size),
+          chunk_size(chunk_size)
+    {}
+
+    /// @brief Containers with fewer elements are processed on the calling thread
+    uint32_t min_size;
+
+    /// @brief Number of elements processed by a single task
+    uint32_t chunk_size;
+};
+
+
+namespace detail
+{
+
+// Runs tasks on an executor and waits for all of them to complete. The first
+// exception thrown by a task is rethrown on the calling thread.
+class ParallelTasks
+    : boost::noncopyable
+{
+public:
+    ParallelTasks()
+        : _pending(0)
+    {}
+
+    ~ParallelTasks()
+    {
+        Wait(std::nothrow);
+    }
+
+    template <typename Executor>
+    void Run(const Executor& executor, const std::function<void()>& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            ++_pending;
+        }
+
+        try
+        {
+            executor([this, task]
+            {
+                Complete(task);
+            });
+        }
+        catch (...)
+        {
+            Done(std::current_exception());
+            throw;
+        }
+    }
+
+    void Wait()
+    {
+        Wait(std::nothrow);
+
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+private:
+    void Wait(const std::nothrow_t&) BOND_NOEXCEPT
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _done.wait(lock, [this] { return _pending == 0; });
+    }
+
+    void Complete(const std::function<void()>& task) BOND_NOEXCEPT
+    {
+        std::exception_ptr error;
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        Done(error);
+    }
+
+    void Done(const std::exception_ptr& error) BOND_NOEXCEPT
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (error && !_error)
+            _error = error;
+
+        if (--_pending == 0)
+            _done.notify_all();
+    }
+
+    std::mutex _lock;
+    std::condition_variable _done;
+    uint32_t _pending;
+    std::exception_ptr _error;
+};
+
+
+template <typename T> struct
+is_struct_vector
+    : std::false_type {};
+
+template <typename T, typename Alloc> struct
+is_struct_vector<std::vector<T, Alloc> >
+    : has_schema<T> {};
+
+
+// Deserialize a vector of structs by splitting it into chunks of elements
+// which are deserialized concurrently. The boundaries of the chunks are found
+// by skipping elements, which for Compact Binary v2 only requires reading the
+// length prefix of each element. The chunks are read from copies of the
+// reader, so this requires a random access input buffer.
+template <typename Protocols, typename T, typename Alloc, typename Reader, typename Executor>
+inline void DeserializeElementsParallel(std::vector<T, Alloc>& var, Reader& input, uint32_t size,
+                                        const Executor& executor, const parallel_options& options)
+{
+    const uint32_t chunk_size = (std::max)(options.chunk_size, 1u);
+
+    resize_list(var, size);
+
+    // Readers positioned at the first element of each chunk
+    std::vector<Reader> chunks;
+    chunks.reserve(size / chunk_size + 1);
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        if (i % chunk_size == 0)
+            chunks.push_back(input);
+
+        bond::Skip<T>(input);
+    }
+
+    ParallelTasks tasks;
+
+    for (size_t i = 1; i < chunks.size(); ++i)
+    {
+        const uint32_t begin = static_cast<uint32_t>(i) * chunk_size;
+        const uint32_t end = (std::min)(size, begin + chunk_size);
+
+        tasks.Run(executor, [&var, &chunks, i, begin, end]
+        {
+            for (uint32_t j = begin; j < end; ++j)
+                Apply<Protocols>(bond::To<T, Protocols>(var[j]), bonded<T, Reader&>(chunks[i]));
+        });
+    }
+
+    // The first chunk is deserialized on the calling thread
+    for (uint32_t j = 0; j < (std::min)(size, chunk_size); ++j)
+        Apply<Protocols>(bond::To<T, Protocols>(var[j]), bonded<T, Reader&>(chunks[0]));
+
+    tasks.Wait();
+}
+
+
+template <typename Protocols, typename T, typename Alloc, typename Reader, typename Executor>
+inline void DeserializeContainerParallel(std::vector<T, Alloc>& var, Reader& input,
+                                         const Executor& executor, const parallel_options& options)
+{
+    BondDataType type = BT_STRUCT;
+    uint32_t     size;
+
+    input.ReadContainerBegin(size, type);
+
+    if (type != BT_STRUCT)
+    {
+        detail::SkipElements(type, input, size);
+    }
+    else if (size < options.min_size
+        || !is_random_access_buffer<typename Reader::Buffer>::value)
+    {
+        DeserializeElements<Protocols>(var, value<T, Reader&>(input, false), size);
+    }
+    else
+    {
+        DeserializeElementsParallel<Protocols>(var, input, size, executor, options);
+    }
+
+    input.ReadContainerEnd();
+}
+
+
+//
+// ParallelTo<T> deserializes an instance of T like To<T>, except that vectors
+// of structs with at least parallel_options::min_size elements are
+// deserialized concurrently using the executor. Vectors in nested structs and
+// base structs are also deserialized concurrently.
+//
+template <typename T, typename Protocols, typename Executor>
+class ParallelTo
+    : public bond::To<T, Protocols>
+{
+public:
+    ParallelTo(T& var, const Executor& executor, const parallel_options& options)
+        : bond::To<T, Protocols>(var),
+          _var(var),
+          _executor(executor),
+          _options(options)
+    {}
+
+    using bond::To<T, Protocols>::Field;
+
+    template <typename X>
+    bool Base(const X& value) const
+    {
+        return AssignToBase(value);
+    }
+
+    // struct field
+    template <typename FieldT, typename X, typename Reader>
+    typename boost::enable_if<is_struct_field<FieldT>, bool>::type
+    Field(const FieldT&, const bonded<X, Reader>& value) const
+    {
+        this->template Validate<FieldT>();
+        Apply<Protocols>(ParallelTo<X, Protocols, Executor>(FieldT::GetVariable(_var), _executor, _options), value);
+        return false;
+    }
+
+    // vector of structs
+    template <typename FieldT, typename X, typename Reader>
+    typename boost::enable_if_c<is_struct_vector<X>::value
+                             && std::is_same<X, typename FieldT::value_type>::value
+                             && !uses_dom_parser<typename std::remove_reference<Reader>::type>::value, bool>::type
+    Field(const FieldT&, const value<X, Reader>& value) const
+    {
+        this->template Validate<FieldT>();
+        DeserializeContainerParallel<Protocols>(FieldT::GetVariable(_var), value._Input(), _executor, _options);
+        return false;
+    }
+
+private:
+    template <typename X, typename U = T>
+    typename boost::enable_if<has_base<U>, bool>::type
+    AssignToBase(const X& value) const
+    {
+        typedef typename schema<T>::type::base Base;
+
+        if (Apply<Protocols>(ParallelTo<Base, Protocols, Executor>(_var, _executor, _options), value))
+        {
+            BOND_THROW(CoreException,
+                "De-serialization failed: unexpected struct stop encountered for "
+                << schema<T>::type::GetMetadata().qualified_name);
+        }
+
+        return false;
+    }
+
+    template <typename X, typename U = T>
+    typename boost::disable_if<has_base<U>, bool>::type
+    AssignToBase(const X& /*value*/) const
+    {
+        return false;
+    }
+
+    T& _var;
+    const Executor& _executor;
+    const parallel_options& _options;
+};
+
+
+// Serialize a range of elements into a separate buffer, using the same
+// protocol and version as the output writer.
+template <typename Protocols, typename Writer, typename T>
+typename boost::enable_if<protocol_has_multiple_versions<typename Writer::Reader> >::type
+inline SerializeElements(const T* begin, const T* end, OutputBuffer& output, uint16_t version)
+{
+    typename get_protocol_writer<typename Writer::Reader, OutputBuffer>::type writer(output, version);
+
+    for (; begin != end; ++begin)
+        bond::Serialize<Protocols>(*begin, writer);
+}
+
+
+template <typename Protocols, typename Writer, typename T>
+typename boost::disable_if<protocol_has_multiple_versions<typename Writer::Reader> >::type
+inline SerializeElements(const T* begin, const T* end, OutputBuffer& output, uint16_t /*version*/)
+{
+    typename get_protocol_writer<typename Writer::Reader, OutputBuffer>::type writer(output);
+
+    for (; begin != end; ++begin)
+        bond::Serialize<Protocols>(*begin, writer);
+}
+
+
+// Serialized elements of the large vectors in an object. With double-pass
+// serialization both passes visit the vectors in the same order; each vector
+// is serialized during the first pass which reaches it and the buffers are
+// reused by the other one.
+struct ParallelSerializerState
+    : boost::noncopyable
+{
+    explicit ParallelSerializerState(uint16_t version)
+        : version(version),
+          pass0(0),
+          pass1(0)
+    {}
+
+    const uint16_t version;
+    std::vector<std::vector<blob> > vectors;
+    size_t pass0;
+    size_t pass1;
+};
+
+
+//
+// ParallelSerializer<Writer> serializes an object like Serializer<Writer>,
+// except that vectors of structs with at least parallel_options::min_size
+// elements are split into chunks which are serialized concurrently into
+// separate buffers. The buffers are then chained into the output without
+// copying. For Compact Binary v2 the first pass only counts the size of the
+// buffers, so the length of enclosing structs is computed correctly.
+//
+template <typename Writer, typename Protocols, typename Executor>
+class ParallelSerializer
+    : public Serializer<Writer, Protocols>
+{
+public:
+    ParallelSerializer(Writer& output, ParallelSerializerState& state, size_t& cursor,
+                       const Executor& executor, const parallel_options& options, bool base = false)
+        : Serializer<Writer, Protocols>(output, base),
+          _state(state),
+          _cursor(cursor),
+          _executor(executor),
+          _options(options)
+    {}
+
+    template <typename Pass0>
+    ParallelSerializer<Pass0, Protocols, Executor> Rebind(Pass0& pass0) const
+    {
+        return ParallelSerializer<Pass0, Protocols, Executor>(pass0, _state, _state.pass0, _executor, _options);
+    }
+
+    template <typename T>
+    bool Base(const T& value) const
+    {
+        // 'true' means that we are writing a base struct
+        Apply<Protocols>(ParallelSerializer(_output, _state, _cursor, _executor, _options, true), value);
+        return false;
+    }
+
+    template <typename T>
+    bool Field(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        return ParallelField(id, metadata, value);
+    }
+
+protected:
+    using Serializer<Writer, Protocols>::_output;
+
+private:
+    // struct field
+    template <typename T>
+    typename boost::enable_if<has_schema<T>, bool>::type
+    ParallelField(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        _output.WriteFieldBegin(BT_STRUCT, id, metadata);
+        Apply<Protocols>(ParallelSerializer(_output, _state, _cursor, _executor, _options), value);
+        _output.WriteFieldEnd();
+        return false;
+    }
+
+    // vector of structs
+    template <typename T, typename Alloc>
+    typename boost::enable_if_c<has_schema<T>::value
+                             && !uses_dom_parser<typename Writer::Reader>::value, bool>::type
+    ParallelField(uint16_t id, const Metadata& metadata, const std::vector<T, Alloc>& value) const
+    {
+        if (value.empty() || value.size() < _options.min_size)
+            return Serializer<Writer, Protocols>::Field(id, metadata, value);
+
+        if (_cursor == _state.vectors.size())
+            _state.vectors.push_back(SerializeVector(value));
+
+        _output.WriteFieldBegin(BT_LIST, id, metadata);
+        _output.WriteContainerBegin(container_size(value), BT_STRUCT);
+
+        for (const blob& buffer : _state.vectors[_cursor++])
+            _output.GetBuffer().Write(buffer);
+
+        _output.WriteContainerEnd();
+        _output.WriteFieldEnd();
+        return false;
+    }
+
+    template <typename T>
+    typename boost::disable_if<has_schema<T>, bool>::type
+    ParallelField(uint16_t id, const Metadata& metadata, const T& value) const
+    {
+        return Serializer<Writer, Protocols>::Field(id, metadata, value);
+    }
+
+    template <typename T, typename Alloc>
+    std::vector<blob> SerializeVector(const std::vector<T, Alloc>& var) const
+    {
+        const uint32_t size = container_size(var);
+        const uint32_t chunk_size = (std::max)(_options.chunk_size, 1u);
+        const uint16_t version = _state.version;
+
+        // Buffers for each chunk of elements
+        std::vector<std::vector<blob> > chunks((size - 1) / chunk_size + 1);
+
+        auto serialize = [&var, &chunks, size, chunk_size, version](size_t i)
+        {
+            const uint32_t begin = static_cast<uint32_t>(i) * chunk_size;
+            const uint32_t end = (std::min)(size, begin + chunk_size);
+
+            OutputBuffer output;
+            SerializeElements<Protocols, Writer>(var.data() + begin, var.data() + end, output, version);
+            output.GetBuffers(chunks[i]);
+        };
+
+        {
+            ParallelTasks tasks;
+
+            for (size_t i = 1; i < chunks.size(); ++i)
+                tasks.Run(_executor, std::bind(serialize, i));
+
+            // The first chunk is serialized on the calling thread
+            serialize(0);
+
+            tasks.Wait();
+        }
+
+        std::vector<blob> buffers;
+
+        for (const std::vector<blob>& chunk : chunks)
+            buffers.insert(buffers.end(), chunk.begin(), chunk.end());
+
+        return buffers;
+    }
+
+    ParallelSerializerState& _state;
+    size_t& _cursor;
+    const Executor& _executor;
+    const parallel_options& _options;
+};
+
+} // namespace detail
+
+
+/// @brief Deserialize an object from a protocol reader, deserializing large
+/// vectors of structs concurrently using the specified executor
+///
+/// The executor must be callable with a `std::function<void()>` task. Tasks
+/// may run on any thread; the call returns once all of them have completed.
+/// Readers over input buffers that aren't random access, see
+/// bond::is_random_access_buffer, deserialize serially.
+template <typename Protocols = BuiltInProtocols, typename Reader, typename T, typename Executor>
+inline void DeserializeParallel(Reader input, T& obj, const Executor& executor,
+                                const parallel_options& options = parallel_options())
+{
+    Apply<Protocols>(detail::ParallelTo<T, Protocols, Executor>(obj, executor, options), bonded<T, Reader&>(input));
+}
+
+
+/// @brief Serialize an object using a protocol writer, serializing large
+/// vectors of structs concurrently using the specified executor
+///
+/// Chunks of elements are serialized into separate buffers which are chained
+/// into the output without copying. The output must be the same as that of
+/// bond::Serialize.
+template <typename Protocols = BuiltInProtocols, typename T, typename Writer, typename Executor>
+inline void SerializeParallel(const T& obj, Writer& output, const Executor& executor,
+                              const parallel_options& options = parallel_options())
+{
+    detail::ParallelSerializerState state(detail::WriterVersion(output));
+
+    Apply<Protocols>(detail::ParallelSerializer<Writer, Protocols, Executor>(
+        output, state, state.pass1, executor, options), obj);
+}
+
+} // namespace bond
@@ -274,7 +274,7 @@ private:
                 // Unknown field or non-exact type match
                 UnknownFieldOrTypeMismatch<is_basic_type<typename Head::field_type>::value>(
                     Head::id,
-                    Head::metadata,
+                    Head::GetMetadata(),
                     id,
                     type,
                     transform);
@@ -306,6 +306,72 @@ private:
     }
 
 
+    // Same as Apply using compile-time schema, except that the fields of the
+    // struct are read by calling readField(id, type) for each field in the
+    // payload. Used by the parsers generated by gbc with --direct-codecs,
+    // which dispatch on the field id with a switch statement.
+    template <typename Schema, typename Transform, typename ReadField>
+    bool
+    DirectApply(const Transform& transform, const Schema&, const ReadField& readField)
+    {
+        detail::StructBegin(_input, _base);
+
+        transform.Begin(Schema::GetMetadata());
+
+        bool done = this->ReadBase(base_class<Schema>(), transform);
+
+        if (!done)
+        {
+            uint16_t     id;
+            BondDataType type;
+
+            for (_input.ReadFieldBegin(type, id);
+                 type != bond::BT_STOP && type != bond::BT_STOP_BASE;
+                 ReadSubsequentField(type, id))
+            {
+                readField(id, type);
+            }
+
+            if (!_base)
+            {
+                ReadUnknownFields(type, id, transform);
+            }
+            else
+            {
+                done = (type == bond::BT_STOP);
+            }
+
+            _input.ReadFieldEnd();
+        }
+
+        transform.End();
+
+        detail::StructEnd(_input, _base);
+
+        return done;
+    }
+
+
+    template <typename Field, typename Transform>
+    void
+    DirectField(const Field&, BondDataType type, const Transform& transform)
+    {
+        if (get_type_id<typename Field::field_type>::value == type)
+        {
+            detail::NonBasicTypeField(Field(), transform, _input);
+        }
+        else
+        {
+            UnknownFieldOrTypeMismatch<is_basic_type<typename Field::field_type>::value>(
+                Field::id,
+                Field::GetMetadata(),
+                Field::id,
+                type,
+                transform);
+        }
+    }
+
+
     // This function is called only when payload has unknown field id or type is not
     // matching exactly. This relativly rare so we don't inline the function to help
     // the compiler to optimize the common path.
@@ -412,7 +478,7 @@ private:
         else if (type == bond::BT_LIST || type == bond::BT_SET || type == bond::BT_MAP)
             return transform.UnknownField(id, value<void, Input>(_input, type));
         else
-            return detail::BasicTypeField(id, schema<Unknown>::type::metadata, type, BindUnknownField(transform), _input);
+            return detail::BasicTypeField(id, schema<Unknown>::type::GetMetadata(), type, BindUnknownField(transform), _input);
     }
 
 
@@ -468,7 +534,7 @@ private:
 
         if (const typename Reader::Field* field = _input.FindField(
                 Head::id,
-                Head::metadata,
+                Head::GetMetadata(),
                 get_type_id<typename Head::field_type>::value,
                 std::is_enum<typename Head::field_type>::value))
         {
@@ -0,0 +1,667 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "blob_string.h"
+#include "detail/inheritance.h"
+#include "exception.h"
+#include "reflection.h"
+#include "runtime_schema.h"
+
+#include <boost/utility/string_ref.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace bond
+{
+
+/// @brief Reference to a field in predicates of \ref record_filter
+struct filter_field
+{
+    /// @brief Number of base structs of the struct declaring the field
+    uint16_t depth;
+    uint16_t id;
+    BondDataType type;
+    Variant default_value;
+};
+
+
+/// @brief Reference to a field of a struct with compile-time schema, e.g.
+/// bond::FilterField<T::Schema::var::field>()
+template <typename Field>
+inline filter_field FilterField()
+{
+    filter_field field;
+
+    field.depth = detail::hierarchy_depth<typename schema<typename Field::struct_type>::type>::value - 1;
+    field.id = Field::id;
+    field.type = get_type_id<typename Field::field_type>::value;
+    field.default_value = Field::GetMetadata().default_value;
+
+    return field;
+}
+
+
+/// @brief Reference to a field of a struct with runtime schema, by name.
+/// Fields of the base structs are found as well.
+inline filter_field FilterField(const RuntimeSchema& schema, const std::string& name)
+{
+    uint16_t depth = 0;
+
+    for (RuntimeSchema s = schema; s.HasBase(); s = s.GetBaseSchema())
+        ++depth;
+
+    for (RuntimeSchema s = schema;; s = s.GetBaseSchema(), --depth)
+    {
+        for (const FieldDef& def : s.GetStruct().fields)
+        {
+            if (def.metadata.name == name)
+            {
+                filter_field field;
+
+                field.depth = depth;
+                field.id = def.id;
+                field.type = def.type.id;
+                field.default_value = def.metadata.default_value;
+
+                return field;
+            }
+        }
+
+        if (!s.HasBase())
+            break;
+    }
+
+    BOND_THROW(CoreException,
+        "Field " << name << " not found in " << schema.GetStruct().metadata.qualified_name);
+}
+
+
+namespace detail
+{
+
+// Value of a field in a payload or of an operand of a predicate. Numbers are
+// compared by value regardless of their type, strings are compared with
+// strings.
+struct filter_value
+{
+    enum kind_type
+    {
+        none,
+        signed_kind,
+        unsigned_kind,
+        floating_kind,
+        string_kind
+    };
+
+    filter_value()
+        : kind(none),
+          int_value(),
+          uint_value(),
+          double_value()
+    {}
+
+    kind_type kind;
+    int64_t int_value;
+    uint64_t uint_value;
+    double double_value;
+    boost::string_ref string_value;
+};
+
+
+inline filter_value SignedValue(int64_t value)
+{
+    filter_value v;
+    v.kind = filter_value::signed_kind;
+    v.int_value = value;
+    return v;
+}
+
+inline filter_value UnsignedValue(uint64_t value)
+{
+    filter_value v;
+    v.kind = filter_value::unsigned_kind;
+    v.uint_value = value;
+    return v;
+}
+
+inline filter_value FloatingValue(double value)
+{
+    filter_value v;
+    v.kind = filter_value::floating_kind;
+    v.double_value = value;
+    return v;
+}
+
+inline filter_value StringValue(boost::string_ref value)
+{
+    filter_value v;
+    v.kind = filter_value::string_kind;
+    v.string_value = value;
+    return v;
+}
+
+
+inline double FloatingValue(const filter_value& value)
+{
+    switch (value.kind)
+    {
+        case filter_value::signed_kind:
+            return static_cast<double>(value.int_value);
+        case filter_value::unsigned_kind:
+            return static_cast<double>(value.uint_value);
+        default:
+            return value.double_value;
+    }
+}
+
+
+// Compares two values, returning false if they are not comparable, i.e. a
+// string and a number, or a NaN
+inline bool CompareValues(const filter_value& x, const filter_value& y, int& result)
+{
+    if (x.kind == filter_value::none || y.kind == filter_value::none)
+        return false;
+
+    if (x.kind == filter_value::string_kind || y.kind == filter_value::string_kind)
+    {
+        if (x.kind != y.kind)
+            return false;
+
+        result = x.string_value.compare(y.string_value);
+        return true;
+    }
+
+    if (x.kind == filter_value::floating_kind || y.kind == filter_value::floating_kind)
+    {
+        const double a = FloatingValue(x);
+        const double b = FloatingValue(y);
+
+        if (a != a || b != b)
+            return false;
+
+        result = a < b ? -1 : (b < a ? 1 : 0);
+        return true;
+    }
+
+    if (x.kind == filter_value::signed_kind && y.kind == filter_value::signed_kind)
+    {
+        result = x.int_value < y.int_value ? -1 : (y.int_value < x.int_value ? 1 : 0);
+        return true;
+    }
+
+    // At least one of the values is unsigned, negative values are smaller
+    if (x.kind == filter_value::signed_kind && x.int_value < 0)
+    {
+        result = -1;
+        return true;
+    }
+
+    if (y.kind == filter_value::signed_kind && y.int_value < 0)
+    {
+        result = 1;
+        return true;
+    }
+
+    const uint64_t a = x.kind == filter_value::signed_kind ? static_cast<uint64_t>(x.int_value) : x.uint_value;
+    const uint64_t b = y.kind == filter_value::signed_kind ? static_cast<uint64_t>(y.int_value) : y.uint_value;
+
+    result = a < b ? -1 : (b < a ? 1 : 0);
+    return true;
+}
+
+
+// Operand of a predicate, which owns the characters of a string
+class filter_operand
+{
+public:
+    template <typename T>
+    explicit filter_operand(const T& value,
+        typename boost::enable_if_c<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value>::type* = nullptr)
+        : _value(SignedValue(static_cast<int64_t>(value)))
+    {}
+
+    template <typename T>
+    explicit filter_operand(const T& value,
+        typename boost::enable_if_c<std::is_unsigned<T>::value && std::is_integral<T>::value>::type* = nullptr)
+        : _value(UnsignedValue(value))
+    {}
+
+    template <typename T>
+    explicit filter_operand(const T& value,
+        typename boost::enable_if<std::is_floating_point<T> >::type* = nullptr)
+        : _value(FloatingValue(static_cast<double>(value)))
+    {}
+
+    explicit filter_operand(const std::string& value)
+        : _value(StringValue(boost::string_ref())),
+          _string(value)
+    {}
+
+    explicit filter_operand(const char* value)
+        : _value(StringValue(boost::string_ref())),
+          _string(value)
+    {}
+
+    // Default value of a field from its metadata
+    filter_operand(BondDataType type, const Variant& value)
+    {
+        if (value.nothing)
+            return;
+
+        if (type == BT_STRING)
+        {
+            _value = StringValue(boost::string_ref());
+            _string = value.string_value;
+        }
+        else if (type == BT_FLOAT || type == BT_DOUBLE)
+            _value = FloatingValue(value.double_value);
+        else if (type == BT_BOOL || type == BT_UINT8 || type == BT_UINT16 || type == BT_UINT32 || type == BT_UINT64)
+            _value = UnsignedValue(value.uint_value);
+        else if (type == BT_INT8 || type == BT_INT16 || type == BT_INT32 || type == BT_INT64)
+            _value = SignedValue(value.int_value);
+    }
+
+    filter_value::kind_type kind() const
+    {
+        return _value.kind;
+    }
+
+    filter_value value() const
+    {
+        filter_value v = _value;
+
+        if (v.kind == filter_value::string_kind)
+            v.string_value = _string;
+
+        return v;
+    }
+
+private:
+    filter_value _value;
+    std::string _string;
+};
+
+
+inline bool OperandLess(const filter_operand& x, const filter_operand& y)
+{
+    int result;
+    return CompareValues(x.value(), y.value(), result) && result < 0;
+}
+
+
+struct filter_predicate
+{
+    enum op_type
+    {
+        equal,
+        range,
+        in,
+        prefix
+    };
+
+    filter_predicate(op_type op, const filter_field& field)
+        : op(op),
+          depth(field.depth),
+          id(field.id),
+          default_value(field.type, field.default_value)
+    {}
+
+    bool Evaluate(const filter_value& value) const
+    {
+        int result;
+
+        switch (op)
+        {
+            case equal:
+                return CompareValues(value, operands[0].value(), result) && result == 0;
+
+            case range:
+                return CompareValues(value, operands[0].value(), result) && result >= 0
+                    && CompareValues(value, operands[1].value(), result) && result <= 0;
+
+            case in:
+            {
+                // Operands are sorted, so do a binary search
+                std::size_t first = 0;
+                std::size_t last = operands.size();
+
+                while (first < last)
+                {
+                    const std::size_t middle = first + (last - first) / 2;
+
+                    if (!CompareValues(value, operands[middle].value(), result))
+                        return false;
+
+                    if (result == 0)
+                        return true;
+                    else if (result < 0)
+                        last = middle;
+                    else
+                        first = middle + 1;
+                }
+
+                return false;
+            }
+
+            case prefix:
+                return value.kind == filter_value::string_kind
+                    && value.string_value.starts_with(operands[0].value().string_value);
+        }
+
+        return false;
+    }
+
+    op_type op;
+    uint16_t depth;
+    uint16_t id;
+    std::vector<filter_operand> operands;
+    filter_operand default_value;
+};
+
+} // namespace detail
+
+
+/// @brief Filter evaluating predicates on fields of structs directly on
+/// serialized payloads, without deserializing them
+///
+/// A struct matches the filter when all predicates are true. Predicates
+/// reference fields of basic types using \ref filter_field, from either
+/// compile-time or runtime schema. Fields absent from the payload have the
+/// default values from the schema. NaN values of fields satisfy no predicate
+/// and NaN operands are rejected.
+///
+/// Payloads must be serialized using a tagged protocol, e.g. Compact Binary
+/// or Fast Binary. Fields are read in the order they appear in the payload
+/// and the evaluation stops as soon as the result is known. Strings are
+/// compared in place and evaluation doesn't allocate memory.
+class record_filter
+{
+public:
+    /// @brief Maximum number of predicates of a filter
+    BOND_STATIC_CONSTEXPR std::size_t max_predicates = 64;
+
+    /// @brief Field is equal to the value
+    template <typename T>
+    record_filter& Equal(const filter_field& field, const T& value)
+    {
+        detail::filter_predicate predicate(detail::filter_predicate::equal, field);
+        predicate.operands.push_back(Operand(field, value));
+        return Add(predicate);
+    }
+
+    /// @brief Field is between the values, inclusive
+    template <typename T>
+    record_filter& Range(const filter_field& field, const T& min, const T& max)
+    {
+        detail::filter_predicate predicate(detail::filter_predicate::range, field);
+        predicate.operands.push_back(Operand(field, min));
+        predicate.operands.push_back(Operand(field, max));
+        return Add(predicate);
+    }
+
+    /// @brief Field is equal to one of the values
+    template <typename T>
+    record_filter& In(const filter_field& field, const std::vector<T>& values)
+    {
+        detail::filter_predicate predicate(detail::filter_predicate::in, field);
+
+        for (const T& value : values)
+            predicate.operands.push_back(Operand(field, value));
+
+        std::sort(predicate.operands.begin(), predicate.operands.end(), detail::OperandLess);
+        return Add(predicate);
+    }
+
+    /// @brief String field starts with the prefix
+    record_filter& Prefix(const filter_field& field, const std::string& prefix)
+    {
+        if (field.type != BT_STRING)
+            UnsupportedField(field, "prefix of non-string");
+
+        detail::filter_predicate predicate(detail::filter_predicate::prefix, field);
+        predicate.operands.push_back(Operand(field, prefix));
+        return Add(predicate);
+    }
+
+    /// @brief Evaluate the filter on a struct read from a protocol reader.
+    ///
+    /// The reader is advanced past the struct, so this can be called
+    /// repeatedly on a stream of structs.
+    template <typename Reader>
+    bool Matches(Reader& input) const
+    {
+        return Evaluate(input, true);
+    }
+
+    /// @brief Evaluate the filter on a struct which is the whole payload,
+    /// e.g. a record of a record file.
+    ///
+    /// The rest of the payload isn't read once the result is known.
+    template <typename Reader>
+    bool MatchesPayload(Reader input) const
+    {
+        return Evaluate(input, false);
+    }
+
+    /// @brief Evaluate the filter on a stream of structs, calling
+    /// function(uint32_t offset, const blob& record) for each matching one.
+    ///
+    /// The offset is relative to the initial position of the reader.
+    /// Structs are read until the end of the input buffer.
+    ///
+    /// @return the number of matching structs
+    template <typename Reader, typename Function>
+    std::size_t Filter(Reader& input, const Function& function) const
+    {
+        const blob start = GetCurrentBuffer(input.GetBuffer());
+        std::size_t count = 0;
+
+        while (!input.GetBuffer().IsEof())
+        {
+            const blob begin = GetCurrentBuffer(input.GetBuffer());
+
+            if (Matches(input))
+            {
+                function(start.length() - begin.length(),
+                         GetBufferRange(begin, GetCurrentBuffer(input.GetBuffer())));
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+private:
+    template <typename T>
+    static detail::filter_operand Operand(const filter_field& field, const T& value)
+    {
+        const detail::filter_operand operand(value);
+        const bool string_operand = operand.kind() == detail::filter_value::string_kind;
+
+        if (!IsBasicField(field))
+            UnsupportedField(field, "predicate on non-basic");
+
+        if ((field.type == BT_STRING) != string_operand)
+            UnsupportedField(field, string_operand ? "string operand for non-string" : "numeric operand for string");
+
+        // NaN isn't ordered, so it couldn't be sorted with the operands of In
+        if (operand.kind() == detail::filter_value::floating_kind && std::isnan(operand.value().double_value))
+            UnsupportedField(field, "NaN operand for");
+
+        return operand;
+    }
+
+    static bool IsBasicField(const filter_field& field)
+    {
+        switch (field.type)
+        {
+            case BT_BOOL:
+            case BT_UINT8: case BT_UINT16: case BT_UINT32: case BT_UINT64:
+            case BT_INT8: case BT_INT16: case BT_INT32: case BT_INT64:
+            case BT_FLOAT: case BT_DOUBLE:
+            case BT_STRING:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    [[noreturn]] static void UnsupportedField(const filter_field& field, const char* message)
+    {
+        BOND_THROW(CoreException,
+            "Invalid filter: " << message << " field " << field.id << " of type " << field.type);
+    }
+
+    record_filter& Add(const detail::filter_predicate& predicate)
+    {
+        if (_predicates.size() == max_predicates)
+        {
+            BOND_THROW(CoreException,
+                "Invalid filter: more than " << static_cast<std::size_t>(max_predicates) << " predicates");
+        }
+
+        _predicates.push_back(predicate);
+        return *this;
+    }
+
+    template <typename T, typename Reader>
+    static detail::filter_value ReadNumber(Reader& input)
+    {
+        T value;
+        input.Read(value);
+
+        if (std::is_floating_point<T>::value)
+            return detail::FloatingValue(static_cast<double>(value));
+        else if (std::is_signed<T>::value)
+            return detail::SignedValue(static_cast<int64_t>(value));
+        else
+            return detail::UnsignedValue(static_cast<uint64_t>(value));
+    }
+
+    // Reads a value of a basic type, or returns false for other types
+    template <typename Reader>
+    static bool ReadValue(Reader& input, BondDataType type, detail::filter_value& value, blob_string& str)
+    {
+        switch (type)
+        {
+            case BT_BOOL:
+            {
+                bool b;
+                input.Read(b);
+                value = detail::UnsignedValue(b ? 1 : 0);
+                return true;
+            }
+            case BT_UINT8:  value = ReadNumber<uint8_t>(input);  return true;
+            case BT_UINT16: value = ReadNumber<uint16_t>(input); return true;
+            case BT_UINT32: value = ReadNumber<uint32_t>(input); return true;
+            case BT_UINT64: value = ReadNumber<uint64_t>(input); return true;
+            case BT_INT8:   value = ReadNumber<int8_t>(input);   return true;
+            case BT_INT16:  value = ReadNumber<int16_t>(input);  return true;
+            case BT_INT32:  value = ReadNumber<int32_t>(input);  return true;
+            case BT_INT64:  value = ReadNumber<int64_t>(input);  return true;
+            case BT_FLOAT:  value = ReadNumber<float>(input);    return true;
+            case BT_DOUBLE: value = ReadNumber<double>(input);   return true;
+            case BT_STRING:
+                input.Read(str);
+                value = detail::StringValue(boost::string_ref(str.data(), str.length()));
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    template <typename Reader>
+    bool Evaluate(Reader& input, bool consume) const
+    {
+        BOOST_STATIC_ASSERT_MSG(!uses_static_parser<Reader>::value,
+            "record_filter requires a tagged protocol");
+
+        uint64_t evaluated = 0;
+        std::size_t remaining = _predicates.size();
+        bool result = true;
+        uint16_t depth = 0;
+
+        BondDataType type;
+        uint16_t id;
+
+        input.ReadStructBegin();
+
+        for (input.ReadFieldBegin(type, id); type != BT_STOP; input.ReadFieldEnd(), input.ReadFieldBegin(type, id))
+        {
+            if (type == BT_STOP_BASE)
+            {
+                ++depth;
+                continue;
+            }
+
+            if (!remaining || !EvaluateField(input, depth, id, type, evaluated, remaining, result))
+                input.Skip(type);
+
+            if (!remaining && !consume)
+                return result;
+        }
+
+        input.ReadStructEnd();
+
+        // Fields absent from the payload have default values
+        for (std::size_t i = 0; remaining && i < _predicates.size(); ++i)
+        {
+            if (!(evaluated & (uint64_t(1) << i)) && !_predicates[i].Evaluate(_predicates[i].default_value.value()))
+                result = false;
+        }
+
+        return result;
+    }
+
+    // Evaluates the predicates on the field, returning false if the field
+    // wasn't read
+    template <typename Reader>
+    bool EvaluateField(Reader& input, uint16_t depth, uint16_t id, BondDataType type,
+                       uint64_t& evaluated, std::size_t& remaining, bool& result) const
+    {
+        detail::filter_value value;
+        blob_string str;
+        bool read = false;
+
+        for (std::size_t i = 0; i < _predicates.size(); ++i)
+        {
+            const detail::filter_predicate& predicate = _predicates[i];
+
+            if (predicate.id != id || predicate.depth != depth || (evaluated & (uint64_t(1) << i)))
+                continue;
+
+            if (!read)
+            {
+                if (!ReadValue(input, type, value, str))
+                    return false;
+
+                read = true;
+            }
+
+            evaluated |= uint64_t(1) << i;
+            --remaining;
+
+            if (!predicate.Evaluate(value))
+            {
+                // The result is decided
+                result = false;
+                remaining = 0;
+                break;
+            }
+        }
+
+        return read;
+    }
+
+    std::vector<detail::filter_predicate> _predicates;
+};
+
+} // namespace bond
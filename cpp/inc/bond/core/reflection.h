@@ -61,15 +61,14 @@ using optional_field_modifier = std::integral_constant<bond::Modifier, bond::Opt
 using required_optional_field_modifier = std::integral_constant<bond::Modifier, bond::RequiredOptional>;
 
 
-/// @brief Field description in compile-time schema
+/// @brief Common base of field descriptions in compile-time schema
 template <
     uint16_t field_id,
     typename ModifierTag,
     typename Struct,
     typename FieldType,
-    FieldType Struct::*field_ptr,
-    const bond::Metadata* metadata_ptr>
-struct FieldTemplate
+    FieldType Struct::*field_ptr>
+struct FieldTemplateBase
 {
     // Note: When introducing new names inside this scope, remember to update the
     // fieldTemplateReservedNames list in Reflection_h.hs
@@ -94,9 +93,6 @@ struct FieldTemplate
     /// - bond::reflection::required_optional_field_modifier
     typedef ModifierTag field_modifier;
 
-    /// @brief Static data member describing field metadata
-    static const Metadata& metadata;
-
     /// @brief Static data member representing the field pointer
     static const field_pointer field;
 
@@ -121,6 +117,40 @@ struct FieldTemplate
 };
 
 
+template <
+    uint16_t field_id,
+    typename ModifierTag,
+    typename Struct,
+    typename FieldType,
+    FieldType Struct::*field_ptr>
+const typename FieldTemplateBase<field_id, ModifierTag, Struct, FieldType, field_ptr>::field_pointer
+    FieldTemplateBase<field_id, ModifierTag, Struct, FieldType, field_ptr>::field = field_ptr;
+
+
+/// @brief Field description in compile-time schema, with metadata in a
+/// static object
+template <
+    uint16_t field_id,
+    typename ModifierTag,
+    typename Struct,
+    typename FieldType,
+    FieldType Struct::*field_ptr,
+    const bond::Metadata* metadata_ptr>
+struct FieldTemplate
+    : FieldTemplateBase<field_id, ModifierTag, Struct, FieldType, field_ptr>
+{
+    /// @brief Static data member describing field metadata
+    static const Metadata& metadata;
+
+    /// @brief Static method returning field metadata
+    static
+    const Metadata& GetMetadata()
+    {
+        return *metadata_ptr;
+    }
+};
+
+
 template <
     uint16_t field_id,
     typename ModifierTag,
@@ -131,17 +161,70 @@ template <
 const bond::Metadata&
     FieldTemplate<field_id, ModifierTag, Struct, FieldType, field_ptr, metadata_ptr>::metadata = *metadata_ptr;
 
-template
-<
+
+/// @brief Field description in compile-time schema, with metadata constructed
+/// on first use
+///
+/// The metadata of all fields of a struct is constructed at once, in the
+/// array returned by fields_metadata, and field_index is the position of the
+/// field in it.
+template <
+    uint16_t field_id,
+    typename ModifierTag,
+    typename Struct,
+    typename FieldType,
+    FieldType Struct::*field_ptr,
+    const bond::Metadata* (*fields_metadata)(),
+    std::size_t field_index>
+struct LazyFieldTemplate
+    : FieldTemplateBase<field_id, ModifierTag, Struct, FieldType, field_ptr>
+{
+    /// @brief Static data member describing field metadata
+    ///
+    /// Unlike GetMetadata(), it is constructed during dynamic initialization
+    /// of the program, if used.
+    static const Metadata& metadata;
+
+    /// @brief Static method returning field metadata, constructed on first use
+    static
+    const Metadata& GetMetadata()
+    {
+        return fields_metadata()[field_index];
+    }
+};
+
+
+template <
     uint16_t field_id,
     typename ModifierTag,
     typename Struct,
     typename FieldType,
     FieldType Struct::*field_ptr,
-    const Metadata* metadata_ptr
->
-const typename FieldTemplate<field_id, ModifierTag, Struct, FieldType, field_ptr, metadata_ptr>::field_pointer
-    FieldTemplate<field_id, ModifierTag, Struct, FieldType, field_ptr, metadata_ptr>::field = field_ptr;
+    const Metadata* (*fields_metadata)(),
+    std::size_t field_index>
+const bond::Metadata&
+    LazyFieldTemplate<field_id, ModifierTag, Struct, FieldType, field_ptr, fields_metadata, field_index>::metadata
+        = fields_metadata()[field_index];
+
+
+/// @brief Base of compile-time schema of a struct
+///
+/// The schema provides static method GetMetadata() returning struct metadata,
+/// constructed on first use.
+template <typename Schema>
+struct SchemaTemplate
+{
+    /// @brief Static data member describing struct metadata
+    ///
+    /// Unlike GetMetadata(), it is constructed during dynamic initialization
+    /// of the program, if used.
+    static const Metadata& metadata;
+};
+
+
+template <typename Schema>
+const bond::Metadata&
+    SchemaTemplate<Schema>::metadata = Schema::GetMetadata();
 
 
 template <typename Service, typename Input, typename Result> struct
@@ -376,6 +459,23 @@ base_class()
 }
 
 
+// Metadata of a struct; schemas generated by older versions of gbc return a
+// copy of their static data member metadata from GetMetadata()
+template <typename Schema>
+inline typename boost::enable_if<std::is_reference<decltype(Schema::GetMetadata())>, const Metadata&>::type
+schema_metadata()
+{
+    return Schema::GetMetadata();
+}
+
+template <typename Schema>
+inline typename boost::disable_if<std::is_reference<decltype(Schema::GetMetadata())>, const Metadata&>::type
+schema_metadata()
+{
+    return Schema::metadata;
+}
+
+
 template <typename T> struct
 remove_bonded
 {
@@ -403,22 +503,20 @@ template <typename Unused> struct
 schema<Unknown, Unused>
 {
     struct type
+        : reflection::SchemaTemplate<type>
     {
         typedef no_base base;
         typedef boost::mpl::list<>::type fields;
-        static const Metadata metadata;
 
-        type()
+        static const Metadata& GetMetadata()
         {
-            (void)metadata;
+            static const Metadata s_metadata
+                = reflection::MetadataInit("Unknown", "Unknown", reflection::Attributes());
+            return s_metadata;
         }
     };
 };
 
-template <typename Unused>
-const Metadata schema<Unknown, Unused>::type::metadata
-    = reflection::MetadataInit("Unknown", "Unknown", reflection::Attributes());
-
 template <typename T, typename Enable> struct
 schema_for_passthrough
     : schema<typename remove_bonded<T>::type>
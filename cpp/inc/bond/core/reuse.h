@@ -0,0 +1,659 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "apply.h"
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/for_each.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <bitset>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace bond
+{
+
+namespace detail
+{
+
+template <typename T, typename Protocols>
+class ReuseTo;
+
+
+// Containers which are deserialized by reusing the existing elements. Vectors
+// of basic types other than strings are simply cleared, which already keeps
+// their capacity.
+template <typename T> struct
+is_reusable_container
+    : std::false_type {};
+
+template <typename T, typename A> struct
+is_reusable_container<std::vector<T, A> >
+    : std::integral_constant<bool,
+        !is_basic_type<T>::value || is_string<T>::value || is_wstring<T>::value> {};
+
+template <typename T, typename C, typename A> struct
+is_reusable_container<std::set<T, C, A> >
+    : std::true_type {};
+
+template <typename K, typename T, typename C, typename A> struct
+is_reusable_container<std::map<K, T, C, A> >
+    : std::true_type {};
+
+
+// Containers are read directly from the input of the value, which requires
+// the reader to be held by reference and not to be a DOM. The reader is
+// rewound when the element types don't match, so the input buffer must also
+// be random access.
+template <typename T, typename X> struct
+is_reusable_value
+    : std::false_type {};
+
+template <typename T, typename Reader> struct
+is_reusable_value<T, value<T, Reader> >
+    : std::integral_constant<bool,
+        is_reusable_container<T>::value
+        && std::is_reference<Reader>::value
+        && !uses_dom_parser<typename std::remove_reference<Reader>::type>::value
+        && is_random_access_buffer<typename std::remove_reference<Reader>::type::Buffer>::value> {};
+
+
+template <typename T>
+typename boost::enable_if<is_list_container<T> >::type
+inline ClearContainer(T& var)
+{
+    resize_list(var, 0);
+}
+
+
+template <typename T>
+typename boost::enable_if<is_set_container<T> >::type
+inline ClearContainer(T& var)
+{
+    clear_set(var);
+}
+
+
+template <typename T>
+typename boost::enable_if<is_map_container<T> >::type
+inline ClearContainer(T& var)
+{
+    clear_map(var);
+}
+
+
+inline void ClearContainer(blob& var)
+{
+    var.clear();
+}
+
+
+// ResetToDefault sets a variable to the default value of a field without
+// releasing memory it holds where possible: strings are assigned in place and
+// containers are cleared.
+template <typename T>
+typename boost::enable_if<has_schema<T> >::type
+inline ResetToDefault(T& var);
+
+template <typename T>
+typename boost::enable_if<has_schema<T> >::type
+inline ResetToDefault(T& var, const Metadata& /*metadata*/)
+{
+    ResetToDefault(var);
+}
+
+
+template <typename T>
+inline void ResetToDefault(maybe<T>& var, const Metadata& /*metadata*/)
+{
+    var.set_nothing();
+}
+
+
+template <typename T>
+typename boost::enable_if<is_container<T> >::type
+inline ResetToDefault(T& var, const Metadata& /*metadata*/)
+{
+    ClearContainer(var);
+}
+
+
+template <typename T>
+typename boost::enable_if<is_bonded<T> >::type
+inline ResetToDefault(T& var, const Metadata& /*metadata*/)
+{
+    var = T();
+}
+
+
+template <typename T>
+typename boost::enable_if<is_type_alias<T> >::type
+inline ResetToDefault(T& var, const Metadata& metadata)
+{
+    typename aliased_type<T>::type value;
+    VariantGet(metadata.default_value, value);
+    set_aliased_value(var, value);
+}
+
+
+template <typename T>
+typename boost::enable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+inline ResetToDefault(T& var, const Metadata& metadata)
+{
+    VariantGet(metadata.default_value, var);
+}
+
+
+// Resets the fields of a struct whose bits in the mask are not set.
+template <typename T, typename Mask>
+class ResetFields
+{
+public:
+    ResetFields(T& var, const Mask& mask)
+        : _var(var),
+          _mask(mask)
+    {}
+
+    template <typename Field>
+    void operator()(const Field&) const
+    {
+        typedef typename schema<T>::type::fields Fields;
+        typedef typename boost::mpl::find<Fields, Field>::type Position;
+
+        if (!_mask.test(boost::mpl::distance<typename boost::mpl::begin<Fields>::type, Position>::value))
+            ResetToDefault(Field::GetVariable(_var), Field::GetMetadata());
+    }
+
+private:
+    T& _var;
+    const Mask& _mask;
+};
+
+
+template <typename T>
+typename boost::enable_if<has_base<T> >::type
+inline ResetBaseToDefault(T& var)
+{
+    ResetToDefault(static_cast<typename schema<T>::type::base&>(var));
+}
+
+
+template <typename T>
+typename boost::disable_if<has_base<T> >::type
+inline ResetBaseToDefault(T& /*var*/)
+{}
+
+
+template <typename T>
+typename boost::enable_if<has_schema<T> >::type
+inline ResetToDefault(T& var)
+{
+    typedef typename schema<T>::type::fields Fields;
+    typedef std::bitset<boost::mpl::size<Fields>::value> Mask;
+
+    ResetBaseToDefault(var);
+    boost::mpl::for_each<Fields>(ResetFields<T, Mask>(var, Mask()));
+}
+
+
+template <typename Protocols, typename T, typename A, typename Reader>
+inline void ReuseContainer(std::vector<T, A>& var, Reader& input);
+
+template <typename Protocols, typename T, typename C, typename A, typename Reader>
+inline void ReuseContainer(std::set<T, C, A>& var, Reader& input);
+
+template <typename Protocols, typename K, typename T, typename C, typename A, typename Reader>
+inline void ReuseContainer(std::map<K, T, C, A>& var, Reader& input);
+
+
+// ReuseValue deserializes a value into a variable which may hold data from a
+// previous payload, leaving it equal to a freshly deserialized one.
+template <typename Protocols, typename T, typename X>
+typename boost::enable_if<has_schema<T> >::type
+inline ReuseValue(T& var, const X& value)
+{
+    Apply<Protocols>(ReuseTo<T, Protocols>(var), value);
+}
+
+
+template <typename Protocols, typename T, typename X>
+inline void ReuseValue(maybe<T>& var, const X& value)
+{
+    ReuseValue<Protocols>(var.set_value(), value);
+}
+
+
+template <typename Protocols, typename T, typename X>
+typename boost::enable_if<is_reusable_value<T, X> >::type
+inline ReuseValue(T& var, const X& value)
+{
+    ReuseContainer<Protocols>(var, value._Input());
+}
+
+
+template <typename Protocols, typename T, typename X>
+typename boost::enable_if_c<is_container<T>::value && !is_reusable_value<T, X>::value>::type
+inline ReuseValue(T& var, const X& value)
+{
+    ClearContainer(var);
+    value.template Deserialize<Protocols>(var);
+}
+
+
+template <typename Protocols, typename T, typename X>
+typename boost::disable_if_c<has_schema<T>::value || is_container<T>::value>::type
+inline ReuseValue(T& var, const X& value)
+{
+    value.template Deserialize<Protocols>(var);
+}
+
+
+template <typename Protocols, typename T, typename Reader>
+typename boost::enable_if<has_schema<T> >::type
+inline ReuseElement(T& var, Reader& input)
+{
+    ReuseValue<Protocols>(var, bonded<T, Reader&>(input));
+}
+
+
+template <typename Protocols, typename T, typename Reader>
+typename boost::disable_if<has_schema<T> >::type
+inline ReuseElement(T& var, Reader& input)
+{
+    ReuseValue<Protocols>(var, value<T, Reader&>(input, false));
+}
+
+
+// The reusing code paths only handle payloads with exactly matching element
+// types. Otherwise the reader is rewound to the beginning of the container
+// and the container is deserialized the regular way, which converts or skips
+// the elements.
+template <typename Protocols, typename T, typename Reader>
+inline void DeserializeCleared(T& var, Reader& input, const Reader& start)
+{
+    input = start;
+    ClearContainer(var);
+    value<T, Reader&>(input, false).template Deserialize<Protocols>(var);
+}
+
+
+// Elements of a vector are deserialized in place; the vector is only resized
+// when the number of elements changes.
+template <typename Protocols, typename T, typename A, typename Reader>
+inline void ReuseContainer(std::vector<T, A>& var, Reader& input)
+{
+    const Reader start = input;
+
+    BondDataType type = get_type_id<T>::value;
+    uint32_t     size = 0;
+
+    input.ReadContainerBegin(size, type);
+
+    if (type != get_type_id<T>::value)
+        return DeserializeCleared<Protocols>(var, input, start);
+
+    if (size != var.size())
+        var.resize(size, make_element(var));
+
+    for (typename std::vector<T, A>::iterator it = var.begin(); it != var.end(); ++it)
+        ReuseElement<Protocols>(*it, input);
+
+    input.ReadContainerEnd();
+}
+
+
+#ifdef BOND_CXX_17
+
+// Nodes of a set or a map whose keys are not in the payload anymore. They are
+// reused for new keys instead of being released. The container holding the
+// nodes is only created when a key is removed.
+template <typename T>
+class SpareNodes
+    : boost::noncopyable
+{
+public:
+    explicit SpareNodes(T& var)
+        : _var(var)
+    {}
+
+    typename T::iterator Release(typename T::iterator it)
+    {
+        if (!_nodes)
+            _nodes.emplace(_var.key_comp(), _var.get_allocator());
+
+        _nodes->insert(_var.extract(it++));
+        return it;
+    }
+
+    bool empty() const
+    {
+        return !_nodes || _nodes->empty();
+    }
+
+    // Returns a node for a new key which is inserted before 'it'. Without any
+    // removed nodes the node of the last element is taken; if its key turns
+    // up later in the payload the node is allocated then instead of now.
+    typename T::node_type Take(typename T::iterator& it)
+    {
+        if (!empty())
+            return _nodes->extract(_nodes->begin());
+
+        BOOST_ASSERT(it != _var.end());
+
+        if (std::next(it) == _var.end())
+            return _var.extract(it++);
+
+        return _var.extract(std::prev(_var.end()));
+    }
+
+private:
+    T& _var;
+    boost::optional<T> _nodes;
+};
+
+#endif
+
+
+// Sets and maps are matched against the payload in key order. Nodes of
+// existing keys are kept as they are; with C++17 nodes of keys which are no
+// longer present are extracted and reused for new keys. Keys don't have to be
+// sorted in the payload, that only reduces the number of matched nodes. Keys
+// are read into a temporary, which for strings that don't fit into the small
+// string buffer is allocated once per container.
+template <typename Protocols, typename T, typename C, typename A, typename Reader>
+inline void ReuseContainer(std::set<T, C, A>& var, Reader& input)
+{
+    const Reader start = input;
+
+    BondDataType type = get_type_id<T>::value;
+    uint32_t     size = 0;
+
+    input.ReadContainerBegin(size, type);
+
+    if (type != get_type_id<T>::value)
+        return DeserializeCleared<Protocols>(var, input, start);
+
+    // Elements starting at 'it' haven't been matched against the payload yet
+    typename std::set<T, C, A>::iterator it = var.begin();
+    T key(make_element(var));
+
+#ifdef BOND_CXX_17
+    SpareNodes<std::set<T, C, A> > spare(var);
+#endif
+
+    while (size--)
+    {
+        value<T, Reader&>(input, false).template Deserialize<Protocols>(key);
+
+        while (it != var.end() && var.key_comp()(*it, key))
+        {
+#ifdef BOND_CXX_17
+            it = spare.Release(it);
+#else
+            it = var.erase(it);
+#endif
+        }
+
+        if (it != var.end() && !var.key_comp()(key, *it))
+        {
+            ++it;
+            continue;
+        }
+
+#ifdef BOND_CXX_17
+        if (!spare.empty() || it != var.end())
+        {
+            typename std::set<T, C, A>::node_type node = spare.Take(it);
+            node.value() = key;
+            var.insert(it, std::move(node));
+            continue;
+        }
+#endif
+        var.insert(it, key);
+    }
+
+    var.erase(it, var.end());
+
+    input.ReadContainerEnd();
+}
+
+
+template <typename Protocols, typename K, typename T, typename C, typename A, typename Reader>
+inline void ReuseContainer(std::map<K, T, C, A>& var, Reader& input)
+{
+    const Reader start = input;
+
+    std::pair<BondDataType, BondDataType> type(get_type_id<K>::value, get_type_id<T>::value);
+    uint32_t                              size = 0;
+
+    input.ReadContainerBegin(size, type);
+
+    if (type.first != get_type_id<K>::value || type.second != get_type_id<T>::value)
+        return DeserializeCleared<Protocols>(var, input, start);
+
+    // Elements starting at 'it' haven't been matched against the payload yet
+    typename std::map<K, T, C, A>::iterator it = var.begin();
+    K key(make_key(var));
+
+#ifdef BOND_CXX_17
+    SpareNodes<std::map<K, T, C, A> > spare(var);
+#endif
+
+    while (size--)
+    {
+        value<K, Reader&>(input, false).template Deserialize<Protocols>(key);
+
+        while (it != var.end() && var.key_comp()(it->first, key))
+        {
+#ifdef BOND_CXX_17
+            it = spare.Release(it);
+#else
+            it = var.erase(it);
+#endif
+        }
+
+        if (it != var.end() && !var.key_comp()(key, it->first))
+        {
+            ReuseElement<Protocols>(it->second, input);
+            ++it;
+            continue;
+        }
+
+#ifdef BOND_CXX_17
+        if (!spare.empty() || it != var.end())
+        {
+            typename std::map<K, T, C, A>::node_type node = spare.Take(it);
+            node.key() = key;
+            ReuseElement<Protocols>(var.insert(it, std::move(node))->second, input);
+            continue;
+        }
+#endif
+        typename std::map<K, T, C, A>::value_type entry(key, make_value(var));
+        ReuseElement<Protocols>(var.insert(it, std::move(entry))->second, input);
+    }
+
+    var.erase(it, var.end());
+
+    input.ReadContainerEnd();
+}
+
+
+//
+// ReuseTo<T> deserializes an instance of T like To<T>, except that the object
+// doesn't have to be in the default state. Memory held by the object is
+// reused instead of being released: strings are assigned in place, elements
+// of vectors, sets and maps are deserialized into the existing elements and
+// nested structs are deserialized field by field. Fields which are omitted
+// in the payload are reset to their default values.
+//
+template <typename T, typename Protocols>
+class ReuseTo
+    : public bond::To<T, Protocols>
+{
+public:
+    ReuseTo(T& var)
+        : bond::To<T, Protocols>(var),
+          _var(var)
+    {}
+
+    void Begin(const Metadata& /*metadata*/) const
+    {
+        // Unlike To<T> this doesn't require the object to be in the default
+        // state.
+        BOOST_STATIC_ASSERT(has_schema<T>::value);
+
+        RequiredFieldValiadator<T>::Begin();
+        _deserialized.reset();
+    }
+
+    void End() const
+    {
+        bond::To<T, Protocols>::End();
+        boost::mpl::for_each<SchemaFields>(ResetFields<T, Mask>(_var, _deserialized));
+    }
+
+    template <typename X>
+    bool Base(const X& value) const
+    {
+        return AssignToBase(value);
+    }
+
+    template <typename Reader, typename X>
+    bool Field(uint16_t id, const Metadata& /*metadata*/, const bonded<X, Reader>& value) const
+    {
+        return AssignToField(typename boost::mpl::begin<typename nested_fields<T>::type>::type(), id, value);
+    }
+
+    template <typename Reader, typename X>
+    bool Field(uint16_t id, const Metadata& /*metadata*/, const value<X, Reader>& value) const
+    {
+        return AssignToField(typename boost::mpl::begin<typename matching_fields<T, X>::type>::type(), id, value);
+    }
+
+    template <typename Reader>
+    bool Field(uint16_t id, const Metadata& /*metadata*/, const value<void, Reader>& value) const
+    {
+        return AssignToField(typename boost::mpl::begin<typename container_fields<T>::type>::type(), id, value);
+    }
+
+    template <typename FieldT, typename X>
+    bool Field(const FieldT&, const X& value) const
+    {
+        typedef typename boost::mpl::find<SchemaFields, FieldT>::type Position;
+
+        this->template Validate<FieldT>();
+        ReuseValue<Protocols>(FieldT::GetVariable(_var), value);
+        _deserialized.set(boost::mpl::distance<typename boost::mpl::begin<SchemaFields>::type, Position>::value);
+        return false;
+    }
+
+private:
+    typedef typename schema<T>::type::fields SchemaFields;
+    typedef std::bitset<boost::mpl::size<SchemaFields>::value> Mask;
+
+    template <typename X, typename U = T>
+    typename boost::enable_if<has_base<U>, bool>::type
+    AssignToBase(const X& value) const
+    {
+        typedef typename schema<T>::type::base Base;
+
+        if (Apply<Protocols>(ReuseTo<Base, Protocols>(_var), value))
+        {
+            BOND_THROW(CoreException,
+                "De-serialization failed: unexpected struct stop encountered for "
+                << schema<T>::type::GetMetadata().qualified_name);
+        }
+
+        return false;
+    }
+
+    template <typename X, typename U = T>
+    typename boost::disable_if<has_base<U>, bool>::type
+    AssignToBase(const X& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename X>
+    bool AssignToField(const boost::mpl::l_iter<boost::mpl::l_end>&, uint16_t /*id*/, const X& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename Fields, typename X>
+    bool AssignToField(const Fields&, uint16_t id, const X& value) const
+    {
+        typedef typename boost::mpl::deref<Fields>::type Head;
+
+        if (id == Head::id)
+        {
+            return Field(Head(), value);
+        }
+        else
+        {
+            return AssignToField(typename boost::mpl::next<Fields>::type(), id, value);
+        }
+    }
+
+    T& _var;
+    mutable Mask _deserialized;
+};
+
+
+// Output iterators which refer to existing objects of type T, e.g. iterators
+// of a vector, are deserialized into in place by DeserializeMany
+template <typename T, typename Iterator> struct
+refers_to_objects
+    : std::is_same<decltype(*std::declval<Iterator&>()), T&> {};
+
+
+template <typename Protocols, typename T, typename Reader, typename Iterator>
+inline typename boost::enable_if<refers_to_objects<T, Iterator> >::type
+DeserializeElement(const bonded<T, Reader&>& record, Iterator& out)
+{
+    Apply<Protocols>(ReuseTo<T, Protocols>(*out), record);
+}
+
+
+// Objects assigned to other output iterators, e.g. std::back_inserter, don't
+// exist yet and are moved out
+template <typename Protocols, typename T, typename Reader, typename Iterator>
+inline typename boost::disable_if<refers_to_objects<T, Iterator> >::type
+DeserializeElement(const bonded<T, Reader&>& record, Iterator& out)
+{
+    T obj;
+    record.template Deserialize<Protocols>(obj);
+    *out = std::move(obj);
+}
+
+} // namespace detail
+
+
+/// @brief Deserialize an object from a protocol reader, reusing memory held
+/// by the object
+///
+/// The object doesn't need to be reset before the call; the result is the
+/// same as deserializing into a default constructed object. Strings keep
+/// their capacity, elements of vectors, sets and maps are deserialized in
+/// place and nested structs are updated field by field. When the same object
+/// is used to deserialize a stream of similar payloads, memory is allocated
+/// only for data which doesn't fit into what was allocated before.
+template <typename Protocols = BuiltInProtocols, typename Reader, typename T>
+inline void DeserializeReuse(Reader input, T& obj)
+{
+    Apply<Protocols>(detail::ReuseTo<T, Protocols>(obj), bonded<T, Reader&>(input));
+}
+
+} // namespace bond
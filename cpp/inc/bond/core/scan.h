@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "reflection.h"
+#include "transforms.h"
+
+#include <tuple>
+
+
+namespace bond
+{
+
+namespace detail
+{
+
+// Index of a field in a list of fields, or the size of the list if the field
+// isn't in it
+template <typename Field, typename... Fields> struct
+field_index
+    : std::integral_constant<std::size_t, 0> {};
+
+template <typename Field, typename Head, typename... Tail> struct
+field_index<Field, Head, Tail...>
+    : std::integral_constant<std::size_t,
+        std::is_same<Field, Head>::value ? 0 : 1 + field_index<Field, Tail...>::value> {};
+
+
+// Whether all the fields belong to struct T or to one of its bases
+template <typename T, typename... Fields> struct
+fields_of
+    : std::true_type {};
+
+template <typename T, typename Head, typename... Tail> struct
+fields_of<T, Head, Tail...>
+    : std::integral_constant<bool,
+        std::is_base_of<typename Head::struct_type, T>::value && fields_of<T, Tail...>::value> {};
+
+
+//
+// Projector deserializes the selected fields of a struct of type T, or of its
+// bases, into a tuple, without creating an instance of T. The parser skips the
+// values of the other fields using the protocol's Skip.
+//
+template <typename T, typename Protocols, typename... Fields>
+class Projector
+    : public detail::To
+{
+public:
+    typedef T FastPathType;
+    typedef std::tuple<typename Fields::value_type...> Values;
+
+    Projector(Values& values)
+        : _values(values)
+    {}
+
+    void Begin(const Metadata& /*metadata*/) const
+    {}
+
+    void End() const
+    {}
+
+    template <typename X, typename U = T>
+    typename boost::enable_if<has_base<U>, bool>::type
+    Base(const X& value) const
+    {
+        return Apply<Protocols>(Projector<typename schema<T>::type::base, Protocols, Fields...>(_values), value);
+    }
+
+    template <typename X, typename U = T>
+    typename boost::disable_if<has_base<U>, bool>::type
+    Base(const X& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename FieldT, typename X>
+    bool Field(const FieldT&, const X& value) const
+    {
+        Assign(value, std::integral_constant<std::size_t, field_index<FieldT, Fields...>::value>());
+        return false;
+    }
+
+    // Basic values whose type in the payload differs from the schema, e.g.
+    // after a field was changed from int32 to int64
+    template <typename X, typename Reader>
+    bool Field(uint16_t id, const Metadata& /*metadata*/, const value<X, Reader>& value) const
+    {
+        AssignMatching(id, value, std::integral_constant<std::size_t, 0>());
+        return false;
+    }
+
+    // Other values of mismatched types are skipped
+    template <typename X>
+    bool Field(uint16_t /*id*/, const Metadata& /*metadata*/, const X& /*value*/) const
+    {
+        return false;
+    }
+
+    template <typename Reader>
+    bool Field(uint16_t /*id*/, const Metadata& /*metadata*/, const value<void, Reader>& /*value*/) const
+    {
+        return false;
+    }
+
+private:
+    template <typename X, std::size_t I>
+    void Assign(const X& value, std::integral_constant<std::size_t, I>) const
+    {
+        AssignToVar<Protocols>(std::get<I>(_values), value);
+    }
+
+    // Fields which are not selected are skipped by the parser
+    template <typename X>
+    void Assign(const X& /*value*/, std::integral_constant<std::size_t, sizeof...(Fields)>) const
+    {}
+
+    template <typename X, std::size_t I>
+    void AssignMatching(uint16_t id, const X& value, std::integral_constant<std::size_t, I>) const
+    {
+        typedef typename std::tuple_element<I, std::tuple<Fields...> >::type field;
+
+        if (std::is_same<typename field::struct_type, T>::value && id == field::id)
+            AssignIfMatching<field>(value, std::integral_constant<std::size_t, I>());
+        else
+            AssignMatching(id, value, std::integral_constant<std::size_t, I + 1>());
+    }
+
+    template <typename X>
+    void AssignMatching(uint16_t /*id*/, const X& /*value*/,
+                        std::integral_constant<std::size_t, sizeof...(Fields)>) const
+    {}
+
+    template <typename FieldT, typename X, typename Reader, std::size_t I>
+    typename boost::enable_if<is_matching<X, typename FieldT::field_type> >::type
+    AssignIfMatching(const value<X, Reader>& value, std::integral_constant<std::size_t, I>) const
+    {
+        AssignToVar<Protocols>(std::get<I>(_values), value);
+    }
+
+    template <typename FieldT, typename X, typename Reader, std::size_t I>
+    typename boost::disable_if<is_matching<X, typename FieldT::field_type> >::type
+    AssignIfMatching(const value<X, Reader>& /*value*/, std::integral_constant<std::size_t, I>) const
+    {}
+
+    Values& _values;
+};
+
+
+// Calls the function with the elements of the tuple as arguments
+template <typename Function, typename Values, typename... Args>
+inline typename boost::enable_if_c<sizeof...(Args) == std::tuple_size<Values>::value>::type
+InvokeWithValues(const Function& function, Values& /*values*/, Args&... args)
+{
+    function(args...);
+}
+
+template <typename Function, typename Values, typename... Args>
+inline typename boost::enable_if_c<sizeof...(Args) < std::tuple_size<Values>::value>::type
+InvokeWithValues(const Function& function, Values& values, Args&... args)
+{
+    InvokeWithValues(function, values, args..., std::get<sizeof...(Args)>(values));
+}
+
+
+//
+// Scanner reads the selected fields of structs of type T from a reader, one
+// struct at a time. The values of fields absent from the payload are the
+// defaults from the schema.
+//
+template <typename T, typename Protocols, typename... Fields>
+class Scanner
+{
+public:
+    BOOST_STATIC_ASSERT(has_schema<T>::value);
+    BOOST_STATIC_ASSERT((fields_of<T, Fields...>::value));
+
+    typedef typename Projector<T, Protocols, Fields...>::Values Values;
+
+    Scanner()
+        : _defaults(Defaults(T()))
+    {}
+
+    template <typename Reader, typename Function>
+    void Read(Reader& input, const Function& function)
+    {
+        _values = _defaults;
+        Apply<Protocols>(Projector<T, Protocols, Fields...>(_values), bonded<T, Reader&>(input));
+        InvokeWithValues(function, _values);
+    }
+
+private:
+    static Values Defaults(const T& obj)
+    {
+        return Values(Fields::GetVariable(obj)...);
+    }
+
+    const Values _defaults;
+    Values _values;
+};
+
+} // namespace detail
+
+} // namespace bond
@@ -274,7 +274,7 @@ private:
             std::end(structs),
             [](const StructDef& def)
             {
-                return def.metadata.qualified_name == schema<T>::type::metadata.qualified_name;
+                return def.metadata.qualified_name == schema<T>::type::GetMetadata().qualified_name;
             });
 
         const auto index = static_cast<uint16_t>(std::distance(std::begin(structs), it));
@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "blob.h"
+#include "bond.h"
+
+#include <bond/stream/output_buffer.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace bond
+{
+
+/// @brief Immutable object which caches its serialized payloads
+///
+/// The object is serialized at most once for each protocol and protocol
+/// version, on first use, and the payload is reused afterwards. The Serialize
+/// method writes the cached payload to the output stream as a blob, which
+/// OutputBuffer chains without copying.
+///
+/// To send the object as a nested field, declare the field as `bonded<T>`
+/// and assign it the result of get_bonded. Serializer passes the payload
+/// through when the protocol and version match those of the writer. With
+/// untagged protocols bonded fields are marshaled as Compact Binary, so use
+/// a Compact Binary payload for them.
+///
+/// All methods are thread-safe.
+template <typename T>
+class serialized_cache
+    : boost::noncopyable
+{
+public:
+    /// @brief Construct with a copy of the object
+    explicit
+    serialized_cache(const T& value)
+        : _value(boost::make_shared<T>(value))
+    {}
+
+    /// @brief Construct by moving the object
+    explicit
+    serialized_cache(T&& value)
+        : _value(boost::make_shared<T>(std::move(value)))
+    {}
+
+    /// @brief Construct from a shared pointer to the object
+    explicit
+    serialized_cache(const boost::shared_ptr<const T>& value)
+        : _value(value)
+    {
+        BOOST_ASSERT(_value);
+    }
+
+    /// @brief The cached object
+    const T& value() const
+    {
+        return *_value;
+    }
+
+    /// @brief Serialize the object using specified protocol writer
+    ///
+    /// The object is serialized on first use with the writer's protocol and
+    /// version. The cached payload is written to the output as a blob.
+    template <typename Protocols = BuiltInProtocols, typename Writer>
+    void Serialize(Writer& output) const
+    {
+        output.GetBuffer().Write(
+            get<typename Writer::Reader, Protocols>(detail::WriterVersion(output)));
+    }
+
+    /// @brief Payload of the object serialized with the protocol of the
+    /// specified reader and the specified protocol version
+    template <typename Reader, typename Protocols = BuiltInProtocols>
+    blob get(uint16_t version = default_version<Reader>::value) const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        for (const entry& e : _entries)
+        {
+            if (e.magic == Reader::magic && e.version == version)
+            {
+                return e.data;
+            }
+        }
+
+        OutputBuffer output;
+        SerializePayload<Protocols>(output, version, static_cast<Reader*>(nullptr));
+
+        _entries.push_back(entry{ Reader::magic, version, output.GetBuffer() });
+        return _entries.back().data;
+    }
+
+    /// @brief bonded<T> referencing the payload of the object serialized
+    /// with the protocol of the specified reader and the specified version
+    ///
+    /// `Reader` must be a protocol reader over a buffer constructible from a
+    /// blob, e.g. `CompactBinaryReader<InputBuffer>`.
+    template <typename Reader, typename Protocols = BuiltInProtocols>
+    bonded<T> get_bonded(uint16_t version = default_version<Reader>::value) const
+    {
+        typename Reader::Buffer input(get<Reader, Protocols>(version));
+
+        return bonded<T>(MakeReader(input, version, static_cast<Reader*>(nullptr)));
+    }
+
+    /// @brief Number of cached payloads
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        return _entries.size();
+    }
+
+private:
+    struct entry
+    {
+        uint16_t magic;
+        uint16_t version;
+        blob data;
+    };
+
+    template <typename Protocols, typename Reader>
+    typename boost::enable_if<protocol_has_multiple_versions<Reader> >::type
+    SerializePayload(OutputBuffer& output, uint16_t version, Reader*) const
+    {
+        typename get_protocol_writer<Reader, OutputBuffer>::type writer(output, version);
+
+        bond::Serialize<Protocols>(*_value, writer);
+    }
+
+    template <typename Protocols, typename Reader>
+    typename boost::disable_if<protocol_has_multiple_versions<Reader> >::type
+    SerializePayload(OutputBuffer& output, uint16_t /*version*/, Reader*) const
+    {
+        typename get_protocol_writer<Reader, OutputBuffer>::type writer(output);
+
+        bond::Serialize<Protocols>(*_value, writer);
+    }
+
+    template <typename Reader>
+    static
+    typename boost::enable_if<protocol_has_multiple_versions<Reader>, Reader>::type
+    MakeReader(typename Reader::Buffer& input, uint16_t version, Reader*)
+    {
+        return Reader(input, version);
+    }
+
+    template <typename Reader>
+    static
+    typename boost::disable_if<protocol_has_multiple_versions<Reader>, Reader>::type
+    MakeReader(typename Reader::Buffer& input, uint16_t /*version*/, Reader*)
+    {
+        return Reader(input);
+    }
+
+    boost::shared_ptr<const T> _value;
+    mutable std::mutex _lock;
+    mutable std::vector<entry> _entries;
+};
+
+} // namespace bond
@@ -15,6 +15,9 @@
 #include <set>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 // Bond container interface on top of STL container classes
@@ -75,6 +78,18 @@ is_map_container<std::map<K, T, C, A> >
     : std::true_type {};
 
 
+// is_set_container<std::unordered_set<T, H, E, A> >
+template <typename T, typename H, typename E, typename A> struct
+is_set_container<std::unordered_set<T, H, E, A> >
+    : std::true_type {};
+
+
+// is_map_container<std::unordered_map<K, T, H, E, A> >
+template <typename K, typename T, typename H, typename E, typename A> struct
+is_map_container<std::unordered_map<K, T, H, E, A> >
+    : std::true_type {};
+
+
 // specialize element_type for map becuase map::value_type is pair<const K, T>
 template <typename K, typename T, typename C, typename A> struct
 element_type<std::map<K, T, C, A> >
@@ -83,6 +98,13 @@ element_type<std::map<K, T, C, A> >
 };
 
 
+template <typename K, typename T, typename H, typename E, typename A> struct
+element_type<std::unordered_map<K, T, H, E, A> >
+{
+    typedef typename std::pair<K, T> type;
+};
+
+
 // string_data
 template<typename C, typename T, typename A>
 inline
@@ -131,6 +153,29 @@ uint32_t container_size(const T& list)
 }
 
 
+// container_reserve
+template <typename T>
+inline
+void container_reserve(T& /*container*/, uint32_t /*size*/)
+{}
+
+
+template <typename T, typename H, typename E, typename A>
+inline
+void container_reserve(std::unordered_set<T, H, E, A>& set, uint32_t size)
+{
+    set.reserve(size);
+}
+
+
+template <typename K, typename T, typename H, typename E, typename A>
+inline
+void container_reserve(std::unordered_map<K, T, H, E, A>& map, uint32_t size)
+{
+    map.reserve(size);
+}
+
+
 // use_container_allocator_for_elements
 template <typename T, typename Enable = void> struct
 use_container_allocator_for_elements
@@ -205,15 +250,49 @@ void clear_set(std::set<T, C, A>& set)
 }
 
 
+template <typename T, typename H, typename E, typename A>
+inline
+void clear_set(std::unordered_set<T, H, E, A>& set)
+{
+    set.clear();
+}
+
+
 // set_insert
+// Elements are serialized in order so they are inserted with the end of the
+// set as a hint, which is constant time when the hint is right.
 template <typename T, typename C, typename A>
 inline
 void set_insert(std::set<T, C, A>& set, const T& item)
+{
+    set.insert(set.end(), item);
+}
+
+
+template <typename T, typename C, typename A>
+inline
+void set_insert(std::set<T, C, A>& set, T&& item)
+{
+    set.insert(set.end(), std::move(item));
+}
+
+
+template <typename T, typename H, typename E, typename A>
+inline
+void set_insert(std::unordered_set<T, H, E, A>& set, const T& item)
 {
     set.insert(item);
 }
 
 
+template <typename T, typename H, typename E, typename A>
+inline
+void set_insert(std::unordered_set<T, H, E, A>& set, T&& item)
+{
+    set.insert(std::move(item));
+}
+
+
 // clear_map
 template <typename K, typename T, typename C, typename A>
 inline
@@ -223,6 +302,14 @@ void clear_map(std::map<K, T, C, A>& map)
 }
 
 
+template <typename K, typename T, typename H, typename E, typename A>
+inline
+void clear_map(std::unordered_map<K, T, H, E, A>& map)
+{
+    map.clear();
+}
+
+
 // use_map_allocator_for_keys
 template <typename T, typename Enable = void> struct
 use_map_allocator_for_keys
@@ -307,6 +394,55 @@ const T& mapped_at(const std::map<K, T, C, A>& map, const K& key)
 }
 
 
+template <typename K, typename T, typename H, typename E, typename A>
+inline
+T& mapped_at(std::unordered_map<K, T, H, E, A>& map, const K& key)
+{
+    return map.insert(typename std::unordered_map<K, T, H, E, A>::value_type(key, make_value(map))).first->second;
+}
+
+
+template <typename K, typename T, typename H, typename E, typename A>
+inline
+const T& mapped_at(const std::unordered_map<K, T, H, E, A>& map, const K& key)
+{
+    typename std::unordered_map<K, T, H, E, A>::const_iterator it = map.find(key);
+
+    if (it == map.end())
+        ElementNotFoundException(key);
+
+    return it->second;
+}
+
+
+// map_insert
+// Like mapped_at but the key can be moved into the map. Deserialization
+// calls it for consecutive keys of a map payload, which are in order, so the
+// end of the map is used as a hint.
+template <typename M, typename K>
+inline
+typename element_type<M>::type::second_type& map_insert(M& map, const K& key)
+{
+    return mapped_at(map, key);
+}
+
+
+template <typename K, typename T, typename C, typename A>
+inline
+T& map_insert(std::map<K, T, C, A>& map, K&& key)
+{
+    return map.emplace_hint(map.end(), std::move(key), make_value(map))->second;
+}
+
+
+template <typename K, typename T, typename H, typename E, typename A>
+inline
+T& map_insert(std::unordered_map<K, T, H, E, A>& map, K&& key)
+{
+    return map.emplace(std::move(key), make_value(map)).first->second;
+}
+
+
 // enumerators
 template <typename T>
 class const_enumerator
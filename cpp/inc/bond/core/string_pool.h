@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "blob.h"
+#include "blob_string.h"
+
+#include <bond/stream/input_buffer.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <cstring>
+#include <stdint.h>
+#include <unordered_set>
+
+namespace bond
+{
+
+/// @brief Pool of distinct string values
+///
+/// Interning a blob_string or blob_wstring makes it reference the pool's copy
+/// of its value, so that equal strings share the same immutable memory and
+/// memory use scales with the number of distinct values. Strings can be
+/// interned during deserialization by reading from an InterningInputBuffer.
+///
+/// The pool holds a reference to every value until it is cleared or
+/// destroyed. Strings referencing the pool's memory stay valid after that.
+/// The pool is not thread-safe.
+class string_pool
+{
+public:
+    string_pool()
+        : _hits(),
+          _misses(),
+          _allocated()
+    {}
+
+    string_pool(const string_pool&) = delete;
+    string_pool& operator=(const string_pool&) = delete;
+
+    /// @brief Return the pooled blob with the same content as the argument,
+    /// adding a copy of it to the pool if needed. Empty blobs aren't pooled.
+    blob intern(const blob& value)
+    {
+        if (value.empty())
+        {
+            return value;
+        }
+
+        auto it = _values.find(value);
+
+        if (it != _values.end())
+        {
+            ++_hits;
+            return *it;
+        }
+
+        ++_misses;
+
+        // Memory from operator new[] is suitably aligned for wide characters
+        boost::shared_ptr<char[]> buffer(new char[value.length()]);
+        std::memcpy(buffer.get(), value.content(), value.length());
+
+        blob pooled(buffer, value.length());
+
+        _values.insert(pooled);
+        _allocated += value.length();
+
+        return pooled;
+    }
+
+    /// @brief Make the string reference the pooled copy of its value
+    template <typename C>
+    void intern(basic_blob_string<C>& str)
+    {
+        str.assign(intern(str.get_blob()));
+    }
+
+    /// @brief Number of distinct values in the pool
+    size_t size() const
+    {
+        return _values.size();
+    }
+
+    /// @brief Number of bytes allocated for the values in the pool
+    uint64_t allocated() const
+    {
+        return _allocated;
+    }
+
+    /// @brief Number of interned values which were already in the pool
+    uint64_t hits() const
+    {
+        return _hits;
+    }
+
+    /// @brief Number of interned values which were added to the pool
+    uint64_t misses() const
+    {
+        return _misses;
+    }
+
+    /// @brief Ratio of hits to all interned non-empty values
+    double hit_rate() const
+    {
+        const uint64_t total = _hits + _misses;
+
+        return total ? static_cast<double>(_hits) / total : 0;
+    }
+
+    /// @brief Remove all values from the pool and reset the statistics
+    void clear()
+    {
+        _values.clear();
+        _hits = _misses = _allocated = 0;
+    }
+
+private:
+    struct hasher
+    {
+        size_t operator()(const blob& value) const
+        {
+            return boost::hash_range(value.begin(), value.end());
+        }
+    };
+
+    std::unordered_set<blob, hasher> _values;
+    uint64_t _hits;
+    uint64_t _misses;
+    uint64_t _allocated;
+};
+
+
+/// @brief Input buffer which interns deserialized blob_string and
+/// blob_wstring values in a string_pool
+///
+/// Other string types are deserialized the same way as by InputBuffer. The
+/// pool must outlive the buffer and any readers using it.
+class InterningInputBuffer
+    : public InputBuffer
+{
+public:
+    InterningInputBuffer(const blob& blob, string_pool& pool)
+        : InputBuffer(blob),
+          _pool(&pool)
+    {}
+
+    InterningInputBuffer(const void* buffer, uint32_t length, string_pool& pool)
+        : InputBuffer(buffer, length),
+          _pool(&pool)
+    {}
+
+    string_pool& GetPool() const
+    {
+        return *_pool;
+    }
+
+private:
+    string_pool* _pool;
+};
+
+
+inline InterningInputBuffer CreateInputBuffer(const InterningInputBuffer& other, const blob& blob)
+{
+    return InterningInputBuffer(blob, other.GetPool());
+}
+
+
+BOND_DEFINE_BUFFER_MAGIC(InterningInputBuffer, 0x5049 /*IP*/);
+
+
+namespace detail
+{
+
+template <> struct
+string_data_reader<InterningInputBuffer, blob_string, void>
+{
+    static void Read(InterningInputBuffer& input, blob_string& value, uint32_t length)
+    {
+        string_data_reader<InputBuffer, blob_string, void>::Read(input, value, length);
+        input.GetPool().intern(value);
+    }
+};
+
+// Wide strings are encoded as UTF-16 and can't reference the input buffer
+template <> struct
+string_data_reader<InterningInputBuffer, blob_wstring, void>
+{
+    static void Read(InterningInputBuffer& input, blob_wstring& value, uint32_t length)
+    {
+        value.resize(length);
+
+        wchar_t* data = value.mutable_data();
+        wchar_t* const data_end = data + length;
+        uint16_t ch;
+        for (; data != data_end; ++data)
+        {
+            input.Read(ch);
+            *data = static_cast<wchar_t>(ch);
+        }
+
+        input.GetPool().intern(value);
+    }
+};
+
+} // namespace detail
+
+} // namespace bond
@@ -6,6 +6,7 @@
 #include <bond/core/config.h>
 
 #include "bond_fwd.h"
+#include "bond_version.h"
 #include "detail/mpl.h"
 #include "scalar_interface.h"
 
@@ -88,6 +89,28 @@ bool is_protocol_version_same(const Reader&, const Writer&)
 }
 
 
+namespace detail
+{
+
+// Protocol version used by a writer
+template <typename Writer>
+typename boost::enable_if<protocol_has_multiple_versions<typename Writer::Reader>, uint16_t>::type
+inline WriterVersion(const Writer& output)
+{
+    return output.GetVersion();
+}
+
+
+template <typename Writer>
+typename boost::disable_if<protocol_has_multiple_versions<typename Writer::Reader>, uint16_t>::type
+inline WriterVersion(const Writer& /*output*/)
+{
+    return default_version<typename Writer::Reader>::value;
+}
+
+} // namespace detail
+
+
 // By default if a protocol has multiple versions any of the versions can be
 // used by an application. This template can be specialized to fix protocol to
 // a single version specified by default_version<Reader>. This can enable some
@@ -8,9 +8,11 @@
 #include "bond_fwd.h"
 #include "detail/debug.h"
 #include "detail/double_pass.h"
+#include "detail/flat_struct.h"
 #include "detail/marshaled_bonded.h"
 #include "detail/odr.h"
 #include "detail/omit_default.h"
+#include "detail/parser_utils.h"
 #include "detail/tags.h"
 #include "exception.h"
 #include "null.h"
@@ -32,9 +34,22 @@ namespace detail
     template <typename T, typename Schema, typename Transform>
     class _Parser;
 
+    template <typename T, typename Writer, typename Protocols>
+    class Differ;
+
 } // namespace detail
 
 
+/// @brief Indicates whether protocol writer T can write field headers
+/// encoded at compile time.
+///
+/// Serializer passes ids and types of fields of structs with compile-time
+/// schema to such writers as template arguments.
+template <typename T> struct
+uses_static_field_headers
+    : std::false_type {};
+
+
 //
 // Serializer writes input using provided protocol writer.
 // When the input is comming from parsing a struct, applying this transform is
@@ -148,6 +163,37 @@ public:
         return false;
     }
 
+    // Field of a struct with compile-time schema, known when writing an
+    // instance of the struct
+    template <typename FieldT, typename T, typename W = Writer>
+    typename boost::enable_if_c<uses_static_field_headers<W>::value && !is_bond_type<T>::value, bool>::type
+    KnownField(const FieldT&, const T& value) const
+    {
+        if (detail::omit_field<Writer>(FieldT::GetMetadata(), value))
+        {
+            detail::WriteFieldOmitted(_output, get_type_id<typename FieldT::field_type>::value, FieldT::id, FieldT::GetMetadata());
+            return false;
+        }
+
+        WriteField(FieldT(), value);
+        return false;
+    }
+
+    template <typename FieldT, typename T, typename W = Writer>
+    typename boost::enable_if_c<uses_static_field_headers<W>::value && is_bond_type<T>::value, bool>::type
+    KnownField(const FieldT&, const T& value) const
+    {
+        WriteField(FieldT(), value);
+        return false;
+    }
+
+    template <typename FieldT, typename T, typename W = Writer>
+    typename boost::disable_if<uses_static_field_headers<W>, bool>::type
+    KnownField(const FieldT&, const T& value) const
+    {
+        return Field(FieldT::id, FieldT::GetMetadata(), value);
+    }
+
     // unknown field
     template <typename T>
     bool UnknownField(uint16_t id, const T& value) const
@@ -212,6 +258,30 @@ private:
         _output.WriteFieldEnd();
     }
 
+    // basic type field with the header encoded at compile time
+    template <typename FieldT, typename T>
+    typename boost::enable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+    WriteField(const FieldT&, const T& value) const
+    {
+        _output.template WriteField<FieldT::id>(value);
+    }
+
+    // struct or container field with the header encoded at compile time
+    template <typename FieldT, typename T>
+    typename boost::disable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value>::type
+    WriteField(const FieldT&, const T& value) const
+    {
+        _output.template WriteFieldBegin<get_type_id<T>::value, FieldT::id>();
+        Write(value);
+        _output.WriteFieldEnd();
+    }
+
+    template <typename FieldT, typename T>
+    void WriteField(const FieldT&, const maybe<T>& value) const
+    {
+        WriteField(FieldT(), value.value());
+    }
+
     // basic type value
     template <typename T>
     typename boost::enable_if_c<is_basic_type<T>::value && !is_type_alias<T>::value && true>::type
@@ -275,6 +345,16 @@ private:
         _output.WriteContainerEnd();
     }
 
+    // vector of flat structs and writer which packs fields
+    template <typename T, typename Alloc>
+    typename boost::enable_if<detail::is_packed_flat_struct<Writer, T> >::type
+    Write(const std::vector<T, Alloc>& value) const
+    {
+        _output.WriteContainerBegin(container_size(value), get_type_id<T>::value);
+        detail::WriteFlatStructs(_output.GetBuffer(), value);
+        _output.WriteContainerEnd();
+    }
+
 
     // blob
     void Write(const blob& value) const
@@ -307,6 +387,9 @@ private:
     template <typename T, typename WriterT, typename ProtocolsT>
     friend class Merger;
 
+    template <typename T, typename WriterT, typename ProtocolsT>
+    friend class detail::Differ;
+
     template <typename T, typename Reader, typename Enable>
     friend class value;
 
@@ -316,12 +399,24 @@ private:
     template <typename ProtocolsT, typename Transform, typename T>
     friend bool detail::DoublePassApply(const Transform&, const T&);
 
+    template <typename WriterT, typename ProtocolsT, typename T>
+    friend bool detail::ApplyFlatStruct(const Serializer<WriterT, ProtocolsT>&, const T&);
+
 protected:
     Writer&     _output;
     const bool  _base;
 };
 
 
+namespace detail
+{
+    template <typename Writer, typename Protocols> struct
+    uses_known_fields<Serializer<Writer, Protocols> >
+        : uses_static_field_headers<Writer> {};
+
+} // namespace detail
+
+
 // SerializeTo
 template <typename Protocols, typename Writer>
 Serializer<Writer, Protocols> SerializeTo(Writer& output)
@@ -437,7 +532,7 @@ void RequiredFieldValiadator<T>::MissingFieldException() const
 
     BOND_THROW(CoreException,
           "De-serialization failed: required field " << _required <<
-          " is missing from " << schema<T>::type::metadata.qualified_name);
+          " is missing from " << schema<T>::type::GetMetadata().qualified_name);
 }
 
 //
@@ -606,9 +701,12 @@ private:
 
         BOND_THROW(CoreException,
             "De-serialization failed: unexpected struct stop encountered for "
-            << schema<T>::type::metadata.qualified_name);
+            << schema<T>::type::GetMetadata().qualified_name);
     }
 
+    template <typename U, typename ProtocolsT, typename ValidatorT, typename Reader>
+    friend bool detail::ApplyFlatStruct(const To<U, ProtocolsT, ValidatorT>&, Reader&);
+
     T& _var;
 };
 
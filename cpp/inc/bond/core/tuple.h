@@ -19,42 +19,35 @@ template <typename ...T>
 struct schema<std::tuple<T...>>
 {
     struct type
+        : reflection::SchemaTemplate<type>
     {
         typedef no_base base;
         typedef typename detail::tuple_fields<std::tuple<T...>, 0, T...>::type fields;
 
-        static const Metadata metadata;
-
-        type()
+        static const Metadata& GetMetadata()
         {
-            // Force instantiation of template statics
-            (void)metadata;
-        }
+            static const Metadata s_metadata = []
+            {
+                Metadata m = reflection::MetadataInit(
+                    "tuple", "bond.tuple", reflection::Attributes());
 
-        static Metadata GetMetadata()
-        {
-            Metadata m = reflection::MetadataInit(
-                "tuple", "bond.tuple", reflection::Attributes());
+                std::string params;
 
-            std::string params;
+                boost::mpl::for_each<typename detail::param_list<T...>::type>(
+                    detail::TypeListBuilder(params));
 
-            boost::mpl::for_each<typename detail::param_list<T...>::type>(
-                detail::TypeListBuilder(params));
+                m.name += "<" + params + ">";
+                m.qualified_name += "<" + params + ">";
 
-            m.name += "<" + params + ">";
-            m.qualified_name += "<" + params + ">";
+                return m;
+            }();
 
-            return m;
+            return s_metadata;
         }
     };
 };
 
 
-template <typename... T>
-const Metadata schema<std::tuple<T...>>::type::metadata
-    = schema<std::tuple<T...>>::type::GetMetadata();
-
-
 template <typename Protocols = BuiltInProtocols, typename Writer, typename... T>
 inline void Pack(Writer& writer, T&&... args)
 {
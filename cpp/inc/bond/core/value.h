@@ -5,6 +5,7 @@
 
 #include <bond/core/config.h>
 
+#include "detail/flat_struct.h"
 #include "protocol.h"
 #include "schema.h"
 
@@ -207,6 +208,14 @@ public:
         bond::Skip<T, typename std::remove_reference<Reader>::type>(_input);
     }
 
+    // Access to the underlying reader for consumers which read the value
+    // directly from the protocol; the whole value must be read.
+    Reader _Input() const
+    {
+        _skip = false;
+        return _input;
+    }
+
     // skip value of non-matching type
     template <typename Protocols = BuiltInProtocols, typename X>
     void Deserialize(X& /*var*/, typename boost::disable_if<is_matching<T, X> >::type* = nullptr) const
@@ -671,19 +680,29 @@ inline void DeserializeElements(blob& var, const value<blob::value_type, Reader&
 }
 
 
+template <typename Protocols, typename T, typename Alloc, typename Reader>
+typename boost::enable_if<detail::is_packed_flat_struct<Reader, T> >::type
+inline DeserializeElements(std::vector<T, Alloc>& var, const value<T, Reader&>& element, uint32_t size)
+{
+    resize_list(var, size);
+    detail::ReadFlatStructs(element._Input().GetBuffer(), var);
+}
+
+
 template <typename Protocols, typename X, typename T>
 typename boost::enable_if_c<is_set_container<X>::value
                          && is_element_matching<T, X>::value>::type
 inline DeserializeElements(X& var, const T& element, uint32_t size)
 {
     clear_set(var);
+    container_reserve(var, size);
 
     typename element_type<X>::type e(make_element(var));
 
     while (size--)
     {
         element.template Deserialize<Protocols>(e);
-        set_insert(var, e);
+        set_insert(var, std::move(e));
     }
 }
 
@@ -841,6 +860,7 @@ inline DeserializeMapElements(X& var, const Key& key, const T& element, uint32_t
     BOOST_STATIC_ASSERT((is_map_element_matching<T, X>::value));
 
     clear_map(var);
+    container_reserve(var, size);
 
     typename element_type<X>::type::first_type k(make_key(var));
 
@@ -852,9 +872,9 @@ inline DeserializeMapElements(X& var, const Key& key, const T& element, uint32_t
         // In debug build To<T> asserts that optional fields are set to default
         // values before deserialization; if invalid map payload contains duplicate
         // keys the second time we deserialize a value it will trigger the assert.
-        element.template Deserialize<Protocols>(mapped_at(var, k) = make_value(var));
+        element.template Deserialize<Protocols>(map_insert(var, std::move(k)) = make_value(var));
 #else
-        element.template Deserialize<Protocols>(mapped_at(var, k));
+        element.template Deserialize<Protocols>(map_insert(var, std::move(k)));
 #endif
     }
 }
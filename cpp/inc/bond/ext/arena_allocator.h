@@ -0,0 +1,299 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/detail/alloc.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace bond { namespace ext
+{
+    /// @brief Monotonic memory resource that hands out memory from chunks
+    /// obtained from an upstream allocator.
+    ///
+    /// @tparam Alloc upstream allocator type used to allocate the chunks. Use
+    /// \ref capped_allocator to limit the total amount of memory the arena
+    /// may consume.
+    ///
+    /// @remarks Individual deallocations are no-ops, except for the most recent
+    /// allocation which can be rolled back. All the memory is returned to the
+    /// upstream allocator at once by \ref release or when the arena is
+    /// destroyed, in time proportional to the number of chunks rather than the
+    /// number of allocations. The arena is not thread-safe and must outlive all
+    /// objects allocated from it.
+    template <typename Alloc = std::allocator<char>>
+    class arena
+        : private bond::detail::allocator_holder<
+            typename std::allocator_traits<Alloc>::template rebind_alloc<char>>
+    {
+        using char_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<char>;
+        using holder = bond::detail::allocator_holder<char_alloc>;
+        using traits = std::allocator_traits<char_alloc>;
+
+        static_assert(std::is_same<typename traits::pointer, char*>::value,
+            "Upstream allocator must use raw pointers.");
+
+    public:
+        /// @brief Default size of the first chunk.
+        static const std::size_t default_chunk_size = 4 * 1024;
+
+        /// @brief Chunks grow geometrically up to this size.
+        static const std::size_t max_chunk_size = 1024 * 1024;
+
+        /// @brief Constructs an empty arena.
+        ///
+        /// @param chunk_size size of the first chunk; subsequent chunks
+        /// double in size up to \ref max_chunk_size.
+        ///
+        /// @param alloc the upstream allocator instance.
+        explicit arena(std::size_t chunk_size = default_chunk_size, const Alloc& alloc = {})
+            : holder{ char_alloc{ alloc } },
+              _head{ nullptr },
+              _current{ nullptr },
+              _end{ nullptr },
+              _first_chunk_size{ chunk_size > sizeof(chunk) ? chunk_size : default_chunk_size },
+              _next_chunk_size{ _first_chunk_size },
+              _allocated{ 0 },
+              _reserved{ 0 }
+        {}
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        ~arena()
+        {
+            release();
+        }
+
+        /// @brief Allocates \p size bytes aligned to \p alignment.
+        ///
+        /// @throw std::bad_alloc or any exception thrown by the upstream
+        /// allocator if a new chunk can't be allocated.
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+        {
+            BOOST_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+            char* ptr = align(_current, alignment);
+
+            if (_current == nullptr || ptr > _end || size > static_cast<std::size_t>(_end - ptr))
+            {
+                if (size > (std::numeric_limits<std::size_t>::max)() - (alignment - 1))
+                {
+                    throw std::bad_alloc{};
+                }
+
+                add_chunk(size + alignment - 1);
+                ptr = align(_current, alignment);
+            }
+
+            _current = ptr + size;
+            _allocated += size;
+            return ptr;
+        }
+
+        /// @brief Returns memory to the arena.
+        ///
+        /// @remarks The memory is reclaimed only if it is the most recent
+        /// allocation, which makes growing the last allocated buffer cheap.
+        void deallocate(void* ptr, std::size_t size) BOND_NOEXCEPT
+        {
+            if (static_cast<char*>(ptr) + size == _current)
+            {
+                _current = static_cast<char*>(ptr);
+                _allocated -= size;
+            }
+        }
+
+        /// @brief Returns all chunks to the upstream allocator.
+        ///
+        /// @remarks All the memory allocated from the arena becomes invalid.
+        /// The next chunk has the size of the first one again.
+        void release() BOND_NOEXCEPT
+        {
+            while (_head != nullptr)
+            {
+                chunk* next = _head->next;
+                traits::deallocate(holder::get(), reinterpret_cast<char*>(_head), _head->size);
+                _head = next;
+            }
+
+            _current = _end = nullptr;
+            _next_chunk_size = _first_chunk_size;
+            _allocated = _reserved = 0;
+        }
+
+        /// @brief Returns the number of bytes handed out by the arena.
+        std::size_t allocated() const BOND_NOEXCEPT
+        {
+            return _allocated;
+        }
+
+        /// @brief Returns the number of bytes obtained from the upstream
+        /// allocator.
+        std::size_t reserved() const BOND_NOEXCEPT
+        {
+            return _reserved;
+        }
+
+        const char_alloc& get_allocator() const BOND_NOEXCEPT
+        {
+            return holder::get();
+        }
+
+    private:
+        struct chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+        static char* align(char* ptr, std::size_t alignment) BOND_NOEXCEPT
+        {
+            const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(ptr);
+            return ptr + ((alignment - value % alignment) % alignment);
+        }
+
+        void add_chunk(std::size_t min_size)
+        {
+            if (min_size > (std::numeric_limits<std::size_t>::max)() - sizeof(chunk))
+            {
+                throw std::bad_alloc{};
+            }
+
+            const std::size_t size = (std::max)(_next_chunk_size, min_size + sizeof(chunk));
+
+            chunk* c = reinterpret_cast<chunk*>(traits::allocate(holder::get(), size));
+            c->next = _head;
+            c->size = size;
+
+            _head = c;
+            _current = reinterpret_cast<char*>(c + 1);
+            _end = reinterpret_cast<char*>(c) + size;
+            _reserved += size;
+
+            if (_next_chunk_size < max_chunk_size)
+            {
+                _next_chunk_size = (std::min)(_next_chunk_size * 2, max_chunk_size);
+            }
+        }
+
+        chunk* _head;
+        char* _current;
+        char* _end;
+        const std::size_t _first_chunk_size;
+        std::size_t _next_chunk_size;
+        std::size_t _allocated;
+        std::size_t _reserved;
+    };
+
+    template <typename Alloc>
+    const std::size_t arena<Alloc>::default_chunk_size;
+
+    template <typename Alloc>
+    const std::size_t arena<Alloc>::max_chunk_size;
+
+
+    /// @brief STL-compatible allocator that allocates from an \ref arena.
+    ///
+    /// @tparam T value type.
+    ///
+    /// @tparam Alloc upstream allocator type of the arena.
+    ///
+    /// @remarks Can be used with the \c --allocator option of gbc, for
+    /// example \c --allocator="bond::ext::arena_allocator<>". Destroying an
+    /// object graph allocated this way does not free any memory; the memory
+    /// is reclaimed when the arena is released.
+    template <typename T = char, typename Alloc = std::allocator<char>>
+    class arena_allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using void_pointer = void*;
+        using const_void_pointer = const void*;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+#if __cplusplus >= 201703L
+        using is_always_equal = std::false_type;
+#endif
+
+        template <typename U>
+        struct rebind
+        {
+            using other = arena_allocator<U, Alloc>;
+        };
+
+
+        /// @brief Constructs an allocator that allocates from \p a.
+        explicit arena_allocator(arena<Alloc>& a) BOND_NOEXCEPT
+            : _arena{ &a }
+        {}
+
+        /// @brief Converts from an allocator for a different type.
+        template <typename U>
+        arena_allocator(const arena_allocator<U, Alloc>& other) BOND_NOEXCEPT
+            : _arena{ &other.get_arena() }
+        {}
+
+        T* allocate(size_type n)
+        {
+            if (n > max_size())
+            {
+                throw std::bad_alloc{};
+            }
+
+            return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_type n) BOND_NOEXCEPT
+        {
+            _arena->deallocate(ptr, n * sizeof(T));
+        }
+
+        size_type max_size() const BOND_NOEXCEPT
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(T);
+        }
+
+        arena<Alloc>& get_arena() const BOND_NOEXCEPT
+        {
+            return *_arena;
+        }
+
+    private:
+        arena<Alloc>* _arena;
+    };
+
+
+    template <typename T1, typename T2, typename Alloc>
+    inline bool operator==(
+        const arena_allocator<T1, Alloc>& a1,
+        const arena_allocator<T2, Alloc>& a2) BOND_NOEXCEPT
+    {
+        return &a1.get_arena() == &a2.get_arena();
+    }
+
+    template <typename T1, typename T2, typename Alloc>
+    inline bool operator!=(
+        const arena_allocator<T1, Alloc>& a1,
+        const arena_allocator<T2, Alloc>& a2) BOND_NOEXCEPT
+    {
+        return !(a1 == a2);
+    }
+
+} } // namespace bond::ext
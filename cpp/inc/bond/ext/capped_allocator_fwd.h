@@ -16,6 +16,9 @@ namespace bond { namespace ext
     template <typename T = std::size_t>
     class multi_threaded_counter;
 
+    template <typename T = std::size_t>
+    class sharded_counter;
+
     template <typename Counter = multi_threaded_counter<>>
     class shared_counter;
 
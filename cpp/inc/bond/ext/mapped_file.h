@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/exception.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+
+#if defined(_WIN32) || defined(WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace bond { namespace ext
+{
+    /// @brief Read-only memory mapping of a whole file.
+    ///
+    /// The mapping stays valid for the lifetime of the object. It can be used
+    /// as the input of \ref record_file_reader.
+    class mapped_file : boost::noncopyable
+    {
+    public:
+        explicit mapped_file(const char* path)
+            : _data(nullptr),
+              _size(0)
+        {
+#if defined(_WIN32) || defined(WIN32)
+            HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                Error("open", path);
+
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(file, &size))
+            {
+                ::CloseHandle(file);
+                Error("get size of", path);
+            }
+
+            _size = static_cast<uint64_t>(size.QuadPart);
+
+            if (_size != 0)
+            {
+                HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                ::CloseHandle(file);
+
+                if (!mapping)
+                    Error("map", path);
+
+                _data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mapping);
+
+                if (!_data)
+                    Error("map", path);
+            }
+            else
+            {
+                ::CloseHandle(file);
+            }
+#else
+            const int file = ::open(path, O_RDONLY);
+            if (file == -1)
+                Error("open", path);
+
+            struct stat info;
+            if (::fstat(file, &info) != 0)
+            {
+                ::close(file);
+                Error("get size of", path);
+            }
+
+            _size = static_cast<uint64_t>(info.st_size);
+
+            if (_size != 0)
+            {
+                void* data = ::mmap(nullptr, static_cast<size_t>(_size), PROT_READ, MAP_SHARED, file, 0);
+                ::close(file);
+
+                if (data == MAP_FAILED)
+                    Error("map", path);
+
+                _data = data;
+            }
+            else
+            {
+                ::close(file);
+            }
+#endif
+        }
+
+        ~mapped_file()
+        {
+            if (_data)
+            {
+#if defined(_WIN32) || defined(WIN32)
+                ::UnmapViewOfFile(_data);
+#else
+                ::munmap(_data, static_cast<size_t>(_size));
+#endif
+            }
+        }
+
+        const void* data() const
+        {
+            return _data;
+        }
+
+        uint64_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        [[noreturn]] static void Error(const char* operation, const char* path)
+        {
+            BOND_THROW(StreamException, "Failed to " << operation << " file " << path);
+        }
+
+#if defined(_WIN32) || defined(WIN32)
+        LPVOID _data;
+#else
+        void* _data;
+#endif
+        uint64_t _size;
+    };
+
+} } // namespace bond::ext
@@ -0,0 +1,619 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/** @file */
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/bond.h>
+#include <bond/core/exception.h>
+#include <bond/core/parallel.h>
+#include <bond/core/record_filter.h>
+#include <bond/protocol/compact_binary.h>
+#include <bond/stream/input_buffer.h>
+#include <bond/stream/output_buffer.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace bond { namespace ext
+{
+    //
+    // Layout of a Bond record file. All integers are written in the native
+    // (little-endian) byte order used by the Bond binary protocols.
+    //
+    //  header  uint32 magic, uint16 format version, uint16 protocol,
+    //          uint16 protocol version, uint16 reserved, 16-byte sync marker
+    //  block   16-byte sync marker, uint32 record count, uint32 payload size,
+    //          payload: records, each a varint length followed by the record
+    //  index   uint32 block count, for each block: uint64 offset, uint64 first
+    //          record, uint32 record count; uint64 record count, uint32 schema
+    //          size, SchemaDef of the records in Compact Binary v1
+    //  trailer uint64 index offset, uint32 magic
+    //
+    // The sync marker is unique to a file. It precedes each block, so a file
+    // whose index was never written (e.g. because the writer crashed) can
+    // still be read up to the last complete block.
+    //
+    namespace detail
+    {
+        const uint32_t record_file_magic = 0x46524442; // "BDRF"
+        const uint16_t record_file_version = 1;
+        const uint32_t record_file_marker_size = 16;
+        const uint32_t record_file_header_size = 12 + record_file_marker_size;
+        const uint32_t record_file_block_header_size = record_file_marker_size + 8;
+        const uint32_t record_file_trailer_size = 12;
+        const uint32_t record_file_index_entry_size = 20;
+        const uint32_t record_file_index_min_size = 16;
+
+        struct record_file_block
+        {
+            uint64_t offset;
+            uint64_t first_record;
+            uint32_t record_count;
+        };
+
+        [[noreturn]] inline void RecordFileException(const char* message, uint64_t offset)
+        {
+            BOND_THROW(StreamException,
+                "Invalid record file: " << message << " at offset " << offset);
+        }
+
+    } // namespace detail
+
+
+    /// @brief Options for \ref record_file_writer
+    struct record_file_options
+    {
+        record_file_options(uint32_t block_size = 1024 * 1024, uint16_t protocol_version = v2)
+            : block_size(block_size),
+              protocol_version(protocol_version)
+        {}
+
+        /// @brief Approximate size of the payload of a block in bytes.
+        /// Blocks are the unit of parallel scans.
+        uint32_t block_size;
+
+        /// @brief Version of Compact Binary protocol used for records
+        uint16_t protocol_version;
+    };
+
+
+    /// @brief Writes a Bond record file with records of type \p T.
+    ///
+    /// Records are serialized using Compact Binary protocol and grouped in
+    /// blocks. \ref Close must be called after the last record to write the
+    /// index; without it the file can only be read sequentially.
+    ///
+    /// @tparam Output Bond output stream, e.g. \ref bond::OutputBuffer or
+    /// \ref bond::StdioOutputStream.
+    template <typename T, typename Output, typename Protocols = BuiltInProtocols>
+    class record_file_writer : boost::noncopyable
+    {
+    public:
+        explicit record_file_writer(Output& output, const record_file_options& options = record_file_options())
+            : _output(output),
+              _options(options),
+              _offset(0),
+              _record_count(0),
+              _block_size(0),
+              _block_records(0),
+              _closed(false)
+        {
+            std::random_device random;
+
+            for (uint32_t i = 0; i < detail::record_file_marker_size; i += sizeof(uint32_t))
+            {
+                const uint32_t value = random();
+                std::memcpy(_marker + i, &value, sizeof(value));
+            }
+
+            _output.Write(detail::record_file_magic);
+            _output.Write(detail::record_file_version);
+            _output.Write(static_cast<uint16_t>(CompactBinaryReader<InputBuffer>::magic));
+            _output.Write(_options.protocol_version);
+            _output.Write(static_cast<uint16_t>(0));
+            _output.Write(_marker, detail::record_file_marker_size);
+
+            _offset = detail::record_file_header_size;
+        }
+
+        /// @brief Append a record to the file
+        void Write(const T& record)
+        {
+            BOOST_ASSERT(!_closed);
+
+            OutputBuffer buffer(256);
+            CompactBinaryWriter<OutputBuffer> writer(buffer, _options.protocol_version);
+
+            Serialize<Protocols>(record, writer);
+
+            const blob data = buffer.GetBuffer();
+
+            _block.WriteVariableUnsigned(data.size());
+            _block.Write(data);
+            _block_size += data.size();
+
+            ++_block_records;
+            ++_record_count;
+
+            if (_block_size >= _options.block_size)
+                Flush();
+        }
+
+        /// @brief Complete the current block.
+        ///
+        /// All records written before the call will be readable even if the
+        /// index is never written.
+        void Flush()
+        {
+            if (_block_records == 0)
+                return;
+
+            const blob payload = _block.GetBuffer();
+            const detail::record_file_block block = { _offset, _record_count - _block_records, _block_records };
+
+            _blocks.push_back(block);
+
+            _output.Write(_marker, detail::record_file_marker_size);
+            _output.Write(_block_records);
+            _output.Write(payload.size());
+            _output.Write(payload);
+
+            _offset += detail::record_file_block_header_size + payload.size();
+
+            _block = OutputBuffer();
+            _block_size = 0;
+            _block_records = 0;
+        }
+
+        /// @brief Complete the file by writing the index.
+        void Close()
+        {
+            if (_closed)
+                return;
+
+            Flush();
+
+            OutputBuffer schema;
+            CompactBinaryWriter<OutputBuffer> writer(schema);
+            Serialize(GetRuntimeSchema<T>().GetSchema(), writer);
+
+            const blob schema_data = schema.GetBuffer();
+
+            _output.Write(static_cast<uint32_t>(_blocks.size()));
+
+            for (const detail::record_file_block& block : _blocks)
+            {
+                _output.Write(block.offset);
+                _output.Write(block.first_record);
+                _output.Write(block.record_count);
+            }
+
+            _output.Write(_record_count);
+            _output.Write(schema_data.size());
+            _output.Write(schema_data);
+
+            _output.Write(_offset);
+            _output.Write(detail::record_file_magic);
+
+            _closed = true;
+        }
+
+        /// @brief Number of records written so far
+        uint64_t record_count() const
+        {
+            return _record_count;
+        }
+
+    private:
+        Output& _output;
+        const record_file_options _options;
+        char _marker[detail::record_file_marker_size];
+        uint64_t _offset;
+        uint64_t _record_count;
+        OutputBuffer _block;
+        uint32_t _block_size;
+        uint32_t _block_records;
+        std::vector<detail::record_file_block> _blocks;
+        bool _closed;
+    };
+
+
+    /// @brief Reads a Bond record file written by \ref record_file_writer.
+    ///
+    /// The whole file must be accessible in memory, e.g. read into a blob or
+    /// mapped using \ref mapped_file. All read functions are const and may be
+    /// called concurrently from multiple threads.
+    template <typename T, typename Protocols = BuiltInProtocols>
+    class record_file_reader
+    {
+    public:
+        /// @brief Construct from a blob holding the file
+        explicit record_file_reader(const blob& data)
+            : _data(data),
+              _content(data.content()),
+              _size(data.size())
+        {
+            Open();
+        }
+
+        /// @brief Construct from memory holding the file, e.g. a memory-mapped
+        /// file which may be larger than 4GB. The memory must stay valid for
+        /// the lifetime of the reader and of the objects read from it.
+        record_file_reader(const void* data, uint64_t size)
+            : _content(static_cast<const char*>(data)),
+              _size(size)
+        {
+            Open();
+        }
+
+        /// @brief Total number of records
+        uint64_t record_count() const
+        {
+            return _record_count;
+        }
+
+        /// @brief Number of blocks, the unit of parallel scans
+        size_t block_count() const
+        {
+            return _blocks.size();
+        }
+
+        /// @brief Returns false if the file has no index because the writer
+        /// was not closed; only complete blocks are available.
+        bool has_index() const
+        {
+            return _has_index;
+        }
+
+        /// @brief Version of Compact Binary protocol of the records
+        uint16_t protocol_version() const
+        {
+            return _protocol_version;
+        }
+
+        /// @brief Schema of the records stored in the index.
+        /// Empty if the file has no index.
+        const SchemaDef& schema() const
+        {
+            return _schema;
+        }
+
+        /// @brief Deserialize the n-th record of the file
+        void Read(uint64_t n, T& record) const
+        {
+            if (n >= _record_count)
+            {
+                BOND_THROW(CoreException,
+                    "Record " << n << " out of range, the file has " << _record_count << " records");
+            }
+
+            auto block = std::upper_bound(_blocks.begin(), _blocks.end(), n,
+                [](uint64_t i, const detail::record_file_block& b) { return i < b.first_record; });
+
+            // The first block starts at record 0, so some block starts at or
+            // before any record in range
+            BOOST_ASSERT(block != _blocks.begin());
+            --block;
+
+            InputBuffer input(Payload(*block));
+
+            for (uint64_t i = block->first_record; i < n; ++i)
+                SkipRecord(input);
+
+            ReadRecord(input, record);
+        }
+
+        /// @brief Deserialize the records of a block, in order, calling
+        /// function(uint64_t index, T& record) for each one.
+        template <typename Function>
+        void ScanBlock(size_t block, const Function& function) const
+        {
+            BOOST_ASSERT(block < _blocks.size());
+
+            InputBuffer input(Payload(_blocks[block]));
+
+            for (uint32_t i = 0; i < _blocks[block].record_count; ++i)
+            {
+                T record;
+                ReadRecord(input, record);
+                function(_blocks[block].first_record + i, record);
+            }
+        }
+
+        /// @brief Deserialize all records of the file in order, calling
+        /// function(uint64_t index, T& record) for each one.
+        template <typename Function>
+        void Scan(const Function& function) const
+        {
+            for (size_t i = 0; i < _blocks.size(); ++i)
+                ScanBlock(i, function);
+        }
+
+        /// @brief Deserialize all records of the file, scanning blocks
+        /// concurrently using the executor.
+        ///
+        /// The function is called concurrently from multiple threads. Records
+        /// within a block are visited in order.
+        template <typename Function, typename Executor>
+        void ScanParallel(const Function& function, const Executor& executor) const
+        {
+            bond::detail::ParallelTasks tasks;
+
+            for (size_t i = 1; i < _blocks.size(); ++i)
+            {
+                tasks.Run(executor, [this, &function, i]
+                {
+                    ScanBlock(i, function);
+                });
+            }
+
+            // The first block is scanned on the calling thread
+            if (!_blocks.empty())
+                ScanBlock(0, function);
+
+            tasks.Wait();
+        }
+
+        /// @brief Read the selected fields of all records of the file in
+        /// order, calling function(uint64_t index, values...) for each one.
+        ///
+        /// Fields are selected as for \ref bond::Scan; only the selected
+        /// fields are deserialized and the others are skipped.
+        template <typename... Fields, typename Function>
+        void ScanFields(const Function& function) const
+        {
+            bond::detail::Scanner<T, Protocols, Fields...> scanner;
+
+            for (const detail::record_file_block& block : _blocks)
+            {
+                InputBuffer input(Payload(block));
+
+                for (uint32_t i = 0; i < block.record_count; ++i)
+                {
+                    const uint64_t index = block.first_record + i;
+                    CompactBinaryReader<InputBuffer> reader(ReadPayload(input), _protocol_version);
+
+                    scanner.Read(reader, [&function, index](typename Fields::value_type&... values)
+                    {
+                        function(index, values...);
+                    });
+                }
+            }
+        }
+
+        /// @brief Evaluate the filter on all records of the file in order,
+        /// calling function(uint64_t index, const blob& record) for each
+        /// matching one.
+        ///
+        /// Records are not deserialized; the record blob holds the Compact
+        /// Binary payload of the record, of \ref protocol_version.
+        ///
+        /// @return the number of matching records
+        template <typename Function>
+        uint64_t Filter(const record_filter& filter, const Function& function) const
+        {
+            uint64_t count = 0;
+
+            for (const detail::record_file_block& block : _blocks)
+            {
+                InputBuffer input(Payload(block));
+
+                for (uint32_t i = 0; i < block.record_count; ++i)
+                {
+                    const blob payload = ReadPayload(input);
+
+                    if (filter.MatchesPayload(CompactBinaryReader<InputBuffer>(payload, _protocol_version)))
+                    {
+                        function(block.first_record + i, payload);
+                        ++count;
+                    }
+                }
+            }
+
+            return count;
+        }
+
+    private:
+        void Open()
+        {
+            InputBuffer header(Range(0, detail::record_file_header_size));
+
+            uint32_t magic;
+            uint16_t version, protocol, reserved;
+
+            header.Read(magic);
+            header.Read(version);
+            header.Read(protocol);
+            header.Read(_protocol_version);
+            header.Read(reserved);
+
+            if (magic != detail::record_file_magic
+                || version != detail::record_file_version
+                || protocol != CompactBinaryReader<InputBuffer>::magic
+                || _protocol_version < v1
+                || _protocol_version > CompactBinaryReader<InputBuffer>::version)
+            {
+                detail::RecordFileException("unsupported header", 0);
+            }
+
+            std::memcpy(_marker, Range(12, detail::record_file_marker_size).content(), detail::record_file_marker_size);
+
+            _has_index = _size >= detail::record_file_header_size + detail::record_file_trailer_size
+                && ReadTrailer();
+
+            if (_has_index)
+                ReadIndex();
+            else
+                RecoverIndex();
+        }
+
+        bool ReadTrailer()
+        {
+            InputBuffer trailer(Range(_size - detail::record_file_trailer_size, detail::record_file_trailer_size));
+
+            uint32_t magic;
+
+            trailer.Read(_index_offset);
+            trailer.Read(magic);
+
+            return magic == detail::record_file_magic
+                && _index_offset >= detail::record_file_header_size
+                && _index_offset <= _size - detail::record_file_trailer_size;
+        }
+
+        // Blocks in the index must follow each other in the file and number
+        // the records contiguously from 0, which Read relies on
+        void ReadIndex()
+        {
+            const uint64_t size = _size - detail::record_file_trailer_size - _index_offset;
+
+            if (size < detail::record_file_index_min_size)
+                detail::RecordFileException("index too small", _index_offset);
+
+            InputBuffer index(Range(_index_offset, static_cast<uint32_t>(size)));
+
+            uint32_t count;
+            index.Read(count);
+
+            if (count > (size - detail::record_file_index_min_size) / detail::record_file_index_entry_size)
+                detail::RecordFileException("block count out of range", _index_offset);
+
+            _blocks.resize(count);
+
+            uint64_t offset = detail::record_file_header_size;
+            uint64_t first_record = 0;
+
+            for (detail::record_file_block& block : _blocks)
+            {
+                index.Read(block.offset);
+                index.Read(block.first_record);
+                index.Read(block.record_count);
+
+                if (block.offset < offset
+                    || block.offset > _index_offset - detail::record_file_block_header_size)
+                {
+                    detail::RecordFileException("block offset out of range", _index_offset);
+                }
+
+                if (block.first_record != first_record)
+                    detail::RecordFileException("block records not contiguous", _index_offset);
+
+                offset = block.offset + detail::record_file_block_header_size;
+                first_record += block.record_count;
+            }
+
+            uint32_t schema_size;
+            blob schema;
+
+            index.Read(_record_count);
+
+            if (first_record != _record_count)
+                detail::RecordFileException("record count mismatch", _index_offset);
+
+            index.Read(schema_size);
+            index.Read(schema, schema_size);
+
+            Deserialize(CompactBinaryReader<InputBuffer>(schema), _schema);
+        }
+
+        // Find complete blocks by walking the block headers
+        void RecoverIndex()
+        {
+            uint64_t offset = detail::record_file_header_size;
+
+            _record_count = 0;
+
+            while (_size - offset >= detail::record_file_block_header_size
+                && std::memcmp(_content + offset, _marker, detail::record_file_marker_size) == 0)
+            {
+                InputBuffer header(Range(offset + detail::record_file_marker_size, 8));
+
+                uint32_t count, size;
+                header.Read(count);
+                header.Read(size);
+
+                if (_size - offset - detail::record_file_block_header_size < size)
+                    break;
+
+                const detail::record_file_block block = { offset, _record_count, count };
+                _blocks.push_back(block);
+
+                _record_count += count;
+                offset += detail::record_file_block_header_size + size;
+            }
+        }
+
+        blob Payload(const detail::record_file_block& block) const
+        {
+            if (std::memcmp(_content + block.offset, _marker, detail::record_file_marker_size) != 0)
+                detail::RecordFileException("sync marker mismatch", block.offset);
+
+            InputBuffer header(Range(block.offset + detail::record_file_marker_size, 8));
+
+            uint32_t count, size;
+            header.Read(count);
+            header.Read(size);
+
+            if (count != block.record_count)
+                detail::RecordFileException("block record count mismatch", block.offset);
+
+            return Range(block.offset + detail::record_file_block_header_size, size);
+        }
+
+        blob Range(uint64_t offset, uint32_t size) const
+        {
+            if (offset > _size || size > _size - offset)
+                detail::RecordFileException("unexpected end of file", offset);
+
+            if (_data.size())
+                return _data.range(static_cast<uint32_t>(offset), size);
+            else
+                return blob(_content + offset, size);
+        }
+
+        static void SkipRecord(InputBuffer& input)
+        {
+            uint32_t size;
+            blob data;
+
+            input.ReadVariableUnsigned(size);
+            input.Read(data, size);
+        }
+
+        static blob ReadPayload(InputBuffer& input)
+        {
+            uint32_t size;
+            blob data;
+
+            input.ReadVariableUnsigned(size);
+            input.Read(data, size);
+
+            return data;
+        }
+
+        void ReadRecord(InputBuffer& input, T& record) const
+        {
+            Deserialize<Protocols>(CompactBinaryReader<InputBuffer>(ReadPayload(input), _protocol_version), record);
+        }
+
+        blob _data;
+        const char* _content;
+        uint64_t _size;
+        char _marker[detail::record_file_marker_size];
+        uint16_t _protocol_version;
+        bool _has_index;
+        uint64_t _index_offset;
+        uint64_t _record_count;
+        std::vector<detail::record_file_block> _blocks;
+        SchemaDef _schema;
+    };
+
+} } // namespace bond::ext
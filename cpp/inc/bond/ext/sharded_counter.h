@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "capped_allocator_fwd.h"
+#include "detail/counter_base.h"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+
+namespace bond { namespace ext
+{
+    namespace detail
+    {
+        /// @brief Returns a small number that is unique to the calling thread.
+        inline std::size_t current_thread_index() BOND_NOEXCEPT
+        {
+            static std::atomic<std::size_t> next_index{};
+            static thread_local const std::size_t index = next_index++;
+            return index;
+        }
+
+    } // namespace detail
+
+
+    /// @brief Multi-threaded counter to be used with \ref capped_allocator
+    /// when many threads allocate concurrently.
+    ///
+    /// @tparam T underlying counter type.
+    ///
+    /// @remarks Threads are spread over a number of shards, each of which
+    /// holds budget that was reserved in batches from the global limit. Most
+    /// calls to \ref try_add and \ref subtract only touch the shard of the
+    /// calling thread, so threads on different shards don't contend on a
+    /// single cache line. Budget that accumulates in a shard beyond two
+    /// batches is returned to the global limit, and when the global limit is
+    /// exhausted the budget of all shards is reclaimed before failing.
+    /// Therefore \ref try_add may fail spuriously close to the limit only
+    /// while another thread is moving a batch into its shard.
+    template <typename T>
+    class sharded_counter : public detail::counter_base<T>
+    {
+    public:
+        using is_thread_safe = std::true_type;
+
+        /// @brief Default number of units reserved from the global limit at once.
+        static const T default_batch_size = 16 * 1024;
+
+        /// @brief Constructs a counter.
+        ///
+        /// @param max_value max counter value.
+        ///
+        /// @param batch_size number of units a shard reserves from the global
+        /// limit at once. It is reduced for small limits so that the batches
+        /// of all shards don't exceed a quarter of \p max_value.
+        ///
+        /// @param shard_count number of shards; defaults to the number of
+        /// hardware threads.
+        explicit sharded_counter(
+            T max_value,
+            T batch_size = default_batch_size,
+            std::size_t shard_count = std::thread::hardware_concurrency())
+            : detail::counter_base<T>{ max_value },
+              _shard_count{ (std::max)(shard_count, std::size_t(1)) },
+              _shards{ new shard[_shard_count] },
+              _batch_size{ (std::min)(batch_size, static_cast<T>(max_value / (4 * _shard_count))) }
+        {}
+
+        bool try_add(T n) BOND_NOEXCEPT
+        {
+            if (n > this->max_value())
+            {
+                return false;
+            }
+
+            auto& budget = current_shard().budget;
+
+            for (auto val = budget.load(std::memory_order::memory_order_relaxed); val >= n; )
+            {
+                if (budget.compare_exchange_weak(
+                        val,
+                        val - n,
+                        std::memory_order::memory_order_relaxed,
+                        std::memory_order::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+
+            if (_batch_size != 0 && n <= this->max_value() - _batch_size && reserve(n + _batch_size))
+            {
+                budget.fetch_add(_batch_size, std::memory_order::memory_order_relaxed);
+                return true;
+            }
+
+            if (reserve(n))
+            {
+                return true;
+            }
+
+            reclaim();
+            return reserve(n);
+        }
+
+        void subtract(T n) BOND_NOEXCEPT
+        {
+            auto& budget = current_shard().budget;
+            const T threshold = 2 * _batch_size;
+
+            auto val = budget.fetch_add(n, std::memory_order::memory_order_relaxed) + n;
+
+            while (val > threshold)
+            {
+                if (budget.compare_exchange_weak(
+                        val,
+                        _batch_size,
+                        std::memory_order::memory_order_relaxed,
+                        std::memory_order::memory_order_relaxed))
+                {
+                    BOOST_ASSERT(_reserved.load(std::memory_order::memory_order_relaxed) >= val - _batch_size);
+                    _reserved.fetch_sub(val - _batch_size, std::memory_order::memory_order_release);
+                    break;
+                }
+            }
+        }
+
+        /// @remarks The returned value may not be up-to-date.
+        T value() const BOND_NOEXCEPT
+        {
+            T budget = 0;
+
+            for (std::size_t i = 0; i < _shard_count; ++i)
+            {
+                budget += _shards[i].budget.load(std::memory_order::memory_order_relaxed);
+            }
+
+            const T reserved = _reserved.load(std::memory_order::memory_order_relaxed);
+            return reserved > budget ? reserved - budget : 0;
+        }
+
+    private:
+        /// @brief Shard padded to keep budgets of different shards on
+        /// different cache lines.
+        struct shard
+        {
+            std::atomic<T> budget{};
+            char padding[128 - sizeof(std::atomic<T>)];
+        };
+
+        shard& current_shard() const BOND_NOEXCEPT
+        {
+            return _shards[detail::current_thread_index() % _shard_count];
+        }
+
+        /// @brief Reserves \p n units from the global limit.
+        bool reserve(T n) BOND_NOEXCEPT
+        {
+            const auto max_val = this->max_value() - n;
+
+            for (auto val = _reserved.load(std::memory_order::memory_order_acquire); val <= max_val; )
+            {
+                if (_reserved.compare_exchange_weak(
+                        val,
+                        val + n,
+                        std::memory_order::memory_order_release,
+                        std::memory_order::memory_order_acquire))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// @brief Returns the budget of all shards to the global limit.
+        void reclaim() BOND_NOEXCEPT
+        {
+            for (std::size_t i = 0; i < _shard_count; ++i)
+            {
+                if (const T budget = _shards[i].budget.exchange(0, std::memory_order::memory_order_relaxed))
+                {
+                    _reserved.fetch_sub(budget, std::memory_order::memory_order_release);
+                }
+            }
+        }
+
+        const std::size_t _shard_count;
+        const std::unique_ptr<shard[]> _shards;
+        const T _batch_size;
+        std::atomic<T> _reserved{};
+    };
+
+    template <typename T>
+    const T sharded_counter<T>::default_batch_size;
+
+} } // namespace bond::ext
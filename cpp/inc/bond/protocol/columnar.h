@@ -0,0 +1,728 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/columns.h"
+#include "encoding.h"
+
+#include <bond/core/bond_version.h>
+#include <bond/core/customize.h>
+#include <bond/core/detail/protocol_visitors.h>
+#include <bond/core/exception.h>
+#include <bond/core/null.h>
+#include <bond/core/traits.h>
+
+#include <boost/call_traits.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <memory>
+
+/*
+   Columnar protocol is an untagged protocol which stores lists and sets of
+   structs column by column rather than struct by struct. Everything else is
+   written in the same way as in Simple Binary protocol v2, except that
+   containers start with the type of their elements.
+
+                                           .------.-------. .-------.
+                    list, set,             | type | count | | items |...
+                    vector, nullable       '------'-------' '-------'
+
+                           type             element type, 1 byte BondDataType
+
+                           count            uint32 count of items (variable encoded)
+
+                           items            each item encoded according to its type
+
+                                           .-----.--------.-------. .-----.--------.
+                    map                    | key | mapped | count | | key | mapped |...
+                                           '-----'--------'-------' '-----'--------'
+
+                           key, mapped      key and value type, 1 byte BondDataType each
+
+                                           .------.-------.--------.-------.
+                    list, set, vector      | type | count | length | root  |
+                    or nullable of structs '------'-------'--------'-------'
+
+                           type             BT_STRUCT
+
+                           count            uint32 count of structs (variable encoded)
+
+                           length           uint32 length of the root column in bytes (variable encoded)
+
+                                           .----------.--------.-------.-------. .--------.
+                    column                 | integers | length | bytes | count | | column |...
+                                           '----------'--------'-------'-------' '--------'
+
+                           integers         integer values of the column, see below
+
+                           length           uint32 length of the raw bytes (variable encoded)
+
+                           bytes            raw bytes of the column
+
+                           count            uint32 count of child columns (variable encoded)
+
+                           column           child columns: the fields of a struct, the
+                                            elements of a list or set, the keys and the
+                                            values of a map
+
+   Each field of the structs in the list, including the fields of their bases
+   and of nested structs, is stored in its own column. Elements of containers
+   in these structs are stored in the child columns of the container's column,
+   all the elements of all the containers of a field in the same column.
+
+   bool, integers and enums, as well as container sizes and string lengths,
+   are stored in the integer column. int8, uint8, float and double values and
+   string characters are stored as raw bytes in the byte column.
+
+                                           .-------. .-----. .-----.
+                    integers               | count | | run |...
+                                           '-------' '-----' '-----'
+
+                           count            uint64 count of values (variable encoded)
+
+                                           .--------. .-------.
+                           run              | header | | value |...
+                                           '--------' '-------'
+
+                           header           uint64 (count << 1 | repeated) (variable encoded)
+
+                           value            a single value repeated count times if
+                                            repeated, otherwise count values
+
+   Each value is the difference from the previous value in the column, zigzag
+   and variable encoded.
+
+   Fields of type bonded<T> are not supported in lists of structs.
+*/
+
+namespace bond
+{
+
+
+template <typename BufferT>
+class ColumnarWriter;
+
+
+/// @brief Reader for Columnar protocol
+///
+/// The protocol isn't one of the built-in protocols. To use it with APIs
+/// which select the protocol at runtime, add the reader to the protocols,
+/// e.g. `bond::BuiltInProtocols::Append<bond::ColumnarReader<bond::InputBuffer> >`.
+template <typename BufferT, typename MarshaledBondedProtocolsT = Protocols<CompactBinaryReader<BufferT> > >
+class ColumnarReader
+{
+public:
+    typedef BufferT                        Buffer;
+    typedef StaticParser<ColumnarReader&>  Parser;
+    typedef ColumnarWriter<Buffer>         Writer;
+
+    BOND_STATIC_CONSTEXPR uint16_t magic = 0x4c43 /*CL*/;
+    BOND_STATIC_CONSTEXPR uint16_t version = v1;
+
+
+    /// @brief Construct from input buffer/stream containing serialized data.
+    ColumnarReader(typename boost::call_traits<Buffer>::param_type input,
+                   uint16_t version_value = default_version<ColumnarReader>::value)
+        : _input(input),
+          _version(version_value)
+    {
+        BOOST_ASSERT(_version <= ColumnarReader::version);
+    }
+
+
+    // Copies share the columns of the list which is being read, if any.
+    /// @brief Copy constructor
+    ColumnarReader(const ColumnarReader& that) BOND_NOEXCEPT
+        : _input(that._input),
+          _version(that._version),
+          _columns(that._columns)
+    {}
+
+
+    /// @brief Comparison operator
+    bool operator==(const ColumnarReader& rhs) const
+    {
+        return _input == rhs._input
+            && _columns == rhs._columns;
+    }
+
+
+    /// @brief Access to underlying buffer
+    typename boost::call_traits<Buffer>::const_reference
+    GetBuffer() const
+    {
+        CheckNotColumnar();
+        return _input;
+    }
+
+
+    /// @brief Access to underlying buffer
+    typename boost::call_traits<Buffer>::reference
+    GetBuffer()
+    {
+        CheckNotColumnar();
+        return _input;
+    }
+
+
+    bool ReadVersion()
+    {
+        uint16_t magic_value;
+
+        _input.Read(magic_value);
+        _input.Read(_version);
+
+        return magic_value == ColumnarReader::magic
+            && _version <= ColumnarReader::version;
+    }
+
+
+    void ReadStructBegin(bool base)
+    {
+        if (_columns && !base)
+            _columns->BeginStruct();
+    }
+
+
+    void ReadStructEnd(bool base)
+    {
+        if (_columns && !base)
+            _columns->End();
+    }
+
+
+    // Read for basic types
+    template <typename T>
+    typename boost::disable_if<is_string_type<T> >::type
+    Read(T& var)
+    {
+        if (_columns)
+            ReadColumn(_columns->Next(), var);
+        else
+            _input.Read(var);
+    }
+
+
+    // Read for strings
+    template <typename T>
+    typename boost::enable_if<is_string_type<T> >::type
+    Read(T& var)
+    {
+        if (_columns)
+        {
+            detail::ColumnReader& column = _columns->Next();
+            detail::ReadStringData(column.Bytes(), var, static_cast<uint32_t>(column.ReadInteger()));
+        }
+        else
+        {
+            uint32_t length = 0;
+
+            ReadVariableUnsigned(_input, length);
+            detail::ReadStringData(_input, var, length);
+        }
+    }
+
+
+    // Read for blob
+    void Read(blob& var, uint32_t size)
+    {
+        if (_columns)
+            _columns->Next().Bytes().Read(var, size);
+        else
+            _input.Read(var, size);
+    }
+
+
+    // Skip for basic types
+    template <typename T>
+    typename boost::disable_if<is_string_type<T> >::type
+    Skip()
+    {
+        T var;
+        Read(var);
+    }
+
+
+    template <typename T>
+    void Skip(const bonded<T, ColumnarReader&>& bonded)
+    {
+        detail::Skip(bonded);
+    }
+
+
+    // Skip for strings
+    template <typename T>
+    typename boost::enable_if<is_string_type<T> >::type
+    Skip()
+    {
+        const uint32_t size = sizeof(typename detail::string_char_int_type<T>::type);
+        uint32_t length;
+
+        if (_columns)
+        {
+            detail::ColumnReader& column = _columns->Next();
+
+            length = static_cast<uint32_t>(column.ReadInteger());
+            column.Bytes().Skip(length * size);
+        }
+        else
+        {
+            ReadVariableUnsigned(_input, length);
+            _input.Skip(length * size);
+        }
+    }
+
+
+    void Skip(BondDataType type)
+    {
+        switch (type)
+        {
+            case BT_BOOL:
+                Skip<bool>();
+                break;
+
+            case BT_UINT8:
+                Skip<uint8_t>();
+                break;
+
+            case BT_UINT16:
+                Skip<uint16_t>();
+                break;
+
+            case BT_UINT32:
+                Skip<uint32_t>();
+                break;
+
+            case BT_UINT64:
+                Skip<uint64_t>();
+                break;
+
+            case BT_FLOAT:
+                Skip<float>();
+                break;
+
+            case BT_DOUBLE:
+                Skip<double>();
+                break;
+
+            case BT_STRING:
+                Skip<std::string>();
+                break;
+
+            case BT_WSTRING:
+                Skip<std::wstring>();
+                break;
+
+            case BT_INT8:
+                Skip<int8_t>();
+                break;
+
+            case BT_INT16:
+                Skip<int16_t>();
+                break;
+
+            case BT_INT32:
+                Skip<int32_t>();
+                break;
+
+            case BT_INT64:
+                Skip<int64_t>();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+
+    void ReadContainerBegin(uint32_t& size, BondDataType& type)
+    {
+        if (_columns)
+        {
+            detail::ColumnReader& column = _columns->Next();
+
+            size = static_cast<uint32_t>(column.ReadInteger());
+            _columns->BeginList(column);
+        }
+        else
+        {
+            ReadType(type);
+            ReadVariableUnsigned(_input, size);
+
+            if (type == BT_STRUCT)
+                ReadColumns();
+        }
+    }
+
+
+    void ReadContainerBegin(uint32_t& size, std::pair<BondDataType, BondDataType>& type)
+    {
+        if (_columns)
+        {
+            detail::ColumnReader& column = _columns->Next();
+
+            size = static_cast<uint32_t>(column.ReadInteger());
+            _columns->BeginMap(column);
+        }
+        else
+        {
+            ReadType(type.first);
+            ReadType(type.second);
+            ReadVariableUnsigned(_input, size);
+        }
+    }
+
+
+    void ReadContainerEnd()
+    {
+        if (_columns)
+        {
+            _columns->End();
+
+            if (!_columns->IsOpen())
+                _columns.reset();
+        }
+    }
+
+protected:
+    void ReadType(BondDataType& type)
+    {
+        uint8_t value;
+
+        _input.Read(value);
+        type = static_cast<BondDataType>(value);
+    }
+
+
+    // Reads and decodes all columns of a list of structs
+    void ReadColumns()
+    {
+        uint32_t length;
+        blob data;
+
+        ReadVariableUnsigned(_input, length);
+        _input.Read(data, length);
+
+        InputBuffer input(data);
+
+        _columns = boost::make_shared<detail::ColumnTree<detail::ColumnReader> >();
+        _columns->Root().Read(input);
+    }
+
+
+    template <typename T>
+    static typename boost::enable_if<detail::is_raw_column_value<T> >::type
+    ReadColumn(detail::ColumnReader& column, T& var)
+    {
+        column.Bytes().Read(var);
+    }
+
+
+    template <typename T>
+    static typename boost::disable_if<detail::is_raw_column_value<T> >::type
+    ReadColumn(detail::ColumnReader& column, T& var)
+    {
+        detail::FromColumnInteger(var, column.ReadInteger());
+    }
+
+
+    void CheckNotColumnar() const
+    {
+        if (_columns)
+        {
+            BOND_THROW(CoreException, "Columnar protocol doesn't support bonded<T> in lists of structs");
+        }
+    }
+
+
+    Buffer   _input;
+    uint16_t _version;
+    boost::shared_ptr<detail::ColumnTree<detail::ColumnReader> > _columns;
+};
+
+
+template <typename BufferT, typename MarshaledBondedProtocolsT>
+BOND_CONSTEXPR_OR_CONST uint16_t ColumnarReader<BufferT, MarshaledBondedProtocolsT>::magic;
+
+template <typename BufferT, typename MarshaledBondedProtocolsT>
+BOND_CONSTEXPR_OR_CONST uint16_t ColumnarReader<BufferT, MarshaledBondedProtocolsT>::version;
+
+
+/// @brief Writer for Columnar protocol
+template <typename BufferT>
+class ColumnarWriter
+    : boost::noncopyable
+{
+public:
+    typedef BufferT                 Buffer;
+    typedef ColumnarReader<Buffer>  Reader;
+
+    /// @brief Construct from output buffer/stream.
+    ColumnarWriter(Buffer& output,
+                   uint16_t version = default_version<Reader>::value)
+        : _output(output),
+          _version(version)
+    {
+        BOOST_ASSERT(_version <= Reader::version);
+    }
+
+    /// @brief Access to underlying buffer
+    typename boost::call_traits<Buffer>::reference
+    GetBuffer()
+    {
+        if (_columns)
+        {
+            BOND_THROW(CoreException, "Columnar protocol doesn't support bonded<T> in lists of structs");
+        }
+
+        return _output;
+    }
+
+    /// @brief Protocol version used by the writer
+    uint16_t GetVersion() const
+    {
+        return _version;
+    }
+
+    void WriteVersion()
+    {
+        _output.Write(Reader::magic);
+        _output.Write(_version);
+    }
+
+    void WriteStructBegin(const Metadata& /*metadata*/, bool base)
+    {
+        if (_columns && !base)
+            _columns->BeginStruct();
+    }
+
+    void WriteStructEnd(bool base = false)
+    {
+        if (_columns && !base)
+            _columns->End();
+    }
+
+    void WriteFieldBegin(BondDataType /*type*/, uint16_t /*id*/, const Metadata& /*metadata*/)
+    {}
+
+    void WriteFieldBegin(BondDataType /*type*/, uint16_t /*id*/)
+    {}
+
+    void WriteFieldEnd()
+    {}
+
+
+    // WriteContainerBegin
+    void WriteContainerBegin(uint32_t size, BondDataType type)
+    {
+        if (_columns)
+        {
+            detail::ColumnWriter& column = _columns->Next();
+
+            column.WriteInteger(size);
+            _columns->BeginList(column);
+        }
+        else
+        {
+            _output.Write(static_cast<uint8_t>(type));
+            WriteVariableUnsigned(_output, size);
+
+            if (type == BT_STRUCT)
+                _columns.reset(new detail::ColumnTree<detail::ColumnWriter>);
+        }
+    }
+
+
+    void WriteContainerBegin(uint32_t size, std::pair<BondDataType, BondDataType> type)
+    {
+        if (_columns)
+        {
+            detail::ColumnWriter& column = _columns->Next();
+
+            column.WriteInteger(size);
+            _columns->BeginMap(column);
+        }
+        else
+        {
+            _output.Write(static_cast<uint8_t>(type.first));
+            _output.Write(static_cast<uint8_t>(type.second));
+            WriteVariableUnsigned(_output, size);
+        }
+    }
+
+
+    // WriteContainerEnd
+    void WriteContainerEnd()
+    {
+        if (_columns)
+        {
+            _columns->End();
+
+            if (!_columns->IsOpen())
+                WriteColumns();
+        }
+    }
+
+    template <typename T>
+    void WriteField(uint16_t /*id*/, const bond::Metadata& /*metadata*/, const T& value)
+    {
+        Write(value);
+    }
+
+    void WriteFieldOmitted(BondDataType type, uint16_t /*id*/, const Metadata& metadata);
+
+    // Write for basic types
+    template <typename T>
+    typename boost::disable_if<is_string_type<T> >::type
+    Write(const T& value)
+    {
+        if (_columns)
+            WriteColumn(_columns->Next(), value);
+        else
+            _output.Write(value);
+    }
+
+    // Write for strings
+    template <typename T>
+    typename boost::enable_if<is_string_type<T> >::type
+    Write(const T& value)
+    {
+        uint32_t length = string_length(value);
+
+        if (_columns)
+        {
+            detail::ColumnWriter& column = _columns->Next();
+
+            column.WriteInteger(length);
+            detail::WriteStringData(column.Bytes(), value, length);
+        }
+        else
+        {
+            WriteVariableUnsigned(_output, length);
+            detail::WriteStringData(_output, value, length);
+        }
+    }
+
+    // Write for blob
+    void Write(const blob& value)
+    {
+        if (_columns)
+            _columns->Next().Bytes().Write(value);
+        else
+            _output.Write(value);
+    }
+
+protected:
+    // Writes the columns of a list of structs once all of them were written
+    void WriteColumns()
+    {
+        OutputBuffer columns;
+        _columns->Root().Write(columns);
+        _columns.reset();
+
+        const blob data = columns.GetBuffer();
+
+        WriteVariableUnsigned(_output, data.length());
+        _output.Write(data);
+    }
+
+    template <typename T>
+    static typename boost::enable_if<detail::is_raw_column_value<T> >::type
+    WriteColumn(detail::ColumnWriter& column, const T& value)
+    {
+        column.Bytes().Write(value);
+    }
+
+    template <typename T>
+    static typename boost::disable_if<detail::is_raw_column_value<T> >::type
+    WriteColumn(detail::ColumnWriter& column, const T& value)
+    {
+        column.WriteInteger(detail::ToColumnInteger(value));
+    }
+
+    Buffer&  _output;
+    uint16_t _version;
+    std::unique_ptr<detail::ColumnTree<detail::ColumnWriter> > _columns;
+};
+
+
+template <typename BufferT>
+inline void ColumnarWriter<BufferT>::WriteFieldOmitted(BondDataType type, uint16_t /*id*/, const Metadata& metadata)
+{
+    // Columnar doesn't support omitting fields so instead we write a default value
+    BOOST_ASSERT(!metadata.default_value.nothing);
+
+    switch (type)
+    {
+        case BT_BOOL:
+            Write(!!metadata.default_value.uint_value);
+            break;
+        case BT_UINT8:
+            Write(static_cast<uint8_t>(metadata.default_value.uint_value));
+            break;
+        case BT_UINT16:
+            Write(static_cast<uint16_t>(metadata.default_value.uint_value));
+            break;
+        case BT_UINT32:
+            Write(static_cast<uint32_t>(metadata.default_value.uint_value));
+            break;
+        case BT_UINT64:
+            Write(static_cast<uint64_t>(metadata.default_value.uint_value));
+            break;
+        case BT_FLOAT:
+            Write(static_cast<float>(metadata.default_value.double_value));
+            break;
+        case BT_DOUBLE:
+            Write(metadata.default_value.double_value);
+            break;
+        case BT_STRING:
+            Write(metadata.default_value.string_value);
+            break;
+        case BT_STRUCT:
+            BOOST_ASSERT(false);
+            break;
+        case BT_LIST:
+        case BT_SET:
+            WriteContainerBegin(0, BT_UNAVAILABLE);
+            WriteContainerEnd();
+            break;
+        case BT_MAP:
+            WriteContainerBegin(0, std::make_pair(BT_UNAVAILABLE, BT_UNAVAILABLE));
+            WriteContainerEnd();
+            break;
+        case BT_INT8:
+            Write(static_cast<int8_t>(metadata.default_value.int_value));
+            break;
+        case BT_INT16:
+            Write(static_cast<int16_t>(metadata.default_value.int_value));
+            break;
+        case BT_INT32:
+            Write(static_cast<int32_t>(metadata.default_value.int_value));
+            break;
+        case BT_INT64:
+            Write(static_cast<int64_t>(metadata.default_value.int_value));
+            break;
+        case BT_WSTRING:
+            Write(metadata.default_value.wstring_value);
+            break;
+        default:
+            BOOST_ASSERT(false);
+            break;
+    }
+}
+
+
+template <typename Output> struct
+may_omit_fields<ColumnarWriter<Output> >
+    : std::false_type {};
+
+template <typename Input, typename MarshaledBondedProtocols> struct
+is_protocol_enabled<ColumnarReader<Input, MarshaledBondedProtocols> >
+    : std::true_type {};
+
+} // namespace bond
@@ -640,6 +640,33 @@ private:
 };
 
 
+namespace detail
+{
+
+// Compact Binary field header for a field known at compile time: 1, 2 or 3
+// bytes stored in the order they are written, starting at the least
+// significant byte of value.
+template <BondDataType type, uint16_t id> struct
+compact_field_header
+{
+    BOOST_STATIC_ASSERT((type & 0x1f) == type);
+
+    BOND_STATIC_CONSTEXPR uint32_t size = id <= 5 ? 1 : (id <= 0xff ? 2 : 3);
+
+    BOND_STATIC_CONSTEXPR uint32_t value = id <= 5
+        ? static_cast<uint32_t>(type | (id << 5))
+        : static_cast<uint32_t>(type | ((id <= 0xff ? 0x06 : 0x07) << 5) | (id << 8));
+};
+
+template <BondDataType type, uint16_t id>
+BOND_CONSTEXPR_OR_CONST uint32_t compact_field_header<type, id>::size;
+
+template <BondDataType type, uint16_t id>
+BOND_CONSTEXPR_OR_CONST uint32_t compact_field_header<type, id>::value;
+
+} // namespace detail
+
+
 /// @brief Writer for Compact Binary Protocol
 template <typename BufferT>
 class CompactBinaryWriter
@@ -695,6 +722,13 @@ public:
     }
 
 
+    /// @brief Protocol version used by the writer
+    uint16_t GetVersion() const
+    {
+        return _version;
+    }
+
+
     bool NeedPass0()
     {
         return v2 == _version && !_it;
@@ -770,6 +804,38 @@ public:
         }
     }
 
+    // WriteFieldBegin with the header encoded at compile time
+    template <BondDataType type, uint16_t id>
+    void WriteFieldBegin()
+    {
+        typedef detail::compact_field_header<type, id> header;
+
+        WriteFieldHeader(std::integral_constant<uint32_t, header::size>(), header::value);
+    }
+
+    // WriteField for basic types with the header encoded at compile time
+    template <uint16_t id, typename T>
+    typename boost::disable_if_c<(sizeof(T) == 1 && id <= 5 && !std::is_enum<T>::value)>::type
+    WriteField(const T& value)
+    {
+        WriteFieldBegin<get_type_id<T>::value, id>();
+        Write(value);
+        WriteFieldEnd();
+    }
+
+    // WriteField for 1 byte values following a 1 byte header, which are
+    // written together in a single store
+    template <uint16_t id, typename T>
+    typename boost::enable_if_c<(sizeof(T) == 1 && id <= 5 && !std::is_enum<T>::value)>::type
+    WriteField(const T& value)
+    {
+        typedef detail::compact_field_header<get_type_id<T>::value, id> header;
+
+        uint8_t byte;
+        std::memcpy(&byte, &value, 1);
+        _output.Write(static_cast<uint16_t>(header::value | (byte << 8)));
+    }
+
     // WriteFieldEnd
     void WriteFieldEnd()
     {}
@@ -874,6 +940,21 @@ protected:
     template <typename Buffer>
     friend class CompactBinaryWriter;
 
+    void WriteFieldHeader(std::integral_constant<uint32_t, 1>, uint32_t header)
+    {
+        _output.Write(static_cast<uint8_t>(header));
+    }
+
+    void WriteFieldHeader(std::integral_constant<uint32_t, 2>, uint32_t header)
+    {
+        _output.Write(static_cast<uint16_t>(header));
+    }
+
+    void WriteFieldHeader(std::integral_constant<uint32_t, 3>, uint32_t header)
+    {
+        _output.Write(&header, 3);
+    }
+
     void LengthBegin(Counter& counter)
     {
         _stack.push(_lengths.size());
@@ -918,6 +999,10 @@ template <typename Input> struct
 protocol_has_multiple_versions<CompactBinaryReader<Input> >
     : enable_protocol_versions<CompactBinaryReader<Input> > {};
 
+template <typename Output> struct
+uses_static_field_headers<CompactBinaryWriter<Output> >
+    : std::true_type {};
+
 template <typename Input, typename Output>
 inline
 bool is_protocol_version_same(const CompactBinaryReader<Input>& reader,
@@ -0,0 +1,462 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "../encoding.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/exception.h>
+#include <bond/stream/input_buffer.h>
+#include <bond/stream/output_buffer.h>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace bond
+{
+namespace detail
+{
+
+// Values which columns store as raw bytes, in their native little endian
+// representation. Other scalars are stored in integer columns.
+template <typename T> struct
+is_raw_column_value
+    : std::integral_constant<bool,
+        std::is_floating_point<T>::value
+        || std::is_same<T, int8_t>::value
+        || std::is_same<T, uint8_t>::value> {};
+
+
+template <typename T>
+typename boost::enable_if<std::is_enum<T>, uint64_t>::type
+inline ToColumnInteger(T value)
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(value));
+}
+
+template <typename T>
+typename boost::disable_if<std::is_enum<T>, uint64_t>::type
+inline ToColumnInteger(T value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+
+template <typename T>
+typename boost::enable_if<std::is_enum<T> >::type
+inline FromColumnInteger(T& var, uint64_t value)
+{
+    var = static_cast<T>(static_cast<int32_t>(value));
+}
+
+inline void FromColumnInteger(bool& var, uint64_t value)
+{
+    var = (value != 0);
+}
+
+template <typename T>
+typename boost::enable_if_c<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type
+inline FromColumnInteger(T& var, uint64_t value)
+{
+    var = static_cast<T>(value);
+}
+
+
+// Integer columns are delta encoded, the deltas are zigzag encoded and then
+// run-length encoded. Each run starts with a variable encoded header,
+// (count << 1 | repeated), followed by either a single variable encoded value
+// repeated count times or by count variable encoded values.
+//
+// Runs shorter than this are merged into the surrounding literal run.
+BOND_CONSTEXPR_OR_CONST uint64_t min_column_run = 3;
+
+
+inline uint64_t ColumnRunLength(const std::vector<uint64_t>& values, uint64_t begin)
+{
+    uint64_t end = begin + 1;
+
+    while (end < values.size() && values[end] == values[begin])
+        ++end;
+
+    return end - begin;
+}
+
+
+template <typename Buffer>
+inline void WriteIntegerColumn(Buffer& output, const std::vector<uint64_t>& integers)
+{
+    const uint64_t count = integers.size();
+    std::vector<uint64_t> deltas(integers.size());
+    uint64_t previous = 0;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        deltas[i] = EncodeZigZag(static_cast<int64_t>(integers[i] - previous));
+        previous = integers[i];
+    }
+
+    WriteVariableUnsigned(output, count);
+
+    for (uint64_t begin = 0; begin < count;)
+    {
+        uint64_t run = ColumnRunLength(deltas, begin);
+
+        if (run >= min_column_run)
+        {
+            WriteVariableUnsigned(output, (run << 1) | 1);
+            WriteVariableUnsigned(output, deltas[begin]);
+            begin += run;
+            continue;
+        }
+
+        uint64_t end = begin + run;
+
+        while (end < count && (run = ColumnRunLength(deltas, end)) < min_column_run)
+            end += run;
+
+        WriteVariableUnsigned(output, (end - begin) << 1);
+
+        for (; begin != end; ++begin)
+            WriteVariableUnsigned(output, deltas[begin]);
+    }
+}
+
+
+// Decoded integer column. Repeated runs are not expanded, since a few bytes
+// of payload can encode a run of any length; the memory used is proportional
+// to the size of the payload rather than to the count of values.
+class IntegerColumn
+{
+public:
+    IntegerColumn()
+        : _count(0),
+          _next(0),
+          _run(0),
+          _remaining(0),
+          _value(0),
+          _delta(0),
+          _literal(nullptr)
+    {}
+
+    template <typename Buffer>
+    void Read(Buffer& input)
+    {
+        ReadVariableUnsigned(input, _count);
+
+        _runs.clear();
+        _literals.clear();
+        _next = _run = _remaining = 0;
+
+        uint64_t previous = 0;
+
+        for (uint64_t decoded = 0; decoded < _count;)
+        {
+            uint64_t header, value;
+            ReadVariableUnsigned(input, header);
+
+            const uint64_t length = header >> 1;
+
+            if (length == 0 || length > _count - decoded)
+            {
+                BOND_THROW(CoreException, "Invalid run of " << length << " values in a column of " << _count);
+            }
+
+            Run run = { length, previous, 0, _literals.size() };
+
+            if (header & 1)
+            {
+                ReadVariableUnsigned(input, value);
+
+                run.delta = static_cast<uint64_t>(DecodeZigZag(value));
+                run.literals = repeated;
+                previous += run.delta * length;
+            }
+            else
+            {
+                for (uint64_t i = 0; i < length; ++i)
+                {
+                    ReadVariableUnsigned(input, value);
+                    _literals.push_back(previous += static_cast<uint64_t>(DecodeZigZag(value)));
+                }
+            }
+
+            _runs.push_back(run);
+            decoded += length;
+        }
+    }
+
+    uint64_t size() const
+    {
+        return _count;
+    }
+
+    bool more() const
+    {
+        return _next != _count;
+    }
+
+    uint64_t next()
+    {
+        BOOST_ASSERT(more());
+
+        if (_remaining == 0)
+            NextRun();
+
+        ++_next;
+        --_remaining;
+
+        return _literal ? *_literal++ : (_value += _delta);
+    }
+
+private:
+    void NextRun()
+    {
+        const Run& run = _runs[_run++];
+
+        _remaining = run.length;
+        _value = run.previous;
+        _delta = run.delta;
+        _literal = run.literals == repeated ? nullptr : &_literals[run.literals];
+    }
+
+    static const size_t repeated = ~size_t(0);
+
+    struct Run
+    {
+        uint64_t length;
+        uint64_t previous;
+        uint64_t delta;
+        size_t literals;
+    };
+
+    uint64_t _count;
+    uint64_t _next;
+    size_t _run;
+    uint64_t _remaining;
+    uint64_t _value;
+    uint64_t _delta;
+    const uint64_t* _literal;
+    std::vector<Run> _runs;
+    std::vector<uint64_t> _literals;
+};
+
+
+// Maximum nesting of columns accepted by ColumnReader
+BOND_CONSTEXPR_OR_CONST uint32_t column_max_depth = 64;
+
+
+// Values of one field of the structs in a columnar list, or of one element
+// or key of a container in such structs, collected by ColumnarWriter.
+// Container sizes and string lengths are stored in the integer column, string
+// characters in the byte column. Struct fields, container elements and map
+// keys and values are stored in child columns.
+class ColumnWriter
+{
+public:
+    void WriteInteger(uint64_t value)
+    {
+        _integers.push_back(value);
+    }
+
+    OutputBuffer& Bytes()
+    {
+        return _bytes;
+    }
+
+    ColumnWriter& Child(uint32_t index)
+    {
+        if (index >= _children.size())
+            _children.resize(index + 1);
+
+        if (!_children[index])
+            _children[index].reset(new ColumnWriter);
+
+        return *_children[index];
+    }
+
+    // Writes the column and its children, depth first
+    template <typename Buffer>
+    void Write(Buffer& output) const
+    {
+        WriteIntegerColumn(output, _integers);
+
+        const blob bytes = _bytes.GetBuffer();
+        WriteVariableUnsigned(output, bytes.length());
+        output.Write(bytes);
+
+        WriteVariableUnsigned(output, static_cast<uint32_t>(_children.size()));
+
+        for (const auto& child : _children)
+        {
+            if (child)
+                child->Write(output);
+            else
+                ColumnWriter().Write(output);
+        }
+    }
+
+private:
+    std::vector<uint64_t> _integers;
+    OutputBuffer _bytes;
+    std::vector<std::unique_ptr<ColumnWriter> > _children;
+};
+
+
+// Column read by ColumnarReader. All integers of the column are decoded at
+// once when the columnar list is opened.
+class ColumnReader
+{
+public:
+    uint64_t ReadInteger()
+    {
+        if (!_integers.more())
+        {
+            BOND_THROW(CoreException, "Read past the end of an integer column of " << _integers.size() << " values");
+        }
+
+        return _integers.next();
+    }
+
+    InputBuffer& Bytes()
+    {
+        return _bytes;
+    }
+
+    ColumnReader& Child(uint32_t index)
+    {
+        if (index >= _children.size())
+        {
+            BOND_THROW(CoreException, "Column " << index << " not found in the payload");
+        }
+
+        return *_children[index];
+    }
+
+    void Read(InputBuffer& input, uint32_t depth = 0)
+    {
+        if (depth == column_max_depth)
+        {
+            BOND_THROW(CoreException, "Columns nested deeper than " << column_max_depth << " levels");
+        }
+
+        _integers.Read(input);
+
+        uint32_t length, count;
+
+        ReadVariableUnsigned(input, length);
+        blob bytes;
+        input.Read(bytes, length);
+        _bytes = InputBuffer(bytes);
+
+        ReadVariableUnsigned(input, count);
+        _children.clear();
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            _children.emplace_back(new ColumnReader);
+            _children.back()->Read(input, depth + 1);
+        }
+    }
+
+private:
+    IntegerColumn _integers;
+    InputBuffer _bytes;
+    std::vector<std::unique_ptr<ColumnReader> > _children;
+};
+
+
+// Columns of a columnar list and the position in them of the value which is
+// written or read next.
+template <typename Column>
+class ColumnTree
+{
+public:
+    ColumnTree()
+    {
+        _frames.push_back(Frame(_root, Frame::elements));
+    }
+
+    Column& Root()
+    {
+        return _root;
+    }
+
+    bool IsOpen() const
+    {
+        return !_frames.empty();
+    }
+
+    // Column of the next field of the struct or element of the container
+    // which is written or read
+    Column& Next()
+    {
+        BOOST_ASSERT(IsOpen());
+        return _frames.back().Next();
+    }
+
+    void BeginStruct()
+    {
+        _frames.push_back(Frame(Next(), Frame::fields));
+    }
+
+    void BeginList(Column& column)
+    {
+        _frames.push_back(Frame(column, Frame::elements));
+    }
+
+    void BeginMap(Column& column)
+    {
+        _frames.push_back(Frame(column, Frame::pairs));
+    }
+
+    void End()
+    {
+        BOOST_ASSERT(IsOpen());
+        _frames.pop_back();
+    }
+
+private:
+    struct Frame
+    {
+        enum Kind
+        {
+            fields,
+            elements,
+            pairs
+        };
+
+        Frame(Column& column_, Kind kind_)
+            : column(&column_),
+              kind(kind_),
+              slot(0)
+        {}
+
+        Column& Next()
+        {
+            uint32_t index = slot;
+
+            if (kind == fields)
+                ++slot;
+            else if (kind == pairs)
+                slot ^= 1;
+
+            return column->Child(index);
+        }
+
+        Column* column;
+        Kind kind;
+        uint32_t slot;
+    };
+
+    Column _root;
+    std::vector<Frame> _frames;
+};
+
+} // namespace detail
+} // namespace bond
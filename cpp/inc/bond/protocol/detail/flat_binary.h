@@ -0,0 +1,650 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "../encoding.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/bond_version.h>
+#include <bond/core/container_interface.h>
+#include <bond/core/exception.h>
+#include <bond/core/reflection.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace bond
+{
+namespace detail
+{
+
+// Values stored in place in the slots of a table or in the elements of a
+// span, in their native little endian representation. All other values are
+// stored elsewhere in the buffer and referenced by an offset.
+template <typename T> struct
+is_flat_scalar
+    : std::integral_constant<bool,
+        std::is_arithmetic<T>::value
+        || std::is_enum<T>::value> {};
+
+
+template <typename T, typename Enable = void> struct
+flat_slot
+{
+    // Offset of the value relative to the slot, 0 for an empty value
+    static const uint32_t size = sizeof(uint32_t);
+    static const uint32_t align = sizeof(uint32_t);
+};
+
+template <typename T> struct
+flat_slot<T, typename boost::enable_if<is_flat_scalar<T> >::type>
+{
+    BOOST_STATIC_ASSERT(!std::is_enum<T>::value || sizeof(T) == sizeof(int32_t));
+
+    static const uint32_t size = sizeof(T);
+    static const uint32_t align = sizeof(T);
+};
+
+
+// Types which Flat Binary protocol doesn't support
+template <typename T> struct
+is_flat_unsupported
+    : std::integral_constant<bool,
+        is_bonded<T>::value
+        || is_type_alias<T>::value
+        || !std::is_same<typename remove_maybe<T>::type, T>::value> {};
+
+
+// Layout of the slots of the fields of a struct, in the order of the field
+// ids, each aligned to its size.
+template <typename Begin, typename End, uint32_t Offset> struct
+flat_fields_layout
+{
+    typedef typename boost::mpl::deref<Begin>::type field;
+    typedef flat_slot<typename field::value_type> slot;
+
+    BOOST_STATIC_ASSERT_MSG(!is_flat_unsupported<typename field::value_type>::value,
+        "bonded<T>, maybe<T> and type aliases are not supported by Flat Binary protocol");
+
+    static const uint32_t offset = (Offset + slot::align - 1) / slot::align * slot::align;
+
+    typedef flat_fields_layout<typename boost::mpl::next<Begin>::type, End, offset + slot::size> next;
+
+    static const uint32_t size = next::size;
+
+    template <typename Field> struct
+    offset_of
+        : std::conditional<std::is_same<Field, field>::value,
+            std::integral_constant<uint32_t, offset>,
+            typename next::template offset_of<Field> >::type {};
+};
+
+template <typename End, uint32_t Offset> struct
+flat_fields_layout<End, End, Offset>
+{
+    static const uint32_t size = Offset;
+
+    template <typename Field> struct
+    offset_of;
+};
+
+
+// A table of a struct starts with the size of the table in bytes, followed by
+// the offset of the table of the base struct, if any, and the slots of the
+// fields. Fields beyond the size of the table have their default values,
+// which makes it possible to add fields with ids higher than existing ones.
+template <typename T> struct
+flat_table
+{
+    typedef typename schema<T>::type::fields fields;
+
+    static const uint32_t base_offset = sizeof(uint32_t);
+    static const uint32_t fields_offset = has_base<T>::value ? 2 * sizeof(uint32_t) : sizeof(uint32_t);
+
+    typedef flat_fields_layout<typename boost::mpl::begin<fields>::type,
+                               typename boost::mpl::end<fields>::type,
+                               fields_offset> layout;
+
+    static const uint32_t size = layout::size;
+    static const uint32_t align = sizeof(uint64_t);
+};
+
+
+BOND_CONSTEXPR_OR_CONST uint16_t flat_magic = 0x4c46 /*FL*/;
+
+// Maximum nesting of tables and containers accepted by the verifier
+BOND_CONSTEXPR_OR_CONST uint32_t flat_max_depth = 64;
+
+
+inline uint64_t FlatAlign(uint64_t position, uint32_t align)
+{
+    return (position + align - 1) / align * align;
+}
+
+
+template <typename T>
+inline T FlatLoad(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+
+// Buffer in which a payload is built front to back. Values referenced from a
+// slot are written after the slot and linked to it once their position is
+// known.
+class FlatBuilder
+{
+public:
+    uint32_t Allocate(uint32_t size, uint32_t align)
+    {
+        const uint64_t position = FlatAlign(_data.size(), align);
+
+        if (position + size > (std::numeric_limits<uint32_t>::max)())
+        {
+            BOND_THROW(CoreException, "Flat Binary payload exceeds 4 GB");
+        }
+
+        _data.resize(static_cast<size_t>(position + size));
+        return static_cast<uint32_t>(position);
+    }
+
+    void Write(const void* data, uint32_t size)
+    {
+        if (size)
+            std::memcpy(&_data[Allocate(size, 1)], data, size);
+    }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+        Write(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void Store(uint32_t position, const T& value)
+    {
+        std::memcpy(&_data[position], &value, sizeof(T));
+    }
+
+    void Link(uint32_t slot, uint32_t target)
+    {
+        BOOST_ASSERT(target > slot);
+        Store(slot, target - slot);
+    }
+
+    // Copies the payload to a buffer aligned to 8 bytes, so that values are
+    // aligned in memory as they are in the payload.
+    blob GetBuffer() const
+    {
+        const uint32_t size = static_cast<uint32_t>(_data.size());
+        const boost::shared_ptr<uint64_t[]> buffer = boost::make_shared_noinit<uint64_t[]>((size + 7) / 8);
+
+        if (size)
+            std::memcpy(buffer.get(), _data.data(), size);
+
+        return blob(boost::shared_ptr<const char[]>(buffer, reinterpret_cast<const char*>(buffer.get())), size);
+    }
+
+private:
+    std::vector<char> _data;
+};
+
+
+// Writes values using their compile-time schema
+class FlatWriter
+{
+public:
+    // Writes the value and returns its position
+    template <typename T>
+    static typename boost::enable_if<has_schema<T>, uint32_t>::type
+    Write(FlatBuilder& output, const T& value)
+    {
+        typedef flat_table<T> table;
+
+        const uint32_t position = output.Allocate(table::size, table::align);
+        output.Store(position, static_cast<uint32_t>(table::size));
+
+        WriteBase(output, position, value);
+        WriteFields(output, position, value, static_cast<const typename table::layout*>(nullptr));
+
+        return position;
+    }
+
+    template <typename T>
+    static typename boost::enable_if_c<is_string<T>::value || is_wstring<T>::value, uint32_t>::type
+    Write(FlatBuilder& output, const T& value)
+    {
+        typedef typename string_char_int_type<T>::type char_type;
+
+        const uint32_t length = string_length(value);
+        const uint32_t position = output.Allocate(sizeof(uint32_t), sizeof(uint32_t));
+
+        output.Store(position, length);
+        WriteStringData(output, value, length);
+        output.Write(char_type());
+
+        return position;
+    }
+
+    static uint32_t Write(FlatBuilder& output, const blob& value)
+    {
+        const uint32_t position = output.Allocate(sizeof(uint32_t), sizeof(uint32_t));
+
+        output.Store(position, value.length());
+        output.Write(value.content(), value.length());
+
+        return position;
+    }
+
+    template <typename T>
+    static typename boost::enable_if_c<(is_list_container<T>::value || is_set_container<T>::value)
+                                    && !std::is_same<T, blob>::value, uint32_t>::type
+    Write(FlatBuilder& output, const T& value)
+    {
+        return WriteElements<typename element_type<T>::type>(output, value, container_size(value),
+            [](const typename element_type<T>::type& item) -> const typename element_type<T>::type& { return item; });
+    }
+
+    // A map is stored as the offsets of a list of keys and of a list of values
+    template <typename T>
+    static typename boost::enable_if<is_map_container<T>, uint32_t>::type
+    Write(FlatBuilder& output, const T& value)
+    {
+        typedef typename element_type<T>::type::first_type key_type;
+        typedef typename element_type<T>::type::second_type mapped_type;
+        typedef typename element_type<T>::type item_type;
+
+        const uint32_t position = output.Allocate(2 * sizeof(uint32_t), sizeof(uint32_t));
+        const uint32_t size = container_size(value);
+
+        output.Link(position, WriteElements<typename std::remove_const<key_type>::type>(output, value, size,
+            [](const item_type& item) -> const key_type& { return item.first; }));
+
+        output.Link(position + sizeof(uint32_t), WriteElements<mapped_type>(output, value, size,
+            [](const item_type& item) -> const mapped_type& { return item.second; }));
+
+        return position;
+    }
+
+private:
+    template <typename T>
+    static typename boost::enable_if<is_flat_scalar<T> >::type
+    WriteSlot(FlatBuilder& output, uint32_t slot, const T& value)
+    {
+        output.Store(slot, value);
+    }
+
+    // Empty strings and containers are stored as an empty offset
+    template <typename T>
+    static typename boost::disable_if<is_flat_scalar<T> >::type
+    WriteSlot(FlatBuilder& output, uint32_t slot, const T& value)
+    {
+        if (!IsEmpty(value))
+            output.Link(slot, Write(output, value));
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_schema<T>, bool>::type
+    IsEmpty(const T& /*value*/)
+    {
+        return false;
+    }
+
+    template <typename T>
+    static typename boost::enable_if_c<is_string<T>::value || is_wstring<T>::value, bool>::type
+    IsEmpty(const T& value)
+    {
+        return string_length(value) == 0;
+    }
+
+    static bool IsEmpty(const blob& value)
+    {
+        return value.empty();
+    }
+
+    template <typename T>
+    static typename boost::enable_if_c<is_container<T>::value && !std::is_same<T, blob>::value, bool>::type
+    IsEmpty(const T& value)
+    {
+        return container_size(value) == 0;
+    }
+
+    template <typename T>
+    static typename boost::enable_if<has_base<T> >::type
+    WriteBase(FlatBuilder& output, uint32_t table, const T& value)
+    {
+        const typename schema<T>::type::base& base = value;
+        output.Link(table + flat_table<T>::base_offset, Write(output, base));
+    }
+
+    template <typename T>
+    static typename boost::disable_if<has_base<T> >::type
+    WriteBase(FlatBuilder& /*output*/, uint32_t /*table*/, const T& /*value*/)
+    {}
+
+    template <typename T, typename End, uint32_t Offset>
+    static void WriteFields(FlatBuilder& /*output*/, uint32_t /*table*/, const T& /*value*/,
+                            const flat_fields_layout<End, End, Offset>*)
+    {}
+
+    template <typename T, typename Layout>
+    static void WriteFields(FlatBuilder& output, uint32_t table, const T& value, const Layout*)
+    {
+        WriteSlot(output, table + Layout::offset, Layout::field::GetVariable(value));
+        WriteFields(output, table, value, static_cast<const typename Layout::next*>(nullptr));
+    }
+
+    // Scalars are stored as a span: the count followed by the elements,
+    // aligned to their size.
+    template <typename E, typename T, typename Project>
+    static typename boost::enable_if<is_flat_scalar<E>, uint32_t>::type
+    WriteElements(FlatBuilder& output, const T& value, uint32_t size, const Project& project)
+    {
+        const uint32_t position = output.Allocate(sizeof(uint32_t), sizeof(uint32_t));
+        output.Store(position, size);
+
+        uint32_t element = output.Allocate(size * sizeof(E), flat_slot<E>::align);
+
+        for (const_enumerator<T> items(value); items.more(); element += sizeof(E))
+            output.Store(element, project(items.next()));
+
+        return position;
+    }
+
+    // Other values are stored as the count followed by the offsets of the
+    // elements.
+    template <typename E, typename T, typename Project>
+    static typename boost::disable_if<is_flat_scalar<E>, uint32_t>::type
+    WriteElements(FlatBuilder& output, const T& value, uint32_t size, const Project& project)
+    {
+        BOOST_STATIC_ASSERT_MSG(!is_flat_unsupported<E>::value,
+            "bonded<T> and type aliases are not supported by Flat Binary protocol");
+
+        const uint32_t position = output.Allocate(sizeof(uint32_t) + size * sizeof(uint32_t), sizeof(uint32_t));
+        output.Store(position, size);
+
+        uint32_t slot = position + sizeof(uint32_t);
+
+        for (const_enumerator<T> items(value); items.more(); slot += sizeof(uint32_t))
+            WriteSlot(output, slot, project(items.next()));
+
+        return position;
+    }
+};
+
+
+// Validates a payload, so that views on it only access memory within the
+// payload and only read valid values.
+class FlatVerifier
+{
+public:
+    FlatVerifier(const char* data, uint32_t size)
+        : _data(data),
+          _size(size),
+          _depth(0),
+          // Each table or container takes at least 4 bytes and each bool
+          // element one more, so verifying a valid payload never costs more
+          // than its size. References sharing a target are charged again.
+          _budget(size)
+    {}
+
+    template <typename T>
+    bool VerifyRoot()
+    {
+        if (reinterpret_cast<uintptr_t>(_data) % sizeof(uint64_t) != 0
+            || !Check(0, 2 * sizeof(uint32_t), 1)
+            || FlatLoad<uint16_t>(_data) != flat_magic
+            || FlatLoad<uint16_t>(_data + sizeof(uint16_t)) != v1)
+        {
+            return false;
+        }
+
+        return Verify<T>(FlatLoad<uint32_t>(_data + sizeof(uint32_t)));
+    }
+
+private:
+    bool Check(uint64_t position, uint64_t size, uint32_t align) const
+    {
+        return position % align == 0
+            && position + size <= _size;
+    }
+
+    bool Charge(uint64_t cost)
+    {
+        if (cost > _budget)
+            return false;
+
+        _budget -= static_cast<uint32_t>(cost);
+        return true;
+    }
+
+    template <typename T>
+    bool VerifyReference(uint32_t slot)
+    {
+        const uint32_t offset = FlatLoad<uint32_t>(_data + slot);
+
+        if (offset == 0)
+            return true;
+
+        if (static_cast<uint64_t>(slot) + offset > _size
+            || _depth == flat_max_depth
+            || !Charge(sizeof(uint32_t)))
+        {
+            return false;
+        }
+
+        ++_depth;
+
+        const bool valid = Verify<T>(slot + offset);
+
+        --_depth;
+        return valid;
+    }
+
+    template <typename T>
+    typename boost::enable_if<has_schema<T>, bool>::type
+    Verify(uint32_t position)
+    {
+        typedef flat_table<T> table;
+
+        if (!Check(position, sizeof(uint32_t), table::align))
+            return false;
+
+        const uint32_t size = FlatLoad<uint32_t>(_data + position);
+
+        return size >= sizeof(uint32_t)
+            && Check(position, size, table::align)
+            && VerifyBase<T>(position, size)
+            && VerifyFields(position, size, static_cast<const typename table::layout*>(nullptr));
+    }
+
+    template <typename T>
+    typename boost::enable_if_c<is_string<T>::value || is_wstring<T>::value, bool>::type
+    Verify(uint32_t position)
+    {
+        return VerifyBytes(position, sizeof(typename string_char_int_type<T>::type), 1);
+    }
+
+    template <typename T>
+    typename boost::enable_if<std::is_same<T, blob>, bool>::type
+    Verify(uint32_t position)
+    {
+        return VerifyBytes(position, sizeof(uint8_t), 0);
+    }
+
+    template <typename T>
+    typename boost::enable_if_c<(is_list_container<T>::value || is_set_container<T>::value)
+                             && !std::is_same<T, blob>::value, bool>::type
+    Verify(uint32_t position)
+    {
+        return VerifyElements<typename element_type<T>::type>(position);
+    }
+
+    template <typename T>
+    typename boost::enable_if<is_map_container<T>, bool>::type
+    Verify(uint32_t position)
+    {
+        typedef typename std::remove_const<typename element_type<T>::type::first_type>::type key_type;
+        typedef typename element_type<T>::type::second_type mapped_type;
+
+        const uint32_t keys = position;
+        const uint32_t values = position + sizeof(uint32_t);
+
+        return Check(position, 2 * sizeof(uint32_t), sizeof(uint32_t))
+            && VerifyElementsReference<key_type>(keys)
+            && VerifyElementsReference<mapped_type>(values)
+            && Count(keys) == Count(values);
+    }
+
+    template <typename T>
+    typename boost::enable_if<has_base<T>, bool>::type
+    VerifyBase(uint32_t table, uint32_t size)
+    {
+        return size < flat_table<T>::fields_offset
+            || VerifyReference<typename schema<T>::type::base>(table + flat_table<T>::base_offset);
+    }
+
+    template <typename T>
+    typename boost::disable_if<has_base<T>, bool>::type
+    VerifyBase(uint32_t /*table*/, uint32_t /*size*/)
+    {
+        return true;
+    }
+
+    template <typename End, uint32_t Offset>
+    bool VerifyFields(uint32_t /*table*/, uint32_t /*size*/, const flat_fields_layout<End, End, Offset>*)
+    {
+        return true;
+    }
+
+    template <typename Layout>
+    bool VerifyFields(uint32_t table, uint32_t size, const Layout*)
+    {
+        typedef typename Layout::field::value_type value_type;
+
+        // Fields beyond the size of the table have default values
+        if (Layout::offset + Layout::slot::size > size)
+            return true;
+
+        return VerifySlot<value_type>(table + Layout::offset)
+            && VerifyFields(table, size, static_cast<const typename Layout::next*>(nullptr));
+    }
+
+    template <typename T>
+    typename boost::enable_if<std::is_same<T, bool>, bool>::type
+    VerifySlot(uint32_t slot)
+    {
+        return FlatLoad<uint8_t>(_data + slot) <= 1;
+    }
+
+    template <typename T>
+    typename boost::enable_if_c<is_flat_scalar<T>::value && !std::is_same<T, bool>::value, bool>::type
+    VerifySlot(uint32_t /*slot*/)
+    {
+        return true;
+    }
+
+    template <typename T>
+    typename boost::disable_if<is_flat_scalar<T>, bool>::type
+    VerifySlot(uint32_t slot)
+    {
+        return VerifyReference<T>(slot);
+    }
+
+    // Count followed by size-byte units and the given number of terminating units
+    bool VerifyBytes(uint32_t position, uint32_t size, uint32_t terminator)
+    {
+        return Check(position, sizeof(uint32_t), sizeof(uint32_t))
+            && Check(position + sizeof(uint32_t),
+                     (static_cast<uint64_t>(FlatLoad<uint32_t>(_data + position)) + terminator) * size, 1);
+    }
+
+    template <typename E>
+    typename boost::enable_if<is_flat_scalar<E>, bool>::type
+    VerifyElements(uint32_t position)
+    {
+        if (!Check(position, sizeof(uint32_t), sizeof(uint32_t)))
+            return false;
+
+        const uint64_t count = FlatLoad<uint32_t>(_data + position);
+        const uint64_t elements = FlatAlign(position + sizeof(uint32_t), flat_slot<E>::align);
+
+        if (!Check(elements, count * sizeof(E), 1)
+            || (std::is_same<E, bool>::value && !Charge(count)))
+        {
+            return false;
+        }
+
+        for (uint64_t i = 0; std::is_same<E, bool>::value && i < count; ++i)
+        {
+            if (!VerifySlot<E>(static_cast<uint32_t>(elements + i)))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename E>
+    typename boost::disable_if<is_flat_scalar<E>, bool>::type
+    VerifyElements(uint32_t position)
+    {
+        if (!Check(position, sizeof(uint32_t), sizeof(uint32_t)))
+            return false;
+
+        const uint32_t count = FlatLoad<uint32_t>(_data + position);
+
+        if (!Check(position + sizeof(uint32_t), static_cast<uint64_t>(count) * sizeof(uint32_t), 1))
+            return false;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!VerifyReference<E>(position + sizeof(uint32_t) * (i + 1)))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename E>
+    bool VerifyElementsReference(uint32_t slot)
+    {
+        const uint32_t offset = FlatLoad<uint32_t>(_data + slot);
+
+        if (offset == 0)
+            return true;
+
+        if (static_cast<uint64_t>(slot) + offset > _size || !Charge(sizeof(uint32_t)))
+            return false;
+
+        return VerifyElements<E>(slot + offset);
+    }
+
+    // Count of the elements referenced from a verified slot
+    uint32_t Count(uint32_t slot) const
+    {
+        const uint32_t offset = FlatLoad<uint32_t>(_data + slot);
+        return offset ? FlatLoad<uint32_t>(_data + slot + offset) : 0;
+    }
+
+    const char* _data;
+    const uint32_t _size;
+    uint32_t _depth;
+    uint32_t _budget;
+};
+
+} // namespace detail
+} // namespace bond
@@ -228,13 +228,28 @@ inline void Read(const rapidjson::Value& value, bool& var)
     var = value.GetBool();
 }
 
+// Names of enum constants are looked up without copying them when the
+// generated code has the ToEnum overload taking the length of the name
+template <typename T>
+inline auto ReadEnumName(const rapidjson::Value& value, T& var, int)
+    -> decltype(ToEnum(var, value.GetString(), std::size_t()))
+{
+    return ToEnum(var, value.GetString(), value.GetStringLength());
+}
+
+template <typename T>
+inline bool ReadEnumName(const rapidjson::Value& value, T& var, long)
+{
+    return ToEnum(var, value.GetString());
+}
+
 // enum
 template <typename T>
 typename boost::enable_if<std::is_enum<T> >::type
 Read(const rapidjson::Value& value, T& var)
 {
     if (value.IsString())
-        ToEnum(var, value.GetString());
+        ReadEnumName(value, var, 0);
     else
         var = static_cast<T>(value.GetInt());
 }
@@ -185,7 +185,7 @@ string_char_int_type<T, typename boost::enable_if<is_wstring<T> >::type>
 
 template <typename Buffer, typename T>
 typename boost::enable_if_c<(sizeof(typename element_type<T>::type) == sizeof(typename string_char_int_type<T>::type))>::type
-inline ReadStringData(Buffer& input, T& value, uint32_t length)
+inline ReadStringCharacters(Buffer& input, T& value, uint32_t length)
 {
     resize_string(value, length);
     input.Read(string_data(value), length * sizeof(typename element_type<T>::type));
@@ -193,7 +193,7 @@ inline ReadStringData(Buffer& input, T& value, uint32_t length)
 
 template <typename Buffer, typename T>
 typename boost::enable_if_c<(sizeof(typename element_type<T>::type) > sizeof(typename string_char_int_type<T>::type))>::type
-inline ReadStringData(Buffer& input, T& value, uint32_t length)
+inline ReadStringCharacters(Buffer& input, T& value, uint32_t length)
 {
     resize_string(value, length);
     typename element_type<T>::type* data = string_data(value);
@@ -206,6 +206,23 @@ inline ReadStringData(Buffer& input, T& value, uint32_t length)
     }
 }
 
+// Reads the characters of a string into the string. Specialized for string
+// types which reference the input buffer instead, e.g. blob_string.
+template <typename Buffer, typename T, typename Enable = void> struct
+string_data_reader
+{
+    static void Read(Buffer& input, T& value, uint32_t length)
+    {
+        ReadStringCharacters(input, value, length);
+    }
+};
+
+template <typename Buffer, typename T>
+inline void ReadStringData(Buffer& input, T& value, uint32_t length)
+{
+    string_data_reader<Buffer, T>::Read(input, value, length);
+}
+
 template <typename Buffer, typename T>
 typename boost::enable_if_c<(sizeof(typename element_type<T>::type) == sizeof(typename string_char_int_type<T>::type))>::type
 inline WriteStringData(Buffer& output, const T& value, uint32_t length)
@@ -0,0 +1,589 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/flat_binary.h"
+
+#include <boost/assert.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include <iterator>
+
+/*
+   Flat Binary protocol is an aligned, offset-based protocol designed to be
+   read in place, without deserialization. Fields are accessed through views
+   on the payload, in constant time, and lists of scalars are exposed as
+   spans of the payload.
+
+                                   .-------.---------.------.
+                    payload        | magic | version | root |
+                                   '-------'---------'------'
+
+                           magic            uint16 0x4c46 ("FL")
+
+                           version          uint16 1
+
+                           root             uint32 position of the table of the root struct
+
+                                   .------.------. .-------.
+                    struct         | size | base | | slots |...
+                                   '------'------' '-------'
+
+                           size             uint32 size of the table in bytes, 8-byte aligned
+
+                           base             uint32 offset of the table of the base struct,
+                                            present only if the struct has a base
+
+                           slots            slots of the fields in the order of the ids,
+                                            each aligned to its size
+
+                                            scalars are stored in the slot, enums as int32
+                                            and bool as a byte 0 or 1
+
+                                            other values are stored after the slot and the
+                                            slot contains their uint32 offset relative to
+                                            the slot, or 0 for an empty value
+
+                                            slots beyond the size of the table have the
+                                            default values of the fields
+
+                                   .--------. .-------.---.
+                    string, wstring| length | | chars | 0 |
+                                   '--------' '-------'---'
+
+                           length           uint32 number of characters
+
+                           chars            uint8 or uint16 characters, followed by a
+                                            terminating 0
+
+                                   .-------. .-------.
+                    blob           | count | | bytes |
+                                   '-------' '-------'
+
+                                   .-------. .-------.
+                    list, set,     | count | | items |...
+                    vector,        '-------' '-------'
+                    nullable
+                           count            uint32 count of items
+
+                           items            scalars, aligned to their size, or uint32
+                                            offsets of the items relative to the offset
+
+                                   .------.--------.
+                    map            | keys | values |
+                                   '------'--------'
+
+                           keys, values     uint32 offsets of lists of the keys and of the
+                                            values, in the same order
+
+   Views don't own the payload and must not outlive it. A payload from an
+   untrusted source must be validated with VerifyFlat before it is accessed.
+   bonded<T>, maybe<T> and type aliases are not supported.
+*/
+
+namespace bond
+{
+
+template <typename T> class FlatView;
+template <typename T> class FlatList;
+template <typename K, typename V> class FlatMap;
+
+
+/// @brief Contiguous sequence of scalars in a Flat Binary payload
+template <typename T>
+class FlatSpan
+{
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+
+    FlatSpan()
+        : _data(nullptr),
+          _size(0)
+    {}
+
+    FlatSpan(const T* data, uint32_t size)
+        : _data(data),
+          _size(size)
+    {}
+
+    const T* data() const
+    {
+        return _data;
+    }
+
+    uint32_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return _data;
+    }
+
+    const_iterator end() const
+    {
+        return _data + _size;
+    }
+
+    const T& operator[](uint32_t index) const
+    {
+        BOOST_ASSERT(index < _size);
+        return _data[index];
+    }
+
+private:
+    const T* _data;
+    uint32_t _size;
+};
+
+
+namespace detail
+{
+
+template <typename T, typename Enable = void> struct
+flat_view;
+
+
+// Value read from a slot which references it, or an empty value
+template <typename T, typename View> struct
+flat_reference
+{
+    typedef View type;
+
+    template <typename Metadata>
+    static View Default(const Metadata& /*metadata*/)
+    {
+        return View();
+    }
+
+    static View Read(const char* slot)
+    {
+        const uint32_t offset = FlatLoad<uint32_t>(slot);
+        return offset ? flat_view<T>::At(slot + offset) : View();
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if<is_flat_scalar<T> >::type>
+{
+    typedef T type;
+
+    template <typename Metadata>
+    static T Default(const Metadata& metadata)
+    {
+        return Default(metadata.default_value);
+    }
+
+    static T Read(const char* slot)
+    {
+        return FlatLoad<T>(slot);
+    }
+
+private:
+    template <typename X = T>
+    static typename boost::enable_if<std::is_same<X, bool>, T>::type
+    Default(const Variant& value)
+    {
+        return value.uint_value != 0;
+    }
+
+    template <typename X = T>
+    static typename boost::enable_if_c<std::is_integral<X>::value && std::is_unsigned<X>::value
+                                    && !std::is_same<X, bool>::value, T>::type
+    Default(const Variant& value)
+    {
+        return static_cast<T>(value.uint_value);
+    }
+
+    template <typename X = T>
+    static typename boost::enable_if_c<(std::is_integral<X>::value && std::is_signed<X>::value)
+                                    || std::is_enum<X>::value, T>::type
+    Default(const Variant& value)
+    {
+        return static_cast<T>(value.int_value);
+    }
+
+    template <typename X = T>
+    static typename boost::enable_if<std::is_floating_point<X>, T>::type
+    Default(const Variant& value)
+    {
+        return static_cast<T>(value.double_value);
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if<has_schema<T> >::type>
+    : flat_reference<T, FlatView<T> >
+{
+    static FlatView<T> At(const char* table)
+    {
+        return FlatView<T>(table);
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if<is_string<T> >::type>
+    : flat_reference<T, boost::string_ref>
+{
+    static boost::string_ref At(const char* target)
+    {
+        return boost::string_ref(target + sizeof(uint32_t), FlatLoad<uint32_t>(target));
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if<is_wstring<T> >::type>
+    : flat_reference<T, FlatSpan<uint16_t> >
+{
+    static FlatSpan<uint16_t> At(const char* target)
+    {
+        return FlatSpan<uint16_t>(reinterpret_cast<const uint16_t*>(target + sizeof(uint32_t)), FlatLoad<uint32_t>(target));
+    }
+};
+
+
+template <> struct
+flat_view<blob>
+    : flat_reference<blob, blob>
+{
+    static blob At(const char* target)
+    {
+        return blob(target + sizeof(uint32_t), FlatLoad<uint32_t>(target));
+    }
+};
+
+
+// Lists of the elements of containers
+template <typename E, typename Enable = void> struct
+flat_elements
+{
+    typedef FlatList<E> type;
+
+    static type At(const char* target)
+    {
+        return type(target);
+    }
+};
+
+template <typename E> struct
+flat_elements<E, typename boost::enable_if<is_flat_scalar<E> >::type>
+{
+    typedef FlatSpan<E> type;
+
+    static type At(const char* target)
+    {
+        const uintptr_t elements = static_cast<uintptr_t>(
+            FlatAlign(reinterpret_cast<uintptr_t>(target) + sizeof(uint32_t), flat_slot<E>::align));
+
+        return type(reinterpret_cast<const E*>(elements), FlatLoad<uint32_t>(target));
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if_c<(is_list_container<T>::value || is_set_container<T>::value)
+                                      && !std::is_same<T, blob>::value>::type>
+    : flat_reference<T, typename flat_elements<typename element_type<T>::type>::type>
+{
+    static typename flat_elements<typename element_type<T>::type>::type At(const char* target)
+    {
+        return flat_elements<typename element_type<T>::type>::At(target);
+    }
+};
+
+
+template <typename T> struct
+flat_view<T, typename boost::enable_if<is_map_container<T> >::type>
+    : flat_reference<T, FlatMap<typename std::remove_const<typename element_type<T>::type::first_type>::type,
+                                typename element_type<T>::type::second_type> >
+{
+    typedef typename flat_view::type type;
+
+    static type At(const char* target)
+    {
+        return type(target);
+    }
+};
+
+} // namespace detail
+
+
+/// @brief Read-only view of a struct in a Flat Binary payload
+///
+/// Fields are accessed using their reflection metadata, e.g.
+/// view.Get<Struct::Schema::var::field>(), and are returned by value for
+/// scalars or as views for other types.
+template <typename T>
+class FlatView
+{
+public:
+    typedef T value_type;
+
+    FlatView()
+        : _table(nullptr)
+    {}
+
+    explicit
+    FlatView(const char* table)
+        : _table(table)
+    {}
+
+    /// @brief True for a view of an empty struct reference
+    bool empty() const
+    {
+        return _table == nullptr;
+    }
+
+    template <typename Field>
+    typename boost::enable_if<std::is_same<typename Field::struct_type, T>,
+                              typename detail::flat_view<typename Field::value_type>::type>::type
+    Get() const
+    {
+        typedef typename Field::value_type field_type;
+        typedef detail::flat_slot<field_type> slot;
+
+        const uint32_t offset = detail::flat_table<T>::layout::template offset_of<Field>::value;
+
+        if (offset + slot::size <= Size())
+            return detail::flat_view<field_type>::Read(_table + offset);
+        else
+            return detail::flat_view<field_type>::Default(Field::GetMetadata());
+    }
+
+    /// @brief Access to the fields of base structs
+    template <typename Field>
+    typename boost::disable_if<std::is_same<typename Field::struct_type, T>,
+                               typename detail::flat_view<typename Field::value_type>::type>::type
+    Get() const
+    {
+        return Base().template Get<Field>();
+    }
+
+    template <typename X = T>
+    FlatView<typename schema<X>::type::base> Base() const
+    {
+        typedef detail::flat_table<T> table;
+
+        if (table::fields_offset <= Size())
+            return detail::flat_view<typename schema<X>::type::base>::Read(_table + table::base_offset);
+        else
+            return FlatView<typename schema<X>::type::base>();
+    }
+
+private:
+    uint32_t Size() const
+    {
+        return _table ? detail::FlatLoad<uint32_t>(_table) : 0;
+    }
+
+    const char* _table;
+};
+
+
+/// @brief Read-only view of a list of non-scalar values in a Flat Binary payload
+template <typename T>
+class FlatList
+{
+public:
+    typedef typename detail::flat_view<T>::type value_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename FlatList::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef value_type reference;
+
+        explicit
+        const_iterator(const char* slot)
+            : _slot(slot)
+        {}
+
+        value_type operator*() const
+        {
+            return detail::flat_view<T>::Read(_slot);
+        }
+
+        const_iterator& operator++()
+        {
+            _slot += sizeof(uint32_t);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const const_iterator& that) const
+        {
+            return _slot == that._slot;
+        }
+
+        bool operator!=(const const_iterator& that) const
+        {
+            return _slot != that._slot;
+        }
+
+    private:
+        const char* _slot;
+    };
+
+    FlatList()
+        : _list(nullptr)
+    {}
+
+    explicit
+    FlatList(const char* list)
+        : _list(list)
+    {}
+
+    uint32_t size() const
+    {
+        return _list ? detail::FlatLoad<uint32_t>(_list) : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(Slot(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(Slot(size()));
+    }
+
+    value_type operator[](uint32_t index) const
+    {
+        BOOST_ASSERT(index < size());
+        return detail::flat_view<T>::Read(Slot(index));
+    }
+
+private:
+    const char* Slot(uint32_t index) const
+    {
+        return _list ? _list + sizeof(uint32_t) * (index + 1) : nullptr;
+    }
+
+    const char* _list;
+};
+
+
+/// @brief Read-only view of a map in a Flat Binary payload
+///
+/// The keys and the values are exposed as two lists in the same order.
+template <typename K, typename V>
+class FlatMap
+{
+public:
+    typedef typename detail::flat_elements<K>::type keys_type;
+    typedef typename detail::flat_elements<V>::type values_type;
+
+    FlatMap()
+        : _map(nullptr)
+    {}
+
+    explicit
+    FlatMap(const char* map)
+        : _map(map)
+    {}
+
+    uint32_t size() const
+    {
+        return keys().size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    keys_type keys() const
+    {
+        return Elements<K>(_map);
+    }
+
+    values_type values() const
+    {
+        return Elements<V>(_map ? _map + sizeof(uint32_t) : nullptr);
+    }
+
+private:
+    template <typename E>
+    static typename detail::flat_elements<E>::type Elements(const char* slot)
+    {
+        const uint32_t offset = slot ? detail::FlatLoad<uint32_t>(slot) : 0;
+
+        return offset
+            ? detail::flat_elements<E>::At(slot + offset)
+            : typename detail::flat_elements<E>::type();
+    }
+
+    const char* _map;
+};
+
+
+/// @brief Serialize an object to a Flat Binary payload
+///
+/// The payload is aligned to 8 bytes in memory, as required to access it
+/// using views.
+template <typename T>
+inline blob SerializeFlat(const T& obj)
+{
+    detail::FlatBuilder output;
+
+    const uint32_t header = output.Allocate(2 * sizeof(uint32_t), detail::flat_table<T>::align);
+    output.Store(header, detail::flat_magic);
+    output.Store(header + sizeof(uint16_t), v1);
+    output.Store(header + sizeof(uint32_t), detail::FlatWriter::Write(output, obj));
+
+    return output.GetBuffer();
+}
+
+
+/// @brief Validate a Flat Binary payload of a struct
+///
+/// Checks that the payload is aligned in memory and that all tables and
+/// values of the struct are within the payload, so that it can be safely
+/// accessed using GetFlatView.
+template <typename T>
+inline bool VerifyFlat(const blob& data)
+{
+    return detail::FlatVerifier(data.content(), data.length()).template VerifyRoot<T>();
+}
+
+
+/// @brief Get a view of the struct in a trusted or verified Flat Binary payload
+template <typename T>
+inline FlatView<T> GetFlatView(const blob& data)
+{
+    BOOST_ASSERT(data.length() >= 2 * sizeof(uint32_t));
+    BOOST_ASSERT(reinterpret_cast<uintptr_t>(data.content()) % sizeof(uint64_t) == 0);
+
+    return FlatView<T>(data.content() + detail::FlatLoad<uint32_t>(data.content() + sizeof(uint32_t)));
+}
+
+} // namespace bond
@@ -306,6 +306,12 @@ public:
         return _output;
     }
 
+    /// @brief Protocol version used by the writer
+    uint16_t GetVersion() const
+    {
+        return _version;
+    }
+
     void WriteVersion()
     {
         _output.Write(Reader::magic);
@@ -408,4 +414,12 @@ template <typename Output> struct
 may_omit_fields<SimpleBinaryWriter<Output> >
     : std::false_type {};
 
+template <typename Input, typename MarshaledBondedProtocols> struct
+uses_packed_fields<SimpleBinaryReader<Input, MarshaledBondedProtocols> >
+    : std::true_type {};
+
+template <typename Output> struct
+uses_packed_fields<SimpleBinaryWriter<Output> >
+    : std::true_type {};
+
 } // namespace bond
@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/exception.h>
+#include <bond/core/local_blob.h>
+#include <bond/core/traits.h>
+
+#include "input_buffer.h"
+
+#include <boost/static_assert.hpp>
+
+#include <cstring>
+
+namespace bond
+{
+
+/// @brief Memory backed input stream over a local_blob
+///
+/// Same as InputBuffer except that the stream, the local_blobs read from it
+/// and the buffers returned by GetCurrentBuffer and GetBufferRange don't
+/// update the reference count of the memory atomically when copied. They
+/// must be used from one thread at a time. Fields of type blob are read as a
+/// copy of the data.
+class LocalInputBuffer
+{
+public:
+    /// @brief Default constructor
+    LocalInputBuffer()
+        : _pointer()
+    {}
+
+    /// @brief Construct from a local_blob
+    LocalInputBuffer(const local_blob& blob)
+        : _blob(blob),
+          _pointer()
+    {}
+
+    /// @brief Construct form a raw memory pointer
+    ///
+    /// Pointer(s) to the memory buffer may be held by the objects deserialized
+    /// from the stream. It is the application's responsibility to manage
+    /// the lifetime of the memory buffer appropriately.
+    LocalInputBuffer(const void* buffer, uint32_t length)
+        : _blob(buffer, length),
+          _pointer()
+    {}
+
+
+    bool operator==(const LocalInputBuffer& rhs) const
+    {
+        return _blob == rhs._blob
+            && _pointer == rhs._pointer;
+    }
+
+
+    void Read(uint8_t& value)
+    {
+        if (_blob.length() == _pointer)
+        {
+            EofException(sizeof(uint8_t));
+        }
+
+        value = static_cast<const uint8_t>(_blob.content()[_pointer++]);
+    }
+
+
+    template <typename T>
+    void Read(T& value)
+    {
+        BOOST_STATIC_ASSERT(std::is_arithmetic<T>::value || std::is_enum<T>::value);
+
+        if (sizeof(T) > _blob.length() - _pointer)
+        {
+            EofException(sizeof(T));
+        }
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+        // See InputBuffer::Read
+        value = *reinterpret_cast<const T*>(_blob.content() + _pointer);
+#else
+        std::memcpy(&value, _blob.content() + _pointer, sizeof(T));
+#endif
+
+        _pointer += sizeof(T);
+    }
+
+
+    void Read(void *buffer, uint32_t size)
+    {
+        if (size > _blob.length() - _pointer)
+        {
+            EofException(size);
+        }
+
+        std::memcpy(buffer, _blob.content() + _pointer, size);
+
+        _pointer += size;
+    }
+
+
+    void Read(local_blob& blob, uint32_t size)
+    {
+        if (size > _blob.length() - _pointer)
+        {
+            EofException(size);
+        }
+
+        blob.assign(_blob, _pointer, size);
+
+        _pointer += size;
+    }
+
+
+    void Read(blob& blob, uint32_t size)
+    {
+        if (size > _blob.length() - _pointer)
+        {
+            EofException(size);
+        }
+
+        blob = blob_copy(_blob.range(_pointer, size));
+
+        _pointer += size;
+    }
+
+
+    void Skip(uint32_t size)
+    {
+        if (size > _blob.length() - _pointer)
+        {
+            return;
+        }
+
+        _pointer += size;
+    }
+
+    /// @brief Check if the stream is at the end of the underlying memory buffer.
+    bool IsEof() const
+    {
+        return _pointer == _blob.length();
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T& value)
+    {
+        if (_blob.length() > _pointer + sizeof(T) * 8 / 7)
+        {
+            const char* ptr = _blob.content() + _pointer;
+            input_buffer::VariableUnsignedUnchecked<T, 0>::Read(ptr, value);
+            _pointer = static_cast<uint32_t>(ptr - _blob.content());
+        }
+        else
+        {
+            GenericReadVariableUnsigned(*this, value);
+        }
+    }
+
+protected:
+    [[noreturn]] void EofException(uint32_t size) const
+    {
+        BOND_THROW(StreamException,
+              "Read out of bounds: " << size << " bytes requested, offset: "
+              << _pointer << ", length: " << _blob.length());
+    }
+
+    local_blob  _blob;
+    uint32_t    _pointer;
+
+
+    friend local_blob GetCurrentBuffer(const LocalInputBuffer& input)
+    {
+        return input._blob.range(input._pointer);
+    }
+};
+
+
+inline LocalInputBuffer CreateInputBuffer(const LocalInputBuffer& /*other*/, const local_blob& blob)
+{
+    return LocalInputBuffer(blob);
+}
+
+inline local_blob GetBufferRange(const local_blob& begin, const local_blob& end)
+{
+    return begin.range(0, begin.length() - end.length());
+}
+
+BOND_DEFINE_BUFFER_MAGIC(LocalInputBuffer, 0x424C /*LB*/);
+
+} // namespace bond
@@ -9,6 +9,7 @@
 #include <bond/core/blob.h>
 #include <bond/core/containers.h>
 #include <bond/core/detail/checked.h>
+#include <bond/core/local_blob.h>
 #include <bond/core/traits.h>
 #include <boost/static_assert.hpp>
 #include <cstring>
@@ -166,6 +167,24 @@ public:
         }
     }
 
+    /// @brief Get content of the stream as a collection of local_blobs
+    /// @remarks Memory buffers shared by several blobs, e.g. ranges of the
+    /// stream's own buffer between chained blobs, are wrapped only once
+    template <typename Alloc>
+    void GetBuffers(std::vector<local_blob, Alloc>& buffers) const
+    {
+        buffers.clear();
+        buffers.reserve(bond::detail::checked_add(_blobs.size(), 1U));
+
+        bond::detail::append_local_blobs(buffers, _blobs.data(), _blobs.data() + _blobs.size());
+
+        if (_rangeSize > 0)
+        {
+            const blob current(_buffer, _rangeOffset, _rangeSize);
+            bond::detail::append_local_blobs(buffers, &current, &current + 1);
+        }
+    }
+
     /// @brief Get content of the stream as one contiguous memory blob
     ///
     /// The function may need to allocate memory and perform memcpy.
@@ -319,6 +338,20 @@ public:
         _blobs.push_back(buffer);
     }
 
+    /// @brief Write a local_blob, chaining the memory when it is owned by a
+    /// boost::shared_ptr and copying the content otherwise
+    void Write(const local_blob& buffer)
+    {
+        const blob shared = bond::detail::share_blob(buffer);
+
+        if (shared.empty())
+        {
+            return Write(buffer.data(), buffer.size());
+        }
+
+        Write(shared);
+    }
+
     void Flush()
     {
         //
@@ -11,6 +11,7 @@
 #include <boost/static_assert.hpp>
 
 #include <type_traits>
+#include <utility>
 
 namespace bond
 {
@@ -47,11 +48,20 @@ public:
 //
 
 
+namespace detail
+{
+
+// Type of the GetCurrentBuffer fallback for input buffers which don't define it
+struct undefined_buffer {};
+
+} // namespace detail
+
+
 // Returns an object that represents the input stream's current position.
 // Return type is not required to be specifically bond::blob.
 // See GetBufferRange for more details.
 template <typename InputBuffer>
-[[noreturn]] inline blob GetCurrentBuffer(const InputBuffer& /*input*/)
+[[noreturn]] inline detail::undefined_buffer GetCurrentBuffer(const InputBuffer& /*input*/)
 {
     BOOST_STATIC_ASSERT_MSG(
         detail::mpl::always_false<InputBuffer>::value,
@@ -59,6 +69,17 @@ template <typename InputBuffer>
 }
 
 
+// Input buffers which define GetCurrentBuffer hold the payload in memory, so
+// a copy of the buffer can be read independently of the original, e.g. after
+// the original was advanced past it. Copies of stream buffers share the
+// position of the underlying stream. Specialize for custom buffers if needed.
+template <typename InputBuffer> struct
+is_random_access_buffer
+    : std::integral_constant<bool,
+        !std::is_same<decltype(GetCurrentBuffer(std::declval<const InputBuffer&>())),
+                      detail::undefined_buffer>::value> {};
+
+
 // Returns an object that represents a buffer range. The input arguments are
 // determined by what the GetCurrentBuffer returns for the given input buffer
 // implementation (i.e. not necessarily a blob). The GetBufferRange may return
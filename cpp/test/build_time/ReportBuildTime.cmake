@@ -0,0 +1,85 @@
+#
+# Prints the results of the build time benchmark, invoked as
+#
+#   cmake -DVARIANTS=file -DLOG=file -DCSV=file -P ReportBuildTime.cmake
+#
+# The variants file sets build_time_variants to the list of variant names and
+# build_time_<variant> to the library of each variant. The compile times are
+# read from the log written by TimeCompile.cmake. The results are also written
+# as CSV, one line per variant.
+#
+
+include (${VARIANTS})
+
+if (EXISTS ${LOG})
+    file (STRINGS ${LOG} entries)
+else()
+    set (entries)
+endif()
+
+function (pad_left var text width)
+    string (LENGTH "${text}" length)
+    while (length LESS width)
+        set (text " ${text}")
+        math (EXPR length "${length} + 1")
+    endwhile()
+    set (${var} "${text}" PARENT_SCOPE)
+endfunction()
+
+function (pad_right var text width)
+    string (LENGTH "${text}" length)
+    while (length LESS width)
+        set (text "${text} ")
+        math (EXPR length "${length} + 1")
+    endwhile()
+    set (${var} "${text}" PARENT_SCOPE)
+endfunction()
+
+function (file_size var file)
+    if (CMAKE_VERSION VERSION_LESS 3.14)
+        file (READ ${file} content HEX)
+        string (LENGTH "${content}" length)
+        math (EXPR length "${length} / 2")
+    else()
+        file (SIZE ${file} length)
+    endif()
+    set (${var} ${length} PARENT_SCOPE)
+endfunction()
+
+pad_right (line "variant" 16)
+pad_left (time "compile ms" 12)
+pad_left (size "library bytes" 16)
+message ("${line}${time}${size}    sources")
+
+set (csv "variant,compile_ms,library_bytes,sources\n")
+
+foreach (variant ${build_time_variants})
+    set (elapsed 0)
+    set (sources)
+    foreach (entry ${entries})
+        list (GET entry 0 name)
+        if (name STREQUAL variant)
+            list (GET entry 1 source)
+            list (GET entry 2 ms)
+            math (EXPR elapsed "${elapsed} + ${ms}")
+            list (APPEND sources ${source})
+        endif()
+    endforeach()
+
+    if (NOT sources)
+        message (FATAL_ERROR "No compile times recorded for ${variant}. Compiler launchers are not supported by this generator.")
+    endif()
+
+    file_size (bytes "${build_time_${variant}}")
+    string (REPLACE ";" " " sources "${sources}")
+
+    pad_right (line "${variant}" 16)
+    pad_left (time "${elapsed}" 12)
+    pad_left (size "${bytes}" 16)
+    message ("${line}${time}${size}    ${sources}")
+
+    set (csv "${csv}${variant},${elapsed},${bytes},${sources}\n")
+endforeach()
+
+file (WRITE ${CSV} "${csv}")
+message ("Results written to ${CSV}")
@@ -0,0 +1,91 @@
+#
+# write_synthetic_schema (schema header structs fields depth containers)
+#
+# Writes a synthetic schema with the specified number of structs, each with
+# the specified number of fields of basic types and, if containers is TRUE,
+# containers. The structs are split into depth levels and each struct below
+# the first level has additional fields of structs from the level above:
+# nested directly and, with containers, in a vector, a map and a nullable.
+#
+# The header defines BOND_BUILD_TIME_STRUCTS(x), which expands x(name) for
+# each struct. Files are only written when their content changes, so that
+# reconfiguring doesn't cause a rebuild.
+#
+
+function (write_if_different file content)
+    if (EXISTS ${file})
+        file (READ ${file} current)
+        if (current STREQUAL content)
+            return()
+        endif()
+    endif()
+    file (WRITE ${file} "${content}")
+endfunction()
+
+function (write_synthetic_schema schema header structs fields depth containers)
+    set (types
+        bool int8 int16 int32 int64 uint8 uint16 uint32 uint64 float double string wstring Kind)
+    if (containers)
+        list (APPEND types
+            blob "vector<int32>" "list<string>" "set<int64>" "map<string, double>"
+            "nullable<uint32>" "vector<vector<uint8>>")
+    endif()
+    list (LENGTH types typeCount)
+
+    if (depth GREATER structs)
+        set (depth ${structs})
+    endif()
+
+    set (content "// Generated by SyntheticSchema.cmake\n\nnamespace build_time;\n\n")
+    set (content "${content}enum Kind\n{\n    Alpha,\n    Beta,\n    Gamma,\n};\n")
+    set (names "// Generated by SyntheticSchema.cmake\n\n#define BOND_BUILD_TIME_STRUCTS(x)")
+
+    set (level 0)
+    set (previous)
+    set (current)
+
+    math (EXPR last "${structs} - 1")
+    foreach (i RANGE ${last})
+        math (EXPR structLevel "${i} * ${depth} / ${structs}")
+        if (NOT structLevel EQUAL level)
+            set (level ${structLevel})
+            set (previous ${current})
+            set (current)
+        endif()
+        list (APPEND current ${i})
+
+        set (content "${content}\n\nstruct Struct${i}\n{\n")
+
+        math (EXPR lastField "${fields} - 1")
+        foreach (j RANGE ${lastField})
+            math (EXPR t "(${i} * ${fields} + ${j}) % ${typeCount}")
+            list (GET types ${t} type)
+            if (type STREQUAL "Kind")
+                set (content "${content}    ${j}: ${type} f${j} = Beta;\n")
+            else()
+                set (content "${content}    ${j}: ${type} f${j};\n")
+            endif()
+        endforeach()
+
+        if (previous)
+            list (LENGTH previous previousCount)
+            math (EXPR p "${i} % ${previousCount}")
+            list (GET previous ${p} nested)
+            set (content "${content}    ${fields}: Struct${nested} nested;\n")
+            if (containers)
+                math (EXPR id "${fields} + 1")
+                set (content "${content}    ${id}: vector<Struct${nested}> nested_vector;\n")
+                math (EXPR id "${fields} + 2")
+                set (content "${content}    ${id}: map<string, Struct${nested}> nested_map;\n")
+                math (EXPR id "${fields} + 3")
+                set (content "${content}    ${id}: nullable<Struct${nested}> nested_nullable;\n")
+            endif()
+        endif()
+
+        set (content "${content}};\n")
+        set (names "${names} \\\n    x(Struct${i})")
+    endforeach()
+
+    write_if_different (${schema} "${content}")
+    write_if_different (${header} "${names}\n")
+endfunction()
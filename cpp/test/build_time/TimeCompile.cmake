@@ -0,0 +1,49 @@
+#
+# Compiler launcher of the build time benchmark, invoked as
+#
+#   cmake -DVARIANT=name -DLOG=file -P TimeCompile.cmake -- <compiler command>
+#
+# Runs the compiler command and appends the variant, the name of the source
+# file and the elapsed time in milliseconds to the log.
+#
+
+set (command)
+set (source)
+set (commandStart FALSE)
+
+math (EXPR last "${CMAKE_ARGC} - 1")
+foreach (i RANGE ${last})
+    if (commandStart)
+        list (APPEND command "${CMAKE_ARGV${i}}")
+        if (CMAKE_ARGV${i} MATCHES "\\.(cpp|cxx|cc)$")
+            get_filename_component (source "${CMAKE_ARGV${i}}" NAME)
+        endif()
+    elseif (CMAKE_ARGV${i} STREQUAL "--")
+        set (commandStart TRUE)
+    endif()
+endforeach()
+
+# Sub-second resolution requires CMake 3.23
+if (CMAKE_VERSION VERSION_LESS 3.23)
+    set (format "%s000")
+else()
+    set (format "%s%f")
+endif()
+
+string (TIMESTAMP start "${format}" UTC)
+execute_process (
+    COMMAND ${command}
+    RESULT_VARIABLE error)
+string (TIMESTAMP end "${format}" UTC)
+
+if (error)
+    message (FATAL_ERROR)
+endif()
+
+if (CMAKE_VERSION VERSION_LESS 3.23)
+    math (EXPR elapsed "${end} - ${start}")
+else()
+    math (EXPR elapsed "(${end} - ${start}) / 1000")
+endif()
+
+file (APPEND ${LOG} "${VARIANT};${source};${elapsed}\n")
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compiled for each variant of the build time benchmark. Serializes and
+// deserializes every synthetic struct using Compact, Fast and Simple Binary,
+// which instantiates the Apply templates in this translation unit, unless
+// BOND_BUILD_TIME_APPLY is defined and the instantiations declared extern in
+// the generated _apply.h file are used instead. Code generated with
+// --direct-codecs declares its Compact Binary codecs in _reflection.h, so
+// they are used either way.
+
+#ifdef BOND_BUILD_TIME_APPLY
+#include "synthetic_apply.h"
+#endif
+
+#include "synthetic_reflection.h"
+#include "synthetic_structs.h"
+
+#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+
+namespace
+{
+
+template <typename Reader, typename Writer, typename T>
+void RoundTrip(const T& obj)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+    bond::Serialize(obj, writer);
+
+    T to;
+    bond::Deserialize(Reader(output.GetBuffer()), to);
+}
+
+template <typename T>
+void RoundTrip()
+{
+    const T obj;
+
+    RoundTrip<bond::CompactBinaryReader<bond::InputBuffer>, bond::CompactBinaryWriter<bond::OutputBuffer> >(obj);
+    RoundTrip<bond::FastBinaryReader<bond::InputBuffer>, bond::FastBinaryWriter<bond::OutputBuffer> >(obj);
+    RoundTrip<bond::SimpleBinaryReader<bond::InputBuffer>, bond::SimpleBinaryWriter<bond::OutputBuffer> >(obj);
+}
+
+}
+
+#define BOND_BUILD_TIME_ROUND_TRIP(name) RoundTrip<build_time::name>();
+
+void RoundTripSyntheticStructs()
+{
+    BOND_BUILD_TIME_STRUCTS(BOND_BUILD_TIME_ROUND_TRIP)
+}
@@ -0,0 +1,242 @@
+#include "precompiled.h"
+
+#ifdef _MSC_VER
+#include "arena_allocator_tests_generated/allocator_test_reflection.h"
+#endif
+
+#include <bond/ext/arena_allocator.h>
+#include <bond/ext/capped_allocator.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ArenaAllocatorTests)
+
+template <typename T>
+bool is_aligned(const T* ptr)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignof(T) == 0;
+}
+
+BOOST_AUTO_TEST_CASE(ArenaBasicTests)
+{
+    bond::ext::arena<> arena{ 256 };
+    BOOST_CHECK_EQUAL(arena.allocated(), 0u);
+    BOOST_CHECK_EQUAL(arena.reserved(), 0u);
+
+    char* c = static_cast<char*>(arena.allocate(1, 1));
+    BOOST_CHECK_EQUAL(arena.allocated(), 1u);
+    BOOST_CHECK_EQUAL(arena.reserved(), 256u);
+
+    double* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    BOOST_CHECK(is_aligned(d));
+    BOOST_CHECK_GT(static_cast<void*>(d), static_cast<void*>(c));
+    BOOST_CHECK_EQUAL(arena.allocated(), 1u + sizeof(double));
+
+    // Only the most recent allocation is reclaimed
+    arena.deallocate(c, 1);
+    BOOST_CHECK_EQUAL(arena.allocated(), 1u + sizeof(double));
+
+    arena.deallocate(d, sizeof(double));
+    BOOST_CHECK_EQUAL(arena.allocated(), 1u);
+    BOOST_CHECK_EQUAL(arena.allocate(sizeof(double), alignof(double)), static_cast<void*>(d));
+
+    arena.release();
+    BOOST_CHECK_EQUAL(arena.allocated(), 0u);
+    BOOST_CHECK_EQUAL(arena.reserved(), 0u);
+
+    // Chunk sizes start over after release
+    BOOST_CHECK(arena.allocate(1, 1) != nullptr);
+    BOOST_CHECK_EQUAL(arena.reserved(), 256u);
+
+    // Size overflowing when padded for alignment
+    BOOST_CHECK_THROW(arena.allocate((std::numeric_limits<std::size_t>::max)() - 2, 16), std::bad_alloc);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaChunkGrowthTests)
+{
+    bond::ext::arena<> arena{ 128 };
+
+    std::size_t reserved = 0;
+    std::size_t chunks = 0;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        std::uint64_t* p = static_cast<std::uint64_t*>(arena.allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+        BOOST_REQUIRE(is_aligned(p));
+        *p = i;
+
+        if (arena.reserved() != reserved)
+        {
+            reserved = arena.reserved();
+            ++chunks;
+        }
+    }
+
+    BOOST_CHECK_EQUAL(arena.allocated(), 10000u * sizeof(std::uint64_t));
+    BOOST_CHECK_GE(arena.reserved(), arena.allocated());
+
+    // Chunks grow geometrically
+    BOOST_CHECK_LT(chunks, 12u);
+
+    // Allocations larger than the chunk size get a chunk of their own
+    const std::size_t large = 2 * bond::ext::arena<>::max_chunk_size;
+    arena.allocate(large);
+    BOOST_CHECK_GE(arena.reserved(), reserved + large);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaCappedUpstreamTests)
+{
+    using capped = bond::ext::capped_allocator<std::allocator<char>, bond::ext::single_threaded_counter<>&>;
+
+    bond::ext::single_threaded_counter<> counter{ 4096 };
+
+    {
+        bond::ext::arena<capped> arena{ 1024, capped{ counter } };
+
+        arena.allocate(100);
+        BOOST_CHECK_EQUAL(counter.value(), 1024u);
+
+        arena.allocate(1000);
+        BOOST_CHECK_EQUAL(counter.value(), 1024u + 2048u);
+
+        BOOST_CHECK_THROW(arena.allocate(2000), std::bad_alloc);
+        BOOST_CHECK_EQUAL(counter.value(), 1024u + 2048u);
+
+        arena.release();
+        BOOST_CHECK_EQUAL(counter.value(), 0u);
+
+        arena.allocate(100);
+        BOOST_CHECK_NE(counter.value(), 0u);
+    }
+
+    BOOST_CHECK_EQUAL(counter.value(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(AllocatorContainerTests)
+{
+    using string = std::basic_string<char, std::char_traits<char>, bond::ext::arena_allocator<char>>;
+    using vector = std::vector<string, bond::ext::arena_allocator<string>>;
+    using map = std::map<int, vector, std::less<int>, bond::ext::arena_allocator<std::pair<const int, vector>>>;
+
+    bond::ext::arena<> arena;
+    bond::ext::arena_allocator<> alloc{ arena };
+
+    {
+        map m{ alloc };
+
+        for (int i = 0; i < 100; ++i)
+        {
+            vector v{ alloc };
+
+            for (int j = 0; j < i; ++j)
+            {
+                const std::string s = std::to_string(i * j) + " is a string long enough to be allocated";
+                v.emplace_back(s.c_str(), alloc);
+            }
+
+            m.emplace(i, std::move(v));
+        }
+
+        BOOST_CHECK_EQUAL(m.size(), 100u);
+        BOOST_CHECK_EQUAL(m.at(99).size(), 99u);
+        BOOST_CHECK_EQUAL(m.at(99)[2].c_str(), "198 is a string long enough to be allocated");
+        BOOST_CHECK(m.get_allocator() == alloc);
+    }
+
+    // Destroying the containers doesn't free the memory
+    BOOST_CHECK_NE(arena.allocated(), 0u);
+
+    arena.release();
+    BOOST_CHECK_EQUAL(arena.reserved(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(AllocatorComparisonTest)
+{
+    bond::ext::arena<> arena1;
+    bond::ext::arena<> arena2;
+
+    bond::ext::arena_allocator<char> a1{ arena1 };
+    bond::ext::arena_allocator<int> a2{ a1 };
+    bond::ext::arena_allocator<char> a3{ arena2 };
+
+    BOOST_CHECK_EQUAL(&a2.get_arena(), &arena1);
+    BOOST_CHECK((a1 == a2));
+    BOOST_CHECK((a1 != a3));
+    BOOST_CHECK((a2 != a3));
+
+    int* p = a2.allocate(10);
+    BOOST_CHECK(is_aligned(p));
+    BOOST_CHECK_EQUAL(arena1.allocated(), 10 * sizeof(int));
+    BOOST_CHECK_EQUAL(arena2.allocated(), 0u);
+    a2.deallocate(p, 10);
+    BOOST_CHECK_EQUAL(arena1.allocated(), 0u);
+
+    BOOST_CHECK_THROW(a2.allocate(a2.max_size() + 1), std::bad_alloc);
+}
+
+#ifdef _MSC_VER
+
+using all_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InputBuffer>,
+    bond::CompactBinaryReader<bond::InputBuffer>,
+    bond::FastBinaryReader<bond::InputBuffer> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(BondStructDeserializationTest, Reader, all_protocols)
+{
+    bond::ext::arena<> from_arena;
+    bond::ext::arena_allocator<> from_alloc{ from_arena };
+
+    arena_allocator_tests::Struct from{ from_alloc };
+    InitRandom(from);
+
+    bond::blob buffer;
+
+    // BOOST_TEST_CONTEXT("Serialization")
+    {
+        using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+        typename Writer::Buffer output;
+        Writer writer{ output };
+        BOOST_REQUIRE_NO_THROW(bond::Serialize(from, writer));
+
+        buffer = output.GetBuffer();
+    }
+
+    // BOOST_TEST_CONTEXT("Compile-time schema deserialize")
+    {
+        Reader reader{ buffer };
+
+        bond::ext::arena<> arena;
+        decltype(from) to{ bond::ext::arena_allocator<>{ arena } };
+        BOOST_REQUIRE_NO_THROW(bond::Deserialize(reader, to));
+        BOOST_CHECK((from == to));
+        BOOST_CHECK_NE(arena.allocated(), 0u);
+    }
+
+    // BOOST_TEST_CONTEXT("Runtime schema deserialize")
+    {
+        Reader reader{ buffer };
+        bond::bonded<void> bonded{ reader, bond::GetRuntimeSchema<decltype(from)>() };
+
+        bond::ext::arena<> arena;
+        decltype(from) to{ bond::ext::arena_allocator<>{ arena } };
+        BOOST_REQUIRE_NO_THROW(bonded.Deserialize(to));
+        BOOST_CHECK((from == to));
+    }
+}
+
+#endif // _MSC_VER
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
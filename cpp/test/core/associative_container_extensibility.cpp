@@ -2,6 +2,9 @@
 #include <bond/core/container_interface.h>
 #include "container_extensibility.h"
 
+#include <unordered_map>
+#include <unordered_set>
+
 
 template <typename T>
 struct SimpleSet
@@ -173,6 +176,52 @@ struct SimpleMapTests
 };
 
 
+// std::unordered_set and std::unordered_map are compared with the ordered
+// containers by content because the order of elements is unspecified.
+template <typename Reader, typename Writer>
+struct UnorderedSetTests
+{
+    template <typename T>
+    void operator()(const T&)
+    {
+        typedef BondStruct<std::unordered_set<T> > Unordered;
+        typedef BondStruct<std::set<T> >           Standard;
+
+        Standard from = InitRandom<Standard>();
+        Unordered unordered;
+        Standard to;
+
+        bond::Deserialize(Serialize<Reader, Writer>(from), unordered);
+        UT_AssertIsTrue(from.field == std::set<T>(unordered.field.begin(), unordered.field.end()));
+
+        bond::Deserialize(Serialize<Reader, Writer>(unordered), to);
+        UT_AssertIsTrue(from.field == to.field);
+    }
+};
+
+
+template <typename Reader, typename Writer>
+struct UnorderedMapTests
+{
+    template <typename T>
+    void operator()(const T&)
+    {
+        typedef BondStruct<std::unordered_map<T, SimpleStruct> > Unordered;
+        typedef BondStruct<std::map<T, SimpleStruct> >           Standard;
+
+        Standard from = InitRandom<Standard>();
+        Unordered unordered;
+        Standard to;
+
+        bond::Deserialize(Serialize<Reader, Writer>(from), unordered);
+        UT_AssertIsTrue(from.field == std::map<T, SimpleStruct>(unordered.field.begin(), unordered.field.end()));
+
+        bond::Deserialize(Serialize<Reader, Writer>(unordered), to);
+        UT_AssertIsTrue(from.field == to.field);
+    }
+};
+
+
 typedef boost::mpl::list
     <
 #ifndef UNIT_TEST_TYPE_SUBSET
@@ -202,6 +251,22 @@ TEST_CASE_BEGIN(SimpleMapTest)
 TEST_CASE_END
 
 
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(UnorderedSetTest)
+{
+    boost::mpl::for_each<Types>(UnorderedSetTests<Reader, Writer>());
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(UnorderedMapTest)
+{
+    boost::mpl::for_each<Types>(UnorderedMapTests<Reader, Writer>());
+}
+TEST_CASE_END
+
+
 template <uint16_t N, typename Reader, typename Writer>
 void AssociativeContainerExtensibilityTests(const char* name)
 {
@@ -212,6 +277,12 @@ void AssociativeContainerExtensibilityTests(const char* name)
 
     AddTestCase<TEST_ID(N), 
         SimpleSetTest, Reader, Writer>(suite, "Custom set tests");
+
+    AddTestCase<TEST_ID(N), 
+        UnorderedMapTest, Reader, Writer>(suite, "std::unordered_map tests");
+
+    AddTestCase<TEST_ID(N), 
+        UnorderedSetTest, Reader, Writer>(suite, "std::unordered_set tests");
 }
 
 
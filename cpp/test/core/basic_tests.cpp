@@ -1,5 +1,6 @@
 #include <bond/core/bond_version.h>
 #include <bond/core/box.h>
+#include <bond/core/detail/enum_names.h>
 #include <bond/stream/output_counter.h>
 
 #include "precompiled.h"
@@ -295,6 +296,92 @@ TEST_CASE_BEGIN(EnumScopeTest)
 }
 TEST_CASE_END
 
+template <typename T>
+void EnumNamesRoundTrip()
+{
+    const auto& names = GetNameToValueMap(T());
+
+    for (const auto& entry : names)
+    {
+        // Every prefix of a name, and the name followed by another character,
+        // is found only if it is a name too
+        const std::string padded = entry.first + "_";
+
+        for (std::size_t length = 0; length <= padded.size(); ++length)
+        {
+            T value = entry.second;
+
+            UT_AssertIsTrue(ToEnum(value, padded.data(), length)
+                == (names.count(padded.substr(0, length)) != 0));
+        }
+
+        T value;
+
+        UT_AssertIsTrue(ToEnum(value, padded.data(), entry.first.size()));
+        UT_AssertIsTrue(value == entry.second);
+
+        FromString(entry.first, value);
+        UT_AssertIsTrue(value == entry.second);
+        UT_AssertIsTrue(names.at(ToString(value)) == entry.second);
+    }
+}
+
+
+TEST_CASE_BEGIN(EnumNameLookupTest)
+{
+    // Names don't have to be null terminated
+    for (const auto& entry : GetNameToValueMap(EnumType1()))
+    {
+        const std::string name = entry.first + "1";
+        EnumType1 value = entry.second == EnumValue1 ? EnumValue2 : EnumValue1;
+
+        UT_AssertIsTrue(ToEnum(value, name.data(), entry.first.size()));
+        UT_AssertIsTrue(value == entry.second);
+    }
+
+    // Duplicate values are named by the first constant, same as in the map
+    for (const auto& entry : GetValueToNameMap(EnumType1()))
+    {
+        std::string name;
+
+        UT_AssertIsTrue(FromEnum(name, entry.first));
+        UT_AssertIsTrue(name == entry.second);
+        UT_AssertIsTrue(ToString(entry.first) == entry.second);
+    }
+
+    UT_AssertIsTrue(ToString(EnumValue5) == "EnumValue3");
+
+    EnumType1 value = EnumValue4;
+    std::string name;
+
+    UT_AssertIsFalse(ToEnum(value, ""));
+    UT_AssertIsFalse(ToEnum(value, "EnumValue"));
+    UT_AssertIsFalse(ToEnum(value, "EnumValue11"));
+    UT_AssertIsFalse(ToEnum(value, "enumValue1"));
+    UT_AssertIsFalse(ToEnum(value, "EnumValue1", 9));
+    UT_AssertIsTrue(value == EnumValue4);
+    UT_AssertIsFalse(FromEnum(name, static_cast<EnumType1>(1)));
+    UT_AssertThrows(ToString(static_cast<EnumType1>(1)), bond::CoreException);
+}
+TEST_CASE_END
+
+TEST_CASE_BEGIN(EnumNamesRoundTripTest)
+{
+    EnumNamesRoundTrip<EnumType1>();
+    EnumNamesRoundTrip<EnumNames>();
+    EnumNamesRoundTrip<Color>();
+    EnumNamesRoundTrip<Fruit>();
+    EnumNamesRoundTrip<ImportedEnum>();
+
+    // gbc hashes the names when it builds the tables, so the hash must not
+    // depend on the platform
+    UT_AssertIsTrue(bond::detail::enum_name_hash("", 0) == 0);
+    UT_AssertIsTrue(bond::detail::enum_name_hash("Q", 1) == 0xeb7386312cf52194ULL);
+    UT_AssertIsTrue(bond::detail::enum_name_hash("Cdefghij", 8) == 0x96a1875939c8bb47ULL);
+    UT_AssertIsTrue(bond::detail::enum_name_hash("ConstantWithAVeryLongName", 25) == 0x6c643ece823d21fdULL);
+}
+TEST_CASE_END
+
 
 TEST_CASE_BEGIN(SimpleBinaryVersion)
 {
@@ -442,6 +529,8 @@ void BasicTest::Initialize()
     AddTestCase<TEST_ID(0xb06), SimpleBinaryVersion>(suite, "Simple Protocol version");
     AddTestCase<TEST_ID(0xb07), CopyMoveTests>(suite, "Copy and Move tests");
     AddTestCase<TEST_ID(0xb08), EnumScopeTest>(suite, "Enum scope tests");
+    AddTestCase<TEST_ID(0xb0a), EnumNameLookupTest>(suite, "Enum name lookup tests");
+    AddTestCase<TEST_ID(0xb0b), EnumNamesRoundTripTest>(suite, "Enum names round trip tests");
     AddTestCase<TEST_ID(0xb09), MakeBoxTest>(suite, "make_box tests");
 }
 
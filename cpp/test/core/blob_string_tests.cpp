@@ -0,0 +1,211 @@
+#include "precompiled.h"
+
+#include "blob_string_tests_generated/allocator_test_reflection.h"
+
+#include <bond/core/blob_string.h>
+#include <bond/protocol/simple_json_reader.h>
+#include <bond/protocol/simple_json_writer.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(BlobStringTests)
+
+namespace
+{
+    bool points_into(const char* ptr, const bond::blob& buffer)
+    {
+        return ptr >= buffer.content() && ptr < buffer.content() + buffer.length();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BlobStringBasicTests)
+{
+    bond::blob_string empty;
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(empty.length(), 0u);
+    BOOST_CHECK(empty == bond::blob_string(""));
+
+    bond::blob_string str("hello");
+    BOOST_CHECK_EQUAL(str.length(), 5u);
+    BOOST_CHECK_EQUAL(str.str(), "hello");
+    BOOST_CHECK(str == bond::blob_string(std::string("hello")));
+    BOOST_CHECK(str != bond::blob_string("hello", 4));
+    BOOST_CHECK(bond::blob_string("hell") < str);
+    BOOST_CHECK(!(str < bond::blob_string("hell")));
+
+    // Strings constructed from characters own a writable copy
+    BOOST_CHECK(str.mutable_data() == str.data());
+
+    bond::blob_string copy = str;
+    BOOST_CHECK(copy.data() == str.data());
+
+    // Copies share the characters until written to
+    copy.mutable_data()[0] = 'j';
+    BOOST_CHECK(copy.data() != str.data());
+    BOOST_CHECK_EQUAL(copy.str(), "jello");
+    BOOST_CHECK_EQUAL(str.str(), "hello");
+
+    // Writing to the original doesn't change its copies either
+    bond::blob_string original("hello");
+    original.mutable_data();
+
+    bond::blob_string copied = original;
+    bond::blob_string assigned;
+    assigned = original;
+    const bond::blob shared = original.get_blob();
+
+    bond::string_data(original)[0] = 'c';
+    BOOST_CHECK_EQUAL(original.str(), "cello");
+    BOOST_CHECK_EQUAL(copied.str(), "hello");
+    BOOST_CHECK_EQUAL(assigned.str(), "hello");
+    BOOST_CHECK_EQUAL(std::string(shared.content(), shared.length()), "hello");
+
+    // Once copied, the original's characters are written in place again
+    char* data = original.mutable_data();
+    BOOST_CHECK(data == original.data());
+
+    // ... and when the copies are gone
+    {
+        const bond::blob_string temp = original;
+        BOOST_CHECK(original.mutable_data() != temp.data());
+    }
+
+    const char* last = original.data();
+    {
+        const bond::blob_string temp = original;
+    }
+    BOOST_CHECK(original.mutable_data() == last);
+
+    bond::blob_string moved = std::move(copy);
+    BOOST_CHECK_EQUAL(moved.str(), "jello");
+    BOOST_CHECK(moved.mutable_data() == moved.data());
+
+    str.resize(0);
+    BOOST_CHECK(str.empty());
+}
+
+BOOST_AUTO_TEST_CASE(BlobStringConcurrentCopyTests)
+{
+    // Copying doesn't modify the source, so a const string can be copied
+    // by several threads
+    const bond::blob_string str("concurrent");
+    bond::blob_string copies[2];
+
+    std::thread first([&] { copies[0] = str; copies[0].mutable_data()[0] = 'C'; });
+    std::thread second([&] { copies[1] = str; copies[1].mutable_data()[0] = 'K'; });
+    first.join();
+    second.join();
+
+    BOOST_CHECK_EQUAL(str.str(), "concurrent");
+    BOOST_CHECK_EQUAL(copies[0].str(), "Concurrent");
+    BOOST_CHECK_EQUAL(copies[1].str(), "Koncurrent");
+}
+
+BOOST_AUTO_TEST_CASE(BlobStringReferenceTests)
+{
+    const char chars[] = "referenced";
+    bond::blob buffer(chars, static_cast<uint32_t>(std::strlen(chars)));
+
+    bond::blob_string str(buffer.range(2, 3));
+    BOOST_CHECK(str.data() == chars + 2);
+    BOOST_CHECK_EQUAL(str.str(), "fer");
+    BOOST_CHECK(str.get_blob() == buffer.range(2, 3));
+
+    // Referenced memory is copied before it is written
+    char* data = bond::string_data(str);
+    BOOST_CHECK(!points_into(data, buffer));
+    data[0] = 'F';
+    BOOST_CHECK_EQUAL(str.str(), "Fer");
+    BOOST_CHECK_EQUAL(chars[2], 'f');
+}
+
+using binary_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InputBuffer>,
+    bond::CompactBinaryReader<bond::InputBuffer>,
+    bond::FastBinaryReader<bond::InputBuffer> >;
+
+template <typename Reader, typename T>
+bond::blob SerializeTo(const T& obj)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    typename Writer::Buffer output;
+    Writer writer{ output };
+    bond::Serialize(obj, writer);
+
+    return output.GetBuffer();
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ZeroCopyDeserializationTest, Reader, binary_protocols)
+{
+    blob_string_tests::SimpleType from;
+    from.m_str = bond::blob_string(std::string(100, 's'));
+    from.m_wstr = bond::blob_wstring(std::wstring(10, L'w'));
+
+    blob_string_tests::SimpleType to;
+
+    {
+        const bond::blob buffer = SerializeTo<Reader>(from);
+
+        Reader reader{ buffer };
+        bond::Deserialize(reader, to);
+
+        BOOST_CHECK(points_into(to.m_str.data(), buffer));
+    }
+
+    // The string shares ownership of the buffer with the reader
+    BOOST_CHECK((from == to));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(RoundtripTest, Reader, binary_protocols)
+{
+    for (uint32_t i = 0; i < c_iterations; ++i)
+    {
+        const auto from = InitRandom<blob_string_tests::NullableFields>();
+
+        Reader reader{ SerializeTo<Reader>(from) };
+
+        blob_string_tests::NullableFields to;
+        bond::Deserialize(reader, to);
+        BOOST_CHECK((from == to));
+
+        Reader runtime_reader{ SerializeTo<Reader>(from) };
+        bond::bonded<void> bonded{ runtime_reader, bond::GetRuntimeSchema<decltype(from)>() };
+
+        blob_string_tests::NullableFields runtime_to;
+        bonded.Deserialize(runtime_to);
+        BOOST_CHECK((from == runtime_to));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(JsonRoundtripTest)
+{
+    blob_string_tests::SimpleType from;
+    from.m_str = "json string";
+
+    bond::OutputBuffer output;
+    bond::SimpleJsonWriter<bond::OutputBuffer> writer(output);
+    bond::Serialize(from, writer);
+
+    const bond::blob buffer = output.GetBuffer();
+
+    bond::SimpleJsonReader<bond::InputBuffer> reader(buffer);
+    blob_string_tests::SimpleType to;
+    bond::Deserialize(reader, to);
+
+    // Text protocols unescape the characters into a copy
+    BOOST_CHECK(!points_into(to.m_str.data(), buffer));
+    BOOST_CHECK((from == to));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
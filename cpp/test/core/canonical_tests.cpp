@@ -0,0 +1,252 @@
+#include "precompiled.h"
+
+#include <bond/core/canonical.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+template <typename Writer, typename Serialize>
+bond::blob SerializeWith(uint16_t version, const Serialize& serialize)
+{
+    bond::OutputBuffer output;
+    Factory<Writer>::Call(output, version, serialize);
+    return output.GetBuffer();
+}
+
+template <typename Writer, typename T>
+bond::blob SerializeCanonical(const T& obj, uint16_t version)
+{
+    return SerializeWith<Writer>(version, [&obj](Writer& writer)
+    {
+        bond::SerializeCanonical(obj, writer);
+    });
+}
+
+template <typename Writer, typename T>
+bond::blob Serialize(const T& obj, uint16_t version)
+{
+    return SerializeWith<Writer>(version, [&obj](Writer& writer)
+    {
+        bond::Serialize(obj, writer);
+    });
+}
+
+// Compact Binary v1 payload of a CanonicalKeys with the doubles written in the
+// specified order
+bond::blob SerializeDoubles(const std::vector<double>& doubles)
+{
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output);
+
+    writer.WriteStructBegin(bond::Metadata(), false);
+    writer.WriteFieldBegin(bond::BT_SET, 0);
+    writer.WriteContainerBegin(static_cast<uint32_t>(doubles.size()), bond::BT_DOUBLE);
+
+    for (double value : doubles)
+        writer.Write(value);
+
+    writer.WriteContainerEnd();
+    writer.WriteFieldEnd();
+    writer.WriteStructEnd();
+
+    return output.GetBuffer();
+}
+
+CanonicalNested MakeCanonicalNested(bool reverse)
+{
+    CanonicalNested obj;
+
+    // Different bucket counts and insertion orders give different iteration orders
+    if (reverse)
+        obj.unordered_map.reserve(1000);
+
+    for (int16_t i = 0; i < 20; ++i)
+    {
+        const int16_t n = reverse ? 19 - i : i;
+        obj.unordered_map[n] = n * 0.5f;
+    }
+
+    return obj;
+}
+
+CanonicalFields MakeCanonicalFields(bool reverse)
+{
+    CanonicalFields obj;
+
+    // Different bucket counts and insertion orders give different iteration orders
+    if (reverse)
+    {
+        obj.unordered_map.reserve(1000);
+        obj.unordered_set.reserve(1000);
+    }
+
+    for (int32_t i = 0; i < 50; ++i)
+    {
+        const int32_t n = reverse ? 49 - i : i;
+
+        obj.unordered_map[std::to_string(n)] = n / 2.0;
+        obj.unordered_set.insert(n * 1000);
+        obj.nested_sets[n % 3].insert(std::to_wstring(n));
+    }
+
+    obj.d = 3.14;
+    obj.floats = { 1.0f, 2.0f };
+    obj.str = "canonical";
+
+    obj.nested = bond::bonded<CanonicalNested>(MakeCanonicalNested(reverse));
+    return obj;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CanonicalTests)
+
+using all_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InputBuffer>,
+    bond::CompactBinaryReader<bond::InputBuffer>,
+    bond::FastBinaryReader<bond::InputBuffer> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(UnorderedContainersTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    const CanonicalFields x = MakeCanonicalFields(false);
+    const CanonicalFields y = MakeCanonicalFields(true);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        const bond::blob canonical = SerializeCanonical<Writer>(x, version);
+        BOOST_CHECK(canonical == SerializeCanonical<Writer>(y, version));
+
+        // Canonical payloads deserialize to the same object
+        bond::InputBuffer input(canonical);
+        CanonicalFields to;
+        bond::Deserialize(Factory<Reader>::Create(input, version), to);
+
+        BOOST_CHECK(to.unordered_map == x.unordered_map);
+        BOOST_CHECK(to.unordered_set == x.unordered_set);
+        BOOST_CHECK(to.nested_sets == x.nested_sets);
+        BOOST_CHECK((to.nested.Deserialize().unordered_map == MakeCanonicalNested(false).unordered_map));
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(OrderedContainersTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    // Output for sorted containers is the same as bond::Serialize
+    const auto obj = InitRandom<SimpleListsStruct>();
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        BOOST_CHECK(SerializeCanonical<Writer>(obj, version) == Serialize<Writer>(obj, version));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NaNTest)
+{
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    CanonicalFields x;
+    x.nested = bond::bonded<CanonicalNested>(CanonicalNested());
+    x.d = std::numeric_limits<double>::quiet_NaN();
+    x.floats = { std::numeric_limits<float>::quiet_NaN(), 1.0f };
+
+    CanonicalFields y;
+    y.nested = x.nested;
+    y.d = -std::nan("1");
+    y.floats = { -std::numeric_limits<float>::signaling_NaN(), 1.0f };
+
+    // Payloads with different NaNs are normally different
+    BOOST_CHECK(Serialize<Writer>(x, bond::v2) != Serialize<Writer>(y, bond::v2));
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == SerializeCanonical<Writer>(y, bond::v2));
+
+    // NaN values of maps are normalized too
+    CanonicalFields z;
+    z.nested = x.nested;
+    z.unordered_map["nan"] = std::nan("2");
+    x.unordered_map["nan"] = std::numeric_limits<double>::quiet_NaN();
+    z.d = x.d;
+    z.floats = x.floats;
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == SerializeCanonical<Writer>(z, bond::v2));
+}
+
+BOOST_AUTO_TEST_CASE(NaNKeysTest)
+{
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    CanonicalKeys x;
+    x.doubles = { std::numeric_limits<double>::quiet_NaN(), 2.0, -0.0, -1.0 };
+
+    CanonicalKeys y;
+    y.doubles.reserve(1000);
+    y.doubles = { -1.0, 0.0, -std::nan("1"), 2.0 };
+
+    // NaN keys are ordered after all other keys
+    const std::vector<double> sorted = { -1.0, 0.0, 2.0, std::numeric_limits<double>::quiet_NaN() };
+
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v1) == SerializeDoubles(sorted));
+    BOOST_CHECK(SerializeCanonical<Writer>(y, bond::v1) == SerializeDoubles(sorted));
+}
+
+BOOST_AUTO_TEST_CASE(NegativeZeroTest)
+{
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    CanonicalFields x;
+    x.nested = bond::bonded<CanonicalNested>(CanonicalNested());
+    x.f = 0.0f;
+    x.floats = { 0.0f };
+
+    CanonicalFields y;
+    y.nested = x.nested;
+    y.f = -0.0f;
+    y.floats = { -0.0f };
+
+    BOOST_CHECK(Serialize<Writer>(x, bond::v2) != Serialize<Writer>(y, bond::v2));
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == SerializeCanonical<Writer>(y, bond::v2));
+}
+
+BOOST_AUTO_TEST_CASE(BondedTest)
+{
+    using Reader = bond::CompactBinaryReader<bond::InputBuffer>;
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    const CanonicalFields x = MakeCanonicalFields(false);
+    CanonicalFields y = MakeCanonicalFields(true);
+
+    // bonded<T> over a payload serialized in non-canonical order
+    bond::InputBuffer input(Serialize<Writer>(MakeCanonicalNested(true), bond::v1));
+    y.nested = bond::bonded<CanonicalNested>(Reader(input, bond::v1));
+
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == SerializeCanonical<Writer>(y, bond::v2));
+}
+
+BOOST_AUTO_TEST_CASE(DefaultValuesTest)
+{
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    CanonicalFields x;
+    x.nested = bond::bonded<CanonicalNested>(CanonicalNested());
+
+    CanonicalFields y;
+    y.nested = x.nested;
+    y.f = 1.5f;
+    y.str = "default";
+
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == SerializeCanonical<Writer>(y, bond::v2));
+    BOOST_CHECK(SerializeCanonical<Writer>(x, bond::v2) == Serialize<Writer>(x, bond::v2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
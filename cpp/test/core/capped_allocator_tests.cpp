@@ -6,6 +6,7 @@
 #endif
 
 #include <bond/ext/capped_allocator.h>
+#include <bond/ext/sharded_counter.h>
 
 #include <boost/mpl/list.hpp>
 #include <boost/range/combine.hpp>
@@ -22,6 +23,7 @@
 #pragma warning (pop)
 #endif
 
+#include <atomic>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -31,12 +33,16 @@ BOOST_AUTO_TEST_SUITE(CappedAllocatorTests)
 using all_counter_types = boost::mpl::list<
     bond::ext::single_threaded_counter<>,
     bond::ext::multi_threaded_counter<>,
+    bond::ext::sharded_counter<>,
     bond::ext::shared_counter<bond::ext::single_threaded_counter<>>,
-    bond::ext::shared_counter<bond::ext::multi_threaded_counter<>>>;
+    bond::ext::shared_counter<bond::ext::multi_threaded_counter<>>,
+    bond::ext::shared_counter<bond::ext::sharded_counter<>>>;
 
 using thread_safe_counter_types = boost::mpl::list<
     bond::ext::multi_threaded_counter<>,
-    bond::ext::shared_counter<bond::ext::multi_threaded_counter<>>>;
+    bond::ext::sharded_counter<>,
+    bond::ext::shared_counter<bond::ext::multi_threaded_counter<>>,
+    bond::ext::shared_counter<bond::ext::sharded_counter<>>>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(CounterBasicTests, Counter, all_counter_types)
 {
@@ -90,6 +96,56 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(CounterThreadSafetyTests, Counter, thread_safe_cou
     }
 }
 
+BOOST_AUTO_TEST_CASE(ShardedCounterTests)
+{
+    // BOOST_TEST_CONTEXT("Budget is reserved in batches and returned")
+    {
+        bond::ext::sharded_counter<> counter{ 10000, 100, 1 };
+        BOOST_CHECK(counter.try_add(10));
+        BOOST_CHECK_EQUAL(counter.value(), 10u);
+        BOOST_CHECK(counter.try_add(90));
+        BOOST_CHECK_EQUAL(counter.value(), 100u);
+        counter.subtract(100);
+        BOOST_CHECK_EQUAL(counter.value(), 0u);
+        BOOST_CHECK(counter.try_add(10000));
+        BOOST_CHECK(!counter.try_add(1));
+        counter.subtract(10000);
+        BOOST_CHECK_EQUAL(counter.value(), 0u);
+    }
+
+    // BOOST_TEST_CONTEXT("Budget held by other shards is reclaimed")
+    {
+        bond::ext::sharded_counter<> counter{ 8000, 100, 8 };
+        std::atomic<std::size_t> failures{};
+
+        std::vector<boost::scoped_thread<>> threads;
+
+        for (size_t t = 0; t < 8; ++t)
+        {
+            threads.emplace_back([&]
+            {
+                for (std::size_t i = 0; i < 100; ++i)
+                {
+                    if (!counter.try_add(10))
+                    {
+                        ++failures;
+                    }
+                }
+            });
+        }
+
+        threads.clear();
+
+        BOOST_CHECK_EQUAL(failures.load(), 0u);
+        BOOST_CHECK_EQUAL(counter.value(), 8000u);
+        BOOST_CHECK(!counter.try_add(1));
+
+        counter.subtract(1000);
+        BOOST_CHECK(counter.try_add(1000));
+        BOOST_CHECK_EQUAL(counter.value(), 8000u);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(SharedCounterAllocationTests)
 {
     auto state = std::make_shared<int>();
@@ -0,0 +1,222 @@
+#include "precompiled.h"
+
+#include <bond/protocol/columnar.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+using ColumnarReader = bond::ColumnarReader<bond::InputBuffer>;
+using ColumnarWriter = bond::ColumnarWriter<bond::OutputBuffer>;
+using CompactReader = bond::CompactBinaryReader<bond::InputBuffer>;
+using CompactWriter = bond::CompactBinaryWriter<bond::OutputBuffer>;
+using SimpleWriter = bond::SimpleBinaryWriter<bond::OutputBuffer>;
+using Protocols = bond::BuiltInProtocols::Append<ColumnarReader>;
+
+template <typename Writer, typename T>
+bond::blob Serialize(const T& obj)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+template <typename T>
+void CheckRoundTrip(const T& from)
+{
+    const bond::blob data = Serialize<ColumnarWriter>(from);
+
+    T to;
+    bond::Deserialize(ColumnarReader(data), to);
+    BOOST_CHECK(Equal(from, to));
+
+    // Transcoding with compile-time and runtime schema
+    const bond::blob compact = Serialize<CompactWriter>(from);
+
+    bond::OutputBuffer output;
+    CompactWriter writer(output);
+    ColumnarReader reader(data);
+    bond::bonded<T, ColumnarReader&>(reader).Serialize(writer);
+    BOOST_CHECK(output.GetBuffer() == compact);
+
+    bond::OutputBuffer runtime_output;
+    CompactWriter runtime_writer(runtime_output);
+    ColumnarReader runtime_reader(data);
+    bond::bonded<void, ColumnarReader&>(runtime_reader, bond::GetRuntimeSchema<T>()).Serialize(runtime_writer);
+    BOOST_CHECK(runtime_output.GetBuffer() == compact);
+
+    // Marshaled payload, read using the protocols including Columnar
+    bond::OutputBuffer marshaled;
+    ColumnarWriter marshal_writer(marshaled);
+    bond::Marshal(from, marshal_writer);
+
+    T unmarshaled;
+    bond::Unmarshal<Protocols>(bond::InputBuffer(marshaled.GetBuffer()), unmarshaled);
+    BOOST_CHECK(Equal(from, unmarshaled));
+}
+
+void CheckIntegers(const std::vector<uint64_t>& integers)
+{
+    bond::OutputBuffer output;
+    bond::detail::WriteIntegerColumn(output, integers);
+
+    bond::detail::IntegerColumn column;
+    bond::InputBuffer input(output.GetBuffer());
+    column.Read(input);
+
+    std::vector<uint64_t> decoded;
+
+    while (column.more())
+        decoded.push_back(column.next());
+
+    BOOST_CHECK(column.size() == integers.size());
+    BOOST_CHECK(decoded == integers);
+    BOOST_CHECK(input.IsEof());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ColumnarTests)
+
+BOOST_AUTO_TEST_CASE(IntegerColumnTest)
+{
+    CheckIntegers({});
+    CheckIntegers({ 42 });
+    CheckIntegers({ 5, 5, 5, 5, 5, 5, 5 });
+    CheckIntegers({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 11, 10, 9, 9, 9 });
+    CheckIntegers({ 0, UINT64_MAX, 0, static_cast<uint64_t>(INT64_MIN), static_cast<uint64_t>(INT64_MAX), 1 });
+
+    std::vector<uint64_t> integers;
+
+    for (uint64_t i = 0; i < 1000; ++i)
+        integers.push_back(i % 7 == 0 ? i * i : static_cast<uint64_t>(-static_cast<int64_t>(i)));
+
+    CheckIntegers(integers);
+
+    // Constant stride is encoded as a single run
+    std::vector<uint64_t> stride;
+
+    for (uint64_t i = 0; i < 10000; ++i)
+        stride.push_back(1000 + 3 * i);
+
+    bond::OutputBuffer output;
+    bond::detail::WriteIntegerColumn(output, stride);
+    BOOST_CHECK_LT(output.GetBuffer().size(), 10u);
+    CheckIntegers(stride);
+
+    // Repeated runs are not expanded when the column is read
+    bond::OutputBuffer huge;
+    const uint64_t count = uint64_t(1) << 40;
+    bond::WriteVariableUnsigned(huge, count);
+    bond::WriteVariableUnsigned(huge, (count << 1) | 1);
+    bond::WriteVariableUnsigned(huge, bond::EncodeZigZag(int64_t(2)));
+
+    bond::detail::IntegerColumn column;
+    bond::InputBuffer input(huge.GetBuffer());
+    column.Read(input);
+    BOOST_CHECK(column.size() == count);
+    BOOST_CHECK_EQUAL(column.next(), 2u);
+    BOOST_CHECK_EQUAL(column.next(), 4u);
+
+    // Runs longer than the column
+    bond::OutputBuffer invalid;
+    bond::WriteVariableUnsigned(invalid, uint64_t(2));
+    bond::WriteVariableUnsigned(invalid, uint64_t(3 << 1));
+
+    bond::InputBuffer invalid_input(invalid.GetBuffer());
+    BOOST_CHECK_THROW(column.Read(invalid_input), bond::CoreException);
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+    CheckRoundTrip(InitRandom<SimpleStruct>());
+    CheckRoundTrip(InitRandom<StructWithBase>());
+    CheckRoundTrip(InitRandom<SimpleListsStruct>());
+    CheckRoundTrip(InitRandom<FlatVectors>());
+    CheckRoundTrip(NestedStructVectors());
+
+    auto vectors = InitRandom<NestedStructVectors>();
+    vectors.v.resize(5, InitRandom<NestedStruct>());
+    vectors.v[2].m_str = "columnar";
+    vectors.nested.v.resize(3, InitRandom<SimpleStruct>());
+    CheckRoundTrip(vectors);
+
+    auto lists = InitRandom<NestedListsStruct>();
+    lists.lSLS.push_back(InitRandom<SimpleListsStruct>());
+    lists.lSLS.push_back(SimpleListsStruct());
+    lists.vlSLS.resize(2);
+    lists.vlSLS[1].push_back(InitRandom<SimpleListsStruct>());
+    lists.vvNS.resize(3);
+    lists.vvNS[0].push_back(InitRandom<NestedStruct>());
+    CheckRoundTrip(lists);
+}
+
+BOOST_AUTO_TEST_CASE(SkipTest)
+{
+    auto from = InitRandom<NestedStructVectors>();
+    from.v.resize(4, InitRandom<NestedStruct>());
+    from.StructVector::v.resize(2, InitRandom<SimpleStruct>());
+
+    const bond::blob data = Serialize<ColumnarWriter>(from);
+
+    // The fields of the derived struct, including the list of structs, are skipped
+    StructVector base;
+    ColumnarReader reader(data);
+    bond::bonded<NestedStructVectors, ColumnarReader&>(reader).Deserialize(base);
+    BOOST_CHECK(Equal(static_cast<const StructVector&>(from), base));
+
+    auto derived = InitRandom<StructWithBase>();
+    SimpleBase simple;
+    ColumnarReader derived_reader(Serialize<ColumnarWriter>(derived));
+    bond::bonded<StructWithBase, ColumnarReader&>(derived_reader).Deserialize(simple);
+    BOOST_CHECK(Equal(static_cast<const SimpleBase&>(derived), simple));
+}
+
+BOOST_AUTO_TEST_CASE(ColumnsTest)
+{
+    FlatVectors obj;
+
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        FlatPoint point;
+        point.x = i;
+        point.y = 7;
+        obj.points.push_back(point);
+    }
+
+    // Integer columns with a constant stride take a few bytes rather than
+    // the 8000 bytes of the points in Simple Binary
+    const bond::blob data = Serialize<ColumnarWriter>(obj);
+    BOOST_CHECK_LT(data.size(), 100u);
+    BOOST_CHECK_GT(Serialize<SimpleWriter>(obj).size(), 8000u);
+    CheckRoundTrip(obj);
+
+    // Columns nested too deeply
+    bond::OutputBuffer nested;
+
+    for (uint32_t i = 0; i <= bond::detail::column_max_depth; ++i)
+    {
+        bond::WriteVariableUnsigned(nested, uint64_t(0));
+        bond::WriteVariableUnsigned(nested, uint32_t(0));
+        bond::WriteVariableUnsigned(nested, uint32_t(1));
+    }
+
+    bond::InputBuffer nested_input(nested.GetBuffer());
+    BOOST_CHECK_THROW(bond::detail::ColumnReader().Read(nested_input), bond::CoreException);
+
+    // bonded<T> can't be written inside of a list of structs
+    bond::OutputBuffer output;
+    ColumnarWriter writer(output);
+    writer.WriteContainerBegin(1, bond::BT_STRUCT);
+    BOOST_CHECK_THROW(writer.GetBuffer(), bond::CoreException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
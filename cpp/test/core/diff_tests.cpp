@@ -0,0 +1,208 @@
+#include "precompiled.h"
+
+
+template <typename Writer, typename T>
+bond::blob MakePatch(const T& original, const T& updated, uint16_t version = bond::v1)
+{
+    typename Writer::Buffer output_buffer(4096);
+
+    Factory<Writer>::Call(output_buffer, version, boost::bind(
+        bond::Diff<bond::BuiltInProtocols, T, Writer>, original, updated, boost::placeholders::_1));
+
+    return output_buffer.GetBuffer();
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void Patching(const T& original, const T& updated, uint16_t version = bond::v1)
+{
+    T patched(original);
+
+    typename Reader::Buffer input_buffer(MakePatch<Writer>(original, updated, version));
+    bond::Patch(patched, Factory<Reader>::Create(input_buffer, version));
+
+    UT_Equal(updated, patched);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void PatchingAllVersions(const T& original, const T& updated)
+{
+    Patching<Reader, Writer>(original, updated);
+    Patching<Reader, Writer>(original, updated, Reader::version);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(PatchingRandom)
+{
+    PatchingAllVersions<Reader, Writer>(T(), T());
+    PatchingAllVersions<Reader, Writer>(T(), InitRandom<T>());
+    PatchingAllVersions<Reader, Writer>(InitRandom<T>(), T());
+
+    for (uint32_t i = 0; i < c_iterations; ++i)
+    {
+        PatchingAllVersions<Reader, Writer>(InitRandom<T>(), InitRandom<T>());
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(PatchingNestedField)
+{
+    NestedStruct original = InitRandom<NestedStruct>();
+    NestedStruct updated = original;
+
+    updated.n3.n2.n1.s.m_int32 = ~original.n3.n2.n1.s.m_int32;
+    updated.m_str += "x";
+
+    PatchingAllVersions<Reader, Writer>(original, updated);
+
+    // The patch for a small change is much smaller than the object
+    typename Writer::Buffer output_buffer(4096);
+    Writer writer(output_buffer);
+    bond::Serialize(updated, writer);
+
+    UT_AssertIsTrue(MakePatch<Writer>(original, updated).size() * 2 < output_buffer.GetBuffer().size());
+
+    // Patching with identical objects leaves the object unchanged
+    PatchingAllVersions<Reader, Writer>(updated, updated);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(PatchingStructLists)
+{
+    NestedListsStruct original = InitRandom<NestedListsStruct>();
+    NestedListsStruct updated;
+
+    // grow
+    updated = original;
+    updated.lSLS.push_back(InitRandom<SimpleListsStruct>());
+    PatchingAllVersions<Reader, Writer>(original, updated);
+
+    // shrink
+    updated = original;
+    if (!updated.lSLS.empty())
+        updated.lSLS.pop_back();
+    PatchingAllVersions<Reader, Writer>(original, updated);
+
+    // modify element in place
+    updated = original;
+    if (!updated.lSLS.empty())
+        updated.lSLS.front().l_uint32.push_back(42);
+    PatchingAllVersions<Reader, Writer>(original, updated);
+
+    // clear
+    updated = original;
+    updated.lSLS.clear();
+    PatchingAllVersions<Reader, Writer>(original, updated);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(PatchingNothing)
+{
+    FieldHeaders original;
+    FieldHeaders updated;
+
+    // set to nothing
+    original.absent.set_value() = 5;
+    PatchingAllVersions<Reader, Writer>(original, updated);
+
+    // nothing to set
+    PatchingAllVersions<Reader, Writer>(updated, original);
+
+    // set to default value of the type
+    updated.absent.set_value() = 0;
+    PatchingAllVersions<Reader, Writer>(original, updated);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(PatchingBonded)
+{
+    const SimpleStruct from = InitRandom<SimpleStruct>();
+    const SimpleStruct to = InitRandom<SimpleStruct>();
+
+    typename Writer::Buffer output_buffer(4096);
+    Writer writer(output_buffer);
+    bond::Serialize(to, writer);
+
+    NestedStruct1BondedView original, updated;
+    original.s = bond::bonded<SimpleStruct>(from);
+    updated.s = bond::bonded<SimpleStruct>(Reader(output_buffer.GetBuffer()));
+
+    NestedStruct1BondedView patched(original);
+
+    typename Reader::Buffer input_buffer(MakePatch<Writer>(original, updated));
+    bond::Patch(patched, Factory<Reader>::Create(input_buffer, bond::v1));
+
+    SimpleStruct result;
+    patched.s.Deserialize(result);
+
+    UT_Equal(to, result);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void DiffTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        PatchingRandom, Reader, Writer, SimpleStruct>(suite, "Patching simple struct");
+
+    AddTestCase<TEST_ID(N),
+        PatchingRandom, Reader, Writer, NestedStruct>(suite, "Patching nested struct");
+
+    AddTestCase<TEST_ID(N),
+        PatchingRandom, Reader, Writer, NestedWithBase>(suite, "Patching struct with base");
+
+    AddTestCase<TEST_ID(N),
+        PatchingRandom, Reader, Writer, SimpleListsStruct>(suite, "Patching simple containers");
+
+    AddTestCase<TEST_ID(N),
+        PatchingRandom, Reader, Writer, NestedListsStruct>(suite, "Patching nested containers");
+
+    AddTestCase<TEST_ID(N),
+        PatchingNestedField, Reader, Writer>(suite, "Patching single nested field");
+
+    AddTestCase<TEST_ID(N),
+        PatchingStructLists, Reader, Writer>(suite, "Patching struct lists");
+
+    AddTestCase<TEST_ID(N),
+        PatchingNothing, Reader, Writer>(suite, "Patching maybe fields");
+
+    AddTestCase<TEST_ID(N),
+        PatchingBonded, Reader, Writer>(suite, "Patching bonded fields");
+}
+
+
+void DiffTestsInit()
+{
+    TEST_COMPACT_BINARY_PROTOCOL(
+        DiffTests<
+            0x2501,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Diff/Patch tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        DiffTests<
+            0x2502,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Diff/Patch tests for FastBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    DiffTestsInit();
+    return true;
+}
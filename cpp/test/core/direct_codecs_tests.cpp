@@ -0,0 +1,122 @@
+#include "precompiled.h"
+
+#include "direct_codec_test_reflection.h"
+
+// Structs in namespace direct_codecs are generated with --direct-codecs, those
+// in namespace direct_codec_test from the same schema without it. The direct
+// codecs are declared in _reflection.h, so _apply.h isn't included here.
+#include "direct_codec_tests_generated/direct_codec_test_reflection.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+using Reader = bond::CompactBinaryReader<bond::InputBuffer>;
+using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+template <typename T>
+bond::blob Serialize(const T& obj, uint16_t version)
+{
+    bond::OutputBuffer output;
+    Writer writer(output, version);
+
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+template <typename T>
+T Deserialize(const bond::blob& data, uint16_t version)
+{
+    T obj;
+    bond::Deserialize(Reader(data, version), obj);
+    return obj;
+}
+
+direct_codec_test::Fields MakeFields(const direct_codec_test::Nested& nested = direct_codec_test::Nested())
+{
+    auto obj = InitRandom<direct_codec_test::Fields>();
+
+    obj.m_bonded = bond::bonded<direct_codec_test::Nested>(nested);
+    obj.m_maybe.set_value() = 42;
+    return obj;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(DirectCodecsTests)
+
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+    const auto nested = InitRandom<direct_codec_test::Nested>();
+    const auto from = MakeFields(nested);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        const bond::blob data = Serialize(from, version);
+        const auto obj = Deserialize<direct_codecs::Fields>(data, version);
+
+        // The direct codecs produce the same payload as bond::Serialize
+        BOOST_CHECK(Serialize(obj, version) == data);
+        BOOST_CHECK(obj == Deserialize<direct_codecs::Fields>(Serialize(obj, version), version));
+
+        BOOST_CHECK_EQUAL(obj.m_id, from.m_id);
+        BOOST_CHECK_EQUAL(obj.m_str, from.m_str);
+        BOOST_CHECK_EQUAL(obj.m_maybe.value(), 42);
+        BOOST_CHECK(obj.m_bonded.Deserialize().m_list == nested.m_list);
+
+        // Other entry points which use Apply go through the direct codecs too
+        direct_codecs::Fields bonded;
+        bond::bonded<direct_codecs::Fields>(Reader(data, version)).Deserialize(bonded);
+        BOOST_CHECK(bonded == obj);
+
+        bond::OutputBuffer output;
+        Writer writer(output, version);
+        bond::Marshal(obj, writer);
+
+        direct_codecs::Fields unmarshaled;
+        bond::Unmarshal(bond::InputBuffer(output.GetBuffer()), unmarshaled);
+        BOOST_CHECK(Serialize(unmarshaled, version) == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TypeMismatchTest)
+{
+    const auto from = InitRandom<direct_codec_test::Narrow>();
+    const bond::blob data = Serialize(from, bond::v1);
+
+    // Fields with matching ids are converted to the wider types and unknown
+    // fields are skipped, same as without direct codecs
+    const auto generic = Deserialize<direct_codec_test::Wide>(data, bond::v1);
+    const auto direct = Deserialize<direct_codecs::Wide>(data, bond::v1);
+
+    BOOST_CHECK_EQUAL(direct.m_int, from.m_int);
+    BOOST_CHECK_EQUAL(direct.m_float, from.m_float);
+    BOOST_CHECK_EQUAL(direct.m_uint, from.m_uint);
+    BOOST_CHECK(Serialize(direct, bond::v1) == Serialize(generic, bond::v1));
+}
+
+BOOST_AUTO_TEST_CASE(InheritanceTest)
+{
+    const bond::blob data = Serialize(MakeFields(), bond::v1);
+
+    // Payload with a deeper hierarchy than the schema
+    const auto generic = Deserialize<direct_codec_test::Nested>(data, bond::v1);
+    const auto direct = Deserialize<direct_codecs::Nested>(data, bond::v1);
+
+    BOOST_CHECK(Serialize(direct, bond::v1) == Serialize(generic, bond::v1));
+
+    // Payload without the required field of the base struct
+    const bond::blob nested = Serialize(InitRandom<direct_codec_test::Nested>(), bond::v1);
+
+    BOOST_CHECK_THROW(Deserialize<direct_codec_test::Fields>(nested, bond::v1), bond::CoreException);
+    BOOST_CHECK_THROW(Deserialize<direct_codecs::Fields>(nested, bond::v1), bond::CoreException);
+    BOOST_CHECK_THROW(Deserialize<direct_codecs::Base>(nested, bond::v1), bond::CoreException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
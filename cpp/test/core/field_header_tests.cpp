@@ -0,0 +1,125 @@
+#include "precompiled.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+using CompactReader = bond::CompactBinaryReader<bond::InputBuffer>;
+using CompactWriter = bond::CompactBinaryWriter<bond::OutputBuffer>;
+using FastReader = bond::FastBinaryReader<bond::InputBuffer>;
+using FastWriter = bond::FastBinaryWriter<bond::OutputBuffer>;
+
+template <bond::BondDataType type, uint16_t id>
+void CheckHeader()
+{
+    bond::OutputBuffer expected;
+    CompactWriter(expected).WriteFieldBegin(type, id);
+
+    bond::OutputBuffer output;
+    CompactWriter(output).WriteFieldBegin<type, id>();
+
+    BOOST_CHECK(output.GetBuffer() == expected.GetBuffer());
+    BOOST_CHECK_EQUAL(output.GetBuffer().size(), (bond::detail::compact_field_header<type, id>::size));
+}
+
+template <uint16_t id, typename T>
+void CheckField(const T& value)
+{
+    bond::OutputBuffer expected;
+    CompactWriter(expected).WriteField(id, bond::Metadata(), value);
+
+    bond::OutputBuffer output;
+    CompactWriter(output).WriteField<id>(value);
+
+    BOOST_CHECK(output.GetBuffer() == expected.GetBuffer());
+}
+
+template <typename T>
+bond::blob Serialize(const T& obj, uint16_t version)
+{
+    bond::OutputBuffer output;
+    CompactWriter writer(output, version);
+
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+// Compact Binary payload written with field headers encoded at run time by
+// transcoding from Fast Binary.
+template <typename T>
+bond::blob Transcode(const T& obj, uint16_t version)
+{
+    bond::OutputBuffer fast;
+    FastWriter fast_writer(fast);
+    bond::Serialize(obj, fast_writer);
+
+    bond::OutputBuffer output;
+    CompactWriter writer(output, version);
+
+    bond::bonded<T>(FastReader(fast.GetBuffer())).Serialize(writer);
+    return output.GetBuffer();
+}
+
+template <typename T>
+void CheckSerialize(const T& from)
+{
+    for (uint16_t version = bond::v1; version <= CompactReader::version; ++version)
+    {
+        const bond::blob data = Serialize(from, version);
+        BOOST_CHECK(data == Transcode(from, version));
+
+        T obj;
+        bond::Deserialize(CompactReader(data, version), obj);
+        BOOST_CHECK(Equal(from, obj));
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(FieldHeaderTests)
+
+BOOST_AUTO_TEST_CASE(HeaderTest)
+{
+    BOOST_STATIC_ASSERT(bond::uses_static_field_headers<CompactWriter>::value);
+    BOOST_STATIC_ASSERT(!bond::uses_static_field_headers<FastWriter>::value);
+
+    CheckHeader<bond::BT_BOOL, 0>();
+    CheckHeader<bond::BT_INT32, 5>();
+    CheckHeader<bond::BT_STRUCT, 6>();
+    CheckHeader<bond::BT_STRING, 255>();
+    CheckHeader<bond::BT_LIST, 256>();
+    CheckHeader<bond::BT_WSTRING, 0x1234>();
+    CheckHeader<bond::BT_MAP, 0xffff>();
+
+    CheckField<0>(true);
+    CheckField<1>(static_cast<int8_t>(-3));
+    CheckField<5>(static_cast<uint8_t>(0xfe));
+    CheckField<6>(static_cast<uint8_t>(7));
+    CheckField<2>(static_cast<int32_t>(-100000));
+    CheckField<3>(3.5);
+    CheckField<4>(EnumValue3);
+    CheckField<300>(std::string("header"));
+}
+
+BOOST_AUTO_TEST_CASE(SerializeTest)
+{
+    // Optional fields with default values are omitted
+    CheckSerialize(FieldHeaders());
+
+    auto obj = InitRandom<FieldHeaders>();
+    obj.absent.set_value() = 42;
+    obj.omitted = 1;
+    CheckSerialize(obj);
+
+    CheckSerialize(InitRandom<NestedStruct>());
+    CheckSerialize(InitRandom<StructWithBase>());
+    CheckSerialize(InitRandom<NestedListsStruct>());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
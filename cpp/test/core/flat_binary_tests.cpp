@@ -0,0 +1,347 @@
+#include "precompiled.h"
+
+#include <bond/protocol/flat_binary.h>
+
+#include <boost/mpl/for_each.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+// Compare a view of a Flat Binary payload with the serialized object
+template <typename T>
+bool Match(const T& view, const T& value);
+
+bool Match(boost::string_ref view, const std::string& value);
+bool Match(const bond::FlatSpan<uint16_t>& view, const std::wstring& value);
+
+template <typename E, typename T>
+bool Match(const bond::FlatSpan<E>& view, const T& value);
+
+template <typename E, typename T>
+bool Match(const bond::FlatList<E>& view, const T& value);
+
+template <typename K, typename V, typename T>
+bool Match(const bond::FlatMap<K, V>& view, const T& value);
+
+template <typename T>
+bool Match(const bond::FlatView<T>& view, const T& value);
+
+
+template <typename T>
+bool Match(const T& view, const T& value)
+{
+    return view == value;
+}
+
+bool Match(boost::string_ref view, const std::string& value)
+{
+    return view == value;
+}
+
+bool Match(const bond::FlatSpan<uint16_t>& view, const std::wstring& value)
+{
+    return std::equal(view.begin(), view.end(), value.begin(), value.end(),
+        [](uint16_t c, wchar_t w) { return c == static_cast<uint16_t>(w); });
+}
+
+template <typename View, typename T>
+bool MatchElements(const View& view, const T& value)
+{
+    if (view.size() != bond::container_size(value))
+        return false;
+
+    uint32_t index = 0;
+
+    for (bond::const_enumerator<T> items(value); items.more(); ++index)
+    {
+        if (!Match(view[index], items.next()))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename E, typename T>
+bool Match(const bond::FlatSpan<E>& view, const T& value)
+{
+    return MatchElements(view, value);
+}
+
+template <typename E, typename T>
+bool Match(const bond::FlatList<E>& view, const T& value)
+{
+    return MatchElements(view, value);
+}
+
+template <typename K, typename V, typename T>
+bool Match(const bond::FlatMap<K, V>& view, const T& value)
+{
+    if (view.size() != bond::container_size(value) || view.values().size() != view.size())
+        return false;
+
+    uint32_t index = 0;
+
+    for (bond::const_enumerator<T> items(value); items.more(); ++index)
+    {
+        const typename bond::element_type<T>::type& item = items.next();
+
+        if (!Match(view.keys()[index], item.first) || !Match(view.values()[index], item.second))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+struct FieldsMatch
+{
+    template <typename Field>
+    void operator()(const Field*)
+    {
+        match = match && Match(view.template Get<Field>(), Field::GetVariable(value));
+    }
+
+    const bond::FlatView<T>& view;
+    const T& value;
+    bool& match;
+};
+
+template <typename T>
+typename boost::enable_if<bond::has_base<T>, bool>::type
+MatchBase(const bond::FlatView<T>& view, const T& value)
+{
+    return Match(view.Base(), static_cast<const typename T::Schema::base&>(value));
+}
+
+template <typename T>
+typename boost::disable_if<bond::has_base<T>, bool>::type
+MatchBase(const bond::FlatView<T>& /*view*/, const T& /*value*/)
+{
+    return true;
+}
+
+template <typename T>
+bool Match(const bond::FlatView<T>& view, const T& value)
+{
+    bool match = !view.empty() && MatchBase(view, value);
+    FieldsMatch<T> fields = { view, value, match };
+
+    boost::mpl::for_each<typename T::Schema::fields, boost::add_pointer<boost::mpl::_> >(fields);
+    return match;
+}
+
+template <typename T>
+void CheckRoundTrip(const T& obj)
+{
+    const bond::blob data = bond::SerializeFlat(obj);
+
+    BOOST_REQUIRE(bond::VerifyFlat<T>(data));
+    BOOST_CHECK(Match(bond::GetFlatView<T>(data), obj));
+}
+
+template <typename T>
+bool IsWithin(const T* view, const bond::blob& data)
+{
+    const char* p = reinterpret_cast<const char*>(view);
+    return p >= data.content() && p < data.content() + data.length();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(FlatBinaryTests)
+
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+    CheckRoundTrip(SimpleStruct());
+    CheckRoundTrip(InitRandom<SimpleStruct>());
+    CheckRoundTrip(InitRandom<StructWithBase>());
+    CheckRoundTrip(InitRandom<NestedStruct>());
+    CheckRoundTrip(InitRandom<SimpleListsStruct>());
+    CheckRoundTrip(InitRandom<FlatStruct>());
+
+    auto vectors = InitRandom<FlatVectors>();
+    vectors.points.resize(100, InitRandom<FlatPoint>());
+    vectors.structs.resize(3, InitRandom<FlatStruct>());
+    CheckRoundTrip(vectors);
+
+    auto lists = InitRandom<NestedListsStruct>();
+    lists.lSLS.push_back(InitRandom<SimpleListsStruct>());
+    lists.lSLS.push_back(SimpleListsStruct());
+    lists.vvNS.resize(3);
+    lists.vvNS[0].push_back(InitRandom<NestedStruct>());
+    CheckRoundTrip(lists);
+}
+
+BOOST_AUTO_TEST_CASE(AccessTest)
+{
+    auto obj = InitRandom<SimpleListsStruct>();
+    obj.v_double = { 0.5, 1.5, 2.5 };
+    obj.l_string = { "flat", "binary" };
+    obj.m_int8_string = { { 1, "one" }, { 2, "two" } };
+
+    const bond::blob data = bond::SerializeFlat(obj);
+    const auto view = bond::GetFlatView<SimpleListsStruct>(data);
+
+    // Lists of scalars are spans of the payload
+    const auto v_double = view.Get<SimpleListsStruct::Schema::var::v_double>();
+    BOOST_REQUIRE_EQUAL(v_double.size(), 3u);
+    BOOST_CHECK(IsWithin(v_double.data(), data));
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(v_double.data()) % sizeof(double), 0u);
+    BOOST_CHECK_EQUAL(v_double[2], 2.5);
+
+    const auto l_string = view.Get<SimpleListsStruct::Schema::var::l_string>();
+    BOOST_REQUIRE_EQUAL(l_string.size(), 2u);
+    BOOST_CHECK(IsWithin(l_string[1].data(), data));
+    BOOST_CHECK_EQUAL(l_string[1], "binary");
+    BOOST_CHECK_EQUAL(std::distance(l_string.begin(), l_string.end()), 2);
+
+    const auto m_int8_string = view.Get<SimpleListsStruct::Schema::var::m_int8_string>();
+    BOOST_REQUIRE_EQUAL(m_int8_string.size(), 2u);
+    BOOST_CHECK_EQUAL(m_int8_string.keys()[1], 2);
+    BOOST_CHECK_EQUAL(m_int8_string.values()[1], "two");
+
+    // Fields of the base struct are accessible from the derived struct
+    auto derived = InitRandom<StructWithBase>();
+    const bond::blob derived_data = bond::SerializeFlat(derived);
+    const auto derived_view = bond::GetFlatView<StructWithBase>(derived_data);
+
+    BOOST_CHECK_EQUAL(derived_view.Get<StructWithBase::Schema::var::m_int32>(), derived.m_int32);
+    BOOST_CHECK_EQUAL(derived_view.Get<SimpleBase::Schema::var::m_int32>(), derived.SimpleBase::m_int32);
+    BOOST_CHECK_EQUAL(derived_view.Get<SimpleStruct::Schema::var::m_uint64>(), derived.m_uint64);
+
+    // Empty containers and strings are stored as empty offsets
+    const bond::blob empty_data = bond::SerializeFlat(SimpleListsStruct());
+    const auto empty = bond::GetFlatView<SimpleListsStruct>(empty_data);
+    BOOST_CHECK(empty.Get<SimpleListsStruct::Schema::var::v_double>().empty());
+    BOOST_CHECK(empty.Get<SimpleListsStruct::Schema::var::l_string>().empty());
+    BOOST_CHECK(empty.Get<SimpleListsStruct::Schema::var::m_string_bool>().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DefaultsTest)
+{
+    FlatStruct obj;
+    obj.amount = 3.5;
+    obj.kind = EnumValue3;
+    obj.weight = 2.0f;
+
+    const bond::blob data = bond::SerializeFlat(obj);
+    const char* table = data.content() + bond::detail::FlatLoad<uint32_t>(data.content() + sizeof(uint32_t));
+
+    // Shrink the table to its base and first field, as written by a
+    // previous version of the schema with fewer fields
+    const uint32_t size = 16;
+    std::memcpy(const_cast<char*>(table), &size, sizeof(size));
+
+    BOOST_REQUIRE(bond::VerifyFlat<FlatStruct>(data));
+
+    const auto view = bond::GetFlatView<FlatStruct>(data);
+    BOOST_CHECK_EQUAL(view.Get<FlatStruct::Schema::var::amount>(), 3.5);
+    BOOST_CHECK_EQUAL(view.Get<FlatStruct::Schema::var::kind>(), EnumValue2);
+    BOOST_CHECK_EQUAL(view.Get<FlatStruct::Schema::var::weight>(), 0.0f);
+    BOOST_CHECK(view.Get<FlatStruct::Schema::var::point>().empty());
+}
+
+BOOST_AUTO_TEST_CASE(VerifyTest)
+{
+    NestedListsStruct obj;
+    obj.ll8 = { { 1, 2 }, {} };
+    obj.lSLS.resize(2);
+    obj.lSLS.front().v_double = { 1.5 };
+    obj.lSLS.front().m_string_bool = { { "key", true } };
+    obj.vvNS.resize(2);
+    obj.vvNS[1].resize(1);
+    obj.vvNS[1][0].m_str = "nested";
+    obj.vvNS[1][0].n1.s.m_wstr = L"wide";
+    obj.lsb = { { false, true } };
+    obj.m64ls[7] = { "seven" };
+
+    const bond::blob data = bond::SerializeFlat(obj);
+    BOOST_REQUIRE(bond::VerifyFlat<NestedListsStruct>(data));
+
+    // Truncated payloads
+    for (uint32_t length = 0; length < data.length(); ++length)
+        BOOST_CHECK(!bond::VerifyFlat<NestedListsStruct>(bond::blob(data.content(), length)));
+
+    // Misaligned payload
+    std::vector<uint64_t> copy(data.length() / sizeof(uint64_t) + 2);
+    std::memcpy(reinterpret_cast<char*>(copy.data()) + 1, data.content(), data.length());
+    BOOST_CHECK(!bond::VerifyFlat<NestedListsStruct>(bond::blob(reinterpret_cast<char*>(copy.data()) + 1, data.length())));
+
+    // Corrupted payloads are either rejected or safe to access
+    std::vector<uint64_t> corrupted(data.length() / sizeof(uint64_t) + 1);
+    char* bytes = reinterpret_cast<char*>(corrupted.data());
+    const bond::blob payload(bytes, data.length());
+
+    for (uint32_t i = 0; i < data.length(); ++i)
+    {
+        for (uint8_t value : { 0x00, 0x01, 0x7f, 0xff })
+        {
+            std::memcpy(bytes, data.content(), data.length());
+            bytes[i] = static_cast<char>(value);
+
+            if (bond::VerifyFlat<NestedListsStruct>(payload))
+                Match(bond::GetFlatView<NestedListsStruct>(payload), obj);
+        }
+    }
+
+    // Invalid bool
+    FlatStruct flat;
+    flat.flag = true;
+
+    const bond::blob flat_data = bond::SerializeFlat(flat);
+    const char* table = flat_data.content() + bond::detail::FlatLoad<uint32_t>(flat_data.content() + sizeof(uint32_t));
+    const uint32_t offset = bond::detail::flat_table<FlatStruct>::layout::offset_of<FlatStruct::Schema::var::flag>::value;
+
+    BOOST_REQUIRE(bond::VerifyFlat<FlatStruct>(flat_data));
+    const_cast<char*>(table)[offset] = 2;
+    BOOST_CHECK(!bond::VerifyFlat<FlatStruct>(flat_data));
+}
+
+BOOST_AUTO_TEST_CASE(SharedSpanTest)
+{
+    // Point the bool lists of many structs at the same long span, so that
+    // verifying each reference separately would take quadratic time.
+    const uint32_t structs = 1024;
+    NestedListsStruct obj;
+    obj.lSLS.resize(structs);
+
+    for (auto& item : obj.lSLS)
+        item.l_bool = { true };
+
+    obj.lSLS.back().l_bool.assign(4096, true);
+
+    const bond::blob data = bond::SerializeFlat(obj);
+    BOOST_REQUIRE(bond::VerifyFlat<NestedListsStruct>(data));
+
+    char* bytes = const_cast<char*>(data.content());
+    auto follow = [bytes](uint32_t slot)
+    {
+        return slot + bond::detail::FlatLoad<uint32_t>(bytes + slot);
+    };
+
+    const uint32_t root = bond::detail::FlatLoad<uint32_t>(bytes + sizeof(uint32_t));
+    const uint32_t list = follow(root
+        + bond::detail::flat_table<NestedListsStruct>::layout::offset_of<NestedListsStruct::Schema::var::lSLS>::value);
+    const uint32_t l_bool =
+        bond::detail::flat_table<SimpleListsStruct>::layout::offset_of<SimpleListsStruct::Schema::var::l_bool>::value;
+    const uint32_t span = follow(follow(list + structs * sizeof(uint32_t)) + l_bool);
+
+    for (uint32_t i = 0; i < structs - 1; ++i)
+    {
+        const uint32_t slot = follow(list + (i + 1) * sizeof(uint32_t)) + l_bool;
+        BOOST_REQUIRE_LT(slot, span);
+
+        const uint32_t offset = span - slot;
+        std::memcpy(bytes + slot, &offset, sizeof(offset));
+    }
+
+    BOOST_CHECK(!bond::VerifyFlat<NestedListsStruct>(data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
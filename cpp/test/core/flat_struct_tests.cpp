@@ -0,0 +1,136 @@
+#include "precompiled.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+using SimpleReader = bond::SimpleBinaryReader<bond::InputBuffer>;
+using SimpleWriter = bond::SimpleBinaryWriter<bond::OutputBuffer>;
+using CompactReader = bond::CompactBinaryReader<bond::InputBuffer>;
+using CompactWriter = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+template <typename T>
+bond::blob SerializeSimple(const T& obj, uint16_t version)
+{
+    bond::OutputBuffer output;
+    SimpleWriter writer(output, version);
+
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+// Simple Binary payload written field by field by transcoding from Compact
+// Binary, which doesn't go through the single copy path.
+template <typename T>
+bond::blob TranscodeToSimple(const T& obj, uint16_t version)
+{
+    bond::OutputBuffer compact;
+    CompactWriter compact_writer(compact);
+    bond::Serialize(obj, compact_writer);
+
+    bond::OutputBuffer output;
+    SimpleWriter writer(output, version);
+
+    bond::bonded<T>(CompactReader(compact.GetBuffer())).Serialize(writer);
+    return output.GetBuffer();
+}
+
+FlatVectors MakeFlatVectors()
+{
+    auto obj = InitRandom<FlatVectors>();
+
+    // Make sure vectors are not empty, so that the bulk copies are exercised
+    obj.points.push_back(InitRandom<FlatPoint>());
+    obj.structs.push_back(InitRandom<FlatStruct>());
+    obj.linked.push_back(InitRandom<FlatPoint>());
+    obj.single.kind = EnumValue3;
+    return obj;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(FlatStructTests)
+
+BOOST_AUTO_TEST_CASE(TraitsTest)
+{
+    BOOST_STATIC_ASSERT(bond::is_flat_struct<FlatPoint>::value);
+    BOOST_STATIC_ASSERT(bond::is_flat_struct<FlatBase>::value);
+    BOOST_STATIC_ASSERT(bond::is_flat_struct<FlatStruct>::value);
+    BOOST_STATIC_ASSERT(!bond::is_flat_struct<FlatVectors>::value);
+    BOOST_STATIC_ASSERT(!bond::is_flat_struct<SimpleStruct>::value);
+    BOOST_STATIC_ASSERT(!bond::is_flat_struct<int32_t>::value);
+    BOOST_STATIC_ASSERT(!bond::is_flat_struct<std::vector<FlatPoint> >::value);
+
+    BOOST_STATIC_ASSERT(bond::uses_packed_fields<SimpleReader>::value);
+    BOOST_STATIC_ASSERT(bond::uses_packed_fields<SimpleWriter>::value);
+    BOOST_STATIC_ASSERT(!bond::uses_packed_fields<CompactReader>::value);
+    BOOST_STATIC_ASSERT(!bond::uses_packed_fields<CompactWriter>::value);
+
+    // FlatPoint is copied as is, FlatStruct has padding and is copied field
+    // by field.
+    BOOST_CHECK(bond::detail::FlatFields::IsPacked(FlatPoint()));
+    BOOST_CHECK(!bond::detail::FlatFields::IsPacked(FlatStruct()));
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+    const FlatVectors from = MakeFlatVectors();
+
+    for (uint16_t version = bond::v1; version <= SimpleReader::version; ++version)
+    {
+        // Same payload as when the fields are written one by one
+        const bond::blob data = SerializeSimple(from, version);
+        BOOST_CHECK(data == TranscodeToSimple(from, version));
+
+        FlatVectors obj;
+        bond::Deserialize(SimpleReader(data, version), obj);
+        BOOST_CHECK(Equal(from, obj));
+
+        // Deserializing fields one by one using runtime schema
+        FlatVectors dynamic;
+        bond::bonded<void>(SimpleReader(data, version), bond::GetRuntimeSchema<FlatVectors>()).Deserialize(dynamic);
+        BOOST_CHECK(Equal(from, dynamic));
+
+        // Top level flat structs
+        const bond::blob point = SerializeSimple(from.single.point, version);
+        BOOST_CHECK(point == TranscodeToSimple(from.single.point, version));
+        BOOST_CHECK_EQUAL(point.size(), 2 * sizeof(int32_t));
+
+        FlatStruct single;
+        bond::bonded<FlatStruct>(SimpleReader(SerializeSimple(from.single, version), version)).Deserialize(single);
+        BOOST_CHECK(Equal(from.single, single));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BaseTest)
+{
+    const FlatStruct from = InitRandom<FlatStruct>();
+    const bond::blob data = SerializeSimple(from, bond::v1);
+
+    // The base part of the payload
+    FlatBase base;
+    bond::bonded<FlatStruct>(SimpleReader(data)).Deserialize(base);
+    BOOST_CHECK_EQUAL(base.key, from.key);
+
+    BOOST_CHECK(SerializeSimple(static_cast<const FlatBase&>(from), bond::v1)
+        == TranscodeToSimple(static_cast<const FlatBase&>(from), bond::v1));
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedPayloadTest)
+{
+    const bond::blob data = SerializeSimple(MakeFlatVectors(), bond::v2);
+
+    FlatVectors obj;
+    BOOST_CHECK_THROW(bond::Deserialize(SimpleReader(data.range(0, data.size() - 1), bond::v2), obj), bond::StreamException);
+
+    FlatPoint point;
+    BOOST_CHECK_THROW(bond::Deserialize(SimpleReader(data.range(0, 7)), point), bond::StreamException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
@@ -0,0 +1,194 @@
+#include "precompiled.h"
+
+#include <bond/core/hash.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+namespace
+{
+
+// Payload of obj read as bonded<T>
+template <typename T, typename Reader, typename U>
+bond::bonded<T> SerializeAs(const U& obj, uint16_t version)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    bond::OutputBuffer output;
+    Factory<Writer>::Call(output, version, [&obj](Writer& writer)
+    {
+        bond::Serialize(obj, writer);
+    });
+
+    typename Reader::Buffer input(output.GetBuffer());
+    return bond::bonded<T>(Factory<Reader>::Create(input, version));
+}
+
+template <typename Reader, typename T>
+bond::bonded<T> SerializeWith(const T& obj, uint16_t version)
+{
+    return SerializeAs<T, Reader>(obj, version);
+}
+
+template <typename T>
+bond::bonded<T> Serialize(const T& obj)
+{
+    return SerializeWith<bond::CompactBinaryReader<bond::InputBuffer> >(obj, bond::v2);
+}
+
+// Payload of a SimpleListsStruct with m_int8_string written in the specified order
+bond::bonded<SimpleListsStruct> SerializeMap(const std::vector<std::pair<int8_t, std::string> >& entries)
+{
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output);
+
+    writer.WriteStructBegin(bond::Metadata(), false);
+    writer.WriteFieldBegin(bond::BT_MAP, 60);
+    writer.WriteContainerBegin(static_cast<uint32_t>(entries.size()),
+        std::make_pair(bond::BT_INT8, bond::BT_STRING));
+
+    for (const auto& entry : entries)
+    {
+        writer.Write(entry.first);
+        writer.Write(entry.second);
+    }
+
+    writer.WriteContainerEnd();
+    writer.WriteFieldEnd();
+    writer.WriteStructEnd();
+
+    return bond::bonded<SimpleListsStruct>(
+        bond::CompactBinaryReader<bond::InputBuffer>(output.GetBuffer()));
+}
+
+template <typename T1, typename T2>
+void CheckEqual(const T1& x, const T2& y)
+{
+    BOOST_CHECK(bond::Equal(x, y));
+    BOOST_CHECK_EQUAL(bond::Hash(x), bond::Hash(y));
+}
+
+template <typename T1, typename T2>
+void CheckNotEqual(const T1& x, const T2& y)
+{
+    BOOST_CHECK(!bond::Equal(x, y));
+    BOOST_CHECK_NE(bond::Hash(x), bond::Hash(y));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(HashTests)
+
+using all_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InputBuffer>,
+    bond::CompactBinaryReader<bond::InputBuffer>,
+    bond::FastBinaryReader<bond::InputBuffer> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ProtocolIndependenceTest, Reader, all_protocols)
+{
+    const auto simple = InitRandom<SimpleStruct>();
+    const auto lists = InitRandom<SimpleListsStruct>();
+    const auto nested = InitRandom<NestedStruct>();
+    const auto derived = InitRandom<StructWithBase>();
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        CheckEqual(SerializeWith<Reader>(simple, version), Serialize(simple));
+        CheckEqual(SerializeWith<Reader>(lists, version), Serialize(lists));
+        CheckEqual(SerializeWith<Reader>(nested, version), Serialize(nested));
+        CheckEqual(SerializeWith<Reader>(derived, version), Serialize(derived));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DifferentValuesTest)
+{
+    const auto obj = InitRandom<SimpleStruct>();
+
+    auto str = obj;
+    str.m_str += "x";
+    CheckNotEqual(Serialize(obj), Serialize(str));
+
+    auto enum1 = obj;
+    enum1.m_enum1 = (obj.m_enum1 == EnumValue2) ? EnumValue3 : EnumValue2;
+    CheckNotEqual(Serialize(obj), Serialize(enum1));
+
+    SimpleListsStruct lists;
+    lists.l_uint32 = { 1, 2, 3 };
+
+    auto reversed = lists;
+    reversed.l_uint32 = { 3, 2, 1 };
+    CheckNotEqual(Serialize(lists), Serialize(reversed));
+
+    // Fields with equal values but different ids
+    SimpleListsStruct int16;
+    int16.l_int16 = { 1, 2, 3 };
+
+    SimpleListsStruct vector_int16;
+    vector_int16.v_int16 = { 1, 2, 3 };
+    CheckNotEqual(Serialize(int16), Serialize(vector_int16));
+
+    // Fields of a base and of the derived struct with the same id
+    StructWithBase base;
+    base.SimpleBase::m_int32 = 10;
+
+    StructWithBase derived;
+    derived.m_int32 = 10;
+    CheckNotEqual(Serialize(base), Serialize(derived));
+}
+
+BOOST_AUTO_TEST_CASE(DefaultValuesTest)
+{
+    SimpleStructView view;
+    view.m_str = "test";
+    view.m_uint64 = 10;
+
+    SimpleStruct obj;
+    obj.m_str = "test";
+    obj.m_uint64 = 10;
+
+    // Fields omitted from the view payload have default values in obj
+    const auto omitted = SerializeAs<SimpleStruct, bond::CompactBinaryReader<bond::InputBuffer> >(view, bond::v2);
+    CheckEqual(omitted, Serialize(obj));
+
+    obj.m_int32 = 1;
+    CheckNotEqual(omitted, Serialize(obj));
+
+    // Empty containers are default
+    CheckEqual(SerializeMap({}), Serialize(SimpleListsStruct()));
+
+    // ... unless the default of the field is nothing
+    OptionalNothing empty;
+    empty.l.emplace();
+    empty.m.emplace();
+    CheckNotEqual(Serialize(empty), Serialize(OptionalNothing()));
+
+    OptionalNothing empty_list;
+    empty_list.l.emplace();
+    CheckNotEqual(Serialize(empty), Serialize(empty_list));
+    CheckEqual(Serialize(empty), Serialize(empty));
+}
+
+BOOST_AUTO_TEST_CASE(UnorderedContainersTest)
+{
+    SimpleListsStruct obj;
+    obj.m_int8_string = { { 1, "one" }, { 2, "two" }, { 3, "three" } };
+
+    const auto ordered = SerializeMap({ { 1, "one" }, { 2, "two" }, { 3, "three" } });
+    const auto reversed = SerializeMap({ { 3, "three" }, { 2, "two" }, { 1, "one" } });
+
+    CheckEqual(ordered, Serialize(obj));
+    CheckEqual(reversed, Serialize(obj));
+
+    // Keys and values are digested together
+    const auto swapped = SerializeMap({ { 1, "two" }, { 2, "one" }, { 3, "three" } });
+    CheckNotEqual(swapped, Serialize(obj));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
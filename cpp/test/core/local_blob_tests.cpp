@@ -0,0 +1,274 @@
+#include "precompiled.h"
+
+#include <bond/core/local_blob.h>
+#include <bond/stream/local_input_buffer.h>
+
+#include <boost/make_shared.hpp>
+
+#include <array>
+#include <vector>
+
+
+TEST_CASE_BEGIN(LocalBlobBasic)
+{
+    const char data[] = "0123456789";
+
+    bond::local_blob a = bond::local_blob::copy(data, 10);
+    UT_AssertAreEqual(a.size(), 10u);
+    UT_AssertIsTrue(a.content() != data);
+    UT_AssertIsTrue(a == bond::local_blob(data, 10));
+
+    bond::local_blob b = a.range(2, 3);
+    bond::local_blob c = a.range(7);
+    UT_AssertAreEqual(b.size(), 3u);
+    UT_AssertAreEqual(c.size(), 3u);
+    UT_AssertIsTrue(b == bond::local_blob(data + 2, 3));
+    UT_AssertIsTrue(c == bond::local_blob(data + 7, 3));
+    UT_AssertIsTrue(b != c);
+
+    // Ranges keep the memory alive
+    a.clear();
+    UT_AssertIsTrue(a.empty());
+    UT_AssertIsTrue(b == bond::local_blob(data + 2, 3));
+
+    bond::local_blob d;
+    d.assign(c, 1, 2);
+    UT_AssertIsTrue(d == bond::local_blob(data + 8, 2));
+
+    swap(b, d);
+    UT_AssertIsTrue(b == bond::local_blob(data + 8, 2));
+
+    bond::local_blob e = std::move(d);
+    UT_AssertIsTrue(d.empty());
+    UT_AssertAreEqual(e.size(), 3u);
+
+    bond::blob copy = bond::blob_copy(e);
+    UT_AssertIsTrue(copy == bond::blob(data + 2, 3));
+    UT_AssertIsTrue(copy.content() != e.content());
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(LocalBlobFromBlob)
+{
+    const uint32_t size = 32;
+
+    boost::shared_ptr<char[]> data = boost::make_shared<char[]>(size);
+    bond::blob blob(data, size);
+    const long count = data.use_count();
+
+    {
+        bond::local_blob a(blob.range(8));
+        UT_AssertAreEqual(a.content(), blob.content() + 8);
+        UT_AssertAreEqual(a.size(), size - 8);
+
+        // Only the conversion references the blob's memory
+        std::vector<bond::local_blob> copies(10, a);
+        UT_AssertAreEqual(data.use_count(), count + 1);
+
+        blob.clear();
+        UT_AssertAreEqual(copies.back().content(), a.content());
+    }
+
+    UT_AssertAreEqual(data.use_count(), count - 1);
+
+    // Blobs constructed from raw memory don't own it
+    bond::local_blob raw(bond::blob(data.get(), size));
+    UT_AssertAreEqual(raw.content(), static_cast<const char*>(data.get()));
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(LocalBlobOutputBuffers)
+{
+    SimpleStruct obj = InitRandom<SimpleStruct>();
+    obj.m_blob = bond::blob(boost::make_shared<std::array<char, 100> >(), 100);
+
+    // Chain all blobs
+    bond::OutputBuffer stream(1000, 1, std::allocator<char>(), 0);
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(stream);
+
+    Serialize(obj, writer);
+
+    std::vector<bond::blob> buffers;
+    stream.GetBuffers(buffers);
+
+    std::vector<bond::local_blob> local_buffers;
+    stream.GetBuffers(local_buffers);
+
+    UT_AssertAreEqual(buffers.size(), local_buffers.size());
+    UT_AssertIsTrue(buffers.size() > 1);
+
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        UT_AssertAreEqual(buffers[i].content(), local_buffers[i].content());
+        UT_AssertAreEqual(buffers[i].size(), local_buffers[i].size());
+    }
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(LocalBlobSharedBuffers)
+{
+    const uint32_t size = 1000;
+
+    boost::shared_ptr<char[]> data = boost::make_shared<char[]>(size);
+    const bond::blob blob(data, size);
+
+    // Slices of one buffer chained between ranges of the stream's buffer
+    bond::OutputBuffer stream(1000, 16, std::allocator<char>(), 1);
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        stream.Write(i);
+        stream.Write(blob.range(i * 100, 100));
+    }
+
+    const long count = data.use_count();
+
+    std::vector<bond::local_blob> local_buffers;
+    stream.GetBuffers(local_buffers);
+
+    UT_AssertAreEqual(local_buffers.size(), 20u);
+    UT_AssertAreEqual(data.use_count(), count + 1);
+
+    local_buffers.clear();
+    UT_AssertAreEqual(data.use_count(), count);
+
+    // Local blobs sharing memory owned by a boost::shared_ptr are chained,
+    // others are copied
+    bond::OutputBuffer output(1000, 16, std::allocator<char>(), 1);
+    const bond::local_blob shared = bond::local_blob(blob).range(100, 100);
+    const bond::local_blob copied = bond::local_blob::copy(blob.content(), 100);
+
+    output.Write(shared);
+    output.Write(copied);
+
+    std::vector<bond::blob> buffers;
+    output.GetBuffers(buffers);
+
+    UT_AssertAreEqual(buffers.size(), 2u);
+    UT_AssertAreEqual(buffers[0].content(), shared.content());
+    UT_AssertAreEqual(buffers[0].size(), shared.size());
+    UT_AssertIsTrue(bond::local_blob(buffers[1]) == copied);
+    UT_AssertIsTrue(buffers[1].content() != copied.content());
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(LocalInputBufferDeserialization)
+{
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            T from = InitRandom<T>();
+            T to;
+
+            bond::Deserialize(Serialize<Reader, Writer>(from, version), to);
+            UT_Equal(from, to);
+        }
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(LocalInputBufferRanges)
+{
+    NestedStruct from = InitRandom<NestedStruct>();
+
+    Reader reader = Serialize<Reader, Writer>(from, Reader::version);
+
+    const bond::local_blob before = GetCurrentBuffer(reader.GetBuffer());
+    reader.Skip(bond::BT_STRUCT);
+    const bond::local_blob after = GetCurrentBuffer(reader.GetBuffer());
+
+    bond::local_blob range = GetBufferRange(before, after);
+    UT_AssertAreEqual(range.content(), before.content());
+    UT_AssertAreEqual(range.size(), before.size() - after.size());
+
+    typename Reader::Buffer input = CreateInputBuffer(reader.GetBuffer(), range);
+
+    NestedStruct to;
+    bond::Deserialize(Factory<Reader>::Create(input, Reader::version), to);
+    UT_Equal(from, to);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void LocalInputBufferTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        LocalInputBufferDeserialization, Reader, Writer, SimpleStruct>(suite, "Deserialize struct");
+
+    AddTestCase<TEST_ID(N),
+        LocalInputBufferDeserialization, Reader, Writer, NestedStruct>(suite, "Deserialize nested structs");
+
+    AddTestCase<TEST_ID(N),
+        LocalInputBufferDeserialization, Reader, Writer, SimpleListsStruct>(suite, "Deserialize containers");
+}
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void LocalInputBufferRangeTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        LocalInputBufferRanges, Reader, Writer>(suite, "Buffer ranges");
+}
+
+
+void LocalBlobTestsInit()
+{
+    {
+        UnitTestSuite suite("local_blob");
+
+        AddTestCase<TEST_ID(0x2901), LocalBlobBasic>(suite, "local_blob operations");
+        AddTestCase<TEST_ID(0x2901), LocalBlobFromBlob>(suite, "local_blob from blob");
+        AddTestCase<TEST_ID(0x2901), LocalBlobOutputBuffers>(suite, "OutputBuffer local_blobs");
+        AddTestCase<TEST_ID(0x2901), LocalBlobSharedBuffers>(suite, "OutputBuffer shared local_blobs");
+    }
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        LocalInputBufferTests<
+            0x2902,
+            bond::CompactBinaryReader<bond::LocalInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("LocalInputBuffer tests for CompactBinary");
+
+        LocalInputBufferRangeTests<
+            0x2903,
+            bond::CompactBinaryReader<bond::LocalInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("LocalInputBuffer ranges for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        LocalInputBufferTests<
+            0x2904,
+            bond::FastBinaryReader<bond::LocalInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("LocalInputBuffer tests for FastBinary");
+
+        LocalInputBufferRangeTests<
+            0x2905,
+            bond::FastBinaryReader<bond::LocalInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("LocalInputBuffer ranges for FastBinary");
+    );
+
+    TEST_SIMPLE_PROTOCOL(
+        LocalInputBufferTests<
+            0x2906,
+            bond::SimpleBinaryReader<bond::LocalInputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("LocalInputBuffer tests for SimpleBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    LocalBlobTestsInit();
+    return true;
+}
@@ -1,6 +1,8 @@
 #include "precompiled.h"
 #include "metadata_tests.h"
 
+#include <bond/core/tuple.h>
+
 #include <boost/format.hpp>
 
 class DefaultValueVerifier
@@ -280,6 +282,139 @@ TEST_CASE_BEGIN(EnsureUnknownSeqIDLType)
 }
 TEST_CASE_END
 
+struct LazyMetadataAsserter
+{
+    template <typename Field>
+    void operator()(const Field&)
+    {
+        UT_AssertIsTrue(&Field::GetMetadata() == &Field::GetMetadata());
+        UT_AssertIsTrue(&Field::metadata == &Field::GetMetadata());
+    }
+};
+
+template <typename T>
+void LazyMetadata(const std::string& name)
+{
+    typedef typename bond::schema<T>::type Schema;
+
+    // Metadata is constructed on first use and the static data members refer
+    // to the same objects as returned by GetMetadata()
+    UT_AssertIsTrue(&Schema::GetMetadata() == &Schema::GetMetadata());
+    UT_AssertIsTrue(&Schema::metadata == &Schema::GetMetadata());
+    UT_AssertAreEqual(Schema::GetMetadata().name, name);
+
+    boost::mpl::for_each<typename Schema::fields>(LazyMetadataAsserter());
+}
+
+TEST_CASE_BEGIN(LazyMetadataTests)
+{
+    LazyMetadata<StructWithDefaults>("StructWithDefaults");
+    LazyMetadata<BondStruct<int32_t> >("BondStruct<int32>");
+    LazyMetadata<std::tuple<int32_t, std::string> >("tuple<int32, string>");
+}
+TEST_CASE_END
+
+// Compile-time schema in the form generated by older versions of gbc, with
+// metadata in static objects
+struct StaticMetadataStruct
+{
+    int32_t n;
+    std::string s;
+
+    StaticMetadataStruct()
+        : n(7),
+          s()
+    {}
+
+    struct Schema;
+};
+
+struct StaticMetadataStruct::Schema
+{
+    typedef bond::no_base base;
+
+    static const bond::Metadata metadata;
+
+    private: static const bond::Metadata s_n_metadata;
+    private: static const bond::Metadata s_s_metadata;
+
+    public: struct var
+    {
+        typedef struct n_type : bond::reflection::FieldTemplate<
+            0,
+            bond::reflection::optional_field_modifier,
+            StaticMetadataStruct,
+            int32_t,
+            &StaticMetadataStruct::n,
+            &s_n_metadata
+        > {} n;
+
+        typedef struct s_type : bond::reflection::FieldTemplate<
+            1,
+            bond::reflection::required_field_modifier,
+            StaticMetadataStruct,
+            std::string,
+            &StaticMetadataStruct::s,
+            &s_s_metadata
+        > {} s;
+    };
+
+    public: typedef boost::mpl::list<var::n, var::s>::type fields;
+
+    static bond::Metadata GetMetadata()
+    {
+        return bond::reflection::MetadataInit("StaticMetadataStruct", "unittest.StaticMetadataStruct",
+            bond::reflection::Attributes()
+        );
+    }
+};
+
+const bond::Metadata StaticMetadataStruct::Schema::metadata
+    = StaticMetadataStruct::Schema::GetMetadata();
+
+const bond::Metadata StaticMetadataStruct::Schema::s_n_metadata
+    = bond::reflection::MetadataInit(static_cast<int32_t>(7), "n");
+
+const bond::Metadata StaticMetadataStruct::Schema::s_s_metadata
+    = bond::reflection::MetadataInit("s", bond::reflection::required_field_modifier::value,
+        bond::reflection::Attributes());
+
+TEST_CASE_BEGIN(StaticMetadataTests)
+{
+    typedef StaticMetadataStruct::Schema Schema;
+
+    UT_AssertIsTrue(&bond::schema_metadata<Schema>() == &Schema::metadata);
+    UT_AssertIsTrue(&Schema::var::n::GetMetadata() == &Schema::var::n::metadata);
+    UT_AssertIsTrue(Schema::var::s::GetMetadata().modifier == bond::Required);
+    UT_AssertIsTrue((std::is_base_of<
+        bond::reflection::FieldTemplateBase<1, bond::reflection::required_field_modifier,
+            StaticMetadataStruct, std::string, &StaticMetadataStruct::s>,
+        Schema::var::s>::value));
+
+    bond::RuntimeSchema schema = bond::GetRuntimeSchema<StaticMetadataStruct>();
+
+    UT_AssertAreEqual(schema.GetStruct().metadata.qualified_name, "unittest.StaticMetadataStruct");
+    UT_AssertAreEqual(schema.GetStruct().fields[0].metadata.default_value.int_value, 7);
+
+    StaticMetadataStruct from;
+    from.n = 3;
+    from.s = "three";
+
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output);
+
+    bond::Serialize(from, writer);
+
+    StaticMetadataStruct to;
+    bond::CompactBinaryReader<bond::InputBuffer> reader(output.GetBuffer());
+
+    bond::Deserialize(reader, to);
+
+    UT_AssertIsTrue(to.n == from.n);
+    UT_AssertIsTrue(to.s == from.s);
+}
+TEST_CASE_END
+
 void MetadataTest::Initialize()
 {
     UnitTestSuite suite("Metadata tests");
@@ -293,6 +428,12 @@ void MetadataTest::Initialize()
     AddTestCase<TEST_ID(0x2201), EnsureUnknownSeqIDLType>
         (suite, "Ensure Unknown SeqIDLType");
 
+    AddTestCase<TEST_ID(0x2201), LazyMetadataTests>
+        (suite, "Lazily constructed metadata");
+
+    AddTestCase<TEST_ID(0x2201), StaticMetadataTests>
+        (suite, "Metadata in static objects");
+
     TEST_SIMPLE_PROTOCOL(
         AddTestCase<TEST_ID(0x2201), RuntimeMetadataTests>
             (suite, "Runtime metadata test");
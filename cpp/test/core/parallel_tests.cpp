@@ -0,0 +1,243 @@
+#include "precompiled.h"
+
+#include <bond/core/parallel.h>
+
+#include <thread>
+
+
+// Runs each task on the calling thread
+struct InlineExecutor
+{
+    void operator()(const std::function<void()>& task) const
+    {
+        task();
+    }
+};
+
+
+// Runs each task on a new thread
+struct ThreadExecutor
+{
+    void operator()(const std::function<void()>& task) const
+    {
+        std::thread(task).detach();
+    }
+};
+
+
+template <typename Writer, typename T, typename Executor>
+bond::blob SerializeParallel(const T& obj, const Executor& executor, const bond::parallel_options& options, uint16_t version)
+{
+    typename Writer::Buffer output_buffer;
+
+    Factory<Writer>::Call(output_buffer, version, boost::bind(
+        bond::SerializeParallel<bond::BuiltInProtocols, T, Writer, Executor>,
+        boost::cref(obj), boost::placeholders::_1, boost::cref(executor), boost::cref(options)));
+
+    return output_buffer.GetBuffer();
+}
+
+
+template <typename Writer, typename T, typename Executor>
+void ParallelSerializing(const T& from, const Executor& executor, uint16_t version)
+{
+    typename Writer::Buffer output_buffer;
+
+    Factory<Writer>::Call(output_buffer, version, boost::bind(
+        bond::Serialize<bond::BuiltInProtocols, T, Writer>, boost::cref(from), boost::placeholders::_1));
+
+    const bond::blob expected = output_buffer.GetBuffer();
+
+    // The output is identical to serial serialization
+    UT_AssertIsTrue(expected == SerializeParallel<Writer>(from, executor, bond::parallel_options(1, 3), version));
+    UT_AssertIsTrue(expected == SerializeParallel<Writer>(from, executor, bond::parallel_options(1, 1000), version));
+    UT_AssertIsTrue(expected == SerializeParallel<Writer>(from, executor, bond::parallel_options(), version));
+}
+
+
+template <typename Reader, typename Writer, typename T, typename Executor>
+void ParallelDeserializing(const T& from, const Executor& executor, uint16_t version)
+{
+    Reader reader = Serialize<Reader, Writer>(from, version);
+
+    T to;
+    bond::DeserializeParallel(reader, to, executor, bond::parallel_options(1, 3));
+
+    UT_Equal(from, to);
+
+    // large chunks, deserialized on the calling thread
+    T to2;
+    bond::DeserializeParallel(reader, to2, executor, bond::parallel_options(1, 1000));
+
+    UT_Equal(from, to2);
+
+    // below the threshold, deserialized serially
+    T to3;
+    bond::DeserializeParallel(reader, to3, executor, bond::parallel_options());
+
+    UT_Equal(from, to3);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(ParallelDeserializingRandom)
+{
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        ParallelDeserializing<Reader, Writer>(T(), InlineExecutor(), version);
+
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            ParallelDeserializing<Reader, Writer>(InitRandom<T>(), InlineExecutor(), version);
+            ParallelDeserializing<Reader, Writer>(InitRandom<T>(), ThreadExecutor(), version);
+        }
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(ParallelSerializingRandom)
+{
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        ParallelSerializing<Writer>(T(), InlineExecutor(), version);
+
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            ParallelSerializing<Writer>(InitRandom<T>(), InlineExecutor(), version);
+            ParallelSerializing<Writer>(InitRandom<T>(), ThreadExecutor(), version);
+        }
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ParallelRoundtrip)
+{
+    NestedStructVectors from;
+
+    from.v.resize(100, InitRandom<NestedStruct>());
+    from.nested.v.resize(50, InitRandom<SimpleStruct>());
+    from.StructVector::v.resize(20, InitRandom<SimpleStruct>());
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        typename Reader::Buffer input_buffer(
+            SerializeParallel<Writer>(from, ThreadExecutor(), bond::parallel_options(1, 7), version));
+
+        NestedStructVectors to;
+        bond::DeserializeParallel(Factory<Reader>::Create(input_buffer, version), to, ThreadExecutor(), bond::parallel_options(1, 7));
+
+        UT_Equal(from, to);
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ParallelDeserializingErrors)
+{
+    NestedStructVectors from;
+    from.v.resize(10, InitRandom<NestedStruct>());
+
+    typename Writer::Buffer output_buffer(4096);
+    Factory<Writer>::Call(output_buffer, Reader::version, boost::bind(
+        bond::Serialize<bond::BuiltInProtocols, NestedStructVectors, Writer>, from, boost::placeholders::_1));
+
+    bond::blob data = output_buffer.GetBuffer();
+    typename Reader::Buffer truncated(data.range(0, data.length() / 2));
+
+    NestedStructVectors to;
+    UT_AssertThrows(
+        bond::DeserializeParallel(Factory<Reader>::Create(truncated, Reader::version), to, ThreadExecutor(), bond::parallel_options(1, 1)),
+        bond::Exception);
+}
+TEST_CASE_END
+
+
+// Readers over stream buffers can't be copied to read chunks concurrently, so
+// they deserialize serially
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ParallelDeserializingStream)
+{
+    BOOST_STATIC_ASSERT(!bond::is_random_access_buffer<typename Reader::Buffer>::value);
+
+    StructVector from;
+    from.v.resize(100, InitRandom<SimpleStruct>());
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        typename Reader::Buffer input_buffer(
+            SerializeParallel<Writer>(from, InlineExecutor(), bond::parallel_options(), version));
+
+        StructVector to;
+        bond::DeserializeParallel(Factory<Reader>::Create(input_buffer, version), to, ThreadExecutor(), bond::parallel_options(1, 7));
+
+        UT_Equal(from, to);
+    }
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename StreamReader, typename Writer>
+void ParallelTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        ParallelDeserializingRandom, Reader, Writer, StructVector>(suite, "Parallel deserialization of vector");
+
+    AddTestCase<TEST_ID(N),
+        ParallelDeserializingRandom, Reader, Writer, NestedStructVectors>(suite, "Parallel deserialization of nested vectors");
+
+    AddTestCase<TEST_ID(N),
+        ParallelSerializingRandom, Reader, Writer, StructVector>(suite, "Parallel serialization of vector");
+
+    AddTestCase<TEST_ID(N),
+        ParallelSerializingRandom, Reader, Writer, NestedStructVectors>(suite, "Parallel serialization of nested vectors");
+
+    AddTestCase<TEST_ID(N),
+        ParallelRoundtrip, Reader, Writer>(suite, "Parallel serialization roundtrip");
+
+    AddTestCase<TEST_ID(N),
+        ParallelDeserializingErrors, Reader, Writer>(suite, "Parallel deserialization errors");
+
+    AddTestCase<TEST_ID(N),
+        ParallelDeserializingStream, StreamReader, Writer>(suite, "Parallel deserialization from a stream");
+}
+
+
+void ParallelTestsInit()
+{
+    TEST_COMPACT_BINARY_PROTOCOL(
+        ParallelTests<
+            0x2601,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryReader<StreamInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Parallel (de)serialization tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        ParallelTests<
+            0x2602,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryReader<StreamInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Parallel (de)serialization tests for FastBinary");
+    );
+
+    TEST_SIMPLE_PROTOCOL(
+        ParallelTests<
+            0x2603,
+            bond::SimpleBinaryReader<bond::InputBuffer>,
+            bond::SimpleBinaryReader<StreamInputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("Parallel (de)serialization tests for SimpleBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    ParallelTestsInit();
+    return true;
+}
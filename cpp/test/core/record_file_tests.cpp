@@ -0,0 +1,348 @@
+#include "precompiled.h"
+
+#include <bond/ext/mapped_file.h>
+#include <bond/ext/record_file.h>
+#include <bond/stream/stdio_output_stream.h>
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+
+template <typename T>
+std::vector<T> RandomRecords(size_t count)
+{
+    std::vector<T> records(count);
+
+    for (auto& record : records)
+        record = InitRandom<T>();
+
+    return records;
+}
+
+
+template <typename T>
+bond::blob WriteRecordFile(const std::vector<T>& records, const bond::ext::record_file_options& options, bool close = true)
+{
+    bond::OutputBuffer output;
+    bond::ext::record_file_writer<T, bond::OutputBuffer> writer(output, options);
+
+    for (const auto& record : records)
+        writer.Write(record);
+
+    UT_AssertIsTrue(records.size() == writer.record_count());
+
+    if (close)
+        writer.Close();
+    else
+        writer.Flush();
+
+    return output.GetBuffer();
+}
+
+
+template <typename T>
+void ReadingRecordFile(const bond::ext::record_file_reader<T>& reader, const std::vector<T>& records)
+{
+    UT_AssertIsTrue(records.size() == reader.record_count());
+
+    // sequential scan
+    std::vector<T> scanned;
+
+    reader.Scan([&scanned](uint64_t index, T& record)
+    {
+        UT_AssertIsTrue(index == scanned.size());
+        scanned.push_back(record);
+    });
+
+    UT_Equal(records, scanned);
+
+    // random access, in reverse order
+    for (size_t i = records.size(); i-- > 0;)
+    {
+        T record;
+        reader.Read(i, record);
+        UT_Equal(records[i], record);
+    }
+}
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileRoundtrip)
+{
+    for (size_t count : { 0, 1, 10, 200 })
+    {
+        const std::vector<T> records = RandomRecords<T>(count);
+
+        for (uint16_t version : { bond::v1, bond::v2 })
+        {
+            for (uint32_t block_size : { 1u, 500u, 1024u * 1024u })
+            {
+                bond::ext::record_file_options options(block_size, version);
+                bond::ext::record_file_reader<T> reader(WriteRecordFile(records, options));
+
+                UT_AssertIsTrue(reader.has_index());
+                UT_AssertIsTrue(reader.schema().structs[reader.schema().root.struct_def].metadata.qualified_name
+                    == bond::schema<T>::type::metadata.qualified_name);
+
+                if (block_size == 1)
+                    UT_AssertIsTrue(count == reader.block_count());
+
+                ReadingRecordFile(reader, records);
+            }
+        }
+    }
+}
+TEST_CASE_END
+
+
+// Runs each task on a new thread
+struct ThreadExecutor
+{
+    void operator()(const std::function<void()>& task) const
+    {
+        std::thread(task).detach();
+    }
+};
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileParallelScan)
+{
+    const std::vector<T> records = RandomRecords<T>(100);
+
+    bond::ext::record_file_reader<T> reader(WriteRecordFile(records, bond::ext::record_file_options(1000)));
+
+    UT_AssertIsTrue(reader.block_count() > 1);
+
+    std::mutex lock;
+    std::vector<T> scanned(records.size());
+    std::vector<bool> visited(records.size());
+
+    reader.ScanParallel([&](uint64_t index, T& record)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        UT_AssertIsFalse(visited[index]);
+        visited[index] = true;
+        scanned[index] = record;
+    }, ThreadExecutor());
+
+    UT_Equal(records, scanned);
+}
+TEST_CASE_END
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileScanFields)
+{
+    const std::vector<T> records = RandomRecords<T>(100);
+
+    bond::ext::record_file_reader<T> reader(WriteRecordFile(records, bond::ext::record_file_options(1000)));
+
+    UT_AssertIsTrue(reader.block_count() > 1);
+
+    uint64_t count = 0;
+
+    reader.template ScanFields<typename T::Schema::var::m_str, typename T::Schema::var::m_uint64>(
+        [&](uint64_t index, const std::string& m_str, uint64_t m_uint64)
+    {
+        UT_AssertIsTrue(index == count++);
+        UT_AssertIsTrue(m_str == records[index].m_str);
+        UT_AssertIsTrue(m_uint64 == records[index].m_uint64);
+    });
+
+    UT_AssertIsTrue(count == records.size());
+}
+TEST_CASE_END
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileFilter)
+{
+    const std::vector<T> records = RandomRecords<T>(100);
+
+    bond::ext::record_file_reader<T> reader(WriteRecordFile(records, bond::ext::record_file_options(1000)));
+
+    const uint8_t max = records[0].m_uint8;
+    bond::record_filter filter;
+    filter.Range(bond::FilterField<typename T::Schema::var::m_uint8>(), uint8_t(0), max);
+
+    std::vector<uint64_t> matching;
+
+    const uint64_t count = reader.Filter(filter, [&](uint64_t index, const bond::blob& record)
+    {
+        T to;
+        bond::Deserialize(bond::CompactBinaryReader<bond::InputBuffer>(record, reader.protocol_version()), to);
+
+        UT_Equal(to, records[index]);
+        matching.push_back(index);
+    });
+
+    std::vector<uint64_t> expected;
+
+    for (uint64_t i = 0; i < records.size(); ++i)
+    {
+        if (records[i].m_uint8 <= max)
+            expected.push_back(i);
+    }
+
+    UT_AssertIsTrue(count == matching.size());
+    UT_AssertIsTrue(matching == expected);
+}
+TEST_CASE_END
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileRecovery)
+{
+    const std::vector<T> records = RandomRecords<T>(50);
+    const bond::ext::record_file_options options(1000);
+
+    // The file without the index is readable up to the last complete block
+    bond::ext::record_file_reader<T> reader(WriteRecordFile(records, options, false));
+
+    UT_AssertIsFalse(reader.has_index());
+    ReadingRecordFile(reader, records);
+
+    // Truncated file
+    const bond::blob data = WriteRecordFile(records, options, false);
+    bond::ext::record_file_reader<T> truncated(data.range(0, data.size() - 1));
+
+    UT_AssertIsFalse(truncated.has_index());
+    UT_AssertIsTrue(truncated.block_count() == reader.block_count() - 1);
+    UT_AssertIsTrue(truncated.record_count() < records.size());
+
+    std::vector<T> prefix(records.begin(), records.begin() + static_cast<ptrdiff_t>(truncated.record_count()));
+    ReadingRecordFile(truncated, prefix);
+}
+TEST_CASE_END
+
+
+// Copy of the file with value written at the offset
+template <typename V>
+bond::blob PatchRecordFile(const bond::blob& data, uint64_t offset, V value)
+{
+    boost::shared_ptr<char[]> copy = boost::make_shared_noinit<char[]>(data.size());
+    std::memcpy(copy.get(), data.content(), data.size());
+    std::memcpy(copy.get() + offset, &value, sizeof(value));
+    return bond::blob(copy, data.size());
+}
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileErrors)
+{
+    const std::vector<T> records = RandomRecords<T>(10);
+    const bond::blob data = WriteRecordFile(records, bond::ext::record_file_options(1));
+
+    // Not a record file
+    UT_AssertThrows(bond::ext::record_file_reader<T>(data.range(1)), bond::StreamException);
+    UT_AssertThrows(bond::ext::record_file_reader<T>(bond::blob()), bond::StreamException);
+
+    // Protocol version 0
+    UT_AssertThrows(bond::ext::record_file_reader<T>(PatchRecordFile(data, 8, uint16_t(0))), bond::StreamException);
+
+    // Record out of range
+    bond::ext::record_file_reader<T> reader(data);
+    T record;
+    UT_AssertThrows(reader.Read(records.size(), record), bond::CoreException);
+
+    // Corrupted sync marker of the first block
+    const uint32_t first_block = bond::ext::detail::record_file_header_size;
+    const char marker = data.content()[first_block];
+
+    bond::ext::record_file_reader<T> corrupted(PatchRecordFile(data, first_block, static_cast<char>(marker ^ 1)));
+    UT_AssertThrows(corrupted.Read(0, record), bond::StreamException);
+
+    // Corrupted index: block count larger than the index, blocks not starting
+    // at record 0 and blocks out of order
+    uint64_t index;
+    std::memcpy(&index, data.content() + data.size() - bond::ext::detail::record_file_trailer_size, sizeof(index));
+
+    const uint64_t first_entry = index + sizeof(uint32_t);
+    const uint64_t second_entry = first_entry + bond::ext::detail::record_file_index_entry_size;
+    uint64_t second_offset;
+    std::memcpy(&second_offset, data.content() + second_entry, sizeof(second_offset));
+
+    UT_AssertThrows(bond::ext::record_file_reader<T>(PatchRecordFile(data, index, uint32_t(0x10000000))),
+        bond::StreamException);
+    UT_AssertThrows(bond::ext::record_file_reader<T>(PatchRecordFile(data, first_entry + 8, uint64_t(1))),
+        bond::StreamException);
+    UT_AssertThrows(bond::ext::record_file_reader<T>(PatchRecordFile(data, first_entry, second_offset)),
+        bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <typename T>
+TEST_CASE_BEGIN(RecordFileMapped)
+{
+    const std::vector<T> records = RandomRecords<T>(100);
+    const char* path = "record_file_tests.tmp";
+
+    {
+        FILE* file = fopen(path, "wb");
+        UT_AssertIsTrue(file != NULL);
+
+        bond::StdioOutputStream output(file);
+        bond::ext::record_file_writer<T, bond::StdioOutputStream> writer(output, bond::ext::record_file_options(1000));
+
+        for (const auto& record : records)
+            writer.Write(record);
+
+        writer.Close();
+        fclose(file);
+    }
+
+    {
+        bond::ext::mapped_file file(path);
+        bond::ext::record_file_reader<T> reader(file.data(), file.size());
+
+        UT_AssertIsTrue(reader.has_index());
+        ReadingRecordFile(reader, records);
+    }
+
+    remove(path);
+
+    UT_AssertThrows(bond::ext::mapped_file("record_file_tests.missing"), bond::StreamException);
+}
+TEST_CASE_END
+
+
+void RecordFileTestsInit()
+{
+    TEST_COMPACT_BINARY_PROTOCOL(
+        UnitTestSuite suite("Record file tests");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileRoundtrip, SimpleStruct>(suite, "Roundtrip simple struct");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileRoundtrip, NestedWithBase>(suite, "Roundtrip struct with base");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileParallelScan, NestedStruct>(suite, "Parallel scan");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileScanFields, SimpleStruct>(suite, "Scan selected fields");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileFilter, SimpleStruct>(suite, "Filter records");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileRecovery, NestedStruct>(suite, "Reading file without index");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileErrors, SimpleStruct>(suite, "Invalid files");
+
+        AddTestCase<TEST_ID(0x2701),
+            RecordFileMapped, NestedStruct>(suite, "Memory-mapped file");
+    );
+}
+
+bool init_unit_test()
+{
+    RecordFileTestsInit();
+    return true;
+}
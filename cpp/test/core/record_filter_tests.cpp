@@ -0,0 +1,261 @@
+#include "precompiled.h"
+
+#include <bond/core/record_filter.h>
+#include <bond/protocol/fast_binary.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace
+{
+
+typedef StructWithBase::Schema::var Derived;
+typedef SimpleBase::Schema::var Base;
+typedef SimpleStruct::Schema::var Simple;
+
+template <typename Writer, typename T>
+bond::blob Serialize(const T& obj)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+// Checks that the filter matches exactly the records for which the predicate
+// is true, and that the offsets and blobs reported for them are correct
+template <typename Reader, typename Writer, typename T>
+void CheckFilter(const std::vector<T>& records,
+                 const bond::record_filter& filter,
+                 const std::function<bool (const T&)>& predicate)
+{
+    bond::OutputBuffer output;
+    std::vector<uint32_t> offsets;
+    std::vector<std::size_t> expected;
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        const bond::blob data = Serialize<Writer>(records[i]);
+
+        offsets.push_back(output.GetBuffer().size());
+        output.Write(data);
+
+        if (predicate(records[i]))
+            expected.push_back(i);
+    }
+
+    Reader reader(output.GetBuffer());
+    std::vector<std::size_t> matching;
+
+    const std::size_t count = filter.Filter(reader, [&](uint32_t offset, const bond::blob& record)
+    {
+        const auto it = std::find(offsets.begin(), offsets.end(), offset);
+        BOOST_REQUIRE(it != offsets.end());
+
+        const std::size_t index = it - offsets.begin();
+        matching.push_back(index);
+
+        T to;
+        bond::Deserialize(Reader(record), to);
+        BOOST_CHECK(Equal(to, records[index]));
+    });
+
+    BOOST_CHECK(reader.GetBuffer().IsEof());
+    BOOST_CHECK_EQUAL(count, matching.size());
+    BOOST_CHECK(matching == expected);
+
+    // Evaluating each payload on its own gives the same result
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(filter.MatchesPayload(Reader(Serialize<Writer>(records[i]))), predicate(records[i]));
+    }
+}
+
+template <typename T>
+std::vector<T> RandomRecords(std::size_t count)
+{
+    std::vector<T> records(count);
+
+    for (auto& record : records)
+        record = InitRandom<T>();
+
+    return records;
+}
+
+template <typename Reader, typename Writer>
+void CheckPredicates()
+{
+    std::vector<SimpleStruct> records = RandomRecords<SimpleStruct>(20);
+
+    records[3].m_uint64 = records[7].m_uint64;
+    records[5].m_str = records[9].m_str + "suffix";
+    records[11].m_int16 = -5;
+
+    {
+        bond::record_filter filter;
+        filter.Equal(bond::FilterField<Simple::m_uint64>(), records[7].m_uint64);
+
+        const uint64_t value = records[7].m_uint64;
+        CheckFilter<Reader, Writer, SimpleStruct>(records, filter,
+            [value](const SimpleStruct& obj) { return obj.m_uint64 == value; });
+    }
+
+    {
+        // Operands of other numeric types are compared by value
+        bond::record_filter filter;
+        filter.Range(bond::FilterField<Simple::m_int16>(), -10, 1000);
+
+        CheckFilter<Reader, Writer, SimpleStruct>(records, filter,
+            [](const SimpleStruct& obj) { return obj.m_int16 >= -10 && obj.m_int16 <= 1000; });
+    }
+
+    {
+        bond::record_filter filter;
+        filter.In(bond::FilterField<Simple::m_uint8>(), std::vector<int>{ records[1].m_uint8, 300, records[4].m_uint8, -1 });
+
+        const uint8_t a = records[1].m_uint8;
+        const uint8_t b = records[4].m_uint8;
+        CheckFilter<Reader, Writer, SimpleStruct>(records, filter,
+            [a, b](const SimpleStruct& obj) { return obj.m_uint8 == a || obj.m_uint8 == b; });
+    }
+
+    {
+        bond::record_filter filter;
+        filter.Prefix(bond::FilterField<Simple::m_str>(), records[9].m_str);
+
+        const std::string prefix = records[9].m_str;
+        CheckFilter<Reader, Writer, SimpleStruct>(records, filter,
+            [prefix](const SimpleStruct& obj) { return obj.m_str.compare(0, prefix.size(), prefix) == 0; });
+    }
+
+    {
+        // All predicates must be true
+        bond::record_filter filter;
+        filter.Range(bond::FilterField<Simple::m_double>(), 0.0, 1e300)
+              .Equal(bond::FilterField<Simple::m_bool>(), true)
+              .In(bond::FilterField<Simple::m_str>(), std::vector<std::string>{ records[2].m_str, records[6].m_str });
+
+        const std::string a = records[2].m_str;
+        const std::string b = records[6].m_str;
+        CheckFilter<Reader, Writer, SimpleStruct>(records, filter,
+            [a, b](const SimpleStruct& obj)
+            {
+                return obj.m_double >= 0 && obj.m_double <= 1e300 && obj.m_bool && (obj.m_str == a || obj.m_str == b);
+            });
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(RecordFilterTests)
+
+BOOST_AUTO_TEST_CASE(PredicatesTest)
+{
+    CheckPredicates<bond::CompactBinaryReader<bond::InputBuffer>, bond::CompactBinaryWriter<bond::OutputBuffer> >();
+    CheckPredicates<bond::FastBinaryReader<bond::InputBuffer>, bond::FastBinaryWriter<bond::OutputBuffer> >();
+}
+
+BOOST_AUTO_TEST_CASE(BaseFieldsTest)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+
+    std::vector<StructWithBase> records = RandomRecords<StructWithBase>(10);
+    records[2].SimpleBase::m_int32 = records[5].SimpleBase::m_int32;
+
+    const int32_t value = records[5].SimpleBase::m_int32;
+    const bond::RuntimeSchema schema = bond::GetRuntimeSchema<StructWithBase>();
+
+    // Fields of bases with the same id as fields of the derived struct
+    bond::record_filter filter;
+    filter.Equal(bond::FilterField<Base::m_int32>(), value);
+
+    CheckFilter<Reader, Writer, StructWithBase>(records, filter,
+        [value](const StructWithBase& obj) { return obj.SimpleBase::m_int32 == value; });
+
+    const bond::filter_field derived = bond::FilterField<Derived::m_int32>();
+    const bond::filter_field base = bond::FilterField<Base::m_int32>();
+    const bond::filter_field simple = bond::FilterField<Simple::m_int32>();
+
+    BOOST_CHECK_EQUAL(derived.depth, 2);
+    BOOST_CHECK_EQUAL(base.depth, 1);
+    BOOST_CHECK_EQUAL(simple.depth, 0);
+
+    // Fields from runtime schema are found in the most derived struct first
+    const bond::filter_field runtime = bond::FilterField(schema, "m_int32");
+    BOOST_CHECK_EQUAL(runtime.depth, derived.depth);
+    BOOST_CHECK_EQUAL(runtime.id, derived.id);
+    BOOST_CHECK_EQUAL(runtime.type, derived.type);
+
+    bond::record_filter runtime_filter;
+    runtime_filter.Prefix(bond::FilterField(schema, "m_str"), records[4].m_str)
+                  .Range(bond::FilterField(schema, "m_uint64"), uint64_t(0), records[4].m_uint64);
+
+    const std::string prefix = records[4].m_str;
+    const uint64_t max = records[4].m_uint64;
+    CheckFilter<Reader, Writer, StructWithBase>(records, runtime_filter,
+        [prefix, max](const StructWithBase& obj)
+        {
+            return obj.StructWithBase::m_str.compare(0, prefix.size(), prefix) == 0 && obj.m_uint64 <= max;
+        });
+}
+
+BOOST_AUTO_TEST_CASE(DefaultsTest)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+    typedef FieldHeaders::Schema::var Fields;
+
+    // Optional fields equal to their defaults are omitted from Compact
+    // Binary payloads and have the defaults from the schema
+    std::vector<FieldHeaders> records(3);
+    records[1].wide = 42;
+    records[2].absent.emplace(5u);
+
+    bond::record_filter filter;
+    filter.Equal(bond::FilterField<Fields::wide>(), 7);
+
+    CheckFilter<Reader, Writer, FieldHeaders>(records, filter,
+        [](const FieldHeaders& obj) { return obj.wide == 7; });
+
+    // Fields with default of nothing don't match any predicate when omitted
+    bond::record_filter absent;
+    absent.Range(bond::FilterField<Fields::absent>(), 0, 10);
+
+    CheckFilter<Reader, Writer, FieldHeaders>(records, absent,
+        [](const FieldHeaders& obj) { return !obj.absent.is_nothing(); });
+}
+
+BOOST_AUTO_TEST_CASE(InvalidFiltersTest)
+{
+    bond::record_filter filter;
+
+    BOOST_CHECK_THROW(filter.Prefix(bond::FilterField<Simple::m_int32>(), "1"), bond::CoreException);
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_int32>(), "1"), bond::CoreException);
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_str>(), 1), bond::CoreException);
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_wstr>(), 1), bond::CoreException);
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_blob>(), 1), bond::CoreException);
+    BOOST_CHECK_THROW(bond::FilterField(bond::GetRuntimeSchema<SimpleStruct>(), "missing"), bond::CoreException);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_double>(), nan), bond::CoreException);
+    BOOST_CHECK_THROW(filter.Range(bond::FilterField<Simple::m_double>(), 0.0, nan), bond::CoreException);
+    BOOST_CHECK_THROW(filter.In(bond::FilterField<Simple::m_double>(), std::vector<double>{ 1.0, nan, 0.0 }),
+        bond::CoreException);
+
+    for (std::size_t i = 0; i < bond::record_filter::max_predicates; ++i)
+        filter.Equal(bond::FilterField<Simple::m_int32>(), 1);
+
+    BOOST_CHECK_THROW(filter.Equal(bond::FilterField<Simple::m_int32>(), 1), bond::CoreException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
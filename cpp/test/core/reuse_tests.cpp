@@ -0,0 +1,385 @@
+#include "precompiled.h"
+
+#include <bond/core/reuse.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+// Count allocations made by the test to verify that deserialization into a
+// reused object doesn't allocate once the object has been warmed up.
+namespace
+{
+    std::atomic<size_t> allocations(0);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+    // GCC pairs the inlined replacement operators with the malloc/free calls
+    // in them and reports them as mismatched
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) BOND_NOEXCEPT
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) BOND_NOEXCEPT
+{
+    std::free(ptr);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void Reusing(T& to, const T& from, uint16_t version)
+{
+    Reader reader = Serialize<Reader, Writer>(from, version);
+
+    bond::DeserializeReuse(reader, to);
+
+    UT_Equal(from, to);
+}
+
+
+template <typename Reader, typename Writer, typename T, typename View>
+void ReusingView(T& to, const View& from, uint16_t version)
+{
+    Reader reader = Serialize<Reader, Writer>(from, version);
+
+    T expected;
+    bond::Deserialize(reader, expected);
+
+    bond::DeserializeReuse(reader, to);
+
+    UT_Equal(expected, to);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(ReuseRandom)
+{
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        T to;
+
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            Reusing<Reader, Writer>(to, InitRandom<T>(), version);
+            Reusing<Reader, Writer>(to, T(), version);
+            Reusing<Reader, Writer>(to, InitRandom<T>(), version);
+        }
+    }
+}
+TEST_CASE_END
+
+
+// Fields which are not in the payload are reset to default values
+template <typename Reader, typename Writer, typename T, typename View>
+TEST_CASE_BEGIN(ReuseOmittedFields)
+{
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        T to;
+
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            Reusing<Reader, Writer>(to, InitRandom<T>(), version);
+            ReusingView<Reader, Writer>(to, InitRandom<View>(), version);
+        }
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ReuseContainers)
+{
+    SimpleListsStruct from;
+    SimpleListsStruct to;
+
+    from.v_string.assign(5, std::string(100, 'v'));
+    from.s_string.insert("b");
+    from.s_string.insert("d");
+    from.m_int8_string[1] = "one";
+    from.m_int8_string[3] = "three";
+    Reusing<Reader, Writer>(to, from, Reader::version);
+
+    // Fewer elements
+    from.v_string.resize(2);
+    from.s_string.erase("b");
+    from.m_int8_string.erase(3);
+    Reusing<Reader, Writer>(to, from, Reader::version);
+
+    // New keys before, between and after the existing ones
+    from.v_string.resize(7, "x");
+    from.s_string.insert("a");
+    from.s_string.insert("c");
+    from.s_string.insert("e");
+    from.m_int8_string[0] = "zero";
+    from.m_int8_string[2] = "two";
+    from.m_int8_string[4] = "four";
+    Reusing<Reader, Writer>(to, from, Reader::version);
+
+    // Different keys
+    from.s_string.clear();
+    from.s_string.insert("f");
+    from.m_int8_string.clear();
+    from.m_int8_string[-1] = "minus one";
+    from.m_int8_string[5] = "five";
+    Reusing<Reader, Writer>(to, from, Reader::version);
+
+    from = SimpleListsStruct();
+    Reusing<Reader, Writer>(to, from, Reader::version);
+}
+TEST_CASE_END
+
+
+// Readers over stream buffers can't be rewound when the element types of a
+// container don't match, so containers are deserialized the regular way
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ReuseStream)
+{
+    BOOST_STATIC_ASSERT(!bond::is_random_access_buffer<typename Reader::Buffer>::value);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        NestedListsStruct to;
+
+        for (uint32_t i = 0; i < c_iterations; ++i)
+        {
+            Reusing<Reader, Writer>(to, InitRandom<NestedListsStruct>(), version);
+
+            // Fields of SimpleListsStruct have the ids of containers of
+            // different types in NestedListsStruct
+            const SimpleListsStruct from = InitRandom<SimpleListsStruct>();
+
+            NestedListsStruct expected;
+            bond::Deserialize(Serialize<Reader, Writer>(from, version), expected);
+
+            bond::DeserializeReuse(Serialize<Reader, Writer>(from, version), to);
+
+            UT_Equal(expected, to);
+        }
+    }
+}
+TEST_CASE_END
+
+
+void InitPayload(NestedStructVectors& obj, char c)
+{
+    obj.v.resize(10);
+
+    for (size_t i = 0; i < obj.v.size(); ++i)
+    {
+        obj.v[i].m_str.assign(40 + (i + c) % 10, c);
+        obj.v[i].n1.s.m_str.assign(50, c);
+        obj.v[i].n1.s.m_wstr.assign(30, c);
+        obj.v[i].m_int64 = c;
+    }
+
+    obj.nested.v.resize(5);
+    obj.nested.v[2].m_str.assign(100, c);
+    obj.ints.assign(100, c);
+}
+
+
+void InitPayload(SimpleListsStruct& obj, char c)
+{
+    obj.v_string.assign(8, std::string(30 + c % 3, c));
+    obj.v_int64.assign(20, c);
+
+    // The same keys with different values. Keys are read into a temporary
+    // which is allocated once per container for long strings, so the keys
+    // here are short.
+    for (int i = 0; i < 5; ++i)
+    {
+        obj.s_string.insert(std::string(10, static_cast<char>('a' + i)));
+        obj.m_string_bool[std::string(10, static_cast<char>('a' + i))] = (c + i) % 2 == 0;
+        obj.m_int8_string[static_cast<int8_t>(i)].assign(20 + i, c);
+    }
+}
+
+
+// After deserializing a couple of payloads the object has enough memory for
+// similar ones
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(ReuseNoAllocations)
+{
+    T from1, from2;
+
+    InitPayload(from1, 'x');
+    InitPayload(from2, 'y');
+
+    Reader reader1 = Serialize<Reader, Writer>(from1, Reader::version);
+    Reader reader2 = Serialize<Reader, Writer>(from2, Reader::version);
+
+    T to;
+    bond::DeserializeReuse(reader1, to);
+    bond::DeserializeReuse(reader2, to);
+
+    const size_t before = allocations;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        bond::DeserializeReuse(reader1, to);
+        bond::DeserializeReuse(reader2, to);
+    }
+
+    const size_t after = allocations;
+
+    UT_AssertAreEqual(before, after);
+    UT_Equal(from2, to);
+}
+TEST_CASE_END
+
+
+#ifdef BOND_CXX_17
+
+// Nodes of removed keys are reused for new keys
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(ReuseNodes)
+{
+    SimpleListsStruct from1, from2;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        from1.s_string.insert(std::string(10, static_cast<char>('a' + i)));
+        from1.m_int8_string[static_cast<int8_t>(2 * i)].assign(20, 'x');
+
+        from2.s_string.insert(std::string(10, static_cast<char>('a' + 2 * i)));
+        from2.m_int8_string[static_cast<int8_t>(3 * i + 1)].assign(20 + i, 'y');
+    }
+
+    Reader reader1 = Serialize<Reader, Writer>(from1, Reader::version);
+    Reader reader2 = Serialize<Reader, Writer>(from2, Reader::version);
+
+    SimpleListsStruct to;
+    bond::DeserializeReuse(reader1, to);
+    bond::DeserializeReuse(reader2, to);
+
+    const size_t before = allocations;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        bond::DeserializeReuse(reader1, to);
+        bond::DeserializeReuse(reader2, to);
+    }
+
+    const size_t after = allocations;
+
+    UT_AssertAreEqual(before, after);
+    UT_Equal(from2, to);
+}
+TEST_CASE_END
+
+#endif
+
+
+template <uint16_t N, typename Reader, typename StreamReader, typename Writer>
+void ReuseTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, SimpleStruct>(suite, "Reuse struct");
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, NestedStruct>(suite, "Reuse nested structs");
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, StructWithBase>(suite, "Reuse struct with base");
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, NestedStructVectors>(suite, "Reuse vectors of structs");
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, SimpleListsStruct>(suite, "Reuse containers");
+
+    AddTestCase<TEST_ID(N),
+        ReuseRandom, Reader, Writer, NestedListsStruct>(suite, "Reuse nested containers");
+
+    AddTestCase<TEST_ID(N),
+        ReuseContainers, Reader, Writer>(suite, "Reuse resized containers");
+
+    AddTestCase<TEST_ID(N),
+        ReuseStream, StreamReader, Writer>(suite, "Reuse containers from a stream");
+
+    AddTestCase<TEST_ID(N),
+        ReuseNoAllocations, Reader, Writer, NestedStructVectors>(suite, "No allocations for vectors");
+
+    AddTestCase<TEST_ID(N),
+        ReuseNoAllocations, Reader, Writer, SimpleListsStruct>(suite, "No allocations for sets and maps");
+
+#ifdef BOND_CXX_17
+    AddTestCase<TEST_ID(N),
+        ReuseNodes, Reader, Writer>(suite, "Reuse nodes of sets and maps");
+#endif
+}
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void ReuseViewTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        ReuseOmittedFields, Reader, Writer, NestedStruct, NestedStructView>(suite, "Omitted fields of nested structs");
+
+    AddTestCase<TEST_ID(N),
+        ReuseOmittedFields, Reader, Writer, SimpleListsStruct, SimpleListsStructView>(suite, "Omitted containers");
+}
+
+
+void ReuseTestsInit()
+{
+    TEST_COMPACT_BINARY_PROTOCOL(
+        ReuseTests<
+            0x2801,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryReader<StreamInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Reuse deserialization tests for CompactBinary");
+
+        ReuseViewTests<
+            0x2802,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Reuse deserialization of views for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        ReuseTests<
+            0x2803,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryReader<StreamInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Reuse deserialization tests for FastBinary");
+
+        ReuseViewTests<
+            0x2804,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Reuse deserialization of views for FastBinary");
+    );
+
+    TEST_SIMPLE_PROTOCOL(
+        ReuseTests<
+            0x2805,
+            bond::SimpleBinaryReader<bond::InputBuffer>,
+            bond::SimpleBinaryReader<StreamInputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("Reuse deserialization tests for SimpleBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    ReuseTestsInit();
+    return true;
+}
@@ -0,0 +1,156 @@
+#include "precompiled.h"
+
+#include <bond/protocol/fast_binary.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+
+typedef StructWithBase::Schema::var Derived;
+typedef SimpleBase::Schema::var Base;
+typedef SimpleStruct::Schema::var Simple;
+
+template <typename Writer, typename T>
+bond::blob SerializeMany(const std::vector<T>& objects)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::SerializeMany(objects, writer);
+    return output.GetBuffer();
+}
+
+template <typename Reader, typename Writer>
+void CheckScan()
+{
+    std::vector<StructWithBase> from(5);
+
+    for (auto& obj : from)
+        obj = InitRandom<StructWithBase>();
+
+    Reader reader(SerializeMany<Writer>(from));
+    std::size_t index = 0;
+
+    // Fields of the struct and of its bases, in any order
+    const std::size_t count = bond::Scan<StructWithBase, Simple::m_uint64, Derived::m_str, Base::m_int32>(reader,
+        [&](uint64_t& m_uint64, std::string& m_str, int32_t& m_int32)
+        {
+            BOOST_REQUIRE_LT(index, from.size());
+            BOOST_CHECK_EQUAL(m_uint64, from[index].m_uint64);
+            BOOST_CHECK_EQUAL(m_str, from[index].m_str);
+            BOOST_CHECK_EQUAL(m_int32, from[index].SimpleBase::m_int32);
+            ++index;
+        });
+
+    BOOST_CHECK_EQUAL(count, from.size());
+    BOOST_CHECK_EQUAL(index, from.size());
+    BOOST_CHECK(reader.GetBuffer().IsEof());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ScanTests)
+
+BOOST_AUTO_TEST_CASE(ProtocolsTest)
+{
+    CheckScan<bond::CompactBinaryReader<bond::InputBuffer>, bond::CompactBinaryWriter<bond::OutputBuffer> >();
+    CheckScan<bond::FastBinaryReader<bond::InputBuffer>, bond::FastBinaryWriter<bond::OutputBuffer> >();
+    CheckScan<bond::SimpleBinaryReader<bond::InputBuffer>, bond::SimpleBinaryWriter<bond::OutputBuffer> >();
+}
+
+BOOST_AUTO_TEST_CASE(FieldTypesTest)
+{
+    std::vector<NestedStruct> nested(3);
+
+    for (auto& obj : nested)
+        obj = InitRandom<NestedStruct>();
+
+    // Structs and containers
+    bond::CompactBinaryReader<bond::InputBuffer> reader(
+        SerializeMany<bond::CompactBinaryWriter<bond::OutputBuffer> >(nested));
+    std::vector<NestedStruct1> n1;
+    std::vector<EnumType1> m_enum1;
+
+    bond::Scan<NestedStruct, NestedStruct::Schema::var::n1, NestedStruct::Schema::var::m_enum1>(reader,
+        [&](NestedStruct1& value, EnumType1 enum1)
+        {
+            n1.push_back(std::move(value));
+            m_enum1.push_back(enum1);
+        });
+
+    BOOST_REQUIRE_EQUAL(n1.size(), nested.size());
+
+    for (std::size_t i = 0; i < nested.size(); ++i)
+    {
+        BOOST_CHECK(Equal(n1[i], nested[i].n1));
+        BOOST_CHECK(m_enum1[i] == nested[i].m_enum1);
+    }
+
+    std::vector<SimpleListsStruct> lists(2, InitRandom<SimpleListsStruct>());
+    lists[1].l_string.clear();
+
+    bond::CompactBinaryReader<bond::InputBuffer> lists_reader(
+        SerializeMany<bond::CompactBinaryWriter<bond::OutputBuffer> >(lists));
+    std::size_t index = 0;
+
+    bond::Scan<SimpleListsStruct, SimpleListsStruct::Schema::var::l_string>(lists_reader,
+        [&](std::list<std::string>& l_string)
+        {
+            BOOST_CHECK(l_string == lists[index++].l_string);
+        });
+
+    BOOST_CHECK_EQUAL(index, lists.size());
+}
+
+BOOST_AUTO_TEST_CASE(DefaultsTest)
+{
+    // Optional fields equal to their defaults are omitted from Compact
+    // Binary payloads and are scanned as the defaults from the schema
+    std::vector<FieldHeaders> from(3);
+    from[1].wide = 42;
+    from[1].label = "label";
+
+    bond::CompactBinaryReader<bond::InputBuffer> reader(
+        SerializeMany<bond::CompactBinaryWriter<bond::OutputBuffer> >(from));
+    std::size_t index = 0;
+
+    bond::Scan<FieldHeaders, FieldHeaders::Schema::var::wide, FieldHeaders::Schema::var::label>(reader,
+        [&](int64_t wide, const std::string& label)
+        {
+            BOOST_CHECK_EQUAL(wide, index == 1 ? 42 : 7);
+            BOOST_CHECK_EQUAL(label, index == 1 ? "label" : "");
+            ++index;
+        });
+
+    BOOST_CHECK_EQUAL(index, from.size());
+}
+
+BOOST_AUTO_TEST_CASE(CustomProtocolsTest)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+
+    std::vector<SimpleStruct> from(3);
+
+    for (auto& obj : from)
+        obj = InitRandom<SimpleStruct>();
+
+    Reader reader(SerializeMany<bond::CompactBinaryWriter<bond::OutputBuffer> >(from));
+    std::size_t index = 0;
+
+    const std::size_t count = bond::ScanWith<SimpleStruct, bond::Protocols<Reader>, Simple::m_str>(reader,
+        [&](const std::string& m_str)
+        {
+            BOOST_CHECK_EQUAL(m_str, from[index++].m_str);
+        });
+
+    BOOST_CHECK_EQUAL(count, from.size());
+    BOOST_CHECK_EQUAL(index, from.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
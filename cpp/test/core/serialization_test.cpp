@@ -80,6 +80,76 @@ TEST_CASE_BEGIN(Streaming)
 TEST_CASE_END
 
 
+template <typename Reader, typename Writer, typename T>
+TEST_CASE_BEGIN(StreamingMany)
+{
+    std::vector<T> from(5);
+
+    for (auto& obj : from)
+        InitRandom(obj);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        typename Writer::Buffer expected;
+        typename Writer::Buffer actual;
+
+        // Output is the same as serializing records one by one
+        Factory<Writer>::Call(expected, version, [&from](Writer& writer)
+        {
+            for (const auto& obj : from)
+                bond::Serialize(obj, writer);
+        });
+
+        Factory<Writer>::Call(actual, version, [&from](Writer& writer)
+        {
+            bond::SerializeMany(from, writer);
+        });
+
+        UT_AssertIsTrue(expected.GetBuffer() == actual.GetBuffer());
+
+        typename Reader::Buffer buffer(actual.GetBuffer());
+        Reader reader = Factory<Reader>::Create(buffer, version);
+
+        std::vector<T> to;
+
+        // Deserialize in batches
+        UT_AssertIsTrue(2 == bond::DeserializeMany<T>(reader, std::back_inserter(to), 2));
+        UT_AssertIsFalse(reader.GetBuffer().IsEof());
+        UT_AssertIsTrue(3 == bond::DeserializeMany<T>(reader, std::back_inserter(to)));
+        UT_AssertIsTrue(reader.GetBuffer().IsEof());
+        UT_AssertIsTrue(0 == bond::DeserializeMany<T>(reader, std::back_inserter(to)));
+
+        UT_Equal(from, to);
+
+        // Deserialize in place into existing objects
+        std::vector<T> reused(from.size());
+
+        for (auto& obj : reused)
+            obj = InitRandom<T>();
+
+        typename Reader::Buffer reused_buffer(actual.GetBuffer());
+        Reader reused_reader = Factory<Reader>::Create(reused_buffer, version);
+
+        UT_AssertIsTrue(from.size() == bond::DeserializeMany<T>(reused_reader, reused.begin(), reused.size()));
+        UT_AssertIsTrue(reused_reader.GetBuffer().IsEof());
+
+        UT_Equal(from, reused);
+
+        // Deserialize in place into a range, which bounds the number of objects
+        typename Reader::Buffer range_buffer(actual.GetBuffer());
+        Reader range_reader = Factory<Reader>::Create(range_buffer, version);
+
+        UT_AssertIsTrue(2 == bond::DeserializeMany<T>(range_reader, reused.begin(), reused.begin() + 2));
+        UT_AssertIsFalse(range_reader.GetBuffer().IsEof());
+        UT_AssertIsTrue(3 == bond::DeserializeMany<T>(range_reader, reused.begin() + 2, reused.end()));
+        UT_AssertIsTrue(range_reader.GetBuffer().IsEof());
+
+        UT_Equal(from, reused);
+    }
+}
+TEST_CASE_END
+
+
 // 1 bit per every 8 fields
 // This simplified count obviously doesn't work for nested structures but
 // the tests that check payload length don't use nested structs.
@@ -260,6 +330,9 @@ void SimpleStructTests(const char* name)
     AddTestCase<COND_TEST_ID(N, (!bond::uses_dom_parser<Reader>::value)),
         Streaming, Reader, Writer, SimpleStruct>(suite, "Record streaming");
 
+    AddTestCase<COND_TEST_ID(N, (!bond::uses_dom_parser<Reader>::value)),
+        StreamingMany, Reader, Writer, NestedStruct>(suite, "Batched record streaming");
+
     AddTestCase<TEST_ID(N),
         SerializeAPIs, Reader, Writer, EnumValueWrapper>(suite, "Struct with alias-wrapped enum");
 }
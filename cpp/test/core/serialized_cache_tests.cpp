@@ -0,0 +1,171 @@
+#include "precompiled.h"
+
+#include <bond/core/serialized_cache.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+SimpleStruct MakeSimpleStruct()
+{
+    auto obj = InitRandom<SimpleStruct>();
+
+    // Large enough for OutputBuffer to chain the payload instead of copying it
+    obj.m_str.assign(100, 'x');
+    return obj;
+}
+
+template <typename Writer, typename Serialize>
+bond::OutputBuffer SerializeWith(uint16_t version, const Serialize& serialize)
+{
+    bond::OutputBuffer output;
+    Factory<Writer>::Call(output, version, serialize);
+    return output;
+}
+
+template <typename Writer, typename T>
+bond::blob SerializeWith(const T& obj, uint16_t version)
+{
+    return SerializeWith<Writer>(version, [&obj](Writer& writer)
+    {
+        bond::Serialize(obj, writer);
+    }).GetBuffer();
+}
+
+bool IsChained(const bond::OutputBuffer& output, const bond::blob& payload)
+{
+    std::vector<bond::blob> buffers;
+    output.GetBuffers(buffers);
+
+    return std::any_of(buffers.begin(), buffers.end(), [&](const bond::blob& buffer)
+    {
+        return buffer.content() == payload.content();
+    });
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SerializedCacheTests)
+
+using all_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InputBuffer>,
+    bond::CompactBinaryReader<bond::InputBuffer>,
+    bond::FastBinaryReader<bond::InputBuffer> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(TopLevelSerializationTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    const auto obj = MakeSimpleStruct();
+    bond::serialized_cache<SimpleStruct> cache(obj);
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        const bond::blob expected = SerializeWith<Writer>(obj, version);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const bond::OutputBuffer output = SerializeWith<Writer>(version, [&cache](Writer& writer)
+            {
+                cache.Serialize(writer);
+            });
+
+            BOOST_CHECK(output.GetBuffer() == expected);
+            BOOST_CHECK(IsChained(output, cache.template get<Reader>(version)));
+        }
+    }
+
+    // Serialized once per protocol version
+    BOOST_CHECK_EQUAL(cache.size(), static_cast<size_t>(Reader::version));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(NestedSerializationTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+    using BondedReader = typename boost::mpl::if_<
+        bond::uses_marshaled_bonded<Reader>,
+        bond::CompactBinaryReader<bond::InputBuffer>,
+        Reader>::type;
+
+    const auto obj = MakeSimpleStruct();
+    bond::serialized_cache<SimpleStruct> cache(obj);
+
+    for (uint16_t version = bond::v1; version <= Reader::version; ++version)
+    {
+        // Bonded fields of untagged protocols are always Compact Binary v1
+        const uint16_t bonded_version = bond::uses_marshaled_bonded<Reader>::value ? bond::v1 : version;
+
+        NestedStruct1OptionalBondedView expected;
+        expected.s = bond::bonded<SimpleStruct>(obj);
+
+        NestedStruct1OptionalBondedView cached;
+        cached.s = cache.template get_bonded<BondedReader>(bonded_version);
+
+        const bond::OutputBuffer output = SerializeWith<Writer>(version, [&cached](Writer& writer)
+        {
+            bond::Serialize(cached, writer);
+        });
+
+        BOOST_CHECK(output.GetBuffer() == SerializeWith<Writer>(expected, version));
+
+        // Marshaled bonded fields are copied into a contiguous blob
+        BOOST_CHECK(IsChained(output, cache.template get<BondedReader>(bonded_version))
+            || bond::uses_marshaled_bonded<Reader>::value);
+
+        bond::InputBuffer input(output.GetBuffer());
+
+        NestedStruct1OptionalBondedView to;
+        bond::Deserialize(Factory<Reader>::Create(input, version), to);
+
+        BOOST_CHECK((to.s.Deserialize() == obj));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentSerializationTest)
+{
+    using Writer = bond::CompactBinaryWriter<bond::OutputBuffer>;
+
+    const auto obj = MakeSimpleStruct();
+    bond::serialized_cache<SimpleStruct> cache(boost::make_shared<const SimpleStruct>(obj));
+    const bond::blob expected = SerializeWith<Writer>(obj, bond::v2);
+
+    std::vector<std::thread> threads;
+    std::vector<bond::blob> results(8);
+
+    for (auto& result : results)
+    {
+        threads.emplace_back([&cache, &result]
+        {
+            bond::OutputBuffer output;
+            Writer writer(output, bond::v2);
+            cache.Serialize(writer);
+            result = output.GetBuffer();
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+    for (const auto& result : results)
+    {
+        BOOST_CHECK(result == expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
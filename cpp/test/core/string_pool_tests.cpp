@@ -0,0 +1,144 @@
+#include "precompiled.h"
+
+#include "blob_string_tests_generated/allocator_test_reflection.h"
+
+#include <bond/core/string_pool.h>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(StringPoolTests)
+
+BOOST_AUTO_TEST_CASE(StringPoolBasicTests)
+{
+    bond::string_pool pool;
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    BOOST_CHECK_EQUAL(pool.hit_rate(), 0);
+
+    bond::blob_string a("value"), b("value"), c("other");
+    BOOST_CHECK(a.data() != b.data());
+
+    pool.intern(a);
+    pool.intern(b);
+    pool.intern(c);
+
+    BOOST_CHECK(a.data() == b.data());
+    BOOST_CHECK(a.data() != c.data());
+    BOOST_CHECK_EQUAL(a.str(), "value");
+    BOOST_CHECK_EQUAL(c.str(), "other");
+
+    BOOST_CHECK_EQUAL(pool.size(), 2u);
+    BOOST_CHECK_EQUAL(pool.hits(), 1u);
+    BOOST_CHECK_EQUAL(pool.misses(), 2u);
+    BOOST_CHECK_EQUAL(pool.allocated(), 10u);
+    BOOST_CHECK_CLOSE(pool.hit_rate(), 1.0 / 3, 0.001);
+
+    // Pooled values are immutable; writes go to a copy
+    b.mutable_data()[0] = 'V';
+    BOOST_CHECK_EQUAL(a.str(), "value");
+    BOOST_CHECK_EQUAL(b.str(), "Value");
+
+    bond::blob_wstring w1(L"wide"), w2(L"wide");
+    pool.intern(w1);
+    pool.intern(w2);
+    BOOST_CHECK(w1.data() == w2.data());
+    BOOST_CHECK(w1.str() == L"wide");
+
+    // Empty strings aren't pooled
+    bond::blob_string empty;
+    pool.intern(empty);
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(pool.size(), 3u);
+
+    // Interned strings outlive the pool's references
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    BOOST_CHECK_EQUAL(pool.hits(), 0u);
+    BOOST_CHECK_EQUAL(pool.allocated(), 0u);
+    BOOST_CHECK_EQUAL(a.str(), "value");
+    BOOST_CHECK(w2.str() == L"wide");
+}
+
+using all_protocols = boost::mpl::list<
+    bond::SimpleBinaryReader<bond::InterningInputBuffer>,
+    bond::CompactBinaryReader<bond::InterningInputBuffer>,
+    bond::FastBinaryReader<bond::InterningInputBuffer> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InterningDeserializationTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    const size_t count = 100;
+    const size_t distinct = 7;
+
+    std::vector<bond::blob> payloads;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        blob_string_tests::SimpleType obj;
+        obj.m_str = bond::blob_string("host" + std::to_string(i % distinct));
+        obj.m_wstr = bond::blob_wstring(L"metric" + std::to_wstring(i % distinct));
+
+        typename Writer::Buffer output;
+        Writer writer{ output };
+        bond::Serialize(obj, writer);
+
+        payloads.push_back(output.GetBuffer());
+    }
+
+    bond::string_pool pool;
+    std::vector<blob_string_tests::SimpleType> records(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Reader reader{ bond::InterningInputBuffer(payloads[i], pool) };
+        bond::Deserialize(reader, records[i]);
+    }
+
+    payloads.clear();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        BOOST_CHECK_EQUAL(records[i].m_str.str(), "host" + std::to_string(i % distinct));
+        BOOST_CHECK(records[i].m_wstr.str() == L"metric" + std::to_wstring(i % distinct));
+
+        BOOST_CHECK(records[i].m_str.data() == records[i % distinct].m_str.data());
+        BOOST_CHECK(records[i].m_wstr.data() == records[i % distinct].m_wstr.data());
+    }
+
+    BOOST_CHECK_EQUAL(pool.size(), 2 * distinct);
+    BOOST_CHECK_EQUAL(pool.misses(), 2 * distinct);
+    BOOST_CHECK_EQUAL(pool.hits(), 2 * (count - distinct));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InterningRoundtripTest, Reader, all_protocols)
+{
+    using Writer = typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type;
+
+    bond::string_pool pool;
+
+    for (uint32_t i = 0; i < c_iterations; ++i)
+    {
+        const auto from = InitRandom<blob_string_tests::NullableFields>();
+
+        typename Writer::Buffer output;
+        Writer writer{ output };
+        bond::Serialize(from, writer);
+
+        Reader reader{ bond::InterningInputBuffer(output.GetBuffer(), pool) };
+
+        blob_string_tests::NullableFields to;
+        bond::Deserialize(reader, to);
+        BOOST_CHECK((from == to));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
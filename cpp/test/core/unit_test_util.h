@@ -19,6 +19,7 @@ using bond::string_length;
 #include <boost/assign/list_of.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 
 using namespace std;
 using boost::mpl::_;
@@ -202,6 +203,45 @@ private:
 };
 
 
+// Input buffer over a stream, whose copies share the position of the stream
+class StreamInputBuffer
+{
+public:
+    StreamInputBuffer(const bond::blob& blob)
+        : _stream(boost::make_shared<bond::InputBuffer>(blob))
+    {}
+
+    template <typename T>
+    void Read(T& value)
+    {
+        _stream->Read(value);
+    }
+
+    void Read(void* buffer, uint32_t size)
+    {
+        _stream->Read(buffer, size);
+    }
+
+    void Read(bond::blob& blob, uint32_t size)
+    {
+        _stream->Read(blob, size);
+    }
+
+    void Skip(uint32_t size)
+    {
+        _stream->Skip(size);
+    }
+
+    bool IsEof() const
+    {
+        return _stream->IsEof();
+    }
+
+private:
+    boost::shared_ptr<bond::InputBuffer> _stream;
+};
+
+
 template <typename Protocol>
 struct Factory
 {
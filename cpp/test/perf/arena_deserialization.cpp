@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares deserializing and destroying records allocated with std::allocator
+// and with bond::ext::arena_allocator. The arena types are generated from
+// perf.bond with --allocator=bond::ext::arena_allocator<>.
+
+#include "benchmark.h"
+#include "arena_generated/perf_reflection.h"
+
+#include <bond/ext/arena_allocator.h>
+#include <bond/protocol/compact_binary.h>
+
+int main(int argc, char** argv)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    for (uint32_t count : { 1000, 100000 })
+    {
+        std::cout << count << " records" << std::endl;
+
+        bond::OutputBuffer output;
+        Writer writer(output);
+        bond::Serialize(perf::MakeRecords(count), writer);
+
+        const bond::blob data = output.GetBuffer();
+
+        perf::Measure("std::allocator", iterations, [&]
+        {
+            perf::Records records;
+            bond::Deserialize(Reader(data), records);
+        });
+
+        perf::Measure("arena_allocator", iterations, [&]
+        {
+            bond::ext::arena<> arena(64 * 1024);
+            bond::ext::arena_allocator<> allocator(arena);
+            perf_arena::Records records(allocator);
+            bond::Deserialize(Reader(data), records);
+        });
+    }
+
+    return 0;
+}
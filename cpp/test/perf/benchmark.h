@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include "perf_reflection.h"
+
+#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace perf
+{
+
+// Number of times each benchmark is repeated; can be overridden with the
+// first command line argument.
+inline uint32_t Iterations(int argc, char** argv, uint32_t iterations = 20)
+{
+    return argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : iterations;
+}
+
+
+// Runs the function the specified number of times and reports the best time
+// per iteration, which is the least affected by noise.
+template <typename Function>
+double Measure(const std::string& name, uint32_t iterations, const Function& function)
+{
+    using clock = std::chrono::steady_clock;
+
+    double best = 0;
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        clock::time_point start = clock::now();
+        function();
+        double elapsed = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::fixed << std::setprecision(3) << std::setw(12) << best << " ms"
+              << std::endl;
+
+    return best;
+}
+
+
+// Simple fixed size thread pool implementing the executor concept used by
+// parallel (de)serialization.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(uint32_t threads)
+        : _done(false)
+    {
+        for (uint32_t i = 0; i < threads; ++i)
+            _threads.emplace_back([this] { Run(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _done = true;
+        }
+
+        _ready.notify_all();
+
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    void operator()(const std::function<void()>& task) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _tasks.push(task);
+        }
+
+        _ready.notify_one();
+    }
+
+private:
+    void Run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _ready.wait(lock, [this] { return _done || !_tasks.empty(); });
+
+                if (_tasks.empty())
+                    return;
+
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+
+            task();
+        }
+    }
+
+    mutable std::mutex _lock;
+    mutable std::condition_variable _ready;
+    mutable std::queue<std::function<void()> > _tasks;
+    std::vector<std::thread> _threads;
+    bool _done;
+};
+
+
+inline Record MakeRecord(uint64_t id)
+{
+    Record record;
+
+    record.id = id;
+    record.count = static_cast<int32_t>(id % 1000);
+    record.color = static_cast<Color>(id % 3);
+    record.name = "record " + std::to_string(id);
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        Point point;
+        point.x = static_cast<double>(id + i);
+        point.y = static_cast<double>(id * i);
+        record.path.push_back(point);
+    }
+
+    for (uint32_t i = 0; i < 4; ++i)
+        record.attributes["attribute " + std::to_string(i)] = static_cast<int64_t>(id + i);
+
+    return record;
+}
+
+
+inline Records MakeRecords(uint32_t count)
+{
+    Records records;
+
+    records.records.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+        records.records.push_back(MakeRecord(i));
+
+    return records;
+}
+
+} // namespace perf
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares blob-heavy stream operations using bond::blob, whose reference
+// count is updated atomically, and bond::local_blob, whose isn't.
+
+#include "benchmark.h"
+
+#include <bond/core/local_blob.h>
+#include <bond/protocol/compact_binary.h>
+#include <bond/stream/local_input_buffer.h>
+
+#include <boost/make_shared.hpp>
+
+const uint32_t slices = 1000000;
+const uint32_t slice_size = 16;
+
+
+template <typename Blob, typename Buffer>
+void Slices(const std::string& name, uint32_t iterations, const bond::blob& data)
+{
+    perf::Measure(name + " Read slices", iterations, [&]
+    {
+        Buffer input(data);
+        Blob slice;
+
+        for (uint32_t i = 0; i < slices; ++i)
+            input.Read(slice, slice_size);
+    });
+
+    perf::Measure(name + " GetBufferRange", iterations, [&]
+    {
+        Buffer input(data);
+
+        for (uint32_t i = 0; i < slices; ++i)
+        {
+            const Blob begin = GetCurrentBuffer(input);
+            input.Skip(slice_size);
+            const Blob range = GetBufferRange(begin, GetCurrentBuffer(input));
+        }
+    });
+
+    perf::Measure(name + " copy buffers", iterations, [&]
+    {
+        std::vector<Buffer> buffers(1024, Buffer(data));
+
+        for (uint32_t i = 0; i < slices / 1024; ++i)
+            std::vector<Buffer> copies(buffers);
+    });
+}
+
+
+template <typename Blob>
+void GetBuffers(const std::string& name, uint32_t iterations, const bond::OutputBuffer& output)
+{
+    perf::Measure(name + " GetBuffers", iterations, [&]
+    {
+        std::vector<Blob> buffers;
+
+        for (uint32_t i = 0; i < 100; ++i)
+            output.GetBuffers(buffers);
+    });
+}
+
+
+template <typename Buffer>
+void Deserialize(const std::string& name, uint32_t iterations, const bond::blob& data)
+{
+    perf::Measure(name + " Deserialize", iterations, [&]
+    {
+        perf::Records records;
+        bond::Deserialize(bond::CompactBinaryReader<Buffer>(Buffer(data)), records);
+    });
+}
+
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    {
+        const bond::blob data = bond::blob_prolong(
+            bond::blob(std::vector<char>(slices * slice_size).data(), slices * slice_size));
+
+        Slices<bond::blob, bond::InputBuffer>("blob", iterations, data);
+        Slices<bond::local_blob, bond::LocalInputBuffer>("local_blob", iterations, data);
+    }
+
+    {
+        // Each blob field is chained into the output as a separate buffer,
+        // between ranges of the output's own buffers
+        perf::Records records = perf::MakeRecords(10000);
+        const bond::blob payloads(boost::make_shared<char[]>(records.records.size() * 64),
+                                  static_cast<uint32_t>(records.records.size() * 64));
+
+        for (size_t i = 0; i < records.records.size(); ++i)
+            records.records[i].payload = payloads.range(static_cast<uint32_t>(i * 64), 64);
+
+        bond::OutputBuffer output(4096, 16, std::allocator<char>(), 0);
+        bond::CompactBinaryWriter<bond::OutputBuffer> writer(output);
+        bond::Serialize(records, writer);
+
+        GetBuffers<bond::blob>("blob", iterations, output);
+        GetBuffers<bond::local_blob>("local_blob", iterations, output);
+
+        const bond::blob data = output.GetBuffer();
+
+        Deserialize<bond::InputBuffer>("blob", iterations, data);
+        Deserialize<bond::LocalInputBuffer>("local_blob", iterations, data);
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Measures how allocations through a shared bond::ext::capped_allocator scale
+// with the number of threads for multi_threaded_counter and sharded_counter.
+
+#include "benchmark.h"
+
+#include <bond/ext/capped_allocator.h>
+#include <bond/ext/sharded_counter.h>
+
+#include <limits>
+#include <sstream>
+
+template <typename Counter>
+void Allocate(const std::string& counter_name, uint32_t iterations, uint32_t threads)
+{
+    const uint32_t allocations = 1000000;
+
+    Counter counter((std::numeric_limits<typename Counter::value_type>::max)());
+    bond::ext::capped_allocator<std::allocator<char>, Counter&> allocator(counter);
+
+    std::ostringstream name;
+    name << counter_name << ", " << threads << " thread(s)";
+
+    perf::Measure(name.str(), iterations, [&]
+    {
+        std::vector<std::thread> workers;
+
+        for (uint32_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&]
+            {
+                auto alloc = allocator;
+
+                for (uint32_t i = 0; i < allocations / threads; ++i)
+                {
+                    const size_t size = 16 + i % 256;
+                    alloc.deallocate(alloc.allocate(size), size);
+                }
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const uint32_t max_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        Allocate<bond::ext::multi_threaded_counter<> >("multi_threaded_counter", iterations, threads);
+        Allocate<bond::ext::sharded_counter<> >("sharded_counter", iterations, threads);
+    }
+
+    return 0;
+}
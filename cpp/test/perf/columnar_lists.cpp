@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares the payload size and the serialization and deserialization time
+// of lists of structs in Columnar protocol, which stores them column by
+// column, against Simple Binary and Compact Binary.
+
+#include "benchmark.h"
+
+#include <bond/protocol/columnar.h>
+#include <bond/protocol/compact_binary.h>
+#include <bond/protocol/simple_binary.h>
+
+namespace
+{
+
+perf::Series MakeSeries(uint32_t count)
+{
+    perf::Series series;
+
+    series.name = "series";
+    series.samples.resize(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        series.samples[i].timestamp = 1000000 + 10 * i;
+        series.samples[i].reading = i * 0.5;
+        series.samples[i].sensor = static_cast<int32_t>(i % 16);
+        series.samples[i].color = static_cast<perf::Color>((i / 100) % 3);
+    }
+
+    return series;
+}
+
+template <typename Writer, typename Reader, typename T>
+void Run(const std::string& name, uint32_t iterations, const T& obj)
+{
+    bond::blob data;
+
+    perf::Measure(name + " serialize", iterations, [&]
+    {
+        bond::OutputBuffer output;
+        Writer writer(output);
+        bond::Serialize(obj, writer);
+        data = output.GetBuffer();
+    });
+
+    perf::Measure(name + " deserialize", iterations, [&]
+    {
+        T to;
+        bond::Deserialize(Reader(data), to);
+    });
+
+    std::cout << name << " payload: " << data.size() << " bytes" << std::endl;
+}
+
+template <typename T>
+void Compare(const std::string& name, uint32_t iterations, const T& obj)
+{
+    std::cout << name << std::endl;
+
+    Run<bond::SimpleBinaryWriter<bond::OutputBuffer>, bond::SimpleBinaryReader<bond::InputBuffer> >(
+        "    Simple Binary", iterations, obj);
+    Run<bond::CompactBinaryWriter<bond::OutputBuffer>, bond::CompactBinaryReader<bond::InputBuffer> >(
+        "    Compact Binary", iterations, obj);
+    Run<bond::ColumnarWriter<bond::OutputBuffer>, bond::ColumnarReader<bond::InputBuffer> >(
+        "    Columnar", iterations, obj);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    Compare("1000000 samples", iterations, MakeSeries(1000000));
+    Compare("100000 records with 8 points each", iterations, perf::MakeRecords(100000));
+
+    return 0;
+}
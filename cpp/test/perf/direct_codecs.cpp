@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares Compact Binary serialization and deserialization of records using
+// the Apply templates and using the direct codecs. The direct codec types are
+// generated from perf.bond with --direct-codecs.
+
+#include "benchmark.h"
+#include "direct_generated/perf_reflection.h"
+
+#include <bond/protocol/compact_binary.h>
+
+namespace
+{
+
+template <typename Writer, typename T>
+bond::blob Serialize(const T& obj)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+    bond::Serialize(obj, writer);
+    return output.GetBuffer();
+}
+
+template <typename Records>
+void Run(const std::string& name, uint32_t iterations, const bond::blob& data)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+
+    Records records;
+    bond::Deserialize(Reader(data), records);
+
+    perf::Measure(name + " deserialize", iterations, [&]
+    {
+        Records to;
+        bond::Deserialize(Reader(data), to);
+    });
+
+    perf::Measure(name + " serialize v1", iterations, [&]
+    {
+        Serialize<bond::CompactBinaryWriter<bond::OutputBuffer> >(records);
+    });
+
+    perf::Measure(name + " serialize v2", iterations, [&]
+    {
+        bond::OutputBuffer output;
+        bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, bond::v2);
+        bond::Serialize(records, writer);
+    });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    for (uint32_t count : { 1000, 100000 })
+    {
+        std::cout << count << " records" << std::endl;
+
+        const bond::blob data = Serialize<bond::CompactBinaryWriter<bond::OutputBuffer> >(perf::MakeRecords(count));
+
+        Run<perf::Records>("Apply", iterations, data);
+        Run<perf_direct::Records>("direct codecs", iterations, data);
+    }
+
+    return 0;
+}
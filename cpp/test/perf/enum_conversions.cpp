@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares conversions between enum values and names using the functions
+// generated by gbc against lookups in std::unordered_map, which the generated
+// functions used before. Names are converted the way JSON deserialization
+// does: before, from a null terminated string, which was copied into an
+// std::string; now from a pointer and a length.
+
+#include "benchmark.h"
+
+#include <unordered_map>
+
+const uint32_t count = 1000000;
+
+
+struct EnumHash
+{
+    template <typename Enum>
+    std::size_t operator()(Enum value) const
+    {
+        return static_cast<std::size_t>(value);
+    }
+};
+
+
+template <typename Enum>
+void Run(const std::string& name, uint32_t iterations)
+{
+    typedef std::unordered_map<Enum, std::string, EnumHash> ValueToName;
+    typedef std::unordered_map<std::string, Enum> NameToValue;
+
+    std::vector<Enum> values;
+    std::vector<std::string> names;
+
+    for (const auto& entry : GetValueToNameMap(Enum()))
+    {
+        values.push_back(entry.first);
+        names.push_back(entry.second);
+    }
+
+    volatile std::size_t sink = 0;
+
+    perf::Measure(name + " ToString", iterations, [&]
+    {
+        std::size_t length = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+            length += ToString(values[i % values.size()]).size();
+
+        sink = length;
+    });
+
+    perf::Measure(name + " unordered_map value to name", iterations, [&]
+    {
+        const ValueToName& map = GetValueToNameMap(Enum(), bond::detail::mpl::identity<ValueToName>());
+        std::size_t length = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+            length += map.find(values[i % values.size()])->second.size();
+
+        sink = length;
+    });
+
+    perf::Measure(name + " ToEnum", iterations, [&]
+    {
+        std::size_t sum = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const std::string& str = names[i % names.size()];
+            Enum value;
+
+            ToEnum(value, str.data(), str.size());
+            sum += value;
+        }
+
+        sink = sum;
+    });
+
+    perf::Measure(name + " unordered_map name to value", iterations, [&]
+    {
+        const NameToValue& map = GetNameToValueMap(Enum(), bond::detail::mpl::identity<NameToValue>());
+        std::size_t sum = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+            sum += map.find(names[i % names.size()].c_str())->second;
+
+        sink = sum;
+    });
+}
+
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    Run<perf::Color>("Color", iterations);
+    Run<perf::Month>("Month", iterations);
+    Run<perf::EventKind>("EventKind", iterations);
+
+    return 0;
+}
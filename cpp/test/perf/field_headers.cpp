@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares Compact Binary serialization of structs with many narrow fields
+// using field headers encoded at compile time against encoding them at run
+// time. The latter uses a buffer for which the compile-time headers are
+// disabled. The first pass of v2, which computes the struct lengths, uses
+// compile-time headers in both cases.
+
+#include "benchmark.h"
+
+#include <bond/protocol/compact_binary.h>
+
+namespace
+{
+
+class RuntimeHeadersOutputBuffer
+    : public bond::OutputBuffer
+{};
+
+}
+
+namespace bond
+{
+
+template <> struct
+uses_static_field_headers<CompactBinaryWriter<RuntimeHeadersOutputBuffer> >
+    : std::false_type {};
+
+}
+
+namespace
+{
+
+perf::Widgets MakeWidgets(uint32_t count)
+{
+    perf::Widgets widgets;
+
+    widgets.items.resize(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        perf::Widget& widget = widgets.items[i];
+
+        widget.enabled = (i % 2) == 0;
+        widget.visible = true;
+        widget.level = static_cast<uint8_t>(i % 8);
+        widget.offset = static_cast<int8_t>(i % 5) - 2;
+        widget.priority = static_cast<uint8_t>(i % 3);
+        widget.left = static_cast<int16_t>(i % 1000);
+        widget.top = static_cast<int16_t>(i % 700);
+        widget.width = 120;
+        widget.height = 40;
+        widget.delta = static_cast<int32_t>(i % 17) - 8;
+        widget.mask = 0xff;
+        widget.layer = static_cast<uint8_t>(i % 4);
+        widget.color = static_cast<perf::Color>(i % 3);
+        widget.opacity = 0.5f;
+        widget.border = 1;
+        widget.angle = static_cast<int16_t>(i % 360);
+        widget.revision = static_cast<uint8_t>(i);
+    }
+
+    return widgets;
+}
+
+template <typename Output, typename T>
+bond::blob Run(const std::string& name, uint32_t iterations, const T& obj, uint16_t version)
+{
+    bond::blob data;
+
+    perf::Measure(name, iterations, [&]
+    {
+        Output output;
+        bond::CompactBinaryWriter<Output> writer(output, version);
+        bond::Serialize(obj, writer);
+        data = output.GetBuffer();
+    });
+
+    return data;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    for (uint32_t count : { 1000, 100000 })
+    {
+        const perf::Widgets widgets = MakeWidgets(count);
+
+        for (uint16_t version = bond::v1; version <= bond::v2; ++version)
+        {
+            std::cout << count << " widgets, Compact Binary v" << version << std::endl;
+
+            const bond::blob runtime = Run<RuntimeHeadersOutputBuffer>("    run-time headers", iterations, widgets, version);
+            const bond::blob precomputed = Run<bond::OutputBuffer>("    compile-time headers", iterations, widgets, version);
+
+            if (!(runtime == precomputed))
+            {
+                std::cerr << "Payloads differ" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares Simple Binary serialization and deserialization of flat structs,
+// which are copied with a single memcpy, against writing and reading them
+// field by field. The latter uses buffers for which the packed copies are
+// disabled.
+
+#include "benchmark.h"
+
+#include <bond/protocol/simple_binary.h>
+
+namespace
+{
+
+class UnpackedOutputBuffer
+    : public bond::OutputBuffer
+{};
+
+class UnpackedInputBuffer
+    : public bond::InputBuffer
+{
+public:
+    UnpackedInputBuffer(const bond::blob& blob)
+        : bond::InputBuffer(blob)
+    {}
+};
+
+}
+
+namespace bond
+{
+
+template <> struct
+uses_packed_fields<SimpleBinaryWriter<UnpackedOutputBuffer> >
+    : std::false_type {};
+
+template <> struct
+uses_packed_fields<SimpleBinaryReader<UnpackedInputBuffer> >
+    : std::false_type {};
+
+}
+
+namespace
+{
+
+perf::Series MakeSeries(uint32_t count)
+{
+    perf::Series series;
+
+    series.name = "series";
+    series.samples.resize(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        series.samples[i].timestamp = 1000000 + i;
+        series.samples[i].reading = i * 0.5;
+        series.samples[i].sensor = static_cast<int32_t>(i % 16);
+        series.samples[i].color = static_cast<perf::Color>(i % 3);
+    }
+
+    return series;
+}
+
+template <typename Output, typename Input, typename T>
+void Run(const std::string& name, uint32_t iterations, const T& obj, uint16_t version)
+{
+    bond::blob data;
+
+    perf::Measure(name + " serialize", iterations, [&]
+    {
+        Output output;
+        bond::SimpleBinaryWriter<Output> writer(output, version);
+        bond::Serialize(obj, writer);
+        data = output.GetBuffer();
+    });
+
+    perf::Measure(name + " deserialize", iterations, [&]
+    {
+        T to;
+        bond::Deserialize(bond::SimpleBinaryReader<Input>(Input(data), version), to);
+    });
+}
+
+template <typename T>
+void Compare(const std::string& name, uint32_t iterations, const T& obj)
+{
+    for (uint16_t version = bond::v1; version <= bond::v2; ++version)
+    {
+        std::cout << name << ", Simple Binary v" << version << std::endl;
+
+        Run<UnpackedOutputBuffer, UnpackedInputBuffer>("    field by field", iterations, obj, version);
+        Run<bond::OutputBuffer, bond::InputBuffer>("    single copy", iterations, obj, version);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    Compare("1000000 samples", iterations, MakeSeries(1000000));
+    Compare("100000 records with 8 points each", iterations, perf::MakeRecords(100000));
+
+    return 0;
+}
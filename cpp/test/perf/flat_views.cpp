@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares reading a few fields of every record through views of a Flat
+// Binary payload, with and without verifying it first, against deserializing
+// the records from Compact Binary.
+
+#include "benchmark.h"
+
+#include <bond/protocol/compact_binary.h>
+#include <bond/protocol/flat_binary.h>
+
+namespace
+{
+
+typedef perf::Record::Schema::var Fields;
+
+double Sum(const perf::Records& records)
+{
+    double sum = 0;
+
+    for (const perf::Record& record : records.records)
+    {
+        sum += record.count;
+
+        if (!record.path.empty())
+            sum += record.path.front().x;
+    }
+
+    return sum;
+}
+
+double Sum(const bond::FlatView<perf::Records>& records)
+{
+    double sum = 0;
+
+    for (const bond::FlatView<perf::Record>& record : records.Get<perf::Records::Schema::var::records>())
+    {
+        sum += record.Get<Fields::count>();
+
+        const auto path = record.Get<Fields::path>();
+
+        if (!path.empty())
+            sum += path[0].Get<perf::Point::Schema::var::x>();
+    }
+
+    return sum;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const perf::Records records = perf::MakeRecords(100000);
+
+    bond::blob compact;
+    bond::blob flat;
+    double sum = 0;
+
+    perf::Measure("Compact Binary serialize", iterations, [&]
+    {
+        bond::OutputBuffer output;
+        bond::CompactBinaryWriter<bond::OutputBuffer> writer(output);
+        bond::Serialize(records, writer);
+        compact = output.GetBuffer();
+    });
+
+    perf::Measure("Flat Binary serialize", iterations, [&]
+    {
+        flat = bond::SerializeFlat(records);
+    });
+
+    perf::Measure("Compact Binary deserialize and read", iterations, [&]
+    {
+        perf::Records to;
+        bond::Deserialize(bond::CompactBinaryReader<bond::InputBuffer>(compact), to);
+        sum = Sum(to);
+    });
+
+    perf::Measure("Flat Binary verify and read", iterations, [&]
+    {
+        if (bond::VerifyFlat<perf::Records>(flat))
+            sum = Sum(bond::GetFlatView<perf::Records>(flat));
+    });
+
+    perf::Measure("Flat Binary read", iterations, [&]
+    {
+        sum = Sum(bond::GetFlatView<perf::Records>(flat));
+    });
+
+    std::cout << "Compact Binary payload: " << compact.size() << " bytes" << std::endl;
+    std::cout << "Flat Binary payload: " << flat.size() << " bytes" << std::endl;
+    std::cout << "Sum: " << sum << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Measures deserialization of a map<string, struct> and of a HashMap<int64, double>,
+// which is generated as std::unordered_map (see maps.bond).
+
+#include "benchmark.h"
+#include "maps_reflection.h"
+
+#include <bond/protocol/compact_binary.h>
+
+template <typename T>
+void Deserialize(const std::string& name, uint32_t iterations, const T& obj)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+
+    bond::OutputBuffer output;
+    Writer writer(output);
+    bond::Serialize(obj, writer);
+
+    const bond::blob data = output.GetBuffer();
+
+    perf::Measure(name, iterations, [&]
+    {
+        T to;
+        bond::Deserialize(Reader(data), to);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+
+    for (uint32_t count : { 1000, 100000 })
+    {
+        std::cout << count << " elements" << std::endl;
+
+        perf::Locations locations;
+        perf::Values values;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            perf::Location& location = locations.locations["location " + std::to_string(i)];
+
+            location.name = "location " + std::to_string(i);
+            location.latitude = i * 0.001;
+            location.longitude = i * 0.002;
+            location.population = static_cast<int32_t>(i);
+
+            values.values[static_cast<int64_t>(i) * 7919] = i * 0.5;
+        }
+
+        Deserialize("map<string, Location>", iterations, locations);
+        Deserialize("unordered_map<int64, double>", iterations, values);
+    }
+
+    return 0;
+}
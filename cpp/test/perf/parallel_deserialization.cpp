@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Measures how deserialization of a large vector of structs scales with the
+// number of threads used by bond::DeserializeParallel.
+
+#include "benchmark.h"
+
+#include <bond/core/parallel.h>
+#include <bond/protocol/compact_binary.h>
+
+#include <sstream>
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const perf::Records records = perf::MakeRecords(200000);
+
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, bond::v2);
+    bond::Serialize(records, writer);
+
+    const bond::blob data = output.GetBuffer();
+
+    std::cout << records.records.size() << " records, " << data.size() << " bytes" << std::endl;
+
+    double serial = perf::Measure("Deserialize", iterations, [&]
+    {
+        perf::Records to;
+        bond::Deserialize(bond::CompactBinaryReader<bond::InputBuffer>(data, bond::v2), to);
+    });
+
+    const uint32_t max_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        perf::ThreadPool pool(threads);
+
+        std::ostringstream name;
+        name << "DeserializeParallel, " << threads << " thread(s)";
+
+        double parallel = perf::Measure(name.str(), iterations, [&]
+        {
+            perf::Records to;
+            bond::DeserializeParallel(bond::CompactBinaryReader<bond::InputBuffer>(data, bond::v2), to, pool);
+        });
+
+        std::cout << "    speedup " << std::setprecision(2) << serial / parallel << "x" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Measures how serialization of a large vector of structs scales with the
+// number of threads used by bond::SerializeParallel.
+
+#include "benchmark.h"
+
+#include <bond/core/parallel.h>
+#include <bond/protocol/compact_binary.h>
+
+#include <sstream>
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const perf::Records records = perf::MakeRecords(200000);
+
+    for (uint16_t version = bond::v1; version <= bond::v2; ++version)
+    {
+        std::cout << "Compact Binary v" << version << std::endl;
+
+        double serial = perf::Measure("Serialize", iterations, [&]
+        {
+            bond::OutputBuffer output;
+            bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, version);
+            bond::Serialize(records, writer);
+        });
+
+        const uint32_t max_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+        for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+        {
+            perf::ThreadPool pool(threads);
+
+            std::ostringstream name;
+            name << "SerializeParallel, " << threads << " thread(s)";
+
+            double parallel = perf::Measure(name.str(), iterations, [&]
+            {
+                bond::OutputBuffer output;
+                bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, version);
+                bond::SerializeParallel(records, writer, pool);
+            });
+
+            std::cout << "    speedup " << std::setprecision(2) << serial / parallel << "x" << std::endl;
+        }
+    }
+
+    return 0;
+}
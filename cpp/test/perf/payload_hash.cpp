@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares hashing Compact Binary payloads with bond::Hash and bond::Equal
+// against skipping and deserializing them.
+
+#include "benchmark.h"
+
+#include <bond/core/hash.h>
+#include <bond/protocol/compact_binary.h>
+
+const uint32_t count = 10000;
+
+
+template <uint16_t Version>
+void Run(const std::string& name, uint32_t iterations, const perf::Records& records)
+{
+    using Reader = bond::CompactBinaryReader<bond::InputBuffer>;
+
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, Version);
+    bond::Serialize(records, writer);
+
+    const bond::blob data = output.GetBuffer();
+
+    perf::Measure(name + " Skip", iterations, [&]
+    {
+        Reader reader(data, Version);
+        reader.Skip(bond::BT_STRUCT);
+    });
+
+    perf::Measure(name + " Hash", iterations, [&]
+    {
+        Reader reader(data, Version);
+        bond::Hash(bond::bonded<perf::Records, Reader&>(reader));
+    });
+
+    perf::Measure(name + " Equal", iterations, [&]
+    {
+        Reader x(data, Version), y(data, Version);
+        bond::Equal(bond::bonded<perf::Records, Reader&>(x), bond::bonded<perf::Records, Reader&>(y));
+    });
+
+    perf::Measure(name + " Deserialize", iterations, [&]
+    {
+        perf::Records to;
+        bond::Deserialize(Reader(data, Version), to);
+    });
+}
+
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const perf::Records records = perf::MakeRecords(count);
+
+    Run<bond::v1>("CompactBinary v1", iterations, records);
+    Run<bond::v2>("CompactBinary v2", iterations, records);
+
+    return 0;
+}
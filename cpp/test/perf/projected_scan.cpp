@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares aggregating two numeric fields of a stream of records with
+// bond::Scan, which deserializes only those fields, against deserializing
+// every record in full.
+
+#include "benchmark.h"
+
+#include <bond/protocol/compact_binary.h>
+#include <bond/protocol/fast_binary.h>
+#include <bond/protocol/simple_binary.h>
+
+namespace
+{
+
+typedef perf::Record::Schema::var Fields;
+
+template <typename Reader, typename Writer>
+void Compare(const std::string& name, uint32_t iterations, const std::vector<perf::Record>& records)
+{
+    std::cout << name << std::endl;
+
+    bond::OutputBuffer output;
+    Writer writer(output);
+    bond::SerializeMany(records, writer);
+
+    const bond::blob data = output.GetBuffer();
+    uint64_t sum = 0;
+
+    perf::Measure("    Deserialize", iterations, [&]
+    {
+        Reader reader(data);
+        bond::bonded<perf::Record, Reader&> bonded(reader);
+
+        sum = 0;
+
+        while (!reader.GetBuffer().IsEof())
+        {
+            perf::Record record;
+            bonded.Deserialize(record);
+            sum += record.id + record.count;
+        }
+    });
+
+    perf::Measure("    Scan", iterations, [&]
+    {
+        Reader reader(data);
+
+        sum = 0;
+
+        bond::Scan<perf::Record, Fields::id, Fields::count>(reader, [&sum](uint64_t id, int32_t count)
+        {
+            sum += id + count;
+        });
+    });
+
+    std::cout << "    Sum: " << sum << std::endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const std::vector<perf::Record> records = perf::MakeRecords(100000).records;
+
+    Compare<bond::CompactBinaryReader<bond::InputBuffer>, bond::CompactBinaryWriter<bond::OutputBuffer> >(
+        "Compact Binary", iterations, records);
+    Compare<bond::FastBinaryReader<bond::InputBuffer>, bond::FastBinaryWriter<bond::OutputBuffer> >(
+        "Fast Binary", iterations, records);
+    Compare<bond::SimpleBinaryReader<bond::InputBuffer>, bond::SimpleBinaryWriter<bond::OutputBuffer> >(
+        "Simple Binary", iterations, records);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares selecting records of a stream with bond::record_filter, which
+// evaluates the predicates on the serialized payloads, against deserializing
+// every record and evaluating the predicates on the objects.
+
+#include "benchmark.h"
+
+#include <bond/core/record_filter.h>
+#include <bond/protocol/compact_binary.h>
+#include <bond/protocol/fast_binary.h>
+
+#include <limits>
+
+namespace
+{
+
+typedef perf::Record::Schema::var Fields;
+
+template <typename Reader, typename Writer>
+void Compare(const std::string& name, uint32_t iterations, const std::vector<perf::Record>& records)
+{
+    std::cout << name << std::endl;
+
+    bond::OutputBuffer output;
+    Writer writer(output);
+    bond::SerializeMany(records, writer);
+
+    const bond::blob data = output.GetBuffer();
+    const int32_t max_count = 500;
+    std::size_t matching = 0;
+
+    perf::Measure("    Deserialize", iterations, [&]
+    {
+        Reader reader(data);
+        bond::bonded<perf::Record, Reader&> bonded(reader);
+
+        matching = 0;
+
+        while (!reader.GetBuffer().IsEof())
+        {
+            perf::Record record;
+            bonded.Deserialize(record);
+
+            if (record.color == perf::Color::Red && record.count <= max_count && record.name.compare(0, 8, "record 1") == 0)
+                ++matching;
+        }
+    });
+
+    bond::record_filter filter;
+    filter.Equal(bond::FilterField<Fields::color>(), perf::Color::Red)
+          .Range(bond::FilterField<Fields::count>(), std::numeric_limits<int32_t>::min(), max_count)
+          .Prefix(bond::FilterField<Fields::name>(), "record 1");
+
+    perf::Measure("    Filter", iterations, [&]
+    {
+        Reader reader(data);
+
+        matching = filter.Filter(reader, [](uint32_t /*offset*/, const bond::blob& /*record*/) {});
+    });
+
+    std::cout << "    Matching: " << matching << std::endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const std::vector<perf::Record> records = perf::MakeRecords(100000).records;
+
+    Compare<bond::CompactBinaryReader<bond::InputBuffer>, bond::CompactBinaryWriter<bond::OutputBuffer> >(
+        "Compact Binary", iterations, records);
+    Compare<bond::FastBinaryReader<bond::InputBuffer>, bond::FastBinaryWriter<bond::OutputBuffer> >(
+        "Fast Binary", iterations, records);
+
+    return 0;
+}
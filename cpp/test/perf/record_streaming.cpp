@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+// Compares bond::SerializeMany and bond::DeserializeMany with serializing and
+// deserializing a stream of records one at a time.
+
+#include "benchmark.h"
+
+#include <bond/protocol/compact_binary.h>
+
+#include <iterator>
+
+int main(int argc, char** argv)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+
+    const uint32_t iterations = perf::Iterations(argc, argv);
+    const std::vector<perf::Record> records = perf::MakeRecords(100000).records;
+
+    for (uint16_t version = bond::v1; version <= bond::v2; ++version)
+    {
+        std::cout << "Compact Binary v" << version << std::endl;
+
+        perf::Measure("Serialize per record", iterations, [&]
+        {
+            bond::OutputBuffer output;
+            Writer writer(output, version);
+
+            for (const perf::Record& record : records)
+                bond::Serialize(record, writer);
+        });
+
+        perf::Measure("SerializeMany", iterations, [&]
+        {
+            bond::OutputBuffer output;
+            Writer writer(output, version);
+
+            bond::SerializeMany(records, writer);
+        });
+
+        bond::OutputBuffer output;
+        Writer writer(output, version);
+        bond::SerializeMany(records, writer);
+
+        const bond::blob data = output.GetBuffer();
+
+        perf::Measure("Deserialize per record", iterations, [&]
+        {
+            Reader reader(data, version);
+            bond::bonded<perf::Record, Reader&> bonded(reader);
+            std::vector<perf::Record> to;
+
+            while (!reader.GetBuffer().IsEof())
+            {
+                perf::Record record;
+                bonded.Deserialize(record);
+                to.push_back(std::move(record));
+            }
+        });
+
+        perf::Measure("DeserializeMany", iterations, [&]
+        {
+            Reader reader(data, version);
+            std::vector<perf::Record> to;
+
+            bond::DeserializeMany<perf::Record>(reader, std::back_inserter(to));
+        });
+    }
+
+    return 0;
+}
@@ -30,7 +30,7 @@ public:
     void operator()(const Field&) const
     {
         // Define read-write property
-        add_property(Field::metadata.name, Field::field);
+        add_property(Field::GetMetadata().name, Field::field);
 
         // Define field type
         def_type<typename Field::value_type>();
@@ -248,12 +248,12 @@ class struct_
 public:
     void def()
     {
-        def_struct(T::Schema::metadata.name);
+        def_struct(T::Schema::GetMetadata().name);
     }
 
     void def(const qualified_name_tag&)
     {
-        def_struct(T::Schema::metadata.qualified_name);
+        def_struct(T::Schema::GetMetadata().qualified_name);
     }
 
 private: